@@ -59,6 +59,11 @@ tests = [
     ("Ice/checksum", ["core"]),
     ("Ice/stream", ["core", "noc++11"]),
     ("Ice/hold", ["core", "bt"]),
+    ("Ice/sendQueue", ["core", "noc++11"]),
+    ("Ice/acceptors", ["core", "noc++11", "nowin32"]),
+    ("Ice/threadPoolShards", ["core", "noc++11"]),
+    ("Ice/threadPoolWorkQueue", ["core", "noc++11"]),
+    ("Ice/compression", ["core", "noc++11"]),
     ("Ice/custom", ["core", "nossl", "nows", "noc++11"]),
     ("Ice/retry", ["core"]),
     ("Ice/timeout", ["core", "nocompress", "nosocks"]),
@@ -88,6 +93,13 @@ tests = [
     ("IceStorm/stress", ["service", "stress", "novc100", "nomingw", "noc++11"]), # Too slow with appverifier.
     ("IceStorm/rep1", ["service", "novc100", "nomingw", "noc++11"]),
     ("IceStorm/repgrid", ["service", "novc100", "nomingw", "noc++11"]),
+    ("IceStorm/replay", ["service", "novc100", "nomingw", "noc++11"]),
+    ("IceStorm/commit", ["service", "novc100", "nomingw", "noc++11"]),
+    ("IceStorm/filter", ["service", "novc100", "nomingw", "noc++11"]),
+    ("IceStorm/overflow", ["service", "novc100", "nomingw", "noc++11"]),
+    ("IceStorm/delivery", ["service", "novc100", "nomingw", "noc++11"]),
+    ("IceStorm/coalesce", ["service", "novc100", "nomingw", "noc++11"]),
+    ("IceStorm/link", ["service", "novc100", "nomingw", "noc++11"]),
     ("IceStorm/repstress", ["service", "noipv6", "stress", "novc100", "nomingw", "noc++11"]),
     ("IceDiscovery/simple", ["service"]),
     ("IceGrid/simple", ["service", "novc100", "nomingw", "noc++11"]),
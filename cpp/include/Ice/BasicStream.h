@@ -552,6 +552,7 @@ public:
     }
     void read(std::vector<Ice::Byte>&);
     void read(std::pair<const Ice::Byte*, const Ice::Byte*>&);
+    void read(Ice::ByteView&);
 
     // This method is useful for generic stream helpers
     void read(std::pair<const Ice::Byte*, const Ice::Byte*>& p, ::IceUtil::ScopedArray<Ice::Byte>& result)
@@ -10,11 +10,40 @@
 #ifndef ICE_BUFFER_H
 #define ICE_BUFFER_H
 
+#include <IceUtil/Shared.h>
+#include <IceUtil/Handle.h>
 #include <Ice/Config.h>
+#include <Ice/BufferPoolF.h>
 
 namespace IceInternal
 {
 
+//
+// The memory of a buffer shared with byte sequence views. The memory
+// is released once the buffer and all the views are destroyed.
+//
+class ICE_API SharedBuffer : public IceUtil::Shared
+{
+public:
+
+    SharedBuffer(Ice::Byte*, size_t, const BufferPoolPtr&);
+    virtual ~SharedBuffer();
+
+    static IceUtil::Handle<SharedBuffer> copy(const Ice::Byte*, const Ice::Byte*);
+
+    const Ice::Byte* begin() const
+    {
+        return _buf;
+    }
+
+private:
+
+    Ice::Byte* _buf;
+    const size_t _capacity;
+    const BufferPoolPtr _pool;
+};
+typedef IceUtil::Handle<SharedBuffer> SharedBufferPtr;
+
 class ICE_API Buffer : private IceUtil::noncopyable
 {
 public:
@@ -80,6 +109,20 @@ public:
         
         void clear();
 
+        //
+        // Allocate the buffer memory from the given pool. This must
+        // be called before any memory is allocated.
+        //
+        void setPool(const BufferPoolPtr&);
+
+        //
+        // Share the buffer memory with byte sequence views. The
+        // container doesn't write to the memory anymore once it's
+        // shared, it allocates new memory instead. Returns 0 if the
+        // memory isn't owned by the container.
+        //
+        SharedBufferPtr share();
+
         void resize(size_type n) // Inlined for performance reasons.
         {
             assert(!_buf || _capacity > 0);
@@ -88,6 +131,10 @@ public:
             {
                 clear();
             }
+            else if(_owner)
+            {
+                unshare(n); // Don't modify memory shared with views.
+            }
             else if(n > _capacity)
             {
                 reserve(n);
@@ -99,6 +146,12 @@ public:
         {
             assert(!_buf || _capacity > 0);
 
+            if(_owner)
+            {
+                clear(); // Don't re-use memory shared with views.
+                return;
+            }
+
             if(_size > 0 && _size * 2 < _capacity)
             {
                 //
@@ -143,11 +196,14 @@ public:
         Container(const Container&);
         void operator=(const Container&);
         void reserve(size_type);
+        void unshare(size_type);
 
         pointer _buf;
         size_type _size;
         size_type _capacity;
         int _shrinkCounter;
+        BufferPoolPtr _pool;
+        SharedBufferPtr _owner;
     };
 
     Container b;
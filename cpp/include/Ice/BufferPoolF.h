@@ -0,0 +1,25 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_BUFFER_POOL_F_H
+#define ICE_BUFFER_POOL_F_H
+
+#include <IceUtil/Shared.h>
+#include <Ice/Handle.h>
+
+namespace IceInternal
+{
+
+class BufferPool;
+ICE_API IceUtil::Shared* upCast(BufferPool*);
+typedef IceInternal::Handle<BufferPool> BufferPoolPtr;
+
+}
+
+#endif
@@ -0,0 +1,130 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_BYTE_VIEW_H
+#define ICE_BYTE_VIEW_H
+
+#include <Ice/Config.h>
+#include <Ice/Buffer.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace Ice
+{
+
+//
+// A read-only byte sequence unmarshaled without copying the bytes
+// out of the message buffer. The view shares the memory of the
+// buffer: it remains valid after the stream it was read from is
+// destroyed, and copying a view doesn't copy the bytes.
+//
+// Use it with the cpp:type metadata, for example:
+//
+// ["cpp:type:Ice::ByteView"] sequence<byte> Blob;
+//
+class ByteView
+{
+public:
+
+    typedef Byte value_type;
+    typedef const Byte* iterator;
+    typedef const Byte* const_iterator;
+    typedef const Byte& reference;
+    typedef const Byte& const_reference;
+    typedef const Byte* pointer;
+    typedef size_t size_type;
+
+    ByteView() : _begin(0), _end(0)
+    {
+    }
+
+    //
+    // Create a view that copies the given bytes.
+    //
+    ByteView(const Byte* beg, const Byte* end) :
+        _owner(IceInternal::SharedBuffer::copy(beg, end))
+    {
+        _begin = _owner->begin();
+        _end = _begin + (end - beg);
+    }
+
+    ByteView(const std::vector<Byte>& v) :
+        _owner(IceInternal::SharedBuffer::copy(v.empty() ? 0 : &v[0], v.empty() ? 0 : &v[0] + v.size()))
+    {
+        _begin = _owner->begin();
+        _end = _begin + v.size();
+    }
+
+    //
+    // Create a view of bytes owned by the given shared buffer.
+    //
+    ByteView(const Byte* beg, const Byte* end, const IceInternal::SharedBufferPtr& owner) :
+        _begin(beg), _end(end), _owner(owner)
+    {
+    }
+
+    const_iterator begin() const
+    {
+        return _begin;
+    }
+
+    const_iterator end() const
+    {
+        return _end;
+    }
+
+    size_type size() const
+    {
+        return static_cast<size_type>(_end - _begin);
+    }
+
+    bool empty() const
+    {
+        return _begin == _end;
+    }
+
+    const_reference operator[](size_type n) const
+    {
+        assert(n < size());
+        return _begin[n];
+    }
+
+    void swap(ByteView& other)
+    {
+        std::swap(_begin, other._begin);
+        std::swap(_end, other._end);
+        _owner.swap(other._owner);
+    }
+
+    bool operator==(const ByteView& other) const
+    {
+        return size() == other.size() && std::equal(_begin, _end, other._begin);
+    }
+
+    bool operator!=(const ByteView& other) const
+    {
+        return !operator==(other);
+    }
+
+    bool operator<(const ByteView& other) const
+    {
+        return std::lexicographical_compare(_begin, _end, other._begin, other._end);
+    }
+
+private:
+
+    const Byte* _begin;
+    const Byte* _end;
+    IceInternal::SharedBufferPtr _owner;
+};
+
+}
+
+#endif
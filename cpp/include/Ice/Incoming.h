@@ -121,6 +121,7 @@ public:
     {
         _current.encoding = _is->readEncaps(v, sz);
     }
+    void readParamEncaps(Ice::ByteView&);
 
 private:
 
@@ -233,6 +233,17 @@ public:
         read(p);
     }
 
+    //
+    // Read a byte sequence view. The default implementation copies
+    // the bytes.
+    //
+    virtual void read(ByteView& v)
+    {
+        ::std::pair<const Byte*, const Byte*> p;
+        read(p);
+        ByteView(p.first, p.second).swap(v);
+    }
+
     virtual bool readOptional(Int, OptionalFormat) = 0;
 
     template<typename T> inline void read(T& v)
@@ -14,6 +14,7 @@
 #include <IceUtil/Iterator.h>
 
 #include <Ice/ObjectF.h>
+#include <Ice/ByteView.h>
 #include <Ice/Traits.h>
 
 namespace Ice
@@ -463,6 +464,23 @@ struct StreamHelper<std::pair<IceUtil::ScopedArray<T>, std::pair<const T*, const
     // no write: only used for unmarshaling
 };
 
+// Helper for zero-copy byte sequence views
+template<>
+struct StreamHelper<ByteView, StreamHelperCategorySequence>
+{
+    template<class S> static inline void
+    write(S* stream, const ByteView& v)
+    {
+        stream->write(v.begin(), v.end());
+    }
+
+    template<class S> static inline void
+    read(S* stream, ByteView& v)
+    {
+        stream->read(v);
+    }
+};
+
 // Helper for dictionaries
 template<typename T>
 struct StreamHelper<T, StreamHelperCategoryDictionary>
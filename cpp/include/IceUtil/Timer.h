@@ -15,8 +15,11 @@
 #include <IceUtil/Monitor.h>
 #include <IceUtil/Time.h>
 
-#include <set>
 #include <map>
+#include <vector>
+#ifdef ICE_CPP11_COMPILER
+#   include <unordered_map>
+#endif
 
 namespace IceUtil
 {
@@ -44,7 +47,13 @@ ICE_DEFINE_PTR(TimerTaskPtr, TimerTask);
 //
 // The timer class is used to schedule tasks for one-time execution or
 // repeated execution. Tasks are executed by the dedicated timer thread 
-// sequentially.
+// sequentially, or concurrently by the additional execution threads
+// started with addThreads().
+//
+// The scheduled tasks are kept in a hierarchical timing wheel with a
+// resolution of one millisecond: scheduling and canceling a task are
+// constant time operations, independently of the number of scheduled
+// tasks.
 //
 class ICE_UTIL_API Timer : virtual public IceUtil::Shared, private IceUtil::Thread
 {
@@ -67,6 +76,12 @@ public:
     //
     void destroy();
 
+    //
+    // Start the given number of additional execution threads. The
+    // threads are started with the priority of the timer thread.
+    //
+    void addThreads(int);
+
     //
     // Schedule a task for execution after a given delay.
     //
@@ -93,17 +108,20 @@ protected:
 
     struct Token
     {
-        IceUtil::Time scheduledTime;
-        IceUtil::Time delay;
         TimerTaskPtr task;
+        IceUtil::Time delay;
+        IceUtil::Int64 expires; // The tick at which the task expires.
+        int slot; // The wheel slot of the token, or one of the states below.
+        Token* prev;
+        Token* next;
 
-        inline Token(const IceUtil::Time&, const IceUtil::Time&, const TimerTaskPtr&);
-        inline bool operator<(const Token& r) const;
+        enum { Ready = -1, Running = -2 };
+
+        inline Token(const TimerTaskPtr&, const IceUtil::Time&);
     };
 
     IceUtil::Monitor<IceUtil::Mutex> _monitor;
     bool _destroyed;
-    std::set<Token> _tokens;
     
     class TimerTaskCompare : public std::binary_function<TimerTaskPtr, TimerTaskPtr, bool>
     {
@@ -114,33 +132,63 @@ protected:
             return lhs.get() < rhs.get();
         }
     };
-    std::map<TimerTaskPtr, IceUtil::Time, TimerTaskCompare> _tasks;
+#ifdef ICE_CPP11_COMPILER
+    class TimerTaskHash
+    {
+    public:
+
+        size_t operator()(const TimerTaskPtr& task) const
+        {
+            return std::hash<TimerTask*>()(task.get());
+        }
+    };
+
+    class TimerTaskEqual
+    {
+    public:
+
+        bool operator()(const TimerTaskPtr& lhs, const TimerTaskPtr& rhs) const
+        {
+            return lhs.get() == rhs.get();
+        }
+    };
+    typedef std::unordered_map<TimerTaskPtr, Token*, TimerTaskHash, TimerTaskEqual> TaskMap;
+#else
+    typedef std::map<TimerTaskPtr, Token*, TimerTaskCompare> TaskMap;
+#endif
+    TaskMap _tasks;
     IceUtil::Time _wakeUpTime;
+
+private:
+
+    class WorkerThread;
+    friend class WorkerThread;
+
+    void scheduleToken(const TimerTaskPtr&, const IceUtil::Time&, const IceUtil::Time&);
+    void link(Token*);
+    void unlink(Token*);
+    void advance(IceUtil::Int64);
+    int cascade(int, IceUtil::Int64);
+    IceUtil::Int64 nextTick() const;
+
+    bool _hasPriority;
+    int _priority;
+    std::vector<IceUtil::ThreadControl> _threads;
+
+    std::vector<Token*> _wheel;
+    size_t _levelCount[4];
+    Token* _readyHead;
+    Token* _readyTail;
+    IceUtil::Int64 _currentTick;
 };
 typedef IceUtil::Handle<Timer> TimerPtr;
 
 inline 
-Timer::Token::Token(const IceUtil::Time& st, const IceUtil::Time& d, const TimerTaskPtr& t) :
-    scheduledTime(st), delay(d), task(t)
-{
-}
-
-inline bool
-Timer::Token::operator<(const Timer::Token& r) const
+Timer::Token::Token(const TimerTaskPtr& t, const IceUtil::Time& d) :
+    task(t), delay(d), expires(0), slot(Ready), prev(0), next(0)
 {
-    if(scheduledTime < r.scheduledTime)
-    {
-        return true;
-    }
-    else if(scheduledTime > r.scheduledTime)
-    {
-        return false;
-    }
-    
-    return task.get() < r.task.get();
 }
 
 }
 
 #endif
-
@@ -140,6 +140,7 @@ Blobject.obj: \
     "Instance.h" \
     "ProxyVerifier.h" \
     "SessionRouterI.h" \
+    "SessionTable.h" \
     "$(includedir)\Glacier2\PermissionsVerifierF.h" \
     "$(includedir)\Glacier2\Router.h" \
     "$(includedir)\Glacier2\Session.h" \
@@ -279,6 +280,7 @@ ClientBlobject.obj: \
     "Instance.h" \
     "ProxyVerifier.h" \
     "SessionRouterI.h" \
+    "SessionTable.h" \
     "$(includedir)\Glacier2\PermissionsVerifierF.h" \
     "$(includedir)\Glacier2\Router.h" \
     "$(includedir)\Glacier2\Session.h" \
@@ -517,6 +519,7 @@ FilterManager.obj: \
     "Instrumentation.h" \
     "ProxyVerifier.h" \
     "SessionRouterI.h" \
+    "SessionTable.h" \
     "$(includedir)\Glacier2\PermissionsVerifierF.h" \
     "$(includedir)\Glacier2\Router.h" \
     "$(includedir)\Glacier2\Session.h" \
@@ -659,6 +662,7 @@ Glacier2Router.obj: \
     "Instrumentation.h" \
     "ProxyVerifier.h" \
     "SessionRouterI.h" \
+    "SessionTable.h" \
     "$(includedir)\Glacier2\PermissionsVerifierF.h" \
     "$(includedir)\Glacier2\Router.h" \
     "$(includedir)\Glacier2\Session.h" \
@@ -674,6 +678,7 @@ Glacier2Router.obj: \
 Instance.obj: \
 	Instance.cpp \
     "SessionRouterI.h" \
+    "SessionTable.h" \
     "$(includedir)\IceUtil\Thread.h" \
     "$(includedir)\IceUtil\Config.h" \
     "$(includedir)\IceUtil\Shared.h" \
@@ -1182,6 +1187,7 @@ RequestQueue.obj: \
     "Instance.h" \
     "ProxyVerifier.h" \
     "SessionRouterI.h" \
+    "SessionTable.h" \
     "$(includedir)\Glacier2\PermissionsVerifierF.h" \
     "$(includedir)\Glacier2\Router.h" \
     "$(includedir)\Glacier2\Session.h" \
@@ -1321,6 +1327,7 @@ RouterI.obj: \
     "Instrumentation.h" \
     "ProxyVerifier.h" \
     "SessionRouterI.h" \
+    "SessionTable.h" \
     "$(includedir)\Glacier2\PermissionsVerifierF.h" \
     "$(includedir)\Glacier2\Router.h" \
     "$(includedir)\Glacier2\Session.h" \
@@ -1595,6 +1602,7 @@ ServerBlobject.obj: \
     "Instance.h" \
     "ProxyVerifier.h" \
     "SessionRouterI.h" \
+    "SessionTable.h" \
     "$(includedir)\Glacier2\PermissionsVerifierF.h" \
     "$(includedir)\Glacier2\Router.h" \
     "$(includedir)\Glacier2\Session.h" \
@@ -1605,6 +1613,7 @@ ServerBlobject.obj: \
 SessionRouterI.obj: \
 	SessionRouterI.cpp \
     "SessionRouterI.h" \
+    "SessionTable.h" \
     "$(includedir)\IceUtil\Thread.h" \
     "$(includedir)\IceUtil\Config.h" \
     "$(includedir)\IceUtil\Shared.h" \
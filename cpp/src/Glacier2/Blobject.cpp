@@ -48,11 +48,11 @@ Glacier2::Blobject::Blobject(const InstancePtr& instance, const ConnectionPtr& r
                         _instance->properties()->getPropertyAsInt(clientTraceOverride)),
     _context(context)
 {
-    RequestQueueThreadPtr t = _reverseConnection ? _instance->serverRequestQueueThread() : 
-                                                   _instance->clientRequestQueueThread();
-    if(t)
+    RequestQueueSchedulerPtr s = _reverseConnection ? _instance->serverRequestQueueScheduler() :
+                                                      _instance->clientRequestQueueScheduler();
+    if(s)
     {
-        const_cast<RequestQueuePtr&>(_requestQueue) = new RequestQueue(t, _instance, _reverseConnection);
+        const_cast<RequestQueuePtr&>(_requestQueue) = new RequestQueue(s, _instance, _reverseConnection);
     }
 }
 
@@ -78,6 +78,39 @@ Glacier2::Blobject::updateObserver(const Glacier2::Instrumentation::SessionObser
     }
 }
 
+DispatchStatus
+Glacier2::Blobject::__dispatch(IceInternal::Incoming& in, const Current& current)
+{
+    //
+    // Unlike BlobjectArrayAsync, read the in-parameters as a view of
+    // the message buffer, which keeps the buffer alive while the
+    // request is queued.
+    //
+    ByteView inParams;
+    in.readParamEncaps(inParams);
+    AMD_Object_ice_invokePtr cb = new ::IceAsync::Ice::AMD_Object_ice_invoke(in);
+    try
+    {
+        dispatch(cb, inParams, current);
+    }
+    catch(const ::std::exception& ex)
+    {
+        cb->ice_exception(ex);
+    }
+    catch(...)
+    {
+        cb->ice_exception();
+    }
+    return DispatchAsync;
+}
+
+void
+Glacier2::Blobject::ice_invoke_async(const AMD_Object_ice_invokePtr& amdCB,
+                                     const pair<const Byte*, const Byte*>& inParams, const Current& current)
+{
+    dispatch(amdCB, ByteView(inParams.first, inParams.second), current);
+}
+
 void
 Glacier2::Blobject::invokeResponse(bool ok, const pair<const Byte*, const Byte*>& outParams,
                                    const AMD_Object_ice_invokePtr& amdCB)
@@ -124,8 +157,8 @@ Glacier2::Blobject::invokeException(const Exception& ex, const AMD_Object_ice_in
 }
 
 void
-Glacier2::Blobject::invoke(ObjectPrx& proxy, const AMD_Object_ice_invokePtr& amdCB, 
-                           const std::pair<const Byte*, const Byte*>& inParams, const Current& current)
+Glacier2::Blobject::invoke(ObjectPrx& proxy, const AMD_Object_ice_invokePtr& amdCB, const ByteView& inParams,
+                           const Current& current)
 {
     //
     // Set the correct facet on the proxy.
@@ -342,6 +375,7 @@ Glacier2::Blobject::invoke(ObjectPrx& proxy, const AMD_Object_ice_invokePtr& amd
 
         try
         {
+            const pair<const Byte*, const Byte*> inPair(inParams.begin(), inParams.end());
             Callback_Object_ice_invokePtr amiCB;
             if(proxy->ice_isTwoway())
             {
@@ -358,22 +392,22 @@ Glacier2::Blobject::invoke(ObjectPrx& proxy, const AMD_Object_ice_invokePtr& amd
                 {
                     Context ctx = current.ctx;
                     ctx.insert(_context.begin(), _context.end());
-                    proxy->begin_ice_invoke(current.operation, current.mode, inParams, ctx, amiCB, amdCB);
+                    proxy->begin_ice_invoke(current.operation, current.mode, inPair, ctx, amiCB, amdCB);
                 }
                 else
                 {
-                    proxy->begin_ice_invoke(current.operation, current.mode, inParams, current.ctx, amiCB, amdCB);
+                    proxy->begin_ice_invoke(current.operation, current.mode, inPair, current.ctx, amiCB, amdCB);
                 }
             }
             else
             {
                 if(_context.size() > 0)
                 {
-                    proxy->begin_ice_invoke(current.operation, current.mode, inParams, _context, amiCB, amdCB);
+                    proxy->begin_ice_invoke(current.operation, current.mode, inPair, _context, amiCB, amdCB);
                 }
                 else
                 {
-                    proxy->begin_ice_invoke(current.operation, current.mode, inParams, amiCB, amdCB);
+                    proxy->begin_ice_invoke(current.operation, current.mode, inPair, amiCB, amdCB);
                 }
             }
         }
@@ -25,6 +25,16 @@ public:
     virtual ~Blobject();
 
     void destroy();
+
+    virtual Ice::DispatchStatus __dispatch(IceInternal::Incoming&, const Ice::Current&);
+    virtual void ice_invoke_async(const Ice::AMD_Object_ice_invokePtr&,
+                                  const std::pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Current&);
+
+    //
+    // Dispatch the request, the in-parameters share the message buffer
+    // and can be queued without being copied.
+    //
+    virtual void dispatch(const Ice::AMD_Object_ice_invokePtr&, const Ice::ByteView&, const Ice::Current&) = 0;
     
     virtual void updateObserver(const Glacier2::Instrumentation::SessionObserverPtr&);
     
@@ -35,8 +45,7 @@ public:
 
 protected:
 
-    void invoke(Ice::ObjectPrx&, const Ice::AMD_Object_ice_invokePtr&, 
-                const std::pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Current&);
+    void invoke(Ice::ObjectPrx&, const Ice::AMD_Object_ice_invokePtr&, const Ice::ByteView&, const Ice::Current&);
 
     const InstancePtr _instance;
     const Ice::ConnectionPtr _reverseConnection;
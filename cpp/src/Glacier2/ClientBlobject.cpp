@@ -33,9 +33,8 @@ Glacier2::ClientBlobject::~ClientBlobject()
 }
 
 void
-Glacier2::ClientBlobject::ice_invoke_async(const Ice::AMD_Object_ice_invokePtr& amdCB, 
-                                           const std::pair<const Byte*, const Byte*>& inParams,
-                                           const Current& current)
+Glacier2::ClientBlobject::dispatch(const Ice::AMD_Object_ice_invokePtr& amdCB, const ByteView& inParams,
+                                   const Current& current)
 {
     bool matched = false;
     bool hasFilters = false;
@@ -32,8 +32,7 @@ public:
     ClientBlobject(const InstancePtr&, const FilterManagerPtr&, const Ice::Context&, const RoutingTablePtr&); 
     virtual ~ClientBlobject();
 
-    virtual void ice_invoke_async(const Ice::AMD_Object_ice_invokePtr&,
-                                  const std::pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Current&);
+    virtual void dispatch(const Ice::AMD_Object_ice_invokePtr&, const Ice::ByteView&, const Ice::Current&);
 
     StringSetPtr categories();
     StringSetPtr adapterIds();
@@ -22,6 +22,23 @@ const string serverSleepTime = "Glacier2.Server.SleepTime";
 const string clientSleepTime = "Glacier2.Client.SleepTime";
 const string serverBuffered = "Glacier2.Server.Buffered";
 const string clientBuffered = "Glacier2.Client.Buffered";
+const string serverFlushSize = "Glacier2.Server.FlushSize";
+const string clientFlushSize = "Glacier2.Client.FlushSize";
+
+//
+// The deferred flushes of a direction run on as many timer threads as
+// the thread pool of the object adapter dispatching its requests.
+//
+int
+flushThreads(const Ice::PropertiesPtr& properties, const string& adapter)
+{
+    int size = properties->getPropertyAsInt(adapter + ".ThreadPool.Size");
+    if(size <= 0)
+    {
+        size = properties->getPropertyAsIntWithDefault("Ice.ThreadPool.Server.Size", 1);
+    }
+    return size;
+}
 
 }
 
@@ -36,29 +53,26 @@ Glacier2::Instance::Instance(const Ice::CommunicatorPtr& communicator, const Ice
     if(_properties->getPropertyAsIntWithDefault(serverBuffered, 1) > 0)
     {
         IceUtil::Time sleepTime = IceUtil::Time::milliSeconds(_properties->getPropertyAsInt(serverSleepTime));
-        const_cast<RequestQueueThreadPtr&>(_serverRequestQueueThread) = new RequestQueueThread(sleepTime);
-        try
-        {
-            _serverRequestQueueThread->start();
-        }
-        catch(const IceUtil::Exception&)
-        {
-            _serverRequestQueueThread->destroy();
-            throw;
-        }
+        const_cast<RequestQueueSchedulerPtr&>(_serverRequestQueueScheduler) =
+            new RequestQueueScheduler(sleepTime, _properties->getPropertyAsInt(serverFlushSize),
+                                      flushThreads(_properties, "Glacier2.Server"));
     }
 
     if(_properties->getPropertyAsIntWithDefault(clientBuffered, 1) > 0)
     {
         IceUtil::Time sleepTime = IceUtil::Time::milliSeconds(_properties->getPropertyAsInt(clientSleepTime));
-        const_cast<RequestQueueThreadPtr&>(_clientRequestQueueThread) = new RequestQueueThread(sleepTime);
         try
         {
-            _clientRequestQueueThread->start();
+            const_cast<RequestQueueSchedulerPtr&>(_clientRequestQueueScheduler) =
+                new RequestQueueScheduler(sleepTime, _properties->getPropertyAsInt(clientFlushSize),
+                                          flushThreads(_properties, "Glacier2.Client"));
         }
         catch(const IceUtil::Exception&)
         {
-            _clientRequestQueueThread->destroy();
+            if(_serverRequestQueueScheduler)
+            {
+                _serverRequestQueueScheduler->destroy();
+            }
             throw;
         }
     }
@@ -86,14 +100,14 @@ Glacier2::Instance::~Instance()
 void
 Glacier2::Instance::destroy()
 {
-    if(_clientRequestQueueThread)
+    if(_clientRequestQueueScheduler)
     {
-        _clientRequestQueueThread->destroy();
+        _clientRequestQueueScheduler->destroy();
     }
 
-    if(_serverRequestQueueThread)
+    if(_serverRequestQueueScheduler)
     {
-        _serverRequestQueueThread->destroy();
+        _serverRequestQueueScheduler->destroy();
     }
 
     const_cast<SessionRouterIPtr&>(_sessionRouter) = 0;
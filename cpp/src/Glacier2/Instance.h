@@ -36,8 +36,8 @@ public:
     Ice::PropertiesPtr properties() const { return _properties; }
     Ice::LoggerPtr logger() const { return _logger; }
 
-    RequestQueueThreadPtr clientRequestQueueThread() const { return _clientRequestQueueThread; }
-    RequestQueueThreadPtr serverRequestQueueThread() const { return _serverRequestQueueThread; }
+    RequestQueueSchedulerPtr clientRequestQueueScheduler() const { return _clientRequestQueueScheduler; }
+    RequestQueueSchedulerPtr serverRequestQueueScheduler() const { return _serverRequestQueueScheduler; }
     ProxyVerifierPtr proxyVerifier() const { return _proxyVerifier; }
     SessionRouterIPtr sessionRouter() const { return _sessionRouter; }
 
@@ -55,8 +55,8 @@ private:
     const Ice::LoggerPtr _logger;
     const Ice::ObjectAdapterPtr _clientAdapter;
     const Ice::ObjectAdapterPtr _serverAdapter;
-    const RequestQueueThreadPtr _clientRequestQueueThread;
-    const RequestQueueThreadPtr _serverRequestQueueThread;
+    const RequestQueueSchedulerPtr _clientRequestQueueScheduler;
+    const RequestQueueSchedulerPtr _serverRequestQueueScheduler;
     const ProxyVerifierPtr _proxyVerifier;
     const SessionRouterIPtr _sessionRouter;
     const Glacier2::Instrumentation::RouterObserverPtr _observer;
@@ -9,6 +9,7 @@
 
 #include <Glacier2/ProxyVerifier.h>
 
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -157,6 +158,12 @@ public:
         return result;
     }
 
+    const string&
+    criteria() const
+    {
+        return _criteria;
+    }
+
     const char*
     toString() const
     {
@@ -201,6 +208,12 @@ public:
         return true;
     }
 
+    const string&
+    criteria() const
+    {
+        return _criteria;
+    }
+
     virtual const char*
     toString() const
     {
@@ -518,18 +531,150 @@ public:
 };
 
 //
-// A proxy validation rule encapsulating an address filter.
+// Matches the port of an endpoint. The values and ranges are merged
+// into a sorted set of disjoint intervals when the rule is parsed so
+// checking a port is a binary search.
 //
-class AddressRule : public Glacier2::ProxyRule
+class PortMatcher : public MatchesNumber
 {
 public:
-    AddressRule(const CommunicatorPtr& communicator, const vector<AddressMatcher*>& address, MatchesNumber* port,
+    PortMatcher(const vector<int>& values, const vector<Range>& ranges) :
+        MatchesNumber(values, ranges)
+    {
+        vector<Interval> intervals;
+        for(vector<int>::const_iterator i = values.begin(); i != values.end(); ++i)
+        {
+            intervals.push_back(Interval(*i, *i));
+        }
+        for(vector<Range>::const_iterator i = ranges.begin(); i != ranges.end(); ++i)
+        {
+            if(i->start <= i->end)
+            {
+                intervals.push_back(Interval(i->start, i->end));
+            }
+        }
+        sort(intervals.begin(), intervals.end());
+
+        for(vector<Interval>::const_iterator i = intervals.begin(); i != intervals.end(); ++i)
+        {
+            if(!_intervals.empty() && i->first <= _intervals.back().second + 1)
+            {
+                _intervals.back().second = max(_intervals.back().second, i->second);
+            }
+            else
+            {
+                _intervals.push_back(*i);
+            }
+        }
+    }
+
+    bool
+    contains(long port) const
+    {
+        vector<Interval>::const_iterator p = upper_bound(_intervals.begin(), _intervals.end(), port, startsAfter);
+        return p != _intervals.begin() && port <= (--p)->second;
+    }
+
+private:
+
+    typedef pair<long, long> Interval;
+
+    static bool
+    startsAfter(long port, const Interval& interval)
+    {
+        return port < interval.first;
+    }
+
+    vector<Interval> _intervals;
+};
+
+//
+// The host and port of an endpoint, extracted once for all the rules.
+//
+struct Address
+{
+    string host;
+    string port;
+    long portNumber;
+    bool validPort;
+};
+
+static bool
+extractPart(const char* opt, const string& source, string& result)
+{
+    string::size_type start = source.find(opt);
+    if(start == string::npos)
+    {
+        return false;
+    }
+    start += strlen(opt);
+    string::size_type end = source.find(' ', start);
+    if(end != string::npos)
+    {
+        result = source.substr(start, end - start);
+    }
+    else
+    {
+        result = source.substr(start);
+    }
+    return true;
+}
+
+//
+// Returns false if the proxy has no endpoints or if an endpoint has no
+// host or port, no address rule can match such a proxy.
+//
+static bool
+extractAddresses(const ObjectPrx& prx, vector<Address>& addresses)
+{
+    EndpointSeq endpoints = prx->ice_getEndpoints();
+    if(endpoints.empty())
+    {
+        return false;
+    }
+
+    addresses.resize(endpoints.size());
+    for(EndpointSeq::size_type i = 0; i < endpoints.size(); ++i)
+    {
+        string info = endpoints[i]->toString();
+        Address& address = addresses[i];
+        if(!extractPart("-h ", info, address.host) || !extractPart("-p ", info, address.port))
+        {
+            return false;
+        }
+        istringstream istr(address.port);
+        int port = 0;
+        address.validPort = !(istr >> port).fail();
+        address.portNumber = port;
+    }
+    return true;
+}
+
+//
+// An address filter, the proxy matches if the host and port of all of
+// its endpoints match.
+//
+class AddressRule : public IceUtil::noncopyable
+{
+public:
+    AddressRule(const CommunicatorPtr& communicator, const vector<AddressMatcher*>& address, PortMatcher* port,
                 const int traceLevel) :
         _communicator(communicator),
         _addressRules(address),
         _portMatcher(port),
         _traceLevel(traceLevel)
     {
+        assert(!_addressRules.empty());
+        StartsWithString* startsWith = dynamic_cast<StartsWithString*>(_addressRules.front());
+        if(startsWith)
+        {
+            _prefix = startsWith->criteria();
+        }
+        EndsWithString* endsWith = dynamic_cast<EndsWithString*>(_addressRules.back());
+        if(endsWith)
+        {
+            _suffix = endsWith->criteria();
+        }
     }
 
     ~AddressRule()
@@ -541,63 +686,60 @@ public:
         delete _portMatcher;
     }
 
-    virtual bool 
-    check(const ObjectPrx& prx) const
+    //
+    // The string the hosts must start with, or end with, to match the
+    // rule. Empty if the rule doesn't require one.
+    //
+    const string&
+    prefix() const
     {
-        EndpointSeq endpoints = prx->ice_getEndpoints();
-        if(endpoints.size() == 0)
-        {
-            return false;
-        }
+        return _prefix;
+    }
 
-        for(EndpointSeq::const_iterator i = endpoints.begin(); i != endpoints.end(); ++i)
-        {
-            string info = (*i)->toString();
-            string host;
-            if(!extractPart("-h ", info, host))
-            {
-                return false;
-            }
-            string port;
-            if(!extractPart("-p ", info, port))
-            {
-                return false;
-            }
+    const string&
+    suffix() const
+    {
+        return _suffix;
+    }
 
-            string::size_type pos = 0;
-            if(_portMatcher && !_portMatcher->match(port, pos))
+    bool
+    match(const vector<Address>& addresses) const
+    {
+        for(vector<Address>::const_iterator p = addresses.begin(); p != addresses.end(); ++p)
+        {
+            if(_portMatcher && !(p->validPort && _portMatcher->contains(p->portNumber)))
             {
                 if(_traceLevel >= 3)
                 {
                     Trace out(_communicator->getLogger(), "Glacier2");
-                    out << _portMatcher->toString() << " failed to match " << port << " at pos=" << pos << "\n";
+                    out << _portMatcher->toString() << " failed to match " << p->port << "\n";
                 }
                 return false;
             }
 
-            pos = 0;
+            string::size_type pos = 0;
             for(vector<AddressMatcher*>::const_iterator i = _addressRules.begin(); i != _addressRules.end(); ++i)
             {
-                if(!(*i)->match(host, pos))
+                if(!(*i)->match(p->host, pos))
                 {
                     if(_traceLevel >= 3)
                     {
                         Trace out(_communicator->getLogger(), "Glacier2");
-                        out << (*i)->toString() << " failed to match " << host << " at pos=" << pos << "\n";
+                        out << (*i)->toString() << " failed to match " << p->host << " at pos=" << pos << "\n";
                     }
                     return false;
                 }
                 if(_traceLevel >= 3)
                 {
                     Trace out(_communicator->getLogger(), "Glacier2");
-                    out << (*i)->toString() << " matched " << host << " at pos=" << pos << "\n";
+                    out << (*i)->toString() << " matched " << p->host << " at pos=" << pos << "\n";
                 }
             }
         }
         return true;
     }
 
-    void 
+    void
     dump() const
     {
         cerr << "address(";
@@ -614,49 +756,187 @@ public:
 
 private:
 
-    bool 
-    extractPart(const char* opt, const string& source, string& result) const
+    CommunicatorPtr _communicator;
+    vector<AddressMatcher*> _addressRules;
+    PortMatcher* _portMatcher;
+    const int _traceLevel;
+    string _prefix;
+    string _suffix;
+};
+
+//
+// A trie over the bytes of the rule prefixes (or of the reversed rule
+// suffixes). Walking the host (or the reversed host) down the trie
+// visits exactly the rules whose prefix (or suffix) the host has.
+//
+class ByteTrie
+{
+public:
+
+    ByteTrie() :
+        _nodes(1)
     {
-        string::size_type start = source.find(opt);
-        if(start == string::npos)
+    }
+
+    template<typename I> void
+    add(I p, I end, size_t rule)
+    {
+        size_t node = 0;
+        for(; p != end; ++p)
         {
-            return false;
+            unsigned char c = static_cast<unsigned char>(*p);
+            map<unsigned char, size_t>::const_iterator q = _nodes[node].next.find(c);
+            if(q != _nodes[node].next.end())
+            {
+                node = q->second;
+            }
+            else
+            {
+                size_t next = _nodes.size();
+                _nodes[node].next[c] = next;
+                _nodes.push_back(Node());
+                node = next;
+            }
+        }
+        _nodes[node].rules.push_back(rule);
+    }
+
+    template<typename I> bool
+    match(I p, I end, const vector<AddressRule*>& rules, const vector<Address>& addresses) const
+    {
+        size_t node = 0;
+        for(; p != end; ++p)
+        {
+            map<unsigned char, size_t>::const_iterator q = _nodes[node].next.find(static_cast<unsigned char>(*p));
+            if(q == _nodes[node].next.end())
+            {
+                return false;
+            }
+            node = q->second;
+            for(vector<size_t>::const_iterator r = _nodes[node].rules.begin(); r != _nodes[node].rules.end(); ++r)
+            {
+                if(rules[*r]->match(addresses))
+                {
+                    return true;
+                }
+            }
         }
-        start += strlen(opt);
-        string::size_type end = source.find(' ', start);
-        if(end != string::npos)
+        return false;
+    }
+
+private:
+
+    struct Node
+    {
+        map<unsigned char, size_t> next;
+        vector<size_t> rules;
+    };
+    vector<Node> _nodes;
+};
+
+//
+// The rules of an accept or reject filter. The rules are indexed by
+// the string their hosts must start or end with so a proxy is only
+// checked against the rules that can match its first endpoint, the
+// other rules are checked one by one.
+//
+class AddressRules : public IceUtil::noncopyable
+{
+public:
+
+    AddressRules(int traceLevel) :
+        _traceLevel(traceLevel)
+    {
+    }
+
+    ~AddressRules()
+    {
+        for(vector<AddressRule*>::const_iterator i = _rules.begin(); i != _rules.end(); ++i)
+        {
+            delete *i;
+        }
+    }
+
+    void
+    add(AddressRule* rule)
+    {
+        size_t index = _rules.size();
+        _rules.push_back(rule);
+        if(!rule->prefix().empty())
         {
-            result = source.substr(start, end - start);
+            _prefixes.add(rule->prefix().begin(), rule->prefix().end(), index);
+        }
+        else if(!rule->suffix().empty())
+        {
+            _suffixes.add(rule->suffix().rbegin(), rule->suffix().rend(), index);
         }
         else
         {
-            result = source.substr(start);
+            _others.push_back(index);
         }
-        return true;
     }
 
-    CommunicatorPtr _communicator;
-    vector<AddressMatcher*> _addressRules;
-    MatchesNumber* _portMatcher;
+    bool
+    match(const vector<Address>& addresses) const
+    {
+        assert(!addresses.empty());
+
+        //
+        // With the matcher tracing enabled, all the rules are checked
+        // in order to trace the matching of each of them.
+        //
+        if(_traceLevel >= 3)
+        {
+            for(vector<AddressRule*>::const_iterator i = _rules.begin(); i != _rules.end(); ++i)
+            {
+                if((*i)->match(addresses))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const string& host = addresses.front().host;
+        if(_prefixes.match(host.begin(), host.end(), _rules, addresses) ||
+           _suffixes.match(host.rbegin(), host.rend(), _rules, addresses))
+        {
+            return true;
+        }
+        for(vector<size_t>::const_iterator i = _others.begin(); i != _others.end(); ++i)
+        {
+            if(_rules[*i]->match(addresses))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+
     const int _traceLevel;
+    vector<AddressRule*> _rules;
+    ByteTrie _prefixes;
+    ByteTrie _suffixes;
+    vector<size_t> _others;
 };
 
-static void
-parseProperty(const Ice::CommunicatorPtr& communicator, const string& property, vector<ProxyRule*>& rules, 
-              const int traceLevel)
+static AddressRules*
+parseProperty(const Ice::CommunicatorPtr& communicator, const string& property, const int traceLevel)
 {
     StartFactory startsWithFactory;
     WildCardFactory wildCardFactory;
     EndsWithFactory endsWithFactory;
     FollowingFactory followingFactory;
-    vector<ProxyRule*> allRules;
+    AddressRules* rules = new AddressRules(traceLevel);
     try
     {
         istringstream propertyInput(property);
 
         while(!propertyInput.eof() && propertyInput.good())
         {
-            MatchesNumber* portMatch = 0;
+            PortMatcher* portMatch = 0;
             vector<AddressMatcher*> currentRuleSet;
 
             string parameter;
@@ -685,7 +965,7 @@ parseProperty(const Ice::CommunicatorPtr& communicator, const string& property,
                 vector<int> ports;
                 vector<Range> ranges;
                 parseGroup(port, ports, ranges);
-                portMatch = new MatchesNumber(ports, ranges);
+                portMatch = new PortMatcher(ports, ranges);
             }
             else
             {
@@ -789,34 +1069,15 @@ parseProperty(const Ice::CommunicatorPtr& communicator, const string& property,
                     currentRuleSet.push_back(currentFactory->create(addr.substr(mark, current - mark)));
                 }
             }
-            allRules.push_back(new AddressRule(communicator, currentRuleSet, portMatch, traceLevel));
+            rules->add(new AddressRule(communicator, currentRuleSet, portMatch, traceLevel));
         }
     }
     catch(...)
     {
-        for(vector<ProxyRule*>::const_iterator i = allRules.begin(); i != allRules.end(); ++i)
-        {
-            delete *i;
-        }
+        delete rules;
         throw;
     }
-    rules = allRules;
-}
-
-//
-// Helper function for checking a rule set. 
-//
-static bool
-match(const vector<ProxyRule*>& rules, const ObjectPrx& proxy)
-{
-    for(vector<ProxyRule*>::const_iterator i = rules.begin(); i != rules.end(); ++i)
-    {
-        if((*i)->check(proxy))
-        {
-            return true;
-        }
-    }
-    return false;
+    return rules;
 }
 
 //
@@ -861,11 +1122,19 @@ private:
     unsigned long _count;
 };
 
+//
+// The maximum number of address rule verdicts kept by the verifier.
+//
+static const size_t verdictCacheSize = 1024;
+
 } // End proxy rule implementations.
 
 Glacier2::ProxyVerifier::ProxyVerifier(const CommunicatorPtr& communicator):
     _communicator(communicator),
-    _traceLevel(communicator->getProperties()->getPropertyAsInt("Glacier2.Client.Trace.Reject"))
+    _traceLevel(communicator->getProperties()->getPropertyAsInt("Glacier2.Client.Trace.Reject")),
+    _acceptRules(0),
+    _rejectRules(0),
+    _proxySizeRule(0)
 {
     //
     // Evaluation order is dependant on how the rules are stored to the
@@ -876,7 +1145,7 @@ Glacier2::ProxyVerifier::ProxyVerifier(const CommunicatorPtr& communicator):
     {
         try
         {
-            Glacier2::parseProperty(communicator, s, _acceptRules, _traceLevel);
+            _acceptRules = Glacier2::parseProperty(communicator, s, _traceLevel);
         }
         catch(const string& msg)
         {
@@ -891,7 +1160,7 @@ Glacier2::ProxyVerifier::ProxyVerifier(const CommunicatorPtr& communicator):
     {
         try
         {
-            Glacier2::parseProperty(communicator, s, _rejectRules, _traceLevel);
+            _rejectRules = Glacier2::parseProperty(communicator, s, _traceLevel);
         }
         catch(const string& msg)
         {
@@ -906,7 +1175,7 @@ Glacier2::ProxyVerifier::ProxyVerifier(const CommunicatorPtr& communicator):
     {
         try
         {
-            _rejectRules.push_back(new ProxyLengthRule(communicator, s, _traceLevel));
+            _proxySizeRule = new ProxyLengthRule(communicator, s, _traceLevel);
 
         }
         catch(const string& msg)
@@ -920,14 +1189,9 @@ Glacier2::ProxyVerifier::ProxyVerifier(const CommunicatorPtr& communicator):
 
 Glacier2::ProxyVerifier::~ProxyVerifier()
 {
-    for(vector<ProxyRule*>::const_iterator i = _acceptRules.begin(); i != _acceptRules.end(); ++i)
-    {
-        delete (*i);
-    }
-    for(vector<ProxyRule*>::const_iterator j = _rejectRules.begin(); j != _rejectRules.end(); ++j)
-    {
-        delete (*j);
-   }
+    delete _acceptRules;
+    delete _rejectRules;
+    delete _proxySizeRule;
 }
 
 bool
@@ -936,33 +1200,24 @@ Glacier2::ProxyVerifier::verify(const ObjectPrx& proxy)
     //
     // No rules have been defined so we accept all.
     //
-    if(_acceptRules.size() == 0 && _rejectRules.size() == 0)
+    if(!_acceptRules && !_rejectRules && !_proxySizeRule)
     {
         return true;
     }
 
-    bool result = false;
-
-    if(_rejectRules.size() == 0)
-    {
-        //
-        // If there are no reject rules, we assume "reject all".
-        //
-        result = match(_acceptRules, proxy);
-    }
-    else if(_acceptRules.size() == 0)
+    //
+    // If there are no reject rules, we assume "reject all" for the
+    // proxies not matching the accept rules. If no accept rules are
+    // defined we assume accept all.
+    //
+    bool result = true;
+    if(_acceptRules || _rejectRules)
     {
-        //
-        // If no accept rules are defined we assume accept all.
-        //
-        result = !match(_rejectRules, proxy);
+        result = verifyAddresses(proxy);
     }
-    else
+    if(result && _proxySizeRule)
     {
-        if(match(_acceptRules, proxy))
-        {
-            result = !match(_rejectRules, proxy);
-        }
+        result = !_proxySizeRule->check(proxy);
     }
 
     //
@@ -982,3 +1237,55 @@ Glacier2::ProxyVerifier::verify(const ObjectPrx& proxy)
     }
     return result;
 }
+
+bool
+Glacier2::ProxyVerifier::verifyAddresses(const ObjectPrx& proxy)
+{
+    vector<Address> addresses;
+    if(!extractAddresses(proxy, addresses))
+    {
+        return !_acceptRules;
+    }
+
+    //
+    // The verdict only depends on the endpoint addresses, it's cached
+    // for the proxies of the same servers. The cache is bypassed when
+    // the matchers trace their progress.
+    //
+    string key;
+    if(_traceLevel < 3)
+    {
+        for(vector<Address>::const_iterator p = addresses.begin(); p != addresses.end(); ++p)
+        {
+            key += p->host;
+            key += ':';
+            key += p->port;
+            key += ' ';
+        }
+
+        IceUtil::Mutex::Lock sync(_cacheMutex);
+        map<string, bool>::const_iterator p = _cache.find(key);
+        if(p != _cache.end())
+        {
+            return p->second;
+        }
+    }
+
+    bool result = (!_acceptRules || _acceptRules->match(addresses)) &&
+                  !(_rejectRules && _rejectRules->match(addresses));
+
+    if(_traceLevel < 3)
+    {
+        IceUtil::Mutex::Lock sync(_cacheMutex);
+        if(_cache.insert(make_pair(key, result)).second)
+        {
+            _cacheQueue.push_back(key);
+            if(_cacheQueue.size() > verdictCacheSize)
+            {
+                _cache.erase(_cacheQueue.front());
+                _cacheQueue.pop_front();
+            }
+        }
+    }
+    return result;
+}
@@ -11,6 +11,9 @@
 #define ICE_PROXY_VERIFIER_H
 
 #include <Ice/Ice.h>
+#include <IceUtil/Mutex.h>
+#include <deque>
+#include <map>
 #include <vector>
 
 namespace Glacier2
@@ -32,6 +35,8 @@ public:
     virtual bool check(const Ice::ObjectPrx&) const = 0;
 };
 
+class AddressRules;
+
 class ProxyVerifier : public IceUtil::Shared
 {
 public:
@@ -47,11 +52,22 @@ public:
 
 private:
 
+    bool verifyAddresses(const Ice::ObjectPrx&);
+
     const Ice::CommunicatorPtr _communicator;
     const int _traceLevel;
 
-    std::vector<ProxyRule*> _acceptRules;
-    std::vector<ProxyRule*> _rejectRules;
+    AddressRules* _acceptRules;
+    AddressRules* _rejectRules;
+    ProxyRule* _proxySizeRule;
+
+    //
+    // The verdicts of the address rules for the most recently
+    // verified endpoint addresses.
+    //
+    IceUtil::Mutex _cacheMutex;
+    std::map<std::string, bool> _cache;
+    std::deque<std::string> _cacheQueue;
 };
 typedef IceUtil::Handle<ProxyVerifier> ProxyVerifierPtr;
 
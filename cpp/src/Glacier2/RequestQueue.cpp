@@ -16,14 +16,63 @@ using namespace std;
 using namespace Ice;
 using namespace Glacier2;
 
-Glacier2::Request::Request(const ObjectPrx& proxy, const std::pair<const Byte*, const Byte*>& inParams,
-                           const Current& current, bool forwardContext, const Ice::Context& sslContext,
+namespace
+{
+
+class FlushTask : public IceUtil::TimerTask
+{
+public:
+
+    FlushTask(const RequestQueuePtr& queue) : _queue(queue)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        _queue->flushRequests(this);
+    }
+
+private:
+
+    const RequestQueuePtr _queue;
+};
+
+//
+// Returns the context to forward with the request. The context is
+// computed once when the request is queued rather than each time it
+// is sent.
+//
+Ice::Context
+forwardedContext(const Current& current, bool forwardContext, const Ice::Context& sslContext)
+{
+    if(!forwardContext)
+    {
+        return sslContext;
+    }
+    else if(sslContext.empty())
+    {
+        return current.ctx;
+    }
+    else
+    {
+        Ice::Context ctx = current.ctx;
+        ctx.insert(sslContext.begin(), sslContext.end());
+        return ctx;
+    }
+}
+
+}
+
+Glacier2::Request::Request(const ObjectPrx& proxy, const ByteView& inParams, const Current& current,
+                           bool forwardContext, const Ice::Context& sslContext,
                            const AMD_Object_ice_invokePtr& amdCB) :
     _proxy(proxy),
-    _inParams(inParams.first, inParams.second),
-    _current(current),
-    _forwardContext(forwardContext),
-    _sslContext(sslContext),
+    _inParams(inParams),
+    _operation(current.operation),
+    _mode(current.mode),
+    _hasContext(forwardContext || !sslContext.empty()),
+    _context(forwardedContext(current, forwardContext, sslContext)),
     _amdCB(amdCB)
 {
     Context::const_iterator p = current.ctx.find("_ovrd");
@@ -37,75 +86,31 @@ Glacier2::Request::Request(const ObjectPrx& proxy, const std::pair<const Byte*,
 Ice::AsyncResultPtr
 Glacier2::Request::invoke(const Callback_Object_ice_invokePtr& cb)
 {
-    pair<const Byte*, const Byte*> inPair;
-    if(_inParams.size() == 0)
-    {
-        inPair.first = inPair.second = 0;
-    }
-    else
-    {
-        inPair.first = &_inParams[0];
-        inPair.second = inPair.first + _inParams.size();
-    }
+    const pair<const Byte*, const Byte*> inPair(_inParams.begin(), _inParams.end());
 
     if(_proxy->ice_isBatchOneway() || _proxy->ice_isBatchDatagram())
     {
         ByteSeq outParams;
-        if(_forwardContext)
-        { 
-            if(_sslContext.size() > 0)
-            {
-                Ice::Context ctx = _current.ctx;
-                ctx.insert(_sslContext.begin(), _sslContext.end());
-                _proxy->ice_invoke(_current.operation, _current.mode, inPair, outParams, ctx);
-            }
-            else
-            {
-                _proxy->ice_invoke(_current.operation, _current.mode, inPair, outParams, _current.ctx);
-            }
+        if(_hasContext)
+        {
+            _proxy->ice_invoke(_operation, _mode, inPair, outParams, _context);
         }
         else
         {
-            if(_sslContext.size() > 0)
-            {
-                _proxy->ice_invoke(_current.operation, _current.mode, inPair, outParams, _sslContext);
-            }
-            else
-            {
-                _proxy->ice_invoke(_current.operation, _current.mode, inPair, outParams);
-            }
+            _proxy->ice_invoke(_operation, _mode, inPair, outParams);
         }
         return 0;
     }
     else
     {
-        Ice::AsyncResultPtr result;
-        if(_forwardContext)
-        { 
-            if(_sslContext.size() > 0)
-            {
-                Ice::Context ctx = _current.ctx;
-                ctx.insert(_sslContext.begin(), _sslContext.end());
-                result = _proxy->begin_ice_invoke(_current.operation, _current.mode, inPair, ctx, cb, this);
-            }
-            else
-            {
-                result = _proxy->begin_ice_invoke(_current.operation, _current.mode, inPair, _current.ctx, cb, this);
-            }
+        if(_hasContext)
+        {
+            return _proxy->begin_ice_invoke(_operation, _mode, inPair, _context, cb, this);
         }
         else
         {
-            if(_sslContext.size() > 0)
-            {
-                result = _proxy->begin_ice_invoke(_current.operation, _current.mode, inPair, _sslContext, cb, this);
-            }
-            else
-            {
-                result = _proxy->begin_ice_invoke(_current.operation, _current.mode, inPair, cb, this);
-            }
+            return _proxy->begin_ice_invoke(_operation, _mode, inPair, cb, this);
         }
-
-        return result;
     }
 }
 
@@ -177,15 +182,18 @@ Glacier2::Request::queued()
     }
 }
 
-Glacier2::RequestQueue::RequestQueue(const RequestQueueThreadPtr& requestQueueThread, 
+Glacier2::RequestQueue::RequestQueue(const RequestQueueSchedulerPtr& scheduler,
                                      const InstancePtr& instance, 
                                      const Ice::ConnectionPtr& connection) :
-    _requestQueueThread(requestQueueThread),
+    _scheduler(scheduler),
     _instance(instance),
     _connection(connection),
     _callback(newCallback_Object_ice_invoke(this, &RequestQueue::response, &RequestQueue::exception,
                                             &RequestQueue::sent)),
     _flushCallback(newCallback_Connection_flushBatchRequests(this, &RequestQueue::exception, &RequestQueue::sent)),
+    _flushed(0),
+    _flushing(false),
+    _flushBatchRequests(false),
     _pendingSend(false),
     _destroyed(false)
 {
@@ -201,31 +209,48 @@ Glacier2::RequestQueue::addRequest(const RequestPtr& request)
     }
     if(request->hasOverride())
     {
-        for(deque<RequestPtr>::iterator p = _requests.begin(); p != _requests.end(); ++p)
+        pair<OverrideIndex::const_iterator, OverrideIndex::const_iterator> r =
+            _overrides.equal_range(request->getOverride());
+        for(OverrideIndex::const_iterator p = r.first; p != r.second; ++p)
         {
             //
             // If the new request overrides an old one, then abort the old
             // request and replace it with the new request.
             //
-            if(request->override(*p))
+            RequestPtr& old = _requests[static_cast<size_t>(p->second - _flushed)];
+            if(request->override(old))
             {
                 if(_observer)
                 {
                     _observer->overridden(!_connection);
                 }
                 request->queued();
-                *p = request;
+                old = request;
                 return true;
             }
         }
     }
-    
+
     //
-    // No override, we add the new request.
+    // No override, we add the new request. The queue is flushed now if
+    // it's large enough, otherwise the flush is scheduled unless it's
+    // already scheduled or a request is waiting to be sent.
     //
-    if(_requests.empty() && (!_connection || !_pendingSend))
+    bool flushNow = false;
+    if(!_connection || !_pendingSend)
     {
-        _requestQueueThread->flushRequestQueue(this); // This might throw if the thread is destroyed.
+        flushNow = _scheduler->flushNow(_requests.size() + 1); // This might throw if the scheduler is destroyed.
+        if(!flushNow && !_flushTask)
+        {
+            IceUtil::TimerTaskPtr task = new FlushTask(this);
+            _scheduler->schedule(this, task);
+            _flushTask = task;
+        }
+    }
+
+    if(request->hasOverride() && !request->getProxy()->ice_isTwoway())
+    {
+        _overrides.insert(make_pair(request->getOverride(), _flushed + static_cast<Ice::Long>(_requests.size())));
     }
     _requests.push_back(request);
     request->queued();
@@ -233,25 +258,23 @@ Glacier2::RequestQueue::addRequest(const RequestPtr& request)
     {
         _observer->queued(!_connection);
     }
+
+    if(flushNow)
+    {
+        flushAll(lock);
+    }
     return false;
 }
 
 void
-Glacier2::RequestQueue::flushRequests(set<Ice::ObjectPrx>& batchProxies)
+Glacier2::RequestQueue::flushRequests(const IceUtil::TimerTaskPtr& task)
 {
     IceUtil::Mutex::Lock lock(*this);
-    if(_connection)
-    {
-        if(_pendingSend)
-        {
-            return;
-        }
-        flush();
-    }
-    else
+    if(task.get() != _flushTask.get())
     {
-        flush(batchProxies);
+        return; // The queue was already flushed.
     }
+    flushAll(lock);
 }
 
 void
@@ -265,7 +288,7 @@ Glacier2::RequestQueue::destroy()
     // Although the session has been destroyed, we cannot destroy this queue
     // until all requests have completed.
     //
-    if(_requests.empty())
+    if(_requests.empty() && !_flushing)
     {
         destroyInternal();
     }
@@ -293,96 +316,228 @@ Glacier2::RequestQueue::destroyInternal()
 }
 
 void
-Glacier2::RequestQueue::flush()
+Glacier2::RequestQueue::cancelFlush()
+{
+    //
+    // Must be called with the mutex locked.
+    //
+    if(_flushTask)
+    {
+        _scheduler->unschedule(this, _flushTask);
+        _flushTask = 0;
+    }
+}
+
+void
+Glacier2::RequestQueue::flushAll(IceUtil::Mutex::Lock& lock)
+{
+    //
+    // Must be called with the mutex locked. The requests are forwarded
+    // with the mutex unlocked, so the dispatch threads queuing requests
+    // for this session don't wait for the forwarding. A single thread
+    // forwards the requests of the queue at a time, including the
+    // requests queued while it's forwarding.
+    //
+    cancelFlush();
+    if(_flushing)
+    {
+        return;
+    }
+
+    _flushing = true;
+    if(_connection)
+    {
+        flushConnection(lock);
+    }
+    else
+    {
+        flushProxies(lock);
+    }
+    _flushing = false;
+
+    if(_destroyed && _requests.empty())
+    {
+        destroyInternal();
+    }
+}
+
+void
+Glacier2::RequestQueue::flushConnection(IceUtil::Mutex::Lock& lock)
 {
     assert(_connection);
-    _pendingSend = false;
-    _pendingSendRequest = 0;
 
-    bool flushBatchRequests = false;
-    deque<RequestPtr>::iterator p;
-    for(p = _requests.begin(); p != _requests.end(); ++p)
+    //
+    // The requests are sent in order over the connection: the
+    // forwarding stops at the first request which isn't sent
+    // synchronously and resumes once it's sent.
+    //
+    while(!_pendingSend)
     {
-        try
+        cancelFlush();
+        if(!_requests.empty())
         {
-            assert(_callback);
+            RequestPtr request = _requests.front();
+            removeOverrides(_requests.begin(), _requests.begin() + 1);
+            _requests.pop_front();
+            ++_flushed;
             if(_observer)
             {
                 _observer->forwarded(!_connection);
             }
-            Ice::AsyncResultPtr result = (*p)->invoke(_callback);
-            if(!result)
+
+            //
+            // The request is pending until we know it's sent, its sent
+            // callback can be called before the mutex is locked again.
+            //
+            _pendingSend = true;
+            _pendingSendRequest = request;
+
+            bool sent = true;
+            bool batch = false;
+            lock.release();
+            try
+            {
+                assert(_callback);
+                Ice::AsyncResultPtr result = request->invoke(_callback);
+                if(!result)
+                {
+                    batch = true;
+                }
+                else
+                {
+                    sent = result->sentSynchronously() || result->isCompleted();
+                }
+            }
+            catch(const Ice::LocalException&)
             {
-                flushBatchRequests = true;
-            } 
-            else if(!result->sentSynchronously() && !result->isCompleted())
+                // Ignore, this can occur for batch requests.
+            }
+            lock.acquire();
+
+            if(batch)
             {
-                _pendingSend = true;
-                _pendingSendRequest = *p++;
-                break;
+                _flushBatchRequests = true;
+            }
+            if(sent && _pendingSendRequest == request)
+            {
+                _pendingSend = false;
+                _pendingSendRequest = 0;
             }
         }
-        catch(const Ice::LocalException&)
+        else if(_flushBatchRequests)
         {
-            // Ignore, this can occur for batch requests.
-        }
-    }
+            _flushBatchRequests = false;
+            _pendingSend = true;
+            _pendingSendRequest = 0;
 
-    if(p == _requests.end())
-    {
-        _requests.clear();
-    }
-    else
-    {
-        _requests.erase(_requests.begin(), p);
-    }
+            bool sent = true;
+            lock.release();
+            try
+            {
+                Ice::AsyncResultPtr result = _connection->begin_flushBatchRequests(_flushCallback);
+                sent = result->sentSynchronously() || result->isCompleted();
+            }
+            catch(const Ice::LocalException&)
+            {
+                // Ignore, the connection is closed.
+            }
+            lock.acquire();
 
-    if(flushBatchRequests)
-    {
-        Ice::AsyncResultPtr result = _connection->begin_flushBatchRequests(_flushCallback);
-        if(!result->sentSynchronously() && !result->isCompleted())
+            if(sent && _pendingSend && !_pendingSendRequest)
+            {
+                _pendingSend = false;
+            }
+        }
+        else
         {
-            _pendingSend = true;
-            _pendingSendRequest = 0;
+            break;
         }
     }
-
-    if(_destroyed && _requests.empty())
-    {
-        destroyInternal();
-    }
 }
 
 void
-Glacier2::RequestQueue::flush(set<Ice::ObjectPrx>& batchProxies)
+Glacier2::RequestQueue::flushProxies(IceUtil::Mutex::Lock& lock)
 {
     assert(!_connection);
 
-    for(deque<RequestPtr>::const_iterator p = _requests.begin(); p != _requests.end(); ++p)
+    while(!_requests.empty())
     {
-        try
+        cancelFlush();
+
+        deque<RequestPtr> requests;
+        requests.swap(_requests);
+        _overrides.clear();
+        _flushed += static_cast<Ice::Long>(requests.size());
+        Glacier2::Instrumentation::SessionObserverPtr observer = _observer;
+
+        lock.release();
+        set<Ice::ObjectPrx> batchProxies;
+        for(deque<RequestPtr>::const_iterator p = requests.begin(); p != requests.end(); ++p)
         {
-            if(_observer)
+            try
             {
-                _observer->forwarded(!_connection);
+                if(observer)
+                {
+                    observer->forwarded(true);
+                }
+                assert(_callback);
+                Ice::AsyncResultPtr result = (*p)->invoke(_callback);
+                if(!result)
+                {
+                    batchProxies.insert((*p)->getProxy());
+                }
             }
-            assert(_callback);
-            Ice::AsyncResultPtr result = (*p)->invoke(_callback);
-            if(!result)
+            catch(const Ice::LocalException&)
             {
-                batchProxies.insert((*p)->getProxy());
-            } 
+                // Ignore, this can occur for batch requests.
+            }
         }
-        catch(const Ice::LocalException&)
+        for(set<Ice::ObjectPrx>::const_iterator q = batchProxies.begin(); q != batchProxies.end(); ++q)
         {
-            // Ignore, this can occur for batch requests.
+            try
+            {
+                (*q)->begin_ice_flushBatchRequests();
+            }
+            catch(const Ice::LocalException&)
+            {
+                // Ignore.
+            }
         }
+        lock.acquire();
     }
-    _requests.clear();
+}
 
-    if(_destroyed)
+void
+Glacier2::RequestQueue::removeOverrides(deque<RequestPtr>::const_iterator first,
+                                        deque<RequestPtr>::const_iterator last)
+{
+    //
+    // Must be called with the mutex locked, before the given requests
+    // are removed from the queue.
+    //
+    if(first == _requests.begin() && last == _requests.end())
     {
-        destroyInternal();
+        _overrides.clear();
+        return;
+    }
+
+    for(deque<RequestPtr>::const_iterator p = first; p != last; ++p)
+    {
+        if(!(*p)->hasOverride())
+        {
+            continue;
+        }
+
+        Ice::Long position = _flushed + static_cast<Ice::Long>(p - _requests.begin());
+        pair<OverrideIndex::iterator, OverrideIndex::iterator> r = _overrides.equal_range((*p)->getOverride());
+        for(OverrideIndex::iterator q = r.first; q != r.second; ++q)
+        {
+            if(q->second == position)
+            {
+                _overrides.erase(q);
+                break;
+            }
+        }
     }
 }
 
@@ -415,9 +570,11 @@ Glacier2::RequestQueue::exception(const Ice::Exception& ex, const RequestPtr& re
         }
 
         IceUtil::Mutex::Lock lock(*this);
-        if(request == _pendingSendRequest)
+        if(_pendingSend && request == _pendingSendRequest)
         {
-            flush();
+            _pendingSend = false;
+            _pendingSendRequest = 0;
+            flushAll(lock);
         }
     }
 
@@ -433,136 +590,91 @@ Glacier2::RequestQueue::sent(bool sentSynchronously, const RequestPtr& request)
     if(_connection && !sentSynchronously)
     {
         IceUtil::Mutex::Lock lock(*this);
-        if(request == _pendingSendRequest)
+        if(_pendingSend && request == _pendingSendRequest)
         {
-            flush();
+            _pendingSend = false;
+            _pendingSendRequest = 0;
+            flushAll(lock);
         }
     }
 }
 
-Glacier2::RequestQueueThread::RequestQueueThread(const IceUtil::Time& sleepTime) :
-    IceUtil::Thread("Glacier2 request queue thread"),
+Glacier2::RequestQueueScheduler::RequestQueueScheduler(const IceUtil::Time& sleepTime, int flushSize,
+                                                       int threads) :
     _sleepTime(sleepTime),
-    _destroy(false),
-    _sleep(false)
-{
-}
-
-Glacier2::RequestQueueThread::~RequestQueueThread()
+    _flushSize(flushSize > 0 ? static_cast<size_t>(flushSize) : 0),
+    _timer(sleepTime > IceUtil::Time() ? new IceUtil::Timer() : 0),
+    _destroyed(false)
 {
-    assert(_destroy);
-    assert(_queues.empty());
+    if(_timer && threads > 1)
+    {
+        _timer->addThreads(threads - 1);
+    }
 }
 
 void 
-Glacier2::RequestQueueThread::destroy()
+Glacier2::RequestQueueScheduler::destroy()
 {
+    map<RequestQueue*, IceUtil::TimerTaskPtr> queues;
     {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-        
-        assert(!_destroy);
-        _destroy = true;
-        _sleep = false;
-        notify();
+        IceUtil::Mutex::Lock lock(*this);
+        assert(!_destroyed);
+        _destroyed = true;
+        _queues.swap(queues);
     }
 
-    try
+    //
+    // Flush the queues still waiting for their sleep time to elapse
+    // before destroying the timer. The queues are kept alive by their
+    // flush task.
+    //
+    for(map<RequestQueue*, IceUtil::TimerTaskPtr>::const_iterator p = queues.begin(); p != queues.end(); ++p)
     {
-        getThreadControl().join();
+        p->first->flushRequests(p->second);
     }
-    catch(const IceUtil::ThreadNotStartedException&)
+
+    if(_timer)
     {
-        // Expected if start() failed.
+        _timer->destroy();
     }
 }
 
-void
-Glacier2::RequestQueueThread::flushRequestQueue(const RequestQueuePtr& queue)
+bool
+Glacier2::RequestQueueScheduler::flushNow(size_t queueSize) const
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-    if(_destroy)
+    IceUtil::Mutex::Lock lock(*this);
+    if(_destroyed)
     {
         throw Ice::ObjectNotExistException(__FILE__, __LINE__);
     }
+    return !_timer || (_flushSize > 0 && queueSize >= _flushSize);
+}
 
-    if(_queues.empty() && !_sleep)
+void
+Glacier2::RequestQueueScheduler::schedule(const RequestQueuePtr& queue, const IceUtil::TimerTaskPtr& task)
+{
+    IceUtil::Mutex::Lock lock(*this);
+    if(_destroyed)
     {
-        notify();
+        throw Ice::ObjectNotExistException(__FILE__, __LINE__);
     }
-    _queues.push_back(queue);
+    assert(_timer);
+    _timer->schedule(task, _sleepTime);
+    _queues[queue.get()] = task;
 }
 
 void
-Glacier2::RequestQueueThread::run()
+Glacier2::RequestQueueScheduler::unschedule(const RequestQueuePtr& queue, const IceUtil::TimerTaskPtr& task)
 {
-    while(true)
+    IceUtil::Mutex::Lock lock(*this);
+    if(_destroyed)
     {
-        vector<RequestQueuePtr> queues;
-
-        {
-            IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-
-            //
-            // Wait indefinitely if there's no requests to
-            // send. If the queue is being destroyed we still need to
-            // wait until all the responses for twoway requests are
-            // received.
-            //
-            while(!_destroy && (_queues.empty() || _sleep))
-            {
-                if(_sleep)
-                {
-                    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
-                    if(!timedWait(_sleepDuration))
-                    {
-                        _sleepDuration = IceUtil::Time();
-                    }
-                    else
-                    {
-                        _sleepDuration -= IceUtil::Time::now(IceUtil::Time::Monotonic) - now;
-                    }
-
-                    if(_sleepDuration <= IceUtil::Time())
-                    {
-                        _sleep = false;
-                    }
-                }
-                else
-                {
-                    wait();
-                }
-            }
-
-            //
-            // If the queue is being destroyed and there's no requests or responses 
-            // to send, we're done.
-            //
-            if(_destroy && _queues.empty())
-            {
-                return;
-            }
-
-            assert(!_queues.empty() && !_sleep);
-            
-            queues.swap(_queues);
-
-            if(_sleepTime > IceUtil::Time())
-            {
-                _sleep = true;
-                _sleepDuration = _sleepTime;
-            }
-        }
-        
-        set<Ice::ObjectPrx> flushProxySet;
-        for(vector<RequestQueuePtr>::const_iterator p = queues.begin(); p != queues.end(); ++p)
-        {
-            (*p)->flushRequests(flushProxySet);
-        }
-
-        for(set<Ice::ObjectPrx>::const_iterator q = flushProxySet.begin(); q != flushProxySet.end(); ++q)
-        {
-            (*q)->begin_ice_flushBatchRequests();
-        }
+        return; // The timer tasks are discarded once the timer is destroyed.
     }
+    map<RequestQueue*, IceUtil::TimerTaskPtr>::iterator p = _queues.find(queue.get());
+    if(p != _queues.end() && p->second.get() == task.get())
+    {
+        _queues.erase(p);
+    }
+    _timer->cancel(task);
 }
-
@@ -10,13 +10,18 @@
 #ifndef REQUEST_H
 #define REQUEST_H
 
-#include <IceUtil/Thread.h>
-#include <IceUtil/Monitor.h>
+#include <IceUtil/Timer.h>
 #include <Ice/Ice.h>
+#include <Ice/ByteView.h>
 
 #include <Glacier2/Instrumentation.h>
 
 #include <deque>
+#include <map>
+#include <set>
+#ifdef ICE_CPP11_COMPILER
+#   include <unordered_map>
+#endif
 
 namespace Glacier2
 {
@@ -27,20 +32,24 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 class Request;
 typedef IceUtil::Handle<Request> RequestPtr;
 
-class RequestQueueThread;
-typedef IceUtil::Handle<RequestQueueThread> RequestQueueThreadPtr;
+class RequestQueue;
+typedef IceUtil::Handle<RequestQueue> RequestQueuePtr;
+
+class RequestQueueScheduler;
+typedef IceUtil::Handle<RequestQueueScheduler> RequestQueueSchedulerPtr;
 
 class Request : public Ice::LocalObject
 {
 public:
 
-    Request(const Ice::ObjectPrx&, const std::pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Current&, bool,
-            const Ice::Context&, const Ice::AMD_Object_ice_invokePtr&);
+    Request(const Ice::ObjectPrx&, const Ice::ByteView&, const Ice::Current&, bool, const Ice::Context&,
+            const Ice::AMD_Object_ice_invokePtr&);
     
     Ice::AsyncResultPtr invoke(const Ice::Callback_Object_ice_invokePtr& callback);
     bool override(const RequestPtr&) const;
     const Ice::ObjectPrx& getProxy() const { return _proxy; }
     bool hasOverride() const { return !_override.empty(); }
+    const std::string& getOverride() const { return _override; }
 
 private:
 
@@ -50,22 +59,30 @@ private:
     void queued();
 
     const Ice::ObjectPrx _proxy;
-    const Ice::ByteSeq _inParams;
-    const Ice::Current _current;
-    const bool _forwardContext;
-    const Ice::Context _sslContext;
+    const Ice::ByteView _inParams;
+    const std::string _operation;
+    const Ice::OperationMode _mode;
+    const bool _hasContext;
+    const Ice::Context _context;
     const std::string _override;
     const Ice::AMD_Object_ice_invokePtr _amdCB;
 };
 
+//
+// The requests of a session are queued and flushed when the queue
+// reaches the configured size or once the sleep time elapsed, from the
+// thread which dispatched the request that triggered the flush or from
+// a scheduler timer thread. The requests are forwarded without holding
+// the queue mutex.
+//
 class RequestQueue : public IceUtil::Mutex, public IceUtil::Shared
 {
 public:
 
-    RequestQueue(const RequestQueueThreadPtr&, const InstancePtr&, const Ice::ConnectionPtr&);
+    RequestQueue(const RequestQueueSchedulerPtr&, const InstancePtr&, const Ice::ConnectionPtr&);
 
     bool addRequest(const RequestPtr&);
-    void flushRequests(std::set<Ice::ObjectPrx>&);
+    void flushRequests(const IceUtil::TimerTaskPtr&);
 
     void destroy();
 
@@ -75,47 +92,72 @@ private:
 
     void destroyInternal();
 
-    void flush();
-    void flush(std::set<Ice::ObjectPrx>&);
+    void cancelFlush();
+    void flushAll(IceUtil::Mutex::Lock&);
+    void flushConnection(IceUtil::Mutex::Lock&);
+    void flushProxies(IceUtil::Mutex::Lock&);
+    void removeOverrides(std::deque<RequestPtr>::const_iterator, std::deque<RequestPtr>::const_iterator);
 
     void response(bool, const std::pair<const Ice::Byte*, const Ice::Byte*>&, const RequestPtr&);
     void exception(const Ice::Exception&, const RequestPtr&);
     void sent(bool, const RequestPtr&);
     
-    const RequestQueueThreadPtr _requestQueueThread;
+    const RequestQueueSchedulerPtr _scheduler;
     const InstancePtr _instance;
     const Ice::ConnectionPtr _connection;
     const Ice::Callback_Object_ice_invokePtr _callback;
     const Ice::Callback_Connection_flushBatchRequestsPtr _flushCallback;
 
     std::deque<RequestPtr> _requests;
+
+    //
+    // The queued requests which can be overridden, indexed by their
+    // override value. The requests are identified by their position
+    // in the queue plus the number of requests flushed so far.
+    //
+#ifdef ICE_CPP11_COMPILER
+    typedef std::unordered_multimap<std::string, Ice::Long> OverrideIndex;
+#else
+    typedef std::multimap<std::string, Ice::Long> OverrideIndex;
+#endif
+    OverrideIndex _overrides;
+    Ice::Long _flushed;
+
+    IceUtil::TimerTaskPtr _flushTask;
+    bool _flushing; // True while a thread forwards the queued requests.
+    bool _flushBatchRequests;
     bool _pendingSend;
     RequestPtr _pendingSendRequest;
     bool _destroyed;
     Glacier2::Instrumentation::SessionObserverPtr _observer;
 };
-typedef IceUtil::Handle<RequestQueue> RequestQueuePtr;
 
-
-class RequestQueueThread : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+//
+// Schedules the deferred flushes of the request queues of one
+// direction and keeps the buffered forwarding configuration. The
+// deferred flushes run concurrently on the given number of timer
+// threads.
+//
+class RequestQueueScheduler : public IceUtil::Mutex, public IceUtil::Shared
 {
 public:
 
-    RequestQueueThread(const IceUtil::Time&);
-    virtual ~RequestQueueThread();
+    RequestQueueScheduler(const IceUtil::Time&, int, int);
 
-    void flushRequestQueue(const RequestQueuePtr&);
     void destroy();
 
-    virtual void run();
+    bool flushNow(size_t) const;
+
+    void schedule(const RequestQueuePtr&, const IceUtil::TimerTaskPtr&);
+    void unschedule(const RequestQueuePtr&, const IceUtil::TimerTaskPtr&);
 
 private:
 
     const IceUtil::Time _sleepTime;
-    bool _destroy;
-    bool _sleep;
-    IceUtil::Time _sleepDuration;
-    std::vector<RequestQueuePtr> _queues;
+    const size_t _flushSize;
+    const IceUtil::TimerPtr _timer;
+    std::map<RequestQueue*, IceUtil::TimerTaskPtr> _queues;
+    bool _destroyed;
 };
 
 }
@@ -24,8 +24,8 @@ Glacier2::RouterI::RouterI(const InstancePtr& instance, const ConnectionPtr& con
     _instance(instance),
     _routingTable(new RoutingTable(_instance->communicator(), _instance->proxyVerifier())),
     _clientBlobject(new ClientBlobject(_instance, filters, context, _routingTable)),
-    _clientBlobjectBuffered(_instance->clientRequestQueueThread()),
-    _serverBlobjectBuffered(_instance->serverRequestQueueThread()),
+    _clientBlobjectBuffered(_instance->clientRequestQueueScheduler()),
+    _serverBlobjectBuffered(_instance->serverRequestQueueScheduler()),
     _connection(connection),
     _userId(userId),
     _session(session),
@@ -227,14 +227,18 @@ Glacier2::RouterI::getSession() const
 IceUtil::Time
 Glacier2::RouterI::getTimestamp() const
 {
-    // Can only be called with the SessionRouterI mutex locked
+    IceUtil::Mutex::Lock lock(_timestampMutex);
     return _timestamp;
 }
 
 void
 Glacier2::RouterI::updateTimestamp() const
 {
-    // Can only be called with the SessionRouterI mutex locked
+    //
+    // Requests are routed without the SessionRouterI mutex locked, the
+    // timestamp can be updated concurrently.
+    //
+    IceUtil::Mutex::Lock lock(_timestampMutex);
     _timestamp = IceUtil::Time::now(IceUtil::Time::Monotonic);
 }
 
@@ -14,11 +14,32 @@ using namespace std;
 using namespace Ice;
 using namespace Glacier2;
 
+namespace
+{
+
+//
+// An estimate of the memory used by the routing table for the given
+// proxy: the table entry, the index entry and the proxy reference.
+//
+size_t
+proxyMemory(const CommunicatorPtr& communicator, const ObjectPrx& proxy)
+{
+    const Identity& id = proxy->ice_getIdentity();
+    return 2 * (sizeof(ObjectPrx) + sizeof(Identity) + id.name.size() + id.category.size()) +
+           communicator->proxyToString(proxy).size();
+}
+
+}
+
 Glacier2::RoutingTable::RoutingTable(const CommunicatorPtr& communicator, const ProxyVerifierPtr& verifier) :
     _communicator(communicator),
     _traceLevel(_communicator->getProperties()->getPropertyAsInt("Glacier2.Trace.RoutingTable")),
     _maxSize(_communicator->getProperties()->getPropertyAsIntWithDefault("Glacier2.RoutingTable.MaxSize", 1000)),
-    _verifier(verifier)
+    _maxMemory(static_cast<Ice::Long>(
+                   _communicator->getProperties()->getPropertyAsInt("Glacier2.RoutingTable.MaxMemory")) * 1024),
+    _verifier(verifier),
+    _hand(0),
+    _memory(0)
 {
 }
 
@@ -28,7 +49,7 @@ Glacier2::RoutingTable::destroy()
     IceUtil::Mutex::Lock sync(*this);
     if(_observer)
     {
-        _observer->routingTableSize(-static_cast<Ice::Int>(_map.size()));
+        _observer->routingTableSize(-static_cast<Ice::Int>(_entries.size()));
     }
     _observer.detach();
 }
@@ -39,7 +60,8 @@ Glacier2::RoutingTable::updateObserver(const Glacier2::Instrumentation::RouterOb
                                        const Ice::ConnectionPtr& connection)
 {
     IceUtil::Mutex::Lock sync(*this);
-    _observer.attach(obsv->getSessionObserver(userId, connection, static_cast<Ice::Int>(_map.size()), _observer.get()));
+    _observer.attach(obsv->getSessionObserver(userId, connection, static_cast<Ice::Int>(_entries.size()),
+                                              _observer.get()));
     return _observer.get();
 }
 
@@ -48,7 +70,7 @@ Glacier2::RoutingTable::add(const ObjectProxySeq& unfiltered, const Current& cur
 {
     IceUtil::Mutex::Lock sync(*this);
 
-    size_t sz = _map.size();
+    size_t sz = _entries.size();
 
     //
     // We 'pre-scan' the list, applying our validation rules. The
@@ -76,21 +98,23 @@ Glacier2::RoutingTable::add(const ObjectProxySeq& unfiltered, const Current& cur
     for(ObjectProxySeq::const_iterator prx = proxies.begin(); prx != proxies.end(); ++prx)
     {
         ObjectPrx proxy = *prx;
-        EvictorMap::iterator p = _map.find(proxy->ice_getIdentity());
+        EntryIndex::iterator p = _index.find(proxy->ice_getIdentity());
         
-        if(p == _map.end())
+        if(p == _index.end())
         {
             if(_traceLevel == 1 || _traceLevel >= 3)
             {
                 Trace out(_communicator->getLogger(), "Glacier2");
                 out << "adding proxy to routing table:\n" << _communicator->proxyToString(proxy);
             }
-            
-            EvictorEntryPtr entry = new EvictorEntry;
-            p = _map.insert(_map.begin(), pair<const Identity, EvictorEntryPtr>(proxy->ice_getIdentity(), entry));
-            EvictorQueue::iterator q = _queue.insert(_queue.end(), p);
-            entry->proxy = proxy;
-            entry->pos = q;
+
+            Entry entry;
+            entry.proxy = proxy;
+            entry.memory = proxyMemory(_communicator, proxy);
+            entry.referenced = true;
+            _index.insert(pair<const Identity, size_t>(proxy->ice_getIdentity(), _entries.size()));
+            _entries.push_back(entry);
+            _memory += entry.memory;
         }
         else
         {
@@ -99,33 +123,20 @@ Glacier2::RoutingTable::add(const ObjectProxySeq& unfiltered, const Current& cur
                 Trace out(_communicator->getLogger(), "Glacier2");
                 out << "proxy already in routing table:\n" << _communicator->proxyToString(proxy);
             }
-            
-            EvictorEntryPtr entry = p->second;
-            _queue.erase(entry->pos);
-            EvictorQueue::iterator q = _queue.insert(_queue.end(), p);
-            entry->pos = q;
+
+            _entries[p->second].referenced = true;
         }
-        
-        while(static_cast<int>(_map.size()) > _maxSize)
-        {
-            p = _queue.front();
-            
-            if(_traceLevel >= 2)
-            {
-                Trace out(_communicator->getLogger(), "Glacier2");
-                out << "evicting proxy from routing table:\n" << _communicator->proxyToString(p->second->proxy);
-            }
-            
-            evictedProxies.push_back(p->second->proxy);
 
-            _map.erase(p);
-            _queue.pop_front();
+        while(!_entries.empty() &&
+              (static_cast<int>(_entries.size()) > _maxSize || (_maxMemory > 0 && _memory > _maxMemory)))
+        {
+            evict(evictedProxies);
         }
     }
 
     if(_observer)
     {
-        _observer->routingTableSize(static_cast<Ice::Int>(_map.size()) - static_cast<Ice::Int>(sz));
+        _observer->routingTableSize(static_cast<Ice::Int>(_entries.size()) - static_cast<Ice::Int>(sz));
     }
 
     return evictedProxies;
@@ -141,19 +152,65 @@ Glacier2::RoutingTable::get(const Identity& ident)
 
     IceUtil::Mutex::Lock sync(*this);
 
-    EvictorMap::iterator p = _map.find(ident);
+    EntryIndex::const_iterator p = _index.find(ident);
 
-    if(p == _map.end())
+    if(p == _index.end())
     {
         return 0;
     }
     else
     {
-        EvictorEntryPtr entry = p->second;
-        _queue.erase(entry->pos);
-        EvictorQueue::iterator q = _queue.insert(_queue.end(), p);
-        entry->pos = q;
+        Entry& entry = _entries[p->second];
+        entry.referenced = true;
+        return entry.proxy;
+    }
+}
 
-        return entry->proxy;
+void
+Glacier2::RoutingTable::evict(ObjectProxySeq& evictedProxies)
+{
+    //
+    // Must be called with the mutex locked.
+    //
+    // The clock hand skips and clears the entries referenced since it
+    // last passed them, the first entry that isn't referenced is
+    // evicted. The last entry takes the place of the evicted entry to
+    // keep the entries contiguous.
+    //
+    assert(!_entries.empty());
+    while(true)
+    {
+        if(_hand >= _entries.size())
+        {
+            _hand = 0;
+        }
+        if(!_entries[_hand].referenced)
+        {
+            break;
+        }
+        _entries[_hand++].referenced = false;
+    }
+
+    Entry& entry = _entries[_hand];
+
+    if(_traceLevel >= 2)
+    {
+        Trace out(_communicator->getLogger(), "Glacier2");
+        out << "evicting proxy from routing table:\n" << _communicator->proxyToString(entry.proxy);
+        if(_maxMemory > 0)
+        {
+            out << "\nrouting table memory = " << _memory << " bytes";
+        }
+    }
+
+    evictedProxies.push_back(entry.proxy);
+    _memory -= entry.memory;
+    _index.erase(entry.proxy->ice_getIdentity());
+
+    if(_hand != _entries.size() - 1)
+    {
+        entry = _entries.back();
+        _index[entry.proxy->ice_getIdentity()] = _hand;
     }
+    _entries.pop_back();
 }
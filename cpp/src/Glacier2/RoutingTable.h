@@ -17,7 +17,10 @@
 #include <Glacier2/ProxyVerifier.h>
 #include <Glacier2/Instrumentation.h>
 
-#include <list>
+#include <map>
+#ifdef ICE_CPP11_COMPILER
+#   include <unordered_map>
+#endif
 
 namespace Glacier2
 {
@@ -42,26 +45,43 @@ public:
 
 private:
 
+    void evict(Ice::ObjectProxySeq&);
+
     const Ice::CommunicatorPtr _communicator;
     const int _traceLevel;
     const int _maxSize;
+    const Ice::Long _maxMemory;
     const ProxyVerifierPtr _verifier; 
 
-    struct EvictorEntry;
-    typedef IceUtil::Handle<EvictorEntry> EvictorEntryPtr;
-
-    typedef std::map<Ice::Identity, EvictorEntryPtr> EvictorMap;
-    typedef std::list<EvictorMap::iterator> EvictorQueue;
-
-    friend struct EvictorEntry;
-    struct EvictorEntry : public IceUtil::Shared
+    //
+    // The proxies are kept in a vector scanned by a clock hand for
+    // eviction, a lookup only sets the referenced flag of the entry.
+    //
+    struct Entry
     {
         Ice::ObjectPrx proxy;
-        EvictorQueue::iterator pos;
+        size_t memory;
+        bool referenced;
     };
 
-    EvictorMap _map;
-    EvictorQueue _queue;
+#ifdef ICE_CPP11_COMPILER
+    struct IdentityHash
+    {
+        size_t operator()(const Ice::Identity& id) const
+        {
+            std::hash<std::string> hasher;
+            return hasher(id.name) ^ (hasher(id.category) << 1);
+        }
+    };
+    typedef std::unordered_map<Ice::Identity, size_t, IdentityHash> EntryIndex;
+#else
+    typedef std::map<Ice::Identity, size_t> EntryIndex;
+#endif
+
+    std::vector<Entry> _entries;
+    EntryIndex _index;
+    size_t _hand;
+    Ice::Long _memory;
 
     IceInternal::ObserverHelperT<Glacier2::Instrumentation::SessionObserver> _observer;
 };
@@ -23,9 +23,8 @@ Glacier2::ServerBlobject::~ServerBlobject()
 }
 
 void
-Glacier2::ServerBlobject::ice_invoke_async(const Ice::AMD_Object_ice_invokePtr& amdCB,
-                                           const std::pair<const Byte*, const Byte*>& inParams,
-                                           const Current& current)
+Glacier2::ServerBlobject::dispatch(const Ice::AMD_Object_ice_invokePtr& amdCB, const ByteView& inParams,
+                                   const Current& current)
 {
     ObjectPrx proxy = _reverseConnection->createProxy(current.id);
     assert(proxy);
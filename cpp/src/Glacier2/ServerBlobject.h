@@ -25,8 +25,7 @@ public:
     ServerBlobject(const InstancePtr&, const Ice::ConnectionPtr&);
     virtual ~ServerBlobject();
 
-    virtual void ice_invoke_async(const Ice::AMD_Object_ice_invokePtr&,
-                                  const std::pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Current&);
+    virtual void dispatch(const Ice::AMD_Object_ice_invokePtr&, const Ice::ByteView&, const Ice::Current&);
 };
 
 }
@@ -22,6 +22,25 @@ using namespace Glacier2;
 
 namespace
 {
+
+class Expired
+{
+public:
+
+    Expired(const IceUtil::Time& minTimestamp) : _minTimestamp(minTimestamp)
+    {
+    }
+
+    bool operator()(const RouterIPtr& router) const
+    {
+        return router->getTimestamp() < _minTimestamp;
+    }
+
+private:
+
+    const IceUtil::Time _minTimestamp;
+};
+
 class PingCallback : public IceUtil::Shared
 {
 public:
@@ -656,8 +675,6 @@ SessionRouterI::SessionRouterI(const InstancePtr& instance,
     _closeCallback(new CloseCallbackI(this)),
     _heartbeatCallback(new HeartbeatCallbackI(this)),
     _sessionThread(_sessionTimeout > IceUtil::Time() ? new SessionThread(this, _sessionTimeout) : 0),
-    _routersByConnectionHint(_routersByConnection.end()),
-    _routersByCategoryHint(_routersByCategory.end()),
     _sessionDestroyCallback(newCallback_Session_destroy(this, &SessionRouterI::sessionDestroyException)),
     _destroy(false)
 {
@@ -718,7 +735,7 @@ SessionRouterI::~SessionRouterI()
 void
 SessionRouterI::destroy()
 {
-    map<ConnectionPtr, RouterIPtr> routers;
+    vector<RouterIPtr> routers;
     SessionThreadPtr sessionThread;
     Callback_Session_destroyPtr destroyCallback;
     {
@@ -728,11 +745,10 @@ SessionRouterI::destroy()
         _destroy = true;
         notify();
 
-        _routersByConnection.swap(routers);
-        _routersByConnectionHint = _routersByConnection.end();
+        _routersByConnection.destroy(routers);
 
-        _routersByCategory.clear();
-        _routersByCategoryHint = _routersByCategory.end();
+        vector<RouterIPtr> routersByCategory;
+        _routersByCategory.destroy(routersByCategory);
 
         sessionThread = _sessionThread;
         _sessionThread = 0;
@@ -747,9 +763,9 @@ SessionRouterI::destroy()
     // We destroy the routers outside the thread synchronization, to
     // avoid deadlocks.
     //
-    for(map<ConnectionPtr, RouterIPtr>::iterator p = routers.begin(); p != routers.end(); ++p)
+    for(vector<RouterIPtr>::iterator p = routers.begin(); p != routers.end(); ++p)
     {
-        p->second->destroy(destroyCallback);
+        (*p)->destroy(destroyCallback);
     }
 
     if(sessionThread)
@@ -867,15 +883,11 @@ SessionRouterI::destroySession(const Current& current)
 void
 SessionRouterI::refreshSession_async(const AMD_Router_refreshSessionPtr& callback, const Ice::Current& current)
 {
-    RouterIPtr router;
+    RouterIPtr router = getRouter(current.con, current.id, false); // getRouter updates the session timestamp.
+    if(!router)
     {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-        router = getRouterImpl(current.con, current.id, false); // getRouter updates the session timestamp.
-        if(!router)
-        {
-            callback->ice_exception(SessionNotExistException());
-            return;
-        }
+        callback->ice_exception(SessionNotExistException());
+        return;
     }
 
     SessionPrx session = router->getSession();
@@ -896,19 +908,15 @@ SessionRouterI::refreshSession_async(const AMD_Router_refreshSessionPtr& callbac
 void
 SessionRouterI::refreshSession(const Ice::ConnectionPtr& con)
 {
-    RouterIPtr router;
+    RouterIPtr router = getRouter(con, Ice::Identity(), false); // getRouter updates the session timestamp.
+    if(!router)
     {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-        router = getRouterImpl(con, Ice::Identity(), false); // getRouter updates the session timestamp.
-        if(!router)
-        {
-            //
-            // Close the connection otherwise the peer has no way to know that the
-            // session has gone.
-            //
-            con->close(false);
-            throw SessionNotExistException();
-        }
+        //
+        // Close the connection otherwise the peer has no way to know that the
+        // session has gone.
+        //
+        con->close(false);
+        throw SessionNotExistException();
     }
 
     SessionPrx session = router->getSession();
@@ -934,33 +942,17 @@ SessionRouterI::destroySession(const ConnectionPtr& connection)
             throw ObjectNotExistException(__FILE__, __LINE__);
         }
 
-        map<ConnectionPtr, RouterIPtr>::iterator p;
-
-        if(_routersByConnectionHint != _routersByConnection.end() && _routersByConnectionHint->first == connection)
-        {
-            p = _routersByConnectionHint;
-        }
-        else
-        {
-            p = _routersByConnection.find(connection);
-        }
-
-        if(p == _routersByConnection.end())
+        router = _routersByConnection.remove(connection);
+        if(!router)
         {
             throw SessionNotExistException();
         }
 
-        router = p->second;
-
-        _routersByConnection.erase(p++);
-        _routersByConnectionHint = p;
-
         if(_instance->serverObjectAdapter())
         {
             string category = router->getServerProxy(Current())->ice_getIdentity().category;
             assert(!category.empty());
-            _routersByCategory.erase(category);
-            _routersByCategoryHint = _routersByCategory.end();
+            _routersByCategory.remove(category);
         }
     }
 
@@ -996,54 +988,56 @@ SessionRouterI::updateSessionObservers()
     Glacier2::Instrumentation::RouterObserverPtr observer = _instance->getObserver();
     assert(observer);
 
-    for(map<ConnectionPtr, RouterIPtr>::iterator p = _routersByConnection.begin(); p != _routersByConnection.end(); ++p)
+    vector<RouterIPtr> routers;
+    _routersByConnection.values(routers);
+    for(vector<RouterIPtr>::iterator p = routers.begin(); p != routers.end(); ++p)
     {
-        p->second->updateObserver(observer);
+        (*p)->updateObserver(observer);
     }
 }
 
 RouterIPtr
 SessionRouterI::getRouter(const ConnectionPtr& connection, const Ice::Identity& id, bool close) const
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-    return getRouterImpl(connection, id, close);
+    //
+    // The monitor isn't locked, the lookup only locks the table shard
+    // of the connection.
+    //
+    RouterIPtr router = _routersByConnection.find(connection); // Throws if the session router is destroyed.
+    if(router)
+    {
+        router->updateTimestamp();
+        return router;
+    }
+    else if(close)
+    {
+        if(_rejectTraceLevel >= 1)
+        {
+            Trace out(_instance->logger(), "Glacier2");
+            out << "rejecting request. no session is associated with the connection.\n";
+            out << "identity: " << _instance->communicator()->identityToString(id);
+        }
+        connection->close(true);
+        throw ObjectNotExistException(__FILE__, __LINE__);
+    }
+    return 0;
 }
 
 Ice::ObjectPtr
 SessionRouterI::getClientBlobject(const ConnectionPtr& connection, const Ice::Identity& id) const
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-    return getRouterImpl(connection, id, true)->getClientBlobject();
+    return getRouter(connection, id, true)->getClientBlobject();
 }
 
 Ice::ObjectPtr
 SessionRouterI::getServerBlobject(const string& category) const
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-
-    if(_destroy)
-    {
-        throw ObjectNotExistException(__FILE__, __LINE__);
-    }
-
-    map<string, RouterIPtr>& routers = const_cast<map<string, RouterIPtr>&>(_routersByCategory);
-
-    if(_routersByCategoryHint != routers.end() && _routersByCategoryHint->first == category)
-    {
-        return _routersByCategoryHint->second->getServerBlobject();
-    }
-
-    map<string, RouterIPtr>::iterator p = routers.find(category);
-
-    if(p != routers.end())
-    {
-        _routersByCategoryHint = p;
-        return p->second->getServerBlobject();
-    }
-    else
+    RouterIPtr router = _routersByCategory.find(category); // Throws if the session router is destroyed.
+    if(!router)
     {
         throw ObjectNotExistException(__FILE__, __LINE__);
     }
+    return router->getServerBlobject();
 }
 
 void
@@ -1062,29 +1056,15 @@ SessionRouterI::expireSessions()
         assert(_sessionTimeout > IceUtil::Time());
         IceUtil::Time minTimestamp = IceUtil::Time::now(IceUtil::Time::Monotonic) - _sessionTimeout;
 
-        map<ConnectionPtr, RouterIPtr>::iterator p = _routersByConnection.begin();
+        _routersByConnection.removeIf(Expired(minTimestamp), routers);
 
-        while(p != _routersByConnection.end())
+        if(_instance->serverObjectAdapter())
         {
-            if(p->second->getTimestamp() < minTimestamp)
+            for(vector<RouterIPtr>::iterator p = routers.begin(); p != routers.end(); ++p)
             {
-                RouterIPtr router = p->second;
-                routers.push_back(router);
-
-                _routersByConnection.erase(p++);
-                _routersByConnectionHint = p;
-
-                if(_instance->serverObjectAdapter())
-                {
-                    string category = router->getServerProxy(Current())->ice_getIdentity().category;
-                    assert(!category.empty());
-                    _routersByCategory.erase(category);
-                    _routersByCategoryHint = _routersByCategory.end();
-                }
-            }
-            else
-            {
-                ++p;
+                string category = (*p)->getServerProxy(Current())->ice_getIdentity().category;
+                assert(!category.empty());
+                _routersByCategory.remove(category);
             }
         }
     }
@@ -1104,44 +1084,6 @@ SessionRouterI::expireSessions()
     }
 }
 
-RouterIPtr
-SessionRouterI::getRouterImpl(const ConnectionPtr& connection, const Ice::Identity& id, bool close) const
-{
-    if(_destroy)
-    {
-        throw ObjectNotExistException(__FILE__, __LINE__);
-    }
-
-    map<ConnectionPtr, RouterIPtr>& routers = const_cast<map<ConnectionPtr, RouterIPtr>&>(_routersByConnection);
-
-    if(_routersByConnectionHint != routers.end() && _routersByConnectionHint->first == connection)
-    {
-        _routersByConnectionHint->second->updateTimestamp();
-        return _routersByConnectionHint->second;
-    }
-
-    map<ConnectionPtr, RouterIPtr>::iterator p = routers.find(connection);
-
-    if(p != routers.end())
-    {
-        _routersByConnectionHint = p;
-        p->second->updateTimestamp();
-        return p->second;
-    }
-    else if(close)
-    {
-        if(_rejectTraceLevel >= 1)
-        {
-            Trace out(_instance->logger(), "Glacier2");
-            out << "rejecting request. no session is associated with the connection.\n";
-            out << "identity: " << _instance->communicator()->identityToString(id);
-        }
-        connection->close(true);
-        throw ObjectNotExistException(__FILE__, __LINE__);
-    }
-    return 0;
-}
-
 void
 SessionRouterI::sessionDestroyException(const Ice::Exception& ex)
 {
@@ -1167,24 +1109,11 @@ SessionRouterI::startCreateSession(const CreateSessionPtr& cb, const ConnectionP
     //
     // Check whether a session already exists for the connection.
     //
+    if(_routersByConnection.find(connection))
     {
-        map<ConnectionPtr, RouterIPtr>::iterator p;
-        if(_routersByConnectionHint != _routersByConnection.end() &&
-           _routersByConnectionHint->first == connection)
-        {
-            p = _routersByConnectionHint;
-        }
-        else
-        {
-            p = _routersByConnection.find(connection);
-        }
-
-        if(p != _routersByConnection.end())
-        {
-            CannotCreateSessionException exc;
-            exc.reason = "session exists";
-            throw exc;
-        }
+        CannotCreateSessionException exc;
+        exc.reason = "session exists";
+        throw exc;
     }
 
     map<ConnectionPtr, CreateSessionPtr>::iterator p = _pending.find(connection);
@@ -1235,19 +1164,24 @@ SessionRouterI::finishCreateSession(const ConnectionPtr& connection, const Route
         throw exc;
     }
 
-    _routersByConnectionHint = _routersByConnection.insert(
-        _routersByConnectionHint, pair<const ConnectionPtr, RouterIPtr>(connection, router));
-
+    //
+    // The category is added first, the server blobject of the session
+    // must be found once requests are routed for the client.
+    //
     if(_instance->serverObjectAdapter())
     {
         string category = router->getServerProxy()->ice_getIdentity().category;
         assert(!category.empty());
-        pair<map<string, RouterIPtr>::iterator, bool> rc =
-            _routersByCategory.insert(pair<const string, RouterIPtr>(category, router));
-        assert(rc.second);
-        _routersByCategoryHint = rc.first;
+#ifndef NDEBUG
+        bool inserted = _routersByCategory.insert(category, router);
+        assert(inserted);
+#else
+        _routersByCategory.insert(category, router);
+#endif
     }
 
+    _routersByConnection.insert(connection, router);
+
     connection->setCloseCallback(_closeCallback);
     connection->setHeartbeatCallback(_heartbeatCallback);
 
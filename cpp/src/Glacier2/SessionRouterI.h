@@ -18,6 +18,7 @@
 #include <Glacier2/PermissionsVerifierF.h>
 #include <Glacier2/Router.h>
 #include <Glacier2/Instrumentation.h>
+#include <Glacier2/SessionTable.h>
 
 #include <set>
 
@@ -129,8 +130,6 @@ public:
 
 private:
 
-    RouterIPtr getRouterImpl(const Ice::ConnectionPtr&, const Ice::Identity&, bool) const;
-
     void sessionDestroyException(const Ice::Exception&);
 
     bool startCreateSession(const CreateSessionPtr&, const Ice::ConnectionPtr&);
@@ -169,11 +168,12 @@ private:
     typedef IceUtil::Handle<SessionThread> SessionThreadPtr;
     SessionThreadPtr _sessionThread;
 
-    std::map<Ice::ConnectionPtr, RouterIPtr> _routersByConnection;
-    mutable std::map<Ice::ConnectionPtr, RouterIPtr>::iterator _routersByConnectionHint;
-
-    std::map<std::string, RouterIPtr> _routersByCategory;
-    mutable std::map<std::string, RouterIPtr>::iterator _routersByCategoryHint;
+    //
+    // The session tables are updated with the monitor locked, looking
+    // up a session only locks the table shard.
+    //
+    SessionTable<Ice::ConnectionPtr, RouterIPtr, ConnectionHash> _routersByConnection;
+    SessionTable<std::string, RouterIPtr, CategoryHash> _routersByCategory;
 
     std::map<Ice::ConnectionPtr, CreateSessionPtr> _pending;
 
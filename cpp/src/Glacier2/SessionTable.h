@@ -0,0 +1,198 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef GLACIER2_SESSION_TABLE_H
+#define GLACIER2_SESSION_TABLE_H
+
+#include <IceUtil/Mutex.h>
+#include <Ice/Connection.h>
+#include <Ice/LocalException.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Glacier2
+{
+
+//
+// Hash functions for the session table keys.
+//
+struct ConnectionHash
+{
+    size_t operator()(const Ice::ConnectionPtr& connection) const
+    {
+        //
+        // Connections are heap allocated, the low bits of the address
+        // are always zero.
+        //
+        size_t h = reinterpret_cast<size_t>(connection.get()) >> 4;
+        return h ^ (h >> 7) ^ (h >> 13);
+    }
+};
+
+struct CategoryHash
+{
+    size_t operator()(const std::string& category) const
+    {
+        size_t h = 2166136261U;
+        for(std::string::const_iterator p = category.begin(); p != category.end(); ++p)
+        {
+            h = (h ^ static_cast<unsigned char>(*p)) * 16777619U;
+        }
+        return h;
+    }
+};
+
+//
+// A table of sessions split into shards, each shard with its own
+// mutex. Lookups only lock the shard of the key so the routing of
+// requests from different sessions doesn't contend on a single
+// lock. Updates are serialized by the caller, see SessionRouterI.
+//
+template<typename K, typename V, typename H>
+class SessionTable : public IceUtil::noncopyable
+{
+public:
+
+    //
+    // Returns the value for the given key or 0 if there's no such
+    // key. Raises ObjectNotExistException if the table is destroyed.
+    //
+    V find(const K& key) const
+    {
+        const Shard& shard = _shards[_hash(key) % shardCount];
+        IceUtil::Mutex::Lock sync(shard.mutex);
+        if(shard.destroyed)
+        {
+            throw Ice::ObjectNotExistException(__FILE__, __LINE__);
+        }
+        typename std::map<K, V>::const_iterator p = shard.values.find(key);
+        return p != shard.values.end() ? p->second : V();
+    }
+
+    bool insert(const K& key, const V& value)
+    {
+        Shard& shard = _shards[_hash(key) % shardCount];
+        IceUtil::Mutex::Lock sync(shard.mutex);
+        assert(!shard.destroyed);
+        return shard.values.insert(std::pair<const K, V>(key, value)).second;
+    }
+
+    V remove(const K& key)
+    {
+        Shard& shard = _shards[_hash(key) % shardCount];
+        IceUtil::Mutex::Lock sync(shard.mutex);
+        typename std::map<K, V>::iterator p = shard.values.find(key);
+        if(p == shard.values.end())
+        {
+            return V();
+        }
+        V value = p->second;
+        shard.values.erase(p);
+        return value;
+    }
+
+    //
+    // Removes the values matching the given predicate and adds them to
+    // the removed sequence.
+    //
+    template<typename P> void removeIf(P predicate, std::vector<V>& removed)
+    {
+        for(size_t i = 0; i < shardCount; ++i)
+        {
+            Shard& shard = _shards[i];
+            IceUtil::Mutex::Lock sync(shard.mutex);
+            typename std::map<K, V>::iterator p = shard.values.begin();
+            while(p != shard.values.end())
+            {
+                if(predicate(p->second))
+                {
+                    removed.push_back(p->second);
+                    shard.values.erase(p++);
+                }
+                else
+                {
+                    ++p;
+                }
+            }
+        }
+    }
+
+    //
+    // Returns a snapshot of the values, the values aren't accessed
+    // with the shard mutexes locked.
+    //
+    void values(std::vector<V>& values) const
+    {
+        for(size_t i = 0; i < shardCount; ++i)
+        {
+            const Shard& shard = _shards[i];
+            IceUtil::Mutex::Lock sync(shard.mutex);
+            for(typename std::map<K, V>::const_iterator p = shard.values.begin(); p != shard.values.end(); ++p)
+            {
+                values.push_back(p->second);
+            }
+        }
+    }
+
+    //
+    // Removes all the values and rejects further lookups.
+    //
+    void destroy(std::vector<V>& values)
+    {
+        for(size_t i = 0; i < shardCount; ++i)
+        {
+            Shard& shard = _shards[i];
+            IceUtil::Mutex::Lock sync(shard.mutex);
+            shard.destroyed = true;
+            for(typename std::map<K, V>::const_iterator p = shard.values.begin(); p != shard.values.end(); ++p)
+            {
+                values.push_back(p->second);
+            }
+            shard.values.clear();
+        }
+    }
+
+    bool empty() const
+    {
+        for(size_t i = 0; i < shardCount; ++i)
+        {
+            const Shard& shard = _shards[i];
+            IceUtil::Mutex::Lock sync(shard.mutex);
+            if(!shard.values.empty())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+
+    static const size_t shardCount = 64;
+
+    struct Shard
+    {
+        Shard() : destroyed(false)
+        {
+        }
+
+        IceUtil::Mutex mutex;
+        std::map<K, V> values;
+        bool destroyed;
+    };
+
+    Shard _shards[shardCount];
+    H _hash;
+};
+
+}
+
+#endif
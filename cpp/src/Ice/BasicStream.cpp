@@ -106,6 +106,8 @@ IceInternal::BasicStream::BasicStream(Instance* instance, const EncodingVersion&
     //
     _preAllocatedReadEncaps.encoding = encoding;
     _preAllocatedWriteEncaps.encoding = encoding;
+
+    b.setPool(instance->bufferPool());
 }
 
 IceInternal::BasicStream::BasicStream(Instance* instance, const EncodingVersion& encoding, const Byte* begin,
@@ -441,6 +443,28 @@ IceInternal::BasicStream::read(pair<const Byte*, const Byte*>& v)
     }
 }
 
+void
+IceInternal::BasicStream::read(ByteView& v)
+{
+    pair<const Byte*, const Byte*> p;
+    read(p);
+
+    //
+    // Share the stream buffer with the view. If the stream doesn't
+    // own its buffer (it was created from a caller-provided buffer),
+    // the view gets a copy of the bytes instead.
+    //
+    SharedBufferPtr owner = b.share();
+    if(owner)
+    {
+        ByteView(p.first, p.second, owner).swap(v);
+    }
+    else
+    {
+        ByteView(p.first, p.second).swap(v);
+    }
+}
+
 void
 IceInternal::BasicStream::write(const vector<bool>& v)
 {
@@ -10,6 +10,7 @@
 #include <Ice/BatchRequestQueue.h>
 #include <Ice/Instance.h>
 #include <Ice/Properties.h>
+#include <Ice/LocalException.h>
 
 using namespace std;
 using namespace IceInternal;
@@ -62,6 +63,48 @@ private:
     const int _size;
 };
 
+//
+// Flushes the batch requests queued during the batch auto flush
+// delay (see Ice.BatchAutoFlushDelay). The queue doesn't keep a
+// reference on the task, a pending task reschedules itself instead of
+// being canceled when the batch is flushed.
+//
+class FlushTask : public IceUtil::TimerTask
+{
+public:
+
+    FlushTask(const BatchRequestQueuePtr& queue, const Ice::ObjectPrxPtr& proxy) : _queue(queue), _proxy(proxy)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        if(!_queue->flushTaskExpired(_proxy))
+        {
+            return;
+        }
+
+        try
+        {
+#ifdef ICE_CPP11_MAPPING
+            _proxy->ice_flushBatchRequests_async();
+#else
+            _proxy->begin_ice_flushBatchRequests();
+#endif
+        }
+        catch(const Ice::CommunicatorDestroyedException&)
+        {
+            // Ignore.
+        }
+    }
+
+private:
+
+    const BatchRequestQueuePtr _queue;
+    const Ice::ObjectPrxPtr _proxy;
+};
+
 }
 
 BatchRequestQueue::BatchRequestQueue(const InstancePtr& instance, bool datagram) :
@@ -69,7 +112,10 @@ BatchRequestQueue::BatchRequestQueue(const InstancePtr& instance, bool datagram)
     _batchStream(instance.get(), Ice::currentProtocolEncoding),
     _batchStreamInUse(false),
     _batchStreamCanFlush(false),
-    _batchRequestNum(0)
+    _batchRequestNum(0),
+    _instance(instance),
+    _maxDelay(instance->batchAutoFlushDelay()),
+    _flushTaskScheduled(false)
 {
     _batchStream.writeBlob(requestBatchHdr, sizeof(requestBatchHdr));
     _batchMarker = _batchStream.b.size();
@@ -143,6 +189,14 @@ BatchRequestQueue::finishBatchRequest(BasicStream* os, const Ice::ObjectPrxPtr&
         _batchStream.resize(_batchMarker);
         _batchStreamInUse = false;
         _batchStreamCanFlush = false;
+        if(_maxDelay > IceUtil::Time() && _batchRequestNum > 0 && _flushDeadline == IceUtil::Time())
+        {
+            _flushDeadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + _maxDelay;
+            if(!_flushTaskScheduled)
+            {
+                scheduleFlushTask(proxy, _maxDelay);
+            }
+        }
         notifyAll();
     }
     catch(const std::exception&)
@@ -191,9 +245,11 @@ BatchRequestQueue::swap(BasicStream* os)
     _batchStream.swap(*os);
 
     //
-    // Reset the batch.
+    // Reset the batch. A pending flush task isn't canceled, it
+    // reschedules itself for the deadline of the next batch if any.
     //
     _batchRequestNum = 0;
+    _flushDeadline = IceUtil::Time();
     _batchStream.writeBlob(requestBatchHdr, sizeof(requestBatchHdr));
     _batchMarker = _batchStream.b.size();
     if(!lastRequest.empty())
@@ -233,3 +289,44 @@ BatchRequestQueue::enqueueBatchRequest()
     _batchMarker = _batchStream.b.size();
     ++_batchRequestNum;
 }
+
+bool
+BatchRequestQueue::flushTaskExpired(const Ice::ObjectPrxPtr& proxy)
+{
+    Lock sync(*this);
+    _flushTaskScheduled = false;
+    if(_exception.get() || _flushDeadline == IceUtil::Time())
+    {
+        return false; // The queue is destroyed or the batch was already flushed.
+    }
+
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    if(now < _flushDeadline)
+    {
+        //
+        // The batch was flushed and requests were queued again since
+        // the task was scheduled.
+        //
+        scheduleFlushTask(proxy, _flushDeadline - now);
+        return false;
+    }
+    _flushDeadline = IceUtil::Time(); // Requests queued from now on are flushed with the next batch.
+    return true;
+}
+
+void
+BatchRequestQueue::scheduleFlushTask(const Ice::ObjectPrxPtr& proxy, const IceUtil::Time& delay)
+{
+    try
+    {
+        _instance->timer()->schedule(ICE_MAKE_SHARED(FlushTask, this, proxy), delay);
+        _flushTaskScheduled = true;
+    }
+    catch(const Ice::CommunicatorDestroyedException&)
+    {
+    }
+    catch(const IceUtil::IllegalArgumentException&)
+    {
+        // The timer is destroyed.
+    }
+}
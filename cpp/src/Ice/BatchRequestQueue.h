@@ -14,6 +14,7 @@
 #include <IceUtil/Mutex.h>
 #include <IceUtil/Monitor.h>
 #include <IceUtil/UniquePtr.h>
+#include <IceUtil/Timer.h>
 
 #include <Ice/BatchRequestInterceptor.h>
 #include <Ice/BatchRequestQueueF.h>
@@ -40,9 +41,12 @@ public:
 
     void enqueueBatchRequest();
 
+    bool flushTaskExpired(const Ice::ObjectPrxPtr&);
+
 private:
 
     void waitStreamInUse(bool);
+    void scheduleFlushTask(const Ice::ObjectPrxPtr&, const IceUtil::Time&);
 
 #ifdef ICE_CPP11_MAPPING
     std::function<void(const Ice::BatchRequest&, int, int)> _interceptor;
@@ -56,6 +60,11 @@ private:
     size_t _batchMarker;
     IceUtil::UniquePtr<Ice::LocalException> _exception;
     size_t _maxSize;
+
+    const InstancePtr _instance;
+    const IceUtil::Time _maxDelay;
+    bool _flushTaskScheduled;
+    IceUtil::Time _flushDeadline; // The time at which the batch must be flushed, 0 if empty.
 };
 
 };
@@ -8,6 +8,7 @@
 // **********************************************************************
 
 #include <Ice/Buffer.h>
+#include <Ice/BufferPool.h>
 #include <Ice/LocalException.h>
 
 using namespace std;
@@ -39,9 +40,16 @@ IceInternal::Buffer::Container::Container(const_iterator beg, const_iterator end
 
 IceInternal::Buffer::Container::~Container()
 {
-    if(_buf && _capacity > 0)
+    if(_buf && _capacity > 0 && !_owner)
     {
-        ::free(_buf);
+        if(_pool)
+        {
+            _pool->release(_buf, _capacity);
+        }
+        else
+        {
+            ::free(_buf);
+        }
     }
 }
 
@@ -55,6 +63,8 @@ IceInternal::Buffer::Container::swap(Container& other)
     std::swap(_size, other._size);
     std::swap(_capacity, other._capacity);
     std::swap(_shrinkCounter, other._shrinkCounter);
+    std::swap(_pool, other._pool);
+    std::swap(_owner, other._owner);
 }
 
 void
@@ -62,16 +72,45 @@ IceInternal::Buffer::Container::clear()
 {
     assert(!_buf || _capacity > 0);
 
-    free(_buf);
+    if(_owner)
+    {
+        _owner = 0; // The memory is released with the last view.
+    }
+    else if(_pool && _buf)
+    {
+        _pool->release(_buf, _capacity);
+    }
+    else
+    {
+        free(_buf);
+    }
     _buf = 0;
     _size = 0;
     _capacity = 0;
 }
 
+void
+IceInternal::Buffer::Container::setPool(const BufferPoolPtr& pool)
+{
+    assert(!_buf || _capacity == 0);
+    _pool = pool;
+}
+
+SharedBufferPtr
+IceInternal::Buffer::Container::share()
+{
+    if(!_owner && _buf && _capacity > 0)
+    {
+        _owner = new SharedBuffer(_buf, _capacity, _pool);
+    }
+    return _owner;
+}
+
 void
 IceInternal::Buffer::Container::reserve(size_type n)
 {
     assert(!_buf || _capacity > 0);
+    assert(!_owner);
 
     size_type c = _capacity;
     if(n > _capacity)
@@ -88,6 +127,33 @@ IceInternal::Buffer::Container::reserve(size_type n)
         return;
     }
 
+    if(_pool)
+    {
+        //
+        // Don't re-allocate the buffer if the new capacity falls in
+        // the same size class.
+        //
+        if(_pool->capacity(_capacity) == c)
+        {
+            _capacity = c;
+            return;
+        }
+
+        pointer p = _pool->allocate(_capacity);
+        if(!p)
+        {
+            _capacity = c; // Restore the previous capacity.
+            throw std::bad_alloc();
+        }
+        if(_buf)
+        {
+            memcpy(p, _buf, std::min(c, _capacity));
+            _pool->release(_buf, c);
+        }
+        _buf = p;
+        return;
+    }
+
     pointer p = reinterpret_cast<pointer>(::realloc(_buf, _capacity));
     if(!p)
     {
@@ -96,3 +162,58 @@ IceInternal::Buffer::Container::reserve(size_type n)
     }
     _buf = p;
 }
+
+void
+IceInternal::Buffer::Container::unshare(size_type n)
+{
+    assert(_owner);
+
+    //
+    // The memory is shared with views, allocate new memory for the
+    // given size only and let the last view release the shared memory.
+    // The previous data is only copied up to the new size, a read
+    // stream is usually resized to the size of a message header.
+    //
+    size_type capacity = std::max<size_type>(static_cast<size_type>(240), n);
+    pointer p = _pool ? _pool->allocate(capacity) : reinterpret_cast<pointer>(::malloc(capacity));
+    if(!p)
+    {
+        throw std::bad_alloc();
+    }
+    memcpy(p, _buf, std::min(_size, n));
+    _owner = 0;
+    _buf = p;
+    _capacity = capacity;
+}
+
+IceInternal::SharedBuffer::SharedBuffer(Byte* buf, size_t capacity, const BufferPoolPtr& pool) :
+    _buf(buf),
+    _capacity(capacity),
+    _pool(pool)
+{
+}
+
+IceInternal::SharedBuffer::~SharedBuffer()
+{
+    if(_pool)
+    {
+        _pool->release(_buf, _capacity);
+    }
+    else
+    {
+        ::free(_buf);
+    }
+}
+
+SharedBufferPtr
+IceInternal::SharedBuffer::copy(const Byte* beg, const Byte* end)
+{
+    size_t sz = static_cast<size_t>(end - beg);
+    Byte* buf = reinterpret_cast<Byte*>(::malloc(std::max<size_t>(sz, 1)));
+    if(!buf)
+    {
+        throw std::bad_alloc();
+    }
+    memcpy(buf, beg, sz);
+    return new SharedBuffer(buf, sz, 0);
+}
@@ -0,0 +1,179 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/BufferPool.h>
+
+#include <stdlib.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(BufferPool* p) { return p; }
+
+namespace
+{
+
+//
+// Size classes go from 256 bytes to 1MB. Each size class caches at
+// most 1MB of buffers (and at least 2 buffers), which limits the
+// memory held by the cache to about 13MB per communicator.
+//
+const size_t minClassSize = 256;
+const int classCount = 13;
+const size_t maxClassBytes = 1024 * 1024;
+const size_t maxClassBuffers = 256;
+
+}
+
+IceInternal::BufferPool::BufferPool() :
+    _uncached(0),
+    _hasObserver(0)
+{
+    for(int i = 0; i < classCount; ++i)
+    {
+        SizeClass* sizeClass = new SizeClass;
+        size_t size = minClassSize << i;
+        sizeClass->max = min(maxClassBuffers, max(static_cast<size_t>(2), maxClassBytes / size));
+        _classes.push_back(sizeClass);
+    }
+}
+
+IceInternal::BufferPool::~BufferPool()
+{
+    for(vector<SizeClass*>::const_iterator p = _classes.begin(); p != _classes.end(); ++p)
+    {
+        for(vector<Byte*>::const_iterator q = (*p)->buffers.begin(); q != (*p)->buffers.end(); ++q)
+        {
+            ::free(*q);
+        }
+        delete *p;
+    }
+}
+
+size_t
+IceInternal::BufferPool::capacity(size_t n) const
+{
+    int i = sizeClass(n);
+    return i < 0 ? n : minClassSize << i;
+}
+
+Byte*
+IceInternal::BufferPool::allocate(size_t& n)
+{
+    int i = sizeClass(n);
+    Byte* buf = 0;
+    if(i < 0)
+    {
+        IceUtil::Mutex::Lock sync(_uncachedMutex);
+        ++_uncached;
+    }
+    else
+    {
+        n = minClassSize << i;
+
+        SizeClass* sizeClass = _classes[i];
+        IceUtil::Mutex::Lock sync(sizeClass->mutex);
+        if(!sizeClass->buffers.empty())
+        {
+            buf = sizeClass->buffers.back();
+            sizeClass->buffers.pop_back();
+            ++sizeClass->hits;
+        }
+        else
+        {
+            ++sizeClass->misses;
+        }
+    }
+
+    if(_hasObserver != 0)
+    {
+        observe(i < 0 ? 0 : n, buf != 0);
+    }
+    return buf ? buf : reinterpret_cast<Byte*>(::malloc(n));
+}
+
+void
+IceInternal::BufferPool::release(Byte* buf, size_t n)
+{
+    int i = sizeClass(n);
+    if(i >= 0 && n == minClassSize << i)
+    {
+        SizeClass* sizeClass = _classes[i];
+        IceUtil::Mutex::Lock sync(sizeClass->mutex);
+        if(sizeClass->buffers.size() < sizeClass->max)
+        {
+            sizeClass->buffers.push_back(buf);
+            return;
+        }
+    }
+    ::free(buf);
+}
+
+BufferPool::Stats
+IceInternal::BufferPool::getStats() const
+{
+    Stats stats;
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.cachedBytes = 0;
+    for(size_t i = 0; i < _classes.size(); ++i)
+    {
+        IceUtil::Mutex::Lock sync(_classes[i]->mutex);
+        stats.hits += _classes[i]->hits;
+        stats.misses += _classes[i]->misses;
+        stats.cachedBytes += _classes[i]->buffers.size() * (minClassSize << i);
+    }
+
+    IceUtil::Mutex::Lock sync(_uncachedMutex);
+    stats.uncached = _uncached;
+    return stats;
+}
+
+void
+IceInternal::BufferPool::setObserver(const CommunicatorObserverIPtr& observer)
+{
+    IceUtil::Mutex::Lock sync(_observerMutex);
+    _observer = observer;
+    _hasObserver.exchange(observer ? 1 : 0);
+}
+
+void
+IceInternal::BufferPool::observe(size_t capacity, bool hit)
+{
+    CommunicatorObserverIPtr observer;
+    {
+        IceUtil::Mutex::Lock sync(_observerMutex);
+        observer = _observer;
+    }
+
+    BufferPoolObserverIPtr o = observer ? observer->getBufferPoolObserver(capacity) : ICE_NULLPTR;
+    if(o)
+    {
+        o->attach();
+        o->allocated(hit);
+        o->detach();
+    }
+}
+
+int
+IceInternal::BufferPool::sizeClass(size_t n) const
+{
+    int i = 0;
+    size_t size = minClassSize;
+    while(size < n)
+    {
+        if(++i == classCount)
+        {
+            return -1;
+        }
+        size <<= 1;
+    }
+    return i;
+}
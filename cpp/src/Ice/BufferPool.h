@@ -0,0 +1,106 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_BUFFER_POOL_H
+#define ICE_BUFFER_POOL_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Atomic.h>
+
+#include <Ice/Config.h>
+#include <Ice/BufferPoolF.h>
+#include <Ice/InstrumentationI.h>
+
+#include <vector>
+
+namespace IceInternal
+{
+
+//
+// The buffer pool caches the memory of the stream buffers of a
+// communicator. Buffers are allocated with a capacity rounded up to
+// a power of 2 (the size class) and released buffers are kept in a
+// free list per size class to be re-used by the next stream which
+// needs a buffer of this size class. Buffers larger than the largest
+// size class are not cached.
+//
+class BufferPool : public IceUtil::Shared
+{
+public:
+
+    struct Stats
+    {
+        Ice::Long hits; // Allocations satisfied from the cache.
+        Ice::Long misses; // Allocations of a size class with an empty cache.
+        Ice::Long uncached; // Allocations larger than the largest size class.
+        size_t cachedBytes; // Memory currently held by the cache.
+    };
+
+    BufferPool();
+    virtual ~BufferPool();
+
+    //
+    // Return the capacity of the buffer that would be allocated for
+    // the given size.
+    //
+    size_t capacity(size_t) const;
+
+    //
+    // Allocate a buffer, the given capacity is rounded up to the
+    // capacity of the size class. Returns 0 if out of memory.
+    //
+    Ice::Byte* allocate(size_t&);
+
+    //
+    // Release a buffer allocated with allocate() with its capacity.
+    //
+    void release(Ice::Byte*, size_t);
+
+    Stats getStats() const;
+
+    //
+    // Set the observer used to update the buffer pool metrics, null
+    // if the metrics are disabled.
+    //
+    void setObserver(const CommunicatorObserverIPtr&);
+
+private:
+
+    struct SizeClass
+    {
+        SizeClass() : max(0), hits(0), misses(0)
+        {
+        }
+
+        IceUtil::Mutex mutex;
+        std::vector<Ice::Byte*> buffers;
+        size_t max;
+        Ice::Long hits;
+        Ice::Long misses;
+    };
+
+    int sizeClass(size_t) const;
+    void observe(size_t, bool);
+
+    std::vector<SizeClass*> _classes;
+    IceUtil::Mutex _uncachedMutex;
+    Ice::Long _uncached;
+
+    //
+    // The observer is only locked for the allocations if it's set.
+    //
+    IceUtil::Mutex _observerMutex;
+    IceUtilInternal::Atomic _hasObserver;
+    CommunicatorObserverIPtr _observer;
+};
+
+}
+
+#endif
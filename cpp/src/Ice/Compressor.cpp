@@ -0,0 +1,513 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Compressor.h>
+#include <Ice/BasicStream.h>
+#include <Ice/Protocol.h>
+#include <Ice/LocalException.h>
+#include <IceUtil/StringUtil.h>
+
+#ifdef ICE_HAS_BZIP2
+#  include <bzlib.h>
+#endif
+
+#ifdef ICE_HAS_LZ4
+#  include <lz4.h>
+#  include <lz4hc.h>
+#endif
+
+#ifdef ICE_HAS_ZSTD
+#  include <zstd.h>
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(Compressor* p) { return p; }
+IceUtil::Shared* IceInternal::upCast(CompressorFactory* p) { return p; }
+
+namespace
+{
+
+#ifdef ICE_HAS_BZIP2
+string
+getBZ2Error(int bzError)
+{
+    if(bzError == BZ_RUN_OK)
+    {
+        return ": BZ_RUN_OK";
+    }
+    else if(bzError == BZ_FLUSH_OK)
+    {
+        return ": BZ_FLUSH_OK";
+    }
+    else if(bzError == BZ_FINISH_OK)
+    {
+        return ": BZ_FINISH_OK";
+    }
+    else if(bzError == BZ_STREAM_END)
+    {
+        return ": BZ_STREAM_END";
+    }
+    else if(bzError == BZ_CONFIG_ERROR)
+    {
+        return ": BZ_CONFIG_ERROR";
+    }
+    else if(bzError == BZ_SEQUENCE_ERROR)
+    {
+        return ": BZ_SEQUENCE_ERROR";
+    }
+    else if(bzError == BZ_PARAM_ERROR)
+    {
+        return ": BZ_PARAM_ERROR";
+    }
+    else if(bzError == BZ_MEM_ERROR)
+    {
+        return ": BZ_MEM_ERROR";
+    }
+    else if(bzError == BZ_DATA_ERROR)
+    {
+        return ": BZ_DATA_ERROR";
+    }
+    else if(bzError == BZ_DATA_ERROR_MAGIC)
+    {
+        return ": BZ_DATA_ERROR_MAGIC";
+    }
+    else if(bzError == BZ_IO_ERROR)
+    {
+        return ": BZ_IO_ERROR";
+    }
+    else if(bzError == BZ_UNEXPECTED_EOF)
+    {
+        return ": BZ_UNEXPECTED_EOF";
+    }
+    else if(bzError == BZ_OUTBUFF_FULL)
+    {
+        return ": BZ_OUTBUFF_FULL";
+    }
+    else
+    {
+        return "";
+    }
+}
+
+class BZip2Compressor : public Compressor
+{
+public:
+
+    BZip2Compressor() : Compressor(2, "bzip2")
+    {
+    }
+
+protected:
+
+    virtual size_t
+    maxCompressedSize(size_t size) const
+    {
+        return static_cast<size_t>(size * 1.01 + 600);
+    }
+
+    virtual size_t
+    compressBuffer(const Byte* src, size_t srcLen, Byte* dest, size_t destLen, int level) const
+    {
+        unsigned int compressedLen = static_cast<unsigned int>(destLen);
+        int bzError = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(dest),
+                                               &compressedLen,
+                                               const_cast<char*>(reinterpret_cast<const char*>(src)),
+                                               static_cast<unsigned int>(srcLen),
+                                               min(max(level, 1), 9), 0, 0);
+        if(bzError != BZ_OK)
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError);
+            throw ex;
+        }
+        return compressedLen;
+    }
+
+    virtual void
+    uncompressBuffer(const Byte* src, size_t srcLen, Byte* dest, size_t destLen) const
+    {
+        unsigned int uncompressedLen = static_cast<unsigned int>(destLen);
+        int bzError = BZ2_bzBuffToBuffDecompress(reinterpret_cast<char*>(dest),
+                                                 &uncompressedLen,
+                                                 const_cast<char*>(reinterpret_cast<const char*>(src)),
+                                                 static_cast<unsigned int>(srcLen),
+                                                 0, 0);
+        if(bzError != BZ_OK)
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = "BZ2_bzBuffToBuffDecompress failed" + getBZ2Error(bzError);
+            throw ex;
+        }
+    }
+};
+#endif
+
+#ifdef ICE_HAS_LZ4
+//
+// LZ4 compression level 1 uses the fast compressor, higher levels use
+// the LZ4 HC compressor, which compresses better but more slowly. The
+// uncompression speed is the same for both.
+//
+class LZ4Compressor : public Compressor
+{
+public:
+
+    LZ4Compressor() : Compressor(3, "lz4")
+    {
+    }
+
+protected:
+
+    virtual size_t
+    maxCompressedSize(size_t size) const
+    {
+        return static_cast<size_t>(LZ4_compressBound(static_cast<int>(size)));
+    }
+
+    virtual size_t
+    compressBuffer(const Byte* src, size_t srcLen, Byte* dest, size_t destLen, int level) const
+    {
+        int compressedLen;
+        if(level <= 1)
+        {
+            compressedLen = LZ4_compress_default(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dest),
+                                                 static_cast<int>(srcLen), static_cast<int>(destLen));
+        }
+        else
+        {
+            compressedLen = LZ4_compress_HC(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dest),
+                                            static_cast<int>(srcLen), static_cast<int>(destLen),
+                                            min(level, static_cast<int>(LZ4HC_CLEVEL_MAX)));
+        }
+        if(compressedLen <= 0)
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = "LZ4 compression failed";
+            throw ex;
+        }
+        return static_cast<size_t>(compressedLen);
+    }
+
+    virtual void
+    uncompressBuffer(const Byte* src, size_t srcLen, Byte* dest, size_t destLen) const
+    {
+        int uncompressedLen = LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dest),
+                                                  static_cast<int>(srcLen), static_cast<int>(destLen));
+        if(uncompressedLen != static_cast<int>(destLen))
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = "LZ4 uncompression failed";
+            throw ex;
+        }
+    }
+};
+#endif
+
+#ifdef ICE_HAS_ZSTD
+class ZstdCompressor : public Compressor
+{
+public:
+
+    ZstdCompressor() : Compressor(4, "zstd")
+    {
+    }
+
+protected:
+
+    virtual size_t
+    maxCompressedSize(size_t size) const
+    {
+        return ZSTD_compressBound(size);
+    }
+
+    virtual size_t
+    compressBuffer(const Byte* src, size_t srcLen, Byte* dest, size_t destLen, int level) const
+    {
+        size_t compressedLen = ZSTD_compress(dest, destLen, src, srcLen, min(max(level, 1), ZSTD_maxCLevel()));
+        if(ZSTD_isError(compressedLen))
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = string("ZSTD_compress failed: ") + ZSTD_getErrorName(compressedLen);
+            throw ex;
+        }
+        return compressedLen;
+    }
+
+    virtual void
+    uncompressBuffer(const Byte* src, size_t srcLen, Byte* dest, size_t destLen) const
+    {
+        size_t uncompressedLen = ZSTD_decompress(dest, destLen, src, srcLen);
+        if(ZSTD_isError(uncompressedLen))
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = string("ZSTD_decompress failed: ") + ZSTD_getErrorName(uncompressedLen);
+            throw ex;
+        }
+        else if(uncompressedLen != destLen)
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = "ZSTD_decompress failed: unexpected uncompressed size";
+            throw ex;
+        }
+    }
+};
+#endif
+
+}
+
+IceInternal::Compressor::Compressor(Byte status, const string& name) :
+    _status(status),
+    _name(name)
+{
+    _stats.compressed = 0;
+    _stats.compressedIn = 0;
+    _stats.compressedOut = 0;
+    _stats.uncompressed = 0;
+    _stats.uncompressedIn = 0;
+}
+
+void
+IceInternal::Compressor::compress(BasicStream& uncompressed, BasicStream& compressed, int level)
+{
+    CompressionObserverIPtr observer = getObserver(true);
+    if(observer)
+    {
+        observer->attach();
+    }
+
+    IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    try
+    {
+        compressMessage(uncompressed, compressed, level);
+    }
+    catch(const LocalException& ex)
+    {
+        if(observer)
+        {
+            observer->failed(ex.ice_name());
+            observer->detach();
+        }
+        throw;
+    }
+    IceUtil::Time elapsed = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        ++_stats.compressed;
+        _stats.compressedIn += static_cast<Long>(uncompressed.b.size());
+        _stats.compressedOut += static_cast<Long>(compressed.b.size());
+        _stats.compressTime += elapsed;
+    }
+
+    if(observer)
+    {
+        observer->sizes(static_cast<Long>(uncompressed.b.size()), static_cast<Long>(compressed.b.size()));
+        observer->detach();
+    }
+}
+
+void
+IceInternal::Compressor::uncompress(BasicStream& compressed, BasicStream& uncompressed, size_t messageSizeMax)
+{
+    CompressionObserverIPtr observer = getObserver(false);
+    if(observer)
+    {
+        observer->attach();
+    }
+
+    IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    try
+    {
+        uncompressMessage(compressed, uncompressed, messageSizeMax);
+    }
+    catch(const LocalException& ex)
+    {
+        if(observer)
+        {
+            observer->failed(ex.ice_name());
+            observer->detach();
+        }
+        throw;
+    }
+    IceUtil::Time elapsed = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        ++_stats.uncompressed;
+        _stats.uncompressedIn += static_cast<Long>(compressed.b.size());
+        _stats.uncompressTime += elapsed;
+    }
+
+    if(observer)
+    {
+        observer->sizes(static_cast<Long>(uncompressed.b.size()), static_cast<Long>(compressed.b.size()));
+        observer->detach();
+    }
+}
+
+Compressor::Stats
+IceInternal::Compressor::getStats() const
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    return _stats;
+}
+
+void
+IceInternal::Compressor::setObserver(const CommunicatorObserverIPtr& observer)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    _observer = observer;
+}
+
+CompressionObserverIPtr
+IceInternal::Compressor::getObserver(bool compress) const
+{
+    CommunicatorObserverIPtr observer;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        observer = _observer;
+    }
+    return observer ? observer->getCompressionObserver(_name, compress) : ICE_NULLPTR;
+}
+
+void
+IceInternal::Compressor::compressMessage(BasicStream& uncompressed, BasicStream& compressed, int level) const
+{
+    const Byte* p;
+
+    //
+    // Compress the message body, but not the header.
+    //
+    size_t uncompressedLen = uncompressed.b.size() - headerSize;
+    compressed.b.resize(headerSize + sizeof(Int) + maxCompressedSize(uncompressedLen));
+    size_t compressedLen = compressBuffer(&uncompressed.b[0] + headerSize, uncompressedLen,
+                                          &compressed.b[0] + headerSize + sizeof(Int),
+                                          compressed.b.size() - headerSize - sizeof(Int), level);
+    compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
+
+    //
+    // Write the size of the compressed stream into the header of the
+    // uncompressed stream. Since the header will be copied, this size
+    // will also be in the header of the compressed stream.
+    //
+    Int compressedSize = static_cast<Int>(compressed.b.size());
+    p = reinterpret_cast<const Byte*>(&compressedSize);
+#ifdef ICE_BIG_ENDIAN
+    reverse_copy(p, p + sizeof(Int), uncompressed.b.begin() + 10);
+#else
+    copy(p, p + sizeof(Int), uncompressed.b.begin() + 10);
+#endif
+
+    //
+    // Add the size of the uncompressed stream before the message body
+    // of the compressed stream.
+    //
+    Int uncompressedSize = static_cast<Int>(uncompressed.b.size());
+    p = reinterpret_cast<const Byte*>(&uncompressedSize);
+#ifdef ICE_BIG_ENDIAN
+    reverse_copy(p, p + sizeof(Int), compressed.b.begin() + headerSize);
+#else
+    copy(p, p + sizeof(Int), compressed.b.begin() + headerSize);
+#endif
+
+    //
+    // Copy the header from the uncompressed stream to the compressed one.
+    //
+    copy(uncompressed.b.begin(), uncompressed.b.begin() + headerSize, compressed.b.begin());
+}
+
+void
+IceInternal::Compressor::uncompressMessage(BasicStream& compressed, BasicStream& uncompressed,
+                                           size_t messageSizeMax) const
+{
+    Int uncompressedSize;
+    compressed.i = compressed.b.begin() + headerSize;
+    compressed.read(uncompressedSize);
+    if(uncompressedSize <= headerSize)
+    {
+        throw IllegalMessageSizeException(__FILE__, __LINE__);
+    }
+
+    if(uncompressedSize > static_cast<Int>(messageSizeMax))
+    {
+        Ex::throwMemoryLimitException(__FILE__, __LINE__, uncompressedSize, messageSizeMax);
+    }
+    uncompressed.resize(uncompressedSize);
+
+    uncompressBuffer(&compressed.b[0] + headerSize + sizeof(Int), compressed.b.size() - headerSize - sizeof(Int),
+                     &uncompressed.b[0] + headerSize, uncompressedSize - headerSize);
+
+    copy(compressed.b.begin(), compressed.b.begin() + headerSize, uncompressed.b.begin());
+}
+
+IceInternal::CompressorFactory::CompressorFactory()
+{
+#ifdef ICE_HAS_BZIP2
+    _compressors.push_back(new BZip2Compressor());
+#endif
+#ifdef ICE_HAS_LZ4
+    _compressors.push_back(new LZ4Compressor());
+#endif
+#ifdef ICE_HAS_ZSTD
+    _compressors.push_back(new ZstdCompressor());
+#endif
+}
+
+void
+IceInternal::CompressorFactory::setObserver(const CommunicatorObserverIPtr& observer)
+{
+    for(vector<CompressorPtr>::const_iterator p = _compressors.begin(); p != _compressors.end(); ++p)
+    {
+        (*p)->setObserver(observer);
+    }
+}
+
+Byte
+IceInternal::CompressorFactory::getAdvertisedCodecs() const
+{
+    Byte codecs = 0;
+    for(vector<CompressorPtr>::const_iterator p = _compressors.begin(); p != _compressors.end(); ++p)
+    {
+        if((*p)->status() > 2)
+        {
+            codecs |= static_cast<Byte>(1 << (*p)->status());
+        }
+    }
+    return codecs;
+}
+
+CompressorPtr
+IceInternal::CompressorFactory::getCompressor(Byte status) const
+{
+    for(vector<CompressorPtr>::const_iterator p = _compressors.begin(); p != _compressors.end(); ++p)
+    {
+        if((*p)->status() == status)
+        {
+            return *p;
+        }
+    }
+    return 0;
+}
+
+CompressorPtr
+IceInternal::CompressorFactory::getCompressor(const string& name) const
+{
+    string lowerName = IceUtilInternal::toLower(name);
+    for(vector<CompressorPtr>::const_iterator p = _compressors.begin(); p != _compressors.end(); ++p)
+    {
+        if((*p)->name() == lowerName)
+        {
+            return *p;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_COMPRESSOR_H
+#define ICE_COMPRESSOR_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Time.h>
+
+#include <Ice/Config.h>
+#include <Ice/CompressorF.h>
+#include <Ice/InstrumentationI.h>
+
+#include <vector>
+
+#if TARGET_OS_IPHONE == 0 && !defined(ICE_OS_WINRT)
+#    ifndef ICE_HAS_BZIP2
+#        define ICE_HAS_BZIP2
+#    endif
+#endif
+
+namespace IceInternal
+{
+
+class BasicStream;
+
+//
+// A compressor compresses and uncompresses the body of protocol
+// messages. Each compressor is identified by the compression status
+// it uses in the message header: 2 for bzip2 (the only codec
+// supported by the Ice protocol 1.0), 3 for LZ4 and 4 for zstd.
+//
+// Peers running Ice 3.6 or earlier only support bzip2, so the other
+// codecs are only used with peers which advertise them: the server
+// sets the compression status of the validate connection message,
+// which these peers ignore, to the codecs it supports (one bit per
+// compression status). The server only uses them once the client
+// sent a message compressed with them.
+//
+class Compressor : public IceUtil::Shared
+{
+public:
+
+    struct Stats
+    {
+        Ice::Long compressed; // Number of compressed messages.
+        Ice::Long compressedIn; // Bytes given to compress().
+        Ice::Long compressedOut; // Bytes produced by compress().
+        IceUtil::Time compressTime;
+        Ice::Long uncompressed; // Number of uncompressed messages.
+        Ice::Long uncompressedIn; // Bytes given to uncompress().
+        IceUtil::Time uncompressTime;
+    };
+
+    Compressor(Ice::Byte, const std::string&);
+
+    Ice::Byte status() const
+    {
+        return _status;
+    }
+
+    const std::string& name() const
+    {
+        return _name;
+    }
+
+    //
+    // Compress the body of the message in the first stream into the
+    // second stream. The message header is copied and the message
+    // size of both streams is set to the size of the compressed
+    // message. Raises CompressionException on failure.
+    //
+    void compress(BasicStream&, BasicStream&, int);
+
+    //
+    // Uncompress the message in the first stream into the second
+    // stream. The size of the uncompressed message is checked against
+    // the given maximum message size.
+    //
+    void uncompress(BasicStream&, BasicStream&, size_t);
+
+    Stats getStats() const;
+
+    //
+    // Set the observer used to update the compression metrics, null
+    // if the metrics are disabled.
+    //
+    void setObserver(const CommunicatorObserverIPtr&);
+
+protected:
+
+    //
+    // The codec specific part: the maximum size of the compressed
+    // data for the given size, the compression of a buffer (returns
+    // the size of the compressed data) and the uncompression of a
+    // buffer whose uncompressed size is known.
+    //
+    virtual size_t maxCompressedSize(size_t) const = 0;
+    virtual size_t compressBuffer(const Ice::Byte*, size_t, Ice::Byte*, size_t, int) const = 0;
+    virtual void uncompressBuffer(const Ice::Byte*, size_t, Ice::Byte*, size_t) const = 0;
+
+private:
+
+    void compressMessage(BasicStream&, BasicStream&, int) const;
+    void uncompressMessage(BasicStream&, BasicStream&, size_t) const;
+    CompressionObserverIPtr getObserver(bool) const;
+
+    const Ice::Byte _status;
+    const std::string _name;
+
+    IceUtil::Mutex _mutex;
+    Stats _stats;
+    CommunicatorObserverIPtr _observer;
+};
+
+//
+// The compressor factory provides the compressors supported by this
+// build of the Ice run time.
+//
+class CompressorFactory : public IceUtil::Shared
+{
+public:
+
+    CompressorFactory();
+
+    //
+    // Return the compressor for the given compression status or name,
+    // or null if the codec isn't supported.
+    //
+    CompressorPtr getCompressor(Ice::Byte) const;
+    CompressorPtr getCompressor(const std::string&) const;
+
+    const std::vector<CompressorPtr>& getCompressors() const
+    {
+        return _compressors;
+    }
+
+    //
+    // The codecs advertised in the validate connection message, one
+    // bit per compression status. bzip2 isn't advertised.
+    //
+    Ice::Byte getAdvertisedCodecs() const;
+
+    void setObserver(const CommunicatorObserverIPtr&);
+
+private:
+
+    std::vector<CompressorPtr> _compressors;
+};
+
+}
+
+#endif
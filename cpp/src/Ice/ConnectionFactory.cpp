@@ -1386,7 +1386,7 @@ IceInternal::IncomingConnectionFactory::message(ThreadPoolCurrent& current)
         try
         {
             connection = ConnectionI::create(_adapter->getCommunicator(), _instance, _monitor, transceiver, 0,
-                                             _endpoint, _adapter);
+                                             _endpoint, _adapter, _threadPoolShard);
         }
         catch(const LocalException& ex)
         {
@@ -1521,11 +1521,13 @@ IceInternal::IncomingConnectionFactory::connectionStartFailed(const Ice::Connect
 //
 IceInternal::IncomingConnectionFactory::IncomingConnectionFactory(const InstancePtr& instance,
                                                                   const EndpointIPtr& endpoint,
-                                                                  const ObjectAdapterIPtr& adapter) :
+                                                                  const ObjectAdapterIPtr& adapter,
+                                                                  int threadPoolShard) :
     _instance(instance),
     _monitor(new FactoryACMMonitor(instance, dynamic_cast<ObjectAdapterI*>(adapter.get())->getACM())),
     _endpoint(endpoint),
     _adapter(adapter),
+    _threadPoolShard(threadPoolShard),
     _warn(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Connections") > 0),
     _state(StateHolding)
 {
@@ -1747,7 +1749,7 @@ IceInternal::IncomingConnectionFactory::createAcceptor()
             out << "listening for " << _endpoint->protocol() << " connections\n" << _acceptor->toDetailedString();
         }
 
-        _adapter->getThreadPool()->initialize(shared_from_this());
+        _adapter->getThreadPool()->initialize(shared_from_this(), _threadPoolShard);
         if(_state == StateActive)
         {
             _adapter->getThreadPool()->_register(shared_from_this(), SocketOperationRead);
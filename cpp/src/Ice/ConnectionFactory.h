@@ -209,7 +209,7 @@ public:
     virtual void connectionStartCompleted(const Ice::ConnectionIPtr&);
     virtual void connectionStartFailed(const Ice::ConnectionIPtr&, const Ice::LocalException&);
 
-    IncomingConnectionFactory(const InstancePtr&, const EndpointIPtr&, const Ice::ObjectAdapterIPtr&);
+    IncomingConnectionFactory(const InstancePtr&, const EndpointIPtr&, const Ice::ObjectAdapterIPtr&, int = -1);
     void initialize();
     virtual ~IncomingConnectionFactory();
     
@@ -243,6 +243,12 @@ private:
 
     Ice::ObjectAdapterIPtr _adapter;
 
+    //
+    // The thread pool shard of the acceptor and of its connections,
+    // -1 if they are assigned in turn to the shards.
+    //
+    const int _threadPoolShard;
+
     const bool _warn;
 
     std::set<Ice::ConnectionIPtr> _connections;
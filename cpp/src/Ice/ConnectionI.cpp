@@ -28,10 +28,7 @@
 #include <Ice/ReferenceFactory.h> // For createProxy().
 #include <Ice/ProxyFactory.h> // For createProxy().
 #include <Ice/BatchRequestQueue.h>
-
-#ifdef ICE_HAS_BZIP2
-#  include <bzlib.h>
-#endif
+#include <Ice/Compressor.h>
 
 using namespace std;
 using namespace Ice;
@@ -47,6 +44,13 @@ namespace
 
 const ::std::string __flushBatchRequests_name = "flushBatchRequests";
 
+//
+// Limits on the number of queued messages and on the number of bytes
+// gathered with the message being sent.
+//
+const size_t maxGatherMessages = 64;
+const size_t maxGatherSize = 256 * 1024;
+
 class TimeoutCallback : public IceUtil::TimerTask
 {
 public:
@@ -1079,9 +1083,11 @@ Ice::ConnectionI::requestCanceled(OutgoingBase* out, const Ice::LocalException&
             {
                 //
                 // If the request is being sent, don't remove it from the send streams,
-                // it will be removed once the sending is finished.
+                // it will be removed once the sending is finished. This is also the
+                // case for queued requests already prepared for sending, they might
+                // have been partially written with the request being sent.
                 //
-                if(o == _sendStreams.begin())
+                if(o == _sendStreams.begin() || o->stream->i)
                 {
                     o->canceled(true); // true = adopt the stream.
                 }
@@ -1174,9 +1180,11 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
             {
                 //
                 // If the request is being sent, don't remove it from the send streams,
-                // it will be removed once the sending is finished.
+                // it will be removed once the sending is finished. This is also the
+                // case for queued requests already prepared for sending, they might
+                // have been partially written with the request being sent.
                 //
-                if(o == _sendStreams.begin())
+                if(o == _sendStreams.begin() || o->stream->i)
                 {
                     o->canceled(true); // true = adopt the stream
                 }
@@ -1554,7 +1562,7 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                 {
                     _observer.startWrite(_writeStream);
                 }
-                writeOp = write(_writeStream);
+                writeOp = writeSendStreams();
                 if(_observer && !(writeOp & SocketOperationWrite))
                 {
                     _observer.finishWrite(_writeStream);
@@ -2191,7 +2199,9 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _readTimeoutScheduled(false),
     _warn(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Connections") > 0),
     _warnUdp(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Datagrams") > 0),
-    _compressionLevel(1),
+    _compressor(adapter ? adapter->compressor() : _instance->compressor()),
+    _compressionLevel(adapter ? adapter->compressionLevel() : _instance->compressionLevel()),
+    _peerCodecs(0),
     _nextRequestId(1),
     _requestsHint(_requests.end()),
     _asyncRequestsHint(_asyncRequests.end()),
@@ -2206,19 +2216,6 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _initialized(false),
     _validated(false)
 {
-    const Ice::PropertiesPtr& properties = _instance->initializationData().properties;
-
-    int& compressionLevel = const_cast<int&>(_compressionLevel);
-    compressionLevel = properties->getPropertyAsIntWithDefault("Ice.Compression.Level", 1);
-    if(compressionLevel < 1)
-    {
-        compressionLevel = 1;
-    }
-    else if(compressionLevel > 9)
-    {
-        compressionLevel = 9;
-    }
-
     if(adapter)
     {
         _servantManager = adapter->getServantManager();
@@ -2237,7 +2234,8 @@ Ice::ConnectionI::create(const CommunicatorPtr& communicator,
                          const TransceiverPtr& transceiver,
                          const ConnectorPtr& connector,
                          const EndpointIPtr& endpoint,
-                         const ObjectAdapterIPtr& adapter)
+                         const ObjectAdapterIPtr& adapter,
+                         int shard)
 {
     Ice::ConnectionIPtr conn(new ConnectionI(communicator, instance, monitor, transceiver, connector,
                                              endpoint, adapter));
@@ -2249,7 +2247,7 @@ Ice::ConnectionI::create(const CommunicatorPtr& communicator,
     {
         const_cast<ThreadPoolPtr&>(conn->_threadPool) = conn->_instance->clientThreadPool();
     }
-    conn->_threadPool->initialize(conn);
+    conn->_threadPool->initialize(conn, shard);
     return conn;
 }
 
@@ -2616,7 +2614,12 @@ Ice::ConnectionI::validate(SocketOperation operation)
                 _writeStream.write(currentProtocol);
                 _writeStream.write(currentProtocolEncoding);
                 _writeStream.write(validateConnectionMsg);
-                _writeStream.write(static_cast<Byte>(0)); // Compression status (always zero for validate connection).
+                //
+                // Advertise the compression codecs supported in addition
+                // to bzip2 with the compression status, it's ignored by
+                // the clients which don't support them.
+                //
+                _writeStream.write(_instance->compressorFactory()->getAdvertisedCodecs());
                 _writeStream.write(headerSize); // Message size.
                 _writeStream.i = _writeStream.b.begin();
                 traceSend(_writeStream, _logger, _traceLevels);
@@ -2698,7 +2701,8 @@ Ice::ConnectionI::validate(SocketOperation operation)
                 throw ConnectionNotValidatedException(__FILE__, __LINE__);
             }
             Byte compress;
-            _readStream.read(compress); // Ignore compression status for validate connection.
+            _readStream.read(compress); // The compression codecs supported by the server.
+            _peerCodecs = compress;
             Int size;
             _readStream.read(size);
             if(size != headerSize)
@@ -2794,66 +2798,10 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
             // Otherwise, prepare the next message stream for writing.
             //
             message = &_sendStreams.front();
-            assert(!message->stream->i);
-#ifdef ICE_HAS_BZIP2
-            if(message->compress && message->stream->b.size() >= 100) // Only compress messages > 100 bytes.
+            if(!message->stream->i) // The message might already be prepared if it was gathered.
             {
-                //
-                // Message compressed. Request compressed response, if any.
-                //
-                message->stream->b[9] = 2;
-
-                //
-                // Do compression.
-                //
-                BasicStream stream(_instance.get(), Ice::currentProtocolEncoding);
-                doCompress(*message->stream, stream);
-
-                if(message->outAsync)
-                {
-                    trace("sending asynchronous request", *message->stream, _logger, _traceLevels);
-                }
-                else
-                {
-                    traceSend(*message->stream, _logger, _traceLevels);
-                }
-
-                message->adopt(&stream); // Adopt the compressed stream.
-                message->stream->i = message->stream->b.begin();
+                prepareMessage(*message);
             }
-            else
-            {
-#endif
-                if(message->compress)
-                {
-                    //
-                    // Message not compressed. Request compressed response, if any.
-                    //
-                    message->stream->b[9] = 1;
-                }
-
-                //
-                // No compression, just fill in the message size.
-                //
-                Int sz = static_cast<Int>(message->stream->b.size());
-                const Byte* p = reinterpret_cast<const Byte*>(&sz);
-#ifdef ICE_BIG_ENDIAN
-                reverse_copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
-#else
-                copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
-#endif
-                message->stream->i = message->stream->b.begin();
-                if(message->outAsync)
-                {
-                    trace("sending asynchronous request", *message->stream, _logger, _traceLevels);
-                }
-                else
-                {
-                    traceSend(*message->stream, _logger, _traceLevels);
-                }
-#ifdef ICE_HAS_BZIP2
-            }
-#endif
             _writeStream.swap(*message->stream);
 
             //
@@ -2866,7 +2814,7 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
             assert(_writeStream.i);
             if(_writeStream.i != _writeStream.b.end())
             {
-                SocketOperation op = write(_writeStream);
+                SocketOperation op = writeSendStreams();
                 if(op)
                 {
                     return op;
@@ -2899,6 +2847,68 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
     return SocketOperationNone;
 }
 
+void
+Ice::ConnectionI::prepareMessage(OutgoingMessage& message)
+{
+    assert(!message.stream->i);
+    CompressorPtr compressor = getCompressor(message);
+    if(compressor)
+    {
+        //
+        // Message compressed. Request compressed response, if any.
+        //
+        message.stream->b[9] = compressor->status();
+
+        //
+        // Do compression.
+        //
+        BasicStream stream(_instance.get(), Ice::currentProtocolEncoding);
+        compressor->compress(*message.stream, stream, _compressionLevel);
+
+        if(message.outAsync)
+        {
+            trace("sending asynchronous request", *message.stream, _logger, _traceLevels);
+        }
+        else
+        {
+            traceSend(*message.stream, _logger, _traceLevels);
+        }
+
+        message.adopt(&stream); // Adopt the compressed stream.
+        message.stream->i = message.stream->b.begin();
+    }
+    else
+    {
+        if(message.compress)
+        {
+            //
+            // Message not compressed. Request compressed response, if any.
+            //
+            message.stream->b[9] = 1;
+        }
+
+        //
+        // No compression, just fill in the message size.
+        //
+        Int sz = static_cast<Int>(message.stream->b.size());
+        const Byte* p = reinterpret_cast<const Byte*>(&sz);
+#ifdef ICE_BIG_ENDIAN
+        reverse_copy(p, p + sizeof(Int), message.stream->b.begin() + 10);
+#else
+        copy(p, p + sizeof(Int), message.stream->b.begin() + 10);
+#endif
+        message.stream->i = message.stream->b.begin();
+        if(message.outAsync)
+        {
+            trace("sending asynchronous request", *message.stream, _logger, _traceLevels);
+        }
+        else
+        {
+            traceSend(*message.stream, _logger, _traceLevels);
+        }
+    }
+}
+
 AsyncStatus
 Ice::ConnectionI::sendMessage(OutgoingMessage& message)
 {
@@ -2920,19 +2930,19 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
 
     message.stream->i = message.stream->b.begin();
     SocketOperation op;
-#ifdef ICE_HAS_BZIP2
-    if(message.compress && message.stream->b.size() >= 100) // Only compress messages larger than 100 bytes.
+    CompressorPtr compressor = getCompressor(message);
+    if(compressor)
     {
         //
         // Message compressed. Request compressed response, if any.
         //
-        message.stream->b[9] = 2;
+        message.stream->b[9] = compressor->status();
 
         //
         // Do compression.
         //
         BasicStream stream(_instance.get(), Ice::currentProtocolEncoding);
-        doCompress(*message.stream, stream);
+        compressor->compress(*message.stream, stream, _compressionLevel);
         stream.i = stream.b.begin();
 
         if(message.outAsync)
@@ -2976,7 +2986,6 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
     }
     else
     {
-#endif
         if(message.compress)
         {
             //
@@ -3034,9 +3043,7 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
 
         _sendStreams.push_back(message);
         _sendStreams.back().adopt(0); // Adopt the stream.
-#ifdef ICE_HAS_BZIP2
     }
-#endif
 
     _writeStream.swap(*_sendStreams.back().stream);
     scheduleTimeout(op);
@@ -3044,157 +3051,26 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
     return AsyncStatusQueued;
 }
 
-#ifdef ICE_HAS_BZIP2
-static string
-getBZ2Error(int bzError)
+CompressorPtr
+Ice::ConnectionI::getCompressor(const OutgoingMessage& message) const
 {
-    if(bzError == BZ_RUN_OK)
-    {
-        return ": BZ_RUN_OK";
-    }
-    else if(bzError == BZ_FLUSH_OK)
+    if(!message.compress || message.stream->b.size() < 100) // Only compress messages larger than 100 bytes.
     {
-        return ": BZ_FLUSH_OK";
+        return 0;
     }
-    else if(bzError == BZ_FINISH_OK)
+    else if(_compressor && _compressor->status() != 2 && !(_peerCodecs & (1 << _compressor->status())))
     {
-        return ": BZ_FINISH_OK";
-    }
-    else if(bzError == BZ_STREAM_END)
-    {
-        return ": BZ_STREAM_END";
-    }
-    else if(bzError == BZ_CONFIG_ERROR)
-    {
-        return ": BZ_CONFIG_ERROR";
-    }
-    else if(bzError == BZ_SEQUENCE_ERROR)
-    {
-        return ": BZ_SEQUENCE_ERROR";
-    }
-    else if(bzError == BZ_PARAM_ERROR)
-    {
-        return ": BZ_PARAM_ERROR";
-    }
-    else if(bzError == BZ_MEM_ERROR)
-    {
-        return ": BZ_MEM_ERROR";
-    }
-    else if(bzError == BZ_DATA_ERROR)
-    {
-        return ": BZ_DATA_ERROR";
-    }
-    else if(bzError == BZ_DATA_ERROR_MAGIC)
-    {
-        return ": BZ_DATA_ERROR_MAGIC";
-    }
-    else if(bzError == BZ_IO_ERROR)
-    {
-        return ": BZ_IO_ERROR";
-    }
-    else if(bzError == BZ_UNEXPECTED_EOF)
-    {
-        return ": BZ_UNEXPECTED_EOF";
-    }
-    else if(bzError == BZ_OUTBUFF_FULL)
-    {
-        return ": BZ_OUTBUFF_FULL";
+        //
+        // The peer didn't advertise the configured codec, use bzip2
+        // which is supported by all the peers.
+        //
+        return _instance->compressorFactory()->getCompressor(2);
     }
     else
     {
-        return "";
-    }
-}
-
-void
-Ice::ConnectionI::doCompress(BasicStream& uncompressed, BasicStream& compressed)
-{
-    const Byte* p;
-
-    //
-    // Compress the message body, but not the header.
-    //
-    unsigned int uncompressedLen = static_cast<unsigned int>(uncompressed.b.size() - headerSize);
-    unsigned int compressedLen = static_cast<unsigned int>(uncompressedLen * 1.01 + 600);
-    compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
-    int bzError = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
-                                           &compressedLen,
-                                           reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
-                                           uncompressedLen,
-                                           _compressionLevel, 0, 0);
-    if(bzError != BZ_OK)
-    {
-        CompressionException ex(__FILE__, __LINE__);
-        ex.reason = "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError);
-        throw ex;
-    }
-    compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
-
-    //
-    // Write the size of the compressed stream into the header of the
-    // uncompressed stream. Since the header will be copied, this size
-    // will also be in the header of the compressed stream.
-    //
-    Int compressedSize = static_cast<Int>(compressed.b.size());
-    p = reinterpret_cast<const Byte*>(&compressedSize);
-#ifdef ICE_BIG_ENDIAN
-    reverse_copy(p, p + sizeof(Int), uncompressed.b.begin() + 10);
-#else
-    copy(p, p + sizeof(Int), uncompressed.b.begin() + 10);
-#endif
-
-    //
-    // Add the size of the uncompressed stream before the message body
-    // of the compressed stream.
-    //
-    Int uncompressedSize = static_cast<Int>(uncompressed.b.size());
-    p = reinterpret_cast<const Byte*>(&uncompressedSize);
-#ifdef ICE_BIG_ENDIAN
-    reverse_copy(p, p + sizeof(Int), compressed.b.begin() + headerSize);
-#else
-    copy(p, p + sizeof(Int), compressed.b.begin() + headerSize);
-#endif
-
-    //
-    // Copy the header from the uncompressed stream to the compressed one.
-    //
-    copy(uncompressed.b.begin(), uncompressed.b.begin() + headerSize, compressed.b.begin());
-}
-
-void
-Ice::ConnectionI::doUncompress(BasicStream& compressed, BasicStream& uncompressed)
-{
-    Int uncompressedSize;
-    compressed.i = compressed.b.begin() + headerSize;
-    compressed.read(uncompressedSize);
-    if(uncompressedSize <= headerSize)
-    {
-        throw IllegalMessageSizeException(__FILE__, __LINE__);
-    }
-
-    if(uncompressedSize > static_cast<Int>(_messageSizeMax))
-    {
-        Ex::throwMemoryLimitException(__FILE__, __LINE__, uncompressedSize, _messageSizeMax);
+        return _compressor;
     }
-    uncompressed.resize(uncompressedSize);
-
-    unsigned int uncompressedLen = uncompressedSize - headerSize;
-    unsigned int compressedLen = static_cast<unsigned int>(compressed.b.size() - headerSize - sizeof(Int));
-    int bzError = BZ2_bzBuffToBuffDecompress(reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
-                                             &uncompressedLen,
-                                             reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
-                                             compressedLen,
-                                             0, 0);
-    if(bzError != BZ_OK)
-    {
-        CompressionException ex(__FILE__, __LINE__);
-        ex.reason = "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError);
-        throw ex;
-    }
-
-    copy(compressed.b.begin(), compressed.b.begin() + headerSize, uncompressed.b.begin());
 }
-#endif
 
 SocketOperation
 Ice::ConnectionI::parseMessage(BasicStream& stream, Int& invokeNum, Int& requestId, Byte& compress,
@@ -3232,17 +3108,20 @@ Ice::ConnectionI::parseMessage(BasicStream& stream, Int& invokeNum, Int& request
         stream.read(messageType);
         stream.read(compress);
 
-        if(compress == 2)
+        if(compress >= 2)
         {
-#ifdef ICE_HAS_BZIP2
+            CompressorPtr compressor = _instance->compressorFactory()->getCompressor(compress);
+            if(!compressor)
+            {
+                FeatureNotSupportedException ex(__FILE__, __LINE__);
+                ex.unsupportedFeature = "Cannot uncompress compressed message";
+                throw ex;
+            }
+            _peerCodecs |= 1 << compress;
+
             BasicStream ustream(_instance.get(), Ice::currentProtocolEncoding);
-            doUncompress(stream, ustream);
+            compressor->uncompress(stream, ustream, _messageSizeMax);
             stream.b.swap(ustream.b);
-#else
-            FeatureNotSupportedException ex(__FILE__, __LINE__);
-            ex.unsupportedFeature = "Cannot uncompress compressed message";
-            throw ex;
-#endif
         }
         stream.i = stream.b.begin() + headerSize;
 
@@ -3610,6 +3489,71 @@ ConnectionI::toConnectionState(State state) const
     return connectionStateMap[static_cast<int>(state)];
 }
 
+SocketOperation
+ConnectionI::writeSendStreams()
+{
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_WINRT)
+    //
+    // Gather the messages queued after the message being sent from
+    // _writeStream to write them all at once, this saves a system call
+    // per message with transports supporting vectored writes.
+    //
+    if(_sendStreams.size() > 1 && _state > StateNotValidated && _state < StateClosingPending)
+    {
+        _writeBuffers.clear();
+        _writeBuffers.push_back(&_writeStream);
+        size_t queued = 0;
+        for(deque<OutgoingMessage>::iterator p = _sendStreams.begin() + 1; p != _sendStreams.end(); ++p)
+        {
+            if(_writeBuffers.size() >= maxGatherMessages || queued >= maxGatherSize)
+            {
+                break;
+            }
+            if(!p->stream->i)
+            {
+                prepareMessage(*p);
+            }
+            _writeBuffers.push_back(p->stream);
+            queued += p->stream->b.end() - p->stream->i;
+        }
+
+        Buffer::Container::iterator start = _writeStream.i;
+        SocketOperation op = _transceiver->writeBuffers(_writeBuffers);
+
+        size_t notSent = 0;
+        for(vector<Buffer*>::const_iterator p = _writeBuffers.begin() + 1; p != _writeBuffers.end(); ++p)
+        {
+            notSent += (*p)->b.end() - (*p)->i;
+        }
+        size_t sent = (_writeStream.i - start) + (queued - notSent);
+
+        if(_instance->traceLevels()->network >= 3 && sent > 0)
+        {
+            Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+            out << "sent " << sent << " of " << ((_writeStream.b.end() - start) + queued) << " bytes via "
+                << _endpoint->protocol() << " (" << _writeBuffers.size() << " messages)\n" << toString();
+        }
+
+        //
+        // The bytes sent from _writeStream are accounted for with the
+        // startWrite/finishWrite observer calls.
+        //
+        if(_observer && queued > notSent)
+        {
+            _observer->sentBytes(static_cast<int>(queued - notSent));
+        }
+
+        //
+        // Only report the operation if the message being sent isn't
+        // fully sent, sendNextMessage takes care of sending the
+        // remaining of the gathered messages.
+        //
+        return _writeStream.i != _writeStream.b.end() ? op : SocketOperationNone;
+    }
+#endif
+    return write(_writeStream);
+}
+
 SocketOperation
 ConnectionI::read(Buffer& buf)
 {
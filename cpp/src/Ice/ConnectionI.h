@@ -37,17 +37,12 @@
 #include <Ice/ObserverHelper.h>
 #include <Ice/ConnectionAsync.h>
 #include <Ice/BatchRequestQueueF.h>
+#include <Ice/CompressorF.h>
 #include <Ice/ACM.h>
 #include <Ice/VirtualShared.h>
 
 #include <deque>
 
-#if TARGET_OS_IPHONE == 0 && !defined(ICE_OS_WINRT)
-#    ifndef ICE_HAS_BZIP2
-#        define ICE_HAS_BZIP2
-#    endif
-#endif
-
 namespace IceInternal
 {
 
@@ -271,7 +266,7 @@ private:
     static ConnectionIPtr
     create(const Ice::CommunicatorPtr&, const IceInternal::InstancePtr&, const IceInternal::ACMMonitorPtr&,
            const IceInternal::TransceiverPtr&, const IceInternal::ConnectorPtr&,
-           const IceInternal::EndpointIPtr&, const ObjectAdapterIPtr&);
+           const IceInternal::EndpointIPtr&, const ObjectAdapterIPtr&, int = -1);
 
     enum State
     {
@@ -298,11 +293,9 @@ private:
     bool validate(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
     IceInternal::SocketOperation sendNextMessage(std::vector<OutgoingMessage>&);
     IceInternal::AsyncStatus sendMessage(OutgoingMessage&);
+    void prepareMessage(OutgoingMessage&);
 
-#ifdef ICE_HAS_BZIP2
-    void doCompress(IceInternal::BasicStream&, IceInternal::BasicStream&);
-    void doUncompress(IceInternal::BasicStream&, IceInternal::BasicStream&);
-#endif
+    IceInternal::CompressorPtr getCompressor(const OutgoingMessage&) const;
 
     IceInternal::SocketOperation parseMessage(IceInternal::BasicStream&, Int&, Int&, Byte&,
                                               IceInternal::ServantManagerPtr&, ObjectAdapterPtr&,
@@ -319,6 +312,7 @@ private:
 
     IceInternal::SocketOperation read(IceInternal::Buffer&);
     IceInternal::SocketOperation write(IceInternal::Buffer&);
+    IceInternal::SocketOperation writeSendStreams();
 
     void reap();
 
@@ -356,7 +350,9 @@ private:
 
     IceUtil::Time _acmLastActivity;
 
+    const IceInternal::CompressorPtr _compressor;
     const int _compressionLevel;
+    int _peerCodecs; // The codecs advertised by the peer or used by its messages, one bit per codec.
 
     Int _nextRequestId;
 
@@ -376,6 +372,7 @@ private:
     IceInternal::BasicStream _readStream;
     bool _readHeader;
     IceInternal::BasicStream _writeStream;
+    std::vector<IceInternal::Buffer*> _writeBuffers;
 
     Observer _observer;
 
@@ -73,6 +73,7 @@ protected:
 #endif
     SocketOperation _ready;
     SocketOperation _registered;
+    size_t _shard;
 
     friend class ThreadPool;
     friend class ThreadPoolCurrent;
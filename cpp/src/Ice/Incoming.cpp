@@ -8,6 +8,7 @@
 // **********************************************************************
 
 #include <Ice/Incoming.h>
+#include <Ice/ByteView.h>
 #include <Ice/IncomingAsync.h>
 #include <Ice/IncomingRequest.h>
 #include <Ice/ObjectAdapter.h>
@@ -570,6 +571,29 @@ IceInternal::Incoming::setActive(IncomingAsync& cb)
 #endif
 }
 
+void
+IceInternal::Incoming::readParamEncaps(ByteView& v)
+{
+    const Byte* p;
+    Int sz;
+    _current.encoding = _is->readEncaps(p, sz);
+
+    //
+    // The view shares the message buffer so that the encapsulation
+    // can outlive the dispatch without being copied, unless the
+    // stream doesn't own its buffer (collocated dispatch).
+    //
+    SharedBufferPtr owner = _is->b.share();
+    if(owner)
+    {
+        ByteView(p, p + sz, owner).swap(v);
+    }
+    else
+    {
+        ByteView(p, p + sz).swap(v);
+    }
+}
+
 void
 IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, BasicStream* stream)
 {
@@ -17,6 +17,8 @@
 #include <Ice/ReferenceFactory.h>
 #include <Ice/ProxyFactory.h>
 #include <Ice/ThreadPool.h>
+#include <Ice/BufferPool.h>
+#include <Ice/Compressor.h>
 #include <Ice/ConnectionFactory.h>
 #include <Ice/ValueFactoryManager.h>
 #include <Ice/LocalException.h>
@@ -209,13 +211,23 @@ private:
 
     virtual void runTimerTask(const IceUtil::TimerTaskPtr&);
 
+    Ice::Instrumentation::ThreadObserverPtr getThreadObserver();
+
     IceUtil::Mutex _mutex;
     //
     // TODO: Replace by std::atomic<bool> when it becomes widely
     // available.
     //
     IceUtilInternal::Atomic _hasObserver;
-    ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+    Ice::Instrumentation::CommunicatorObserverPtr _communicatorObserver;
+
+    //
+    // Each timer thread has its own observer. The threads are named
+    // Ice.Timer, Ice.Timer-1, ... in the order they first run a task.
+    //
+    typedef std::map<IceUtil::ThreadControl::ID, std::string> ThreadNameMap;
+    ThreadNameMap _threadNames;
+    std::map<IceUtil::ThreadControl::ID, ObserverHelperT<Ice::Instrumentation::ThreadObserver> > _observers;
 };
 
 }
@@ -225,11 +237,40 @@ Timer::updateObserver(const Ice::Instrumentation::CommunicatorObserverPtr& obsv)
 {
     IceUtil::Mutex::Lock sync(_mutex);
     assert(obsv);
-    _observer.attach(obsv->getThreadObserver("Communicator",
-                                            "Ice.Timer",
-                                            Ice::Instrumentation::ThreadStateIdle,
-                                            _observer.get()));
-    _hasObserver.exchange(_observer.get() ? 1 : 0);
+    _communicatorObserver = obsv;
+    for(ThreadNameMap::const_iterator p = _threadNames.begin(); p != _threadNames.end(); ++p)
+    {
+        ObserverHelperT<Ice::Instrumentation::ThreadObserver>& observer = _observers[p->first];
+        observer.attach(obsv->getThreadObserver("Communicator",
+                                                p->second,
+                                                Ice::Instrumentation::ThreadStateIdle,
+                                                observer.get()));
+    }
+    _hasObserver.exchange(1);
+}
+
+Ice::Instrumentation::ThreadObserverPtr
+Timer::getThreadObserver()
+{
+    const IceUtil::ThreadControl::ID id = IceUtil::ThreadControl().id();
+
+    IceUtil::Mutex::Lock sync(_mutex);
+    ObserverHelperT<Ice::Instrumentation::ThreadObserver>& observer = _observers[id];
+    if(_threadNames.find(id) == _threadNames.end())
+    {
+        ostringstream os;
+        os << "Ice.Timer";
+        if(!_threadNames.empty())
+        {
+            os << "-" << _threadNames.size();
+        }
+        _threadNames.insert(make_pair(id, os.str()));
+        observer.attach(_communicatorObserver->getThreadObserver("Communicator",
+                                                                 os.str(),
+                                                                 Ice::Instrumentation::ThreadStateIdle,
+                                                                 0));
+    }
+    return observer.get();
 }
 
 void
@@ -237,11 +278,7 @@ Timer::runTimerTask(const IceUtil::TimerTaskPtr& task)
 {
     if(_hasObserver != 0)
     {
-        Ice::Instrumentation::ThreadObserverPtr threadObserver;
-        {
-            IceUtil::Mutex::Lock sync(_mutex);
-            threadObserver = _observer.get();
-        }
+        Ice::Instrumentation::ThreadObserverPtr threadObserver = getThreadObserver();
         if(threadObserver)
         {
             threadObserver->stateChanged(Ice::Instrumentation::ThreadStateIdle,
@@ -1074,6 +1111,7 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
     _messageSizeMax(0),
     _batchAutoFlushSize(0),
     _collectObjects(false),
+    _compressionLevel(1),
     _implicitContext(0),
     _stringConverter(IceUtil::getProcessStringConverter()),
     _wstringConverter(IceUtil::getProcessWstringConverter()),
@@ -1310,8 +1348,53 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
             }
         }
 
+        {
+            //
+            // Property is in microseconds. When set, the batch requests
+            // are flushed at the latest after this delay.
+            //
+            Int num = _initData.properties->getPropertyAsInt("Ice.BatchAutoFlushDelay");
+            if(num > 0)
+            {
+                const_cast<IceUtil::Time&>(_batchAutoFlushDelay) = IceUtil::Time::microSeconds(num);
+            }
+        }
+
         const_cast<bool&>(_collectObjects) = _initData.properties->getPropertyAsInt("Ice.CollectObjects") > 0;
 
+        if(_initData.properties->getPropertyAsInt("Ice.CacheMessageBuffers") > 0)
+        {
+            const_cast<BufferPoolPtr&>(_bufferPool) = new BufferPool();
+        }
+
+        const_cast<CompressorFactoryPtr&>(_compressorFactory) = new CompressorFactory();
+
+        {
+            //
+            // The codec used to compress the messages sent by proxies
+            // with compression enabled, and the replies sent by
+            // incoming connections if the peer supports it.
+            //
+            string codec = _initData.properties->getProperty("Ice.Compression.Codec");
+            if(codec.empty())
+            {
+                const_cast<CompressorPtr&>(_compressor) = _compressorFactory->getCompressor("bzip2");
+            }
+            else
+            {
+                const_cast<CompressorPtr&>(_compressor) = _compressorFactory->getCompressor(codec);
+                if(!_compressor)
+                {
+                    InitializationException ex(__FILE__, __LINE__);
+                    ex.reason = "unsupported compression codec `" + codec + "' in Ice.Compression.Codec";
+                    throw ex;
+                }
+            }
+
+            const_cast<int&>(_compressionLevel) =
+                max(_initData.properties->getPropertyAsIntWithDefault("Ice.Compression.Level", 1), 1);
+        }
+
         //
         // Client ACM enabled by default. Server ACM disabled by default.
         //
@@ -1537,6 +1620,11 @@ IceInternal::Instance::finishSetup(int& argc, char* argv[], const Ice::Communica
             CommunicatorObserverIPtr observer = ICE_MAKE_SHARED(CommunicatorObserverI, _initData);
             _initData.observer = observer;
             _adminFacets.insert(make_pair(metricsFacetName, observer->getFacet()));
+            _compressorFactory->setObserver(observer);
+            if(_bufferPool)
+            {
+                _bufferPool->setObserver(observer);
+            }
 
             //
             // Make sure the metrics admin facet receives property updates.
@@ -1571,6 +1659,12 @@ IceInternal::Instance::finishSetup(int& argc, char* argv[], const Ice::Communica
         {
             _timer = new Timer;
         }
+
+        int timerThreads = _initData.properties->getPropertyAsIntWithDefault("Ice.TimerThreads", 1);
+        if(timerThreads > 1)
+        {
+            _timer->addThreads(timerThreads - 1);
+        }
     }
     catch(const IceUtil::Exception& ex)
     {
@@ -1728,6 +1822,11 @@ IceInternal::Instance::destroy()
         if(observer)
         {
             observer->destroy(); // Break cyclic reference counts. Don't clear _observer, it's immutable.
+            _compressorFactory->setObserver(ICE_NULLPTR);
+            if(_bufferPool)
+            {
+                _bufferPool->setObserver(ICE_NULLPTR);
+            }
         }
         _initData.observer->setObserverUpdater(0); // Break cyclic reference count.
     }
@@ -1815,6 +1914,47 @@ IceInternal::Instance::destroy()
         }
     }
 
+    if(_bufferPool && _traceLevels->network >= 2)
+    {
+        BufferPool::Stats stats = _bufferPool->getStats();
+        Ice::Long allocations = stats.hits + stats.misses;
+        Trace out(_initData.logger, _traceLevels->networkCat);
+        out << "message buffer cache: " << allocations << " allocations, " << stats.hits << " hits";
+        if(allocations > 0)
+        {
+            out << " (" << stats.hits * 100 / allocations << "%)";
+        }
+        out << ", " << stats.uncached << " uncached allocations, " << stats.cachedBytes << " cached bytes";
+    }
+
+    if(_compressorFactory && _traceLevels->network >= 2)
+    {
+        const vector<CompressorPtr>& compressors = _compressorFactory->getCompressors();
+        for(vector<CompressorPtr>::const_iterator p = compressors.begin(); p != compressors.end(); ++p)
+        {
+            Compressor::Stats stats = (*p)->getStats();
+            if(stats.compressed == 0 && stats.uncompressed == 0)
+            {
+                continue;
+            }
+
+            Trace out(_initData.logger, _traceLevels->networkCat);
+            out << (*p)->name() << " compression: " << stats.compressed << " messages compressed";
+            if(stats.compressed > 0)
+            {
+                out << " (" << stats.compressedIn << " to " << stats.compressedOut << " bytes, ratio "
+                    << static_cast<double>(stats.compressedIn) / static_cast<double>(stats.compressedOut) << ", "
+                    << stats.compressTime.toMicroSeconds() / stats.compressed << "us per message)";
+            }
+            out << ", " << stats.uncompressed << " messages uncompressed";
+            if(stats.uncompressed > 0)
+            {
+                out << " (" << stats.uncompressedIn << " bytes, "
+                    << stats.uncompressTime.toMicroSeconds() / stats.uncompressed << "us per message)";
+            }
+        }
+    }
+
     //
     // Destroy last so that a Logger plugin can receive all log/traces before its destruction.
     //
@@ -26,6 +26,8 @@
 #include <Ice/ReferenceFactoryF.h>
 #include <Ice/ProxyFactoryF.h>
 #include <Ice/ThreadPoolF.h>
+#include <Ice/BufferPoolF.h>
+#include <Ice/CompressorF.h>
 #include <Ice/ConnectionFactoryF.h>
 #include <Ice/ACM.h>
 #include <Ice/ValueFactoryManagerF.h>
@@ -42,6 +44,7 @@
 #include <Ice/FacetMap.h>
 #include <Ice/Process.h>
 #include <list>
+#include <set>
 #include <IceUtil/UniquePtr.h>
 
 namespace Ice
@@ -110,7 +113,12 @@ public:
     Ice::PluginManagerPtr pluginManager() const;
     size_t messageSizeMax() const { return _messageSizeMax; }
     size_t batchAutoFlushSize() const { return _batchAutoFlushSize; }
+    const IceUtil::Time& batchAutoFlushDelay() const { return _batchAutoFlushDelay; }
     bool collectObjects() const { return _collectObjects; }
+    const BufferPoolPtr& bufferPool() const { return _bufferPool; }
+    const CompressorFactoryPtr& compressorFactory() const { return _compressorFactory; }
+    const CompressorPtr& compressor() const { return _compressor; }
+    int compressionLevel() const { return _compressionLevel; }
     const ACMConfig& clientACM() const;
     const ACMConfig& serverACM() const;
     Ice::Identity stringToIdentity(const std::string&) const;
@@ -174,7 +182,12 @@ private:
     const DefaultsAndOverridesPtr _defaultsAndOverrides; // Immutable, not reset by destroy().
     const size_t _messageSizeMax; // Immutable, not reset by destroy().
     const size_t _batchAutoFlushSize; // Immutable, not reset by destroy().
+    const IceUtil::Time _batchAutoFlushDelay; // Immutable, not reset by destroy().
     const bool _collectObjects; // Immutable, not reset by destroy().
+    const BufferPoolPtr _bufferPool; // Immutable, not reset by destroy().
+    const CompressorFactoryPtr _compressorFactory; // Immutable, not reset by destroy().
+    const CompressorPtr _compressor; // Immutable, not reset by destroy().
+    const int _compressionLevel; // Immutable, not reset by destroy().
     ACMConfig _clientACM;
     ACMConfig _serverACM;
     RouterManagerPtr _routerManager;
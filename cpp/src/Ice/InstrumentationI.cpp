@@ -755,6 +755,110 @@ private:
 
 EndpointHelper::Attributes EndpointHelper::attributes;
 
+class CompressionHelper : public MetricsHelperT<CompressionMetrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<CompressionHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &CompressionHelper::getParent);
+            add("id", &CompressionHelper::getCodec);
+            add("codec", &CompressionHelper::getCodec);
+            add("operation", &CompressionHelper::getOperation);
+        }
+    };
+    static Attributes attributes;
+
+    CompressionHelper(const string& codec, bool compress) : _codec(codec), _compress(compress)
+    {
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+    string
+    getParent() const
+    {
+        return "Communicator";
+    }
+
+    const string&
+    getCodec() const
+    {
+        return _codec;
+    }
+
+    string
+    getOperation() const
+    {
+        return _compress ? "compress" : "uncompress";
+    }
+
+private:
+
+    const string& _codec;
+    const bool _compress;
+};
+
+CompressionHelper::Attributes CompressionHelper::attributes;
+
+class BufferPoolHelper : public MetricsHelperT<BufferPoolMetrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<BufferPoolHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &BufferPoolHelper::getParent);
+            add("id", &BufferPoolHelper::getSizeClass);
+            add("sizeClass", &BufferPoolHelper::getSizeClass);
+        }
+    };
+    static Attributes attributes;
+
+    BufferPoolHelper(size_t capacity) : _capacity(capacity)
+    {
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+    string
+    getParent() const
+    {
+        return "Communicator";
+    }
+
+    string
+    getSizeClass() const
+    {
+        if(_capacity == 0)
+        {
+            return "uncached";
+        }
+        ostringstream os;
+        os << _capacity;
+        return os.str();
+    }
+
+private:
+
+    const size_t _capacity;
+};
+
+BufferPoolHelper::Attributes BufferPoolHelper::attributes;
+
 }
 
 void
@@ -788,6 +892,26 @@ ThreadObserverI::stateChanged(ThreadState oldState, ThreadState newState)
 
 }
 
+void
+CompressionObserverI::sizes(Long uncompressedSize, Long compressedSize)
+{
+    forEach(add(&CompressionMetrics::uncompressedSize, uncompressedSize));
+    forEach(add(&CompressionMetrics::compressedSize, compressedSize));
+}
+
+void
+BufferPoolObserverI::allocated(bool hit)
+{
+    if(hit)
+    {
+        forEach(inc(&BufferPoolMetrics::hits));
+    }
+    else
+    {
+        forEach(inc(&BufferPoolMetrics::misses));
+    }
+}
+
 void
 DispatchObserverI::userException()
 {
@@ -899,7 +1023,9 @@ CommunicatorObserverI::CommunicatorObserverI(const InitializationData& initData)
     _invocations(_metrics, "Invocation"),
     _threads(_metrics, "Thread"),
     _connects(_metrics, "ConnectionEstablishment"),
-    _endpointLookups(_metrics, "EndpointLookup")
+    _endpointLookups(_metrics, "EndpointLookup"),
+    _compression(_metrics, "Compression"),
+    _bufferPool(_metrics, "BufferPool")
 {
     _invocations.registerSubMap<RemoteMetrics>("Remote", &InvocationMetrics::remotes);
     _invocations.registerSubMap<CollocatedMetrics>("Collocated", &InvocationMetrics::collocated);
@@ -1062,6 +1188,42 @@ CommunicatorObserverI::getDispatchObserver(const Current& current, int size)
     return ICE_NULLPTR;
 }
 
+CompressionObserverIPtr
+CommunicatorObserverI::getCompressionObserver(const string& codec, bool compress)
+{
+    if(_compression.isEnabled())
+    {
+        try
+        {
+            return _compression.getObserver(CompressionHelper(codec, compress));
+        }
+        catch(const exception& ex)
+        {
+            Error error(_metrics->getLogger());
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
+    }
+    return ICE_NULLPTR;
+}
+
+BufferPoolObserverIPtr
+CommunicatorObserverI::getBufferPoolObserver(size_t capacity)
+{
+    if(_bufferPool.isEnabled())
+    {
+        try
+        {
+            return _bufferPool.getObserver(BufferPoolHelper(capacity));
+        }
+        catch(const exception& ex)
+        {
+            Error error(_metrics->getLogger());
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
+    }
+    return ICE_NULLPTR;
+}
+
 const IceInternal::MetricsAdminIPtr&
 CommunicatorObserverI::getFacet() const
 {
@@ -1078,6 +1240,8 @@ CommunicatorObserverI::destroy()
     _threads.destroy();
     _connects.destroy();
     _endpointLookups.destroy();
+    _compression.destroy();
+    _bufferPool.destroy();
 
     _metrics->destroy();
 }
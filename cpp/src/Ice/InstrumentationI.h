@@ -209,6 +209,26 @@ public:
 
 typedef ObserverWithDelegateT<IceMX::Metrics, Ice::Instrumentation::Observer> ObserverI;
 
+//
+// The compression observer isn't part of the Instrumentation local
+// interfaces, it's only used to update the IceMX metrics.
+//
+class CompressionObserverI : public IceMX::ObserverT<IceMX::CompressionMetrics>
+{
+public:
+
+    void sizes(Ice::Long, Ice::Long);
+};
+ICE_DEFINE_PTR(CompressionObserverIPtr, CompressionObserverI);
+
+class BufferPoolObserverI : public IceMX::ObserverT<IceMX::BufferPoolMetrics>
+{
+public:
+
+    void allocated(bool);
+};
+ICE_DEFINE_PTR(BufferPoolObserverIPtr, BufferPoolObserverI);
+
 class ICE_API CommunicatorObserverI : public Ice::Instrumentation::CommunicatorObserver
 {
 public:
@@ -238,6 +258,19 @@ public:
 
     virtual Ice::Instrumentation::DispatchObserverPtr getDispatchObserver(const Ice::Current&, Ice::Int);
 
+    //
+    // Get an observer for the compression (if true) or uncompression
+    // of a message with the given codec.
+    //
+    CompressionObserverIPtr getCompressionObserver(const std::string&, bool);
+
+    //
+    // Get an observer for the allocation of a buffer of the given
+    // size class capacity from the buffer pool, 0 if the buffer is
+    // too large to be cached.
+    //
+    BufferPoolObserverIPtr getBufferPoolObserver(size_t);
+
     const IceInternal::MetricsAdminIPtr& getFacet() const;
 
     void destroy();
@@ -253,6 +286,8 @@ private:
     ObserverFactoryWithDelegateT<ThreadObserverI> _threads;
     ObserverFactoryWithDelegateT<ObserverI> _connects;
     ObserverFactoryWithDelegateT<ObserverI> _endpointLookups;
+    IceMX::ObserverFactoryT<CompressionObserverI> _compression;
+    IceMX::ObserverFactoryT<BufferPoolObserverI> _bufferPool;
 };
 ICE_DEFINE_PTR(CommunicatorObserverIPtr, CommunicatorObserverI);
 
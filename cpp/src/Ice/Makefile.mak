@@ -64,8 +64,10 @@ OBJS	       =  .\Acceptor.obj \
 		  .\BasicStream.obj \
 		  .\BatchRequestQueue.obj \
 		  .\Buffer.obj \
+		  .\BufferPool.obj \
 		  .\CollocatedRequestHandler.obj \
 		  .\CommunicatorI.obj \
+		  .\Compressor.obj \
 		  .\ConnectionFactory.obj \
 		  .\ConnectionI.obj \
 		  .\ConnectionRequestHandler.obj \
@@ -1981,6 +1981,36 @@ IceInternal::setReuseAddress(SOCKET fd, bool reuse)
 }
 #endif
 
+#ifdef ICE_OS_WINRT
+void
+IceInternal::setReusePort(SOCKET, bool)
+{
+}
+#else
+void
+IceInternal::setReusePort(SOCKET fd, bool reuse)
+{
+#ifdef SO_REUSEPORT
+    int flag = reuse ? 1 : 0;
+    if(setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<char*>(&flag), int(sizeof(int))) == SOCKET_ERROR)
+    {
+        closeSocketNoThrow(fd);
+        SocketException ex(__FILE__, __LINE__);
+        ex.error = getSocketErrno();
+        throw ex;
+    }
+#else
+    if(reuse)
+    {
+        closeSocketNoThrow(fd);
+        Ice::FeatureNotSupportedException ex(__FILE__, __LINE__);
+        ex.unsupportedFeature = "SO_REUSEPORT";
+        throw ex;
+    }
+#endif
+}
+#endif
+
 
 #ifdef ICE_OS_WINRT
 void
@@ -43,7 +43,9 @@ typedef int ssize_t;
 #   include <netdb.h>
 #endif
 
-#if defined(__linux) && !defined(ICE_NO_EPOLL)
+#if defined(__linux) && defined(ICE_USE_IO_URING)
+    // The io_uring selector is only used if explicitly requested
+#elif defined(__linux) && !defined(ICE_NO_EPOLL)
 #   define ICE_USE_EPOLL 1
 #elif (defined(__APPLE__) || defined(__FreeBSD__)) && TARGET_OS_IPHONE == 0 && !defined(ICE_NO_KQUEUE)
 #   define ICE_USE_KQUEUE 1
@@ -285,6 +287,7 @@ ICE_API void setMcastGroup(SOCKET, const Address&, const std::string&);
 ICE_API void setMcastInterface(SOCKET, const std::string&, const Address&);
 ICE_API void setMcastTtl(SOCKET, int, const Address&);
 ICE_API void setReuseAddress(SOCKET, bool);
+ICE_API void setReusePort(SOCKET, bool);
 
 ICE_API Address doBind(SOCKET, const Address&);
 
@@ -26,6 +26,7 @@
 #include <Ice/Locator.h>
 #include <Ice/LoggerUtil.h>
 #include <Ice/ThreadPool.h>
+#include <Ice/Compressor.h>
 #include <Ice/Communicator.h>
 #include <Ice/Router.h>
 #include <Ice/DefaultsAndOverrides.h>
@@ -681,16 +682,8 @@ Ice::ObjectAdapterI::getEndpoints() const
     IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(*this);
 
     EndpointSeq endpoints;
-    transform(_incomingConnectionFactories.begin(), _incomingConnectionFactories.end(),
-            back_inserter(endpoints), 
-#ifdef ICE_CPP11_MAPPING
-            [](const IncomingConnectionFactoryPtr& factory)
-            {
-                return factory->endpoint();
-            });
-#else
-            Ice::constMemFun(&IncomingConnectionFactory::endpoint));
-#endif
+    vector<EndpointIPtr> factoryEndpoints = getFactoryEndpoints();
+    copy(factoryEndpoints.begin(), factoryEndpoints.end(), back_inserter(endpoints));
     return endpoints;
 }
 
@@ -914,7 +907,9 @@ Ice::ObjectAdapterI::ObjectAdapterI(const InstancePtr& instance, const Communica
     _name(name),
     _directCount(0),
     _noConfig(noConfig),
-    _messageSizeMax(0)
+    _messageSizeMax(0),
+    _compressor(instance->compressor()),
+    _compressionLevel(instance->compressionLevel())
 {
 }
 
@@ -992,6 +987,22 @@ Ice::ObjectAdapterI::initialize(const RouterPrxPtr& router)
             }
         }
 
+        {
+            string codec = properties->getProperty(_name + ".Compression.Codec");
+            if(!codec.empty())
+            {
+                _compressor = _instance->compressorFactory()->getCompressor(codec);
+                if(!_compressor)
+                {
+                    InitializationException ex(__FILE__, __LINE__);
+                    ex.reason = "unsupported compression codec `" + codec + "' for object adapter `" + _name + "'";
+                    throw ex;
+                }
+            }
+            _compressionLevel = max(properties->getPropertyAsIntWithDefault(_name + ".Compression.Level",
+                                                                            _compressionLevel), 1);
+        }
+
         int threadPoolSize = properties->getPropertyAsInt(_name + ".ThreadPool.Size");
         int threadPoolSizeMax = properties->getPropertyAsInt(_name + ".ThreadPool.SizeMax");
         bool hasPriority = properties->getProperty(_name + ".ThreadPool.ThreadPriority") != "";
@@ -1057,11 +1068,35 @@ Ice::ObjectAdapterI::initialize(const RouterPrxPtr& router)
             // fill in the real port number.
             //
             vector<EndpointIPtr> endpoints = parseEndpoints(properties->getProperty(_name + ".Endpoints"), true);
+            int acceptors = properties->getPropertyAsIntWithDefault(_name + ".Acceptors", 1);
             for(vector<EndpointIPtr>::iterator p = endpoints.begin(); p != endpoints.end(); ++p)
             {
-                IncomingConnectionFactoryPtr factory = ICE_MAKE_SHARED(IncomingConnectionFactory, _instance, *p, ICE_SHARED_FROM_THIS);
-                 factory->initialize();
+                //
+                // With <adapter>.Acceptors > 1, additional acceptors are
+                // bound to the endpoint returned by the first factory (so
+                // that they share its port if it was system-assigned). The
+                // acceptors enable SO_REUSEPORT and the kernel distributes
+                // new connections between them. If the adapter thread pool
+                // is sharded, each acceptor and the connections it accepts
+                // are assigned to their own shard.
+                //
+                bool sharded = acceptors > 1 && !(*p)->datagram();
+                IncomingConnectionFactoryPtr factory = ICE_MAKE_SHARED(IncomingConnectionFactory, _instance, *p,
+                                                                       ICE_SHARED_FROM_THIS, sharded ? 0 : -1);
+                factory->initialize();
                 _incomingConnectionFactories.push_back(factory);
+
+                if(sharded)
+                {
+                    for(int i = 1; i < acceptors; ++i)
+                    {
+                        IncomingConnectionFactoryPtr f =
+                            ICE_MAKE_SHARED(IncomingConnectionFactory, _instance, factory->endpoint(),
+                                            ICE_SHARED_FROM_THIS, i);
+                        f->initialize();
+                        _incomingConnectionFactories.push_back(f);
+                    }
+                }
             }
 
             if(endpoints.empty())
@@ -1260,6 +1295,35 @@ Ice::ObjectAdapterI::parseEndpoints(const string& endpts, bool oaEndpoints) cons
     return endpoints;
 }
 
+std::vector<EndpointIPtr>
+ObjectAdapterI::getFactoryEndpoints() const
+{
+    //
+    // Return the endpoints of the incoming connection factories. The
+    // factories created for <adapter>.Acceptors share the endpoint of
+    // the first factory, only one of them is returned.
+    //
+    vector<EndpointIPtr> endpoints;
+    for(vector<IncomingConnectionFactoryPtr>::const_iterator p = _incomingConnectionFactories.begin();
+        p != _incomingConnectionFactories.end(); ++p)
+    {
+        EndpointIPtr endpoint = (*p)->endpoint();
+        vector<EndpointIPtr>::const_iterator q;
+        for(q = endpoints.begin(); q != endpoints.end(); ++q)
+        {
+            if(*endpoint == **q)
+            {
+                break;
+            }
+        }
+        if(q == endpoints.end())
+        {
+            endpoints.push_back(endpoint);
+        }
+    }
+    return endpoints;
+}
+
 std::vector<EndpointIPtr>
 ObjectAdapterI::parsePublishedEndpoints()
 {
@@ -1276,9 +1340,10 @@ ObjectAdapterI::parsePublishedEndpoints()
         // from the OA endpoints, expanding any endpoints that may be listening on INADDR_ANY
         // to include actual addresses in the published endpoints.
         //
-        for(unsigned int i = 0; i < _incomingConnectionFactories.size(); ++i)
+        vector<EndpointIPtr> factoryEndpoints = getFactoryEndpoints();
+        for(vector<EndpointIPtr>::const_iterator p = factoryEndpoints.begin(); p != factoryEndpoints.end(); ++p)
         {
-            vector<EndpointIPtr> endps = _incomingConnectionFactories[i]->endpoint()->expand();
+            vector<EndpointIPtr> endps = (*p)->expand();
             endpoints.insert(endpoints.end(), endps.begin(), endps.end());
         }
     }
@@ -1409,7 +1474,10 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "ACM.Close",
         "ACM.Heartbeat",
         "ACM.Timeout",
+        "Acceptors",
         "AdapterId",
+        "Compression.Codec",
+        "Compression.Level",
         "Endpoints",
         "Locator",
         "Locator.EncodingVersion",
@@ -1442,7 +1510,9 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "ThreadPool.SizeWarn",
         "ThreadPool.StackSize",
         "ThreadPool.Serialize",
-        "ThreadPool.ThreadPriority"
+        "ThreadPool.ThreadPriority",
+        "ThreadPool.Shards",
+        "ThreadPool.WorkStealing"
     };
 
     //
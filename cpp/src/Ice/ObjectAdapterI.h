@@ -25,6 +25,7 @@
 #include <Ice/EndpointIF.h>
 #include <Ice/LocatorInfoF.h>
 #include <Ice/ThreadPoolF.h>
+#include <Ice/CompressorF.h>
 #include <Ice/OutgoingAsyncF.h>
 #include <Ice/Exception.h>
 #include <Ice/BuiltinSequences.h>
@@ -101,6 +102,8 @@ public:
     IceInternal::ServantManagerPtr getServantManager() const;
     IceInternal::ACMConfig getACM() const;
     size_t messageSizeMax() const { return _messageSizeMax; }
+    const IceInternal::CompressorPtr& compressor() const { return _compressor; }
+    int compressionLevel() const { return _compressionLevel; }
 
     ObjectAdapterI(const IceInternal::InstancePtr&, const CommunicatorPtr&,
                    const IceInternal::ObjectAdapterFactoryPtr&, const std::string&, bool);
@@ -116,6 +119,7 @@ private:
     ObjectPrxPtr newIndirectProxy(const Identity&, const std::string&, const std::string&) const;
     void checkForDeactivation() const;
     std::vector<IceInternal::EndpointIPtr> parseEndpoints(const std::string&, bool) const;
+    std::vector<IceInternal::EndpointIPtr> getFactoryEndpoints() const;
     std::vector<IceInternal::EndpointIPtr> parsePublishedEndpoints();
     void updateLocatorRegistry(const IceInternal::LocatorInfoPtr&, const Ice::ObjectPrxPtr&);
     bool filterProperties(Ice::StringSeq&);
@@ -150,6 +154,8 @@ private:
     int _directCount; // The number of direct proxies dispatching on this object adapter.
     bool _noConfig;
     size_t _messageSizeMax;
+    IceInternal::CompressorPtr _compressor;
+    int _compressionLevel;
 };
 
 }
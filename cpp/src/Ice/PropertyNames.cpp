@@ -64,7 +64,12 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.Shards", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("Ice.Admin.MessageSizeMax", false, 0),
+    IceInternal::Property("Ice.Admin.Acceptors", false, 0),
+    IceInternal::Property("Ice.Admin.Compression.Codec", false, 0),
+    IceInternal::Property("Ice.Admin.Compression.Level", false, 0),
     IceInternal::Property("Ice.Admin.DelayCreation", false, 0),
     IceInternal::Property("Ice.Admin.Enabled", false, 0),
     IceInternal::Property("Ice.Admin.Facets", false, 0),
@@ -75,9 +80,11 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.ServerId", false, 0),
     IceInternal::Property("Ice.BackgroundLocatorCacheUpdates", false, 0),
     IceInternal::Property("Ice.BatchAutoFlush", true, 0),
+    IceInternal::Property("Ice.BatchAutoFlushDelay", false, 0),
     IceInternal::Property("Ice.BatchAutoFlushSize", false, 0),
     IceInternal::Property("Ice.ChangeUser", false, 0),
     IceInternal::Property("Ice.ClientAccessPolicyProtocol", false, 0),
+    IceInternal::Property("Ice.Compression.Codec", false, 0),
     IceInternal::Property("Ice.Compression.Level", false, 0),
     IceInternal::Property("Ice.CollectObjects", false, 0),
     IceInternal::Property("Ice.Config", false, 0),
@@ -154,6 +161,8 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Client.Serialize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.Shards", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.WorkStealing", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.Size", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.SizeMax", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.SizeWarn", false, 0),
@@ -161,7 +170,10 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Server.Serialize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.Shards", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.WorkStealing", false, 0),
     IceInternal::Property("Ice.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.TimerThreads", false, 0),
     IceInternal::Property("Ice.Trace.Admin.Properties", false, 0),
     IceInternal::Property("Ice.Trace.Admin.Logger", false, 0),
     IceInternal::Property("Ice.Trace.Locator", false, 0),
@@ -245,7 +257,12 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.MessageSizeMax", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Acceptors", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Compression.Codec", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Compression.Level", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ACM.Timeout", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ACM.Heartbeat", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ACM.Close", false, 0),
@@ -282,7 +299,12 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceDiscovery.Reply.MessageSizeMax", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Acceptors", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Compression.Codec", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Compression.Level", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ACM.Timeout", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ACM.Heartbeat", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ACM.Close", false, 0),
@@ -319,7 +341,12 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceDiscovery.Locator.MessageSizeMax", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Acceptors", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Compression.Codec", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Compression.Level", false, 0),
     IceInternal::Property("IceDiscovery.Lookup", false, 0),
     IceInternal::Property("IceDiscovery.Timeout", false, 0),
     IceInternal::Property("IceDiscovery.RetryCount", false, 0),
@@ -372,7 +399,12 @@ const IceInternal::Property IceGridDiscoveryPropsData[] =
     IceInternal::Property("IceGridDiscovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGridDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGridDiscovery.Reply.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGridDiscovery.Reply.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceGridDiscovery.Reply.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGridDiscovery.Reply.Acceptors", false, 0),
+    IceInternal::Property("IceGridDiscovery.Reply.Compression.Codec", false, 0),
+    IceInternal::Property("IceGridDiscovery.Reply.Compression.Level", false, 0),
     IceInternal::Property("IceGridDiscovery.Locator.ACM.Timeout", false, 0),
     IceInternal::Property("IceGridDiscovery.Locator.ACM.Heartbeat", false, 0),
     IceInternal::Property("IceGridDiscovery.Locator.ACM.Close", false, 0),
@@ -409,7 +441,12 @@ const IceInternal::Property IceGridDiscoveryPropsData[] =
     IceInternal::Property("IceGridDiscovery.Locator.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGridDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGridDiscovery.Locator.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGridDiscovery.Locator.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceGridDiscovery.Locator.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGridDiscovery.Locator.Acceptors", false, 0),
+    IceInternal::Property("IceGridDiscovery.Locator.Compression.Codec", false, 0),
+    IceInternal::Property("IceGridDiscovery.Locator.Compression.Level", false, 0),
     IceInternal::Property("IceGridDiscovery.Lookup", false, 0),
     IceInternal::Property("IceGridDiscovery.Timeout", false, 0),
     IceInternal::Property("IceGridDiscovery.RetryCount", false, 0),
@@ -516,7 +553,12 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Acceptors", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Compression.Codec", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Compression.Level", false, 0),
     IceInternal::Property("IceGridAdmin.Trace.Observers", false, 0),
     IceInternal::Property("IceGridAdmin.Trace.SaveToRegistry", false, 0),
 };
@@ -563,7 +605,12 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Acceptors", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Compression.Codec", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Compression.Level", false, 0),
     IceInternal::Property("IceGrid.InstanceName", false, 0),
     IceInternal::Property("IceGrid.Node.ACM.Timeout", false, 0),
     IceInternal::Property("IceGrid.Node.ACM.Heartbeat", false, 0),
@@ -601,7 +648,12 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceGrid.Node.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Node.Acceptors", false, 0),
+    IceInternal::Property("IceGrid.Node.Compression.Codec", false, 0),
+    IceInternal::Property("IceGrid.Node.Compression.Level", false, 0),
     IceInternal::Property("IceGrid.Node.AllowRunningServersAsRoot", false, 0),
     IceInternal::Property("IceGrid.Node.AllowEndpointsOverride", false, 0),
     IceInternal::Property("IceGrid.Node.CollocateRegistry", false, 0),
@@ -678,7 +730,12 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Acceptors", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Compression.Codec", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Compression.Level", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.ConnectionCached", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.PreferSecure", false, 0),
@@ -725,7 +782,12 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Acceptors", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Compression.Codec", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Compression.Level", false, 0),
     IceInternal::Property("IceGrid.Registry.CryptPasswords", false, 0),
     IceInternal::Property("IceGrid.Registry.DefaultTemplates", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ACM.Timeout", false, 0),
@@ -764,7 +826,12 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Acceptors", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Compression.Codec", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Compression.Level", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Enabled", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Address", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Port", false, 0),
@@ -806,7 +873,12 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Acceptors", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Compression.Codec", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Compression.Level", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.MapSize", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.Path", false, 0),
     IceInternal::Property("IceGrid.Registry.NodeSessionTimeout", false, 0),
@@ -860,7 +932,12 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Acceptors", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Compression.Codec", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Compression.Level", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionFilters", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ACM.Timeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ACM.Heartbeat", false, 0),
@@ -898,7 +975,12 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Acceptors", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Compression.Codec", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Compression.Level", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.ConnectionCached", false, 0),
@@ -967,7 +1049,12 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("IcePatch2.MessageSizeMax", false, 0),
+    IceInternal::Property("IcePatch2.Acceptors", false, 0),
+    IceInternal::Property("IcePatch2.Compression.Codec", false, 0),
+    IceInternal::Property("IcePatch2.Compression.Level", false, 0),
     IceInternal::Property("IcePatch2.Directory", false, 0),
     IceInternal::Property("IcePatch2.InstanceName", false, 0),
 };
@@ -1102,10 +1189,16 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.Shards", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("Glacier2.Client.MessageSizeMax", false, 0),
+    IceInternal::Property("Glacier2.Client.Acceptors", false, 0),
+    IceInternal::Property("Glacier2.Client.Compression.Codec", false, 0),
+    IceInternal::Property("Glacier2.Client.Compression.Level", false, 0),
     IceInternal::Property("Glacier2.Client.AlwaysBatch", false, 0),
     IceInternal::Property("Glacier2.Client.Buffered", false, 0),
     IceInternal::Property("Glacier2.Client.ForwardContext", false, 0),
+    IceInternal::Property("Glacier2.Client.FlushSize", false, 0),
     IceInternal::Property("Glacier2.Client.SleepTime", false, 0),
     IceInternal::Property("Glacier2.Client.Trace.Override", false, 0),
     IceInternal::Property("Glacier2.Client.Trace.Reject", false, 0),
@@ -1140,6 +1233,7 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.CollocationOptimized", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.Context.*", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier", false, 0),
+    IceInternal::Property("Glacier2.RoutingTable.MaxMemory", false, 0),
     IceInternal::Property("Glacier2.RoutingTable.MaxSize", false, 0),
     IceInternal::Property("Glacier2.Server.ACM.Timeout", false, 0),
     IceInternal::Property("Glacier2.Server.ACM.Heartbeat", false, 0),
@@ -1177,10 +1271,16 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.Shards", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.WorkStealing", false, 0),
     IceInternal::Property("Glacier2.Server.MessageSizeMax", false, 0),
+    IceInternal::Property("Glacier2.Server.Acceptors", false, 0),
+    IceInternal::Property("Glacier2.Server.Compression.Codec", false, 0),
+    IceInternal::Property("Glacier2.Server.Compression.Level", false, 0),
     IceInternal::Property("Glacier2.Server.AlwaysBatch", false, 0),
     IceInternal::Property("Glacier2.Server.Buffered", false, 0),
     IceInternal::Property("Glacier2.Server.ForwardContext", false, 0),
+    IceInternal::Property("Glacier2.Server.FlushSize", false, 0),
     IceInternal::Property("Glacier2.Server.SleepTime", false, 0),
     IceInternal::Property("Glacier2.Server.Trace.Override", false, 0),
     IceInternal::Property("Glacier2.Server.Trace.Request", false, 0),
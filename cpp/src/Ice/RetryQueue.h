@@ -19,6 +19,8 @@
 #include <Ice/RequestHandler.h> // For CancellationHandler
 #include <Ice/VirtualShared.h>
 
+#include <set>
+
 namespace IceInternal
 {
 
@@ -19,9 +19,55 @@
 #   include <CoreFoundation/CFStream.h>
 #endif
 
+#ifdef ICE_USE_IO_URING
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   include <signal.h>
+#endif
+
 using namespace std;
 using namespace IceInternal;
 
+#ifdef ICE_USE_IO_URING
+namespace
+{
+
+//
+// Reserved tokens for the interrupt pipe poll request and for poll
+// remove requests, the completions of the later are ignored.
+//
+const __u64 interruptToken = 0;
+const __u64 removeToken = ~static_cast<__u64>(0);
+
+//
+// Number of entries of the submission queue, the completion queue is
+// sized to hold several completions per submission.
+//
+const unsigned queueEntries = 1024;
+
+//
+// The poll events of a submission entry are stored as two swapped
+// 16-bit halves on big endian platforms.
+//
+__u32
+pollEvents(__u32 events)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return (events << 16) | (events >> 16);
+#else
+    return events;
+#endif
+}
+
+int
+ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags, void* arg, size_t argsz)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argsz));
+}
+
+}
+#endif
+
 #ifdef ICE_OS_WINRT
 //using namespace Windows::Foundation;
 using namespace Windows::Storage::Streams;
@@ -239,7 +285,8 @@ Selector::completed(EventHandler* handler, SocketOperation op)
 #endif
 }
 
-#elif defined(ICE_USE_KQUEUE) || defined(ICE_USE_EPOLL) || defined(ICE_USE_SELECT) || defined(ICE_USE_POLL)
+#elif defined(ICE_USE_KQUEUE) || defined(ICE_USE_EPOLL) || defined(ICE_USE_SELECT) || defined(ICE_USE_POLL) || \
+      defined(ICE_USE_IO_URING)
 
 Selector::Selector(const InstancePtr& instance) : _instance(instance), _interrupted(false)
 {
@@ -268,6 +315,88 @@ Selector::Selector(const InstancePtr& instance) : _instance(instance), _interrup
         Ice::Error out(_instance->initializationData().logger);
         out << "error while updating selector:\n" << IceUtilInternal::errorToString(IceInternal::getSocketErrno());
     }
+#elif defined(ICE_USE_IO_URING)
+    _events.resize(256);
+    _nextToken = interruptToken + 1;
+    _interruptArmed = false;
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(io_uring_params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = queueEntries * 4;
+    _queueFd = static_cast<int>(syscall(__NR_io_uring_setup, queueEntries, &params));
+    if(_queueFd < 0)
+    {
+        Ice::SocketException ex(__FILE__, __LINE__);
+        ex.error = IceInternal::getSocketErrno();
+        throw ex;
+    }
+
+    if(!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_NODROP))
+    {
+        closeSocket(_queueFd);
+        throw Ice::InitializationException(__FILE__, __LINE__, "io_uring selector not supported by this kernel");
+    }
+
+    _sqEntries = params.sq_entries;
+    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    _sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    if(params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        _sqRingSize = _cqRingSize = max(_sqRingSize, _cqRingSize);
+    }
+
+    _sqRing = mmap(0, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _queueFd, IORING_OFF_SQ_RING);
+    if(_sqRing == MAP_FAILED)
+    {
+        Ice::SocketException ex(__FILE__, __LINE__, IceInternal::getSocketErrno());
+        closeSocket(_queueFd);
+        throw ex;
+    }
+
+    if(params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        _cqRing = _sqRing;
+    }
+    else
+    {
+        _cqRing = mmap(0, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _queueFd,
+                       IORING_OFF_CQ_RING);
+        if(_cqRing == MAP_FAILED)
+        {
+            Ice::SocketException ex(__FILE__, __LINE__, IceInternal::getSocketErrno());
+            munmap(_sqRing, _sqRingSize);
+            closeSocket(_queueFd);
+            throw ex;
+        }
+    }
+
+    _sqes = static_cast<struct io_uring_sqe*>(mmap(0, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                                   _queueFd, IORING_OFF_SQES));
+    if(_sqes == MAP_FAILED)
+    {
+        Ice::SocketException ex(__FILE__, __LINE__, IceInternal::getSocketErrno());
+        if(_cqRing != _sqRing)
+        {
+            munmap(_cqRing, _cqRingSize);
+        }
+        munmap(_sqRing, _sqRingSize);
+        closeSocket(_queueFd);
+        throw ex;
+    }
+
+    char* sq = static_cast<char*>(_sqRing);
+    _sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    _sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    _sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    _sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    char* cq = static_cast<char*>(_cqRing);
+    _cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    _cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    _cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
 #elif defined(ICE_USE_KQUEUE)
     _events.resize(256);
     _queueFd = kqueue();
@@ -306,7 +435,16 @@ Selector::~Selector()
 void
 Selector::destroy()
 {
-#if defined(ICE_USE_KQUEUE) || defined(ICE_USE_EPOLL)
+#if defined(ICE_USE_IO_URING)
+    munmap(_sqes, _sqesSize);
+    if(_cqRing != _sqRing)
+    {
+        munmap(_cqRing, _cqRingSize);
+    }
+    munmap(_sqRing, _sqRingSize);
+#endif
+
+#if defined(ICE_USE_KQUEUE) || defined(ICE_USE_EPOLL) || defined(ICE_USE_IO_URING)
     try
     {
         closeSocket(_queueFd);
@@ -392,6 +530,8 @@ Selector::update(EventHandler* handler, SocketOperation remove, SocketOperation
         Ice::Error out(_instance->initializationData().logger);
         out << "error while updating selector:\n" << IceUtilInternal::errorToString(IceInternal::getSocketErrno());
     }
+#elif defined(ICE_USE_IO_URING)
+    arm(handler);
 #elif defined(ICE_USE_KQUEUE)
     SOCKET fd = nativeInfo->fd();
     if(remove & SocketOperationRead)
@@ -463,6 +603,8 @@ Selector::enable(EventHandler* handler, SocketOperation status)
             Ice::Error out(_instance->initializationData().logger);
             out << "error while updating selector:\n" << IceUtilInternal::errorToString(IceInternal::getSocketErrno());
         }
+#elif defined(ICE_USE_IO_URING)
+        arm(handler);
 #elif defined(ICE_USE_KQUEUE)
         struct kevent ev;
         SOCKET fd = handler->getNativeInfo()->fd();
@@ -510,6 +652,8 @@ Selector::disable(EventHandler* handler, SocketOperation status)
             Ice::Error out(_instance->initializationData().logger);
             out << "error while updating selector:\n" << IceUtilInternal::errorToString(IceInternal::getSocketErrno());
         }
+#elif defined(ICE_USE_IO_URING)
+        arm(handler);
 #elif defined(ICE_USE_KQUEUE)
         SOCKET fd = nativeInfo->fd();
         struct kevent ev;
@@ -532,12 +676,21 @@ Selector::finish(EventHandler* handler, bool closeNow)
     if(handler->_registered)
     {
         update(handler, handler->_registered, SocketOperationNone);
-#if !defined(ICE_USE_EPOLL) && !defined(ICE_USE_KQUEUE)
+#if !defined(ICE_USE_EPOLL) && !defined(ICE_USE_KQUEUE) && !defined(ICE_USE_IO_URING)
         return false; // Don't close now if selecting
 #endif
     }
 
-#if defined(ICE_USE_KQUEUE)
+#if defined(ICE_USE_IO_URING)
+    if(closeNow)
+    {
+        //
+        // Submit the poll remove request now if we're going to close
+        // the FD, the poll request otherwise holds on to the socket.
+        //
+        updateSelector();
+    }
+#elif defined(ICE_USE_KQUEUE)
     if(closeNow && !_changes.empty())
     {
         //
@@ -619,7 +772,30 @@ Selector::startSelect()
         _interrupted = false;
     }
 
-#if !defined(ICE_USE_EPOLL)
+#if defined(ICE_USE_IO_URING)
+    //
+    // Re-arm the handlers whose one-shot poll request completed. The
+    // requests are submitted with the wait for completions in select().
+    //
+    if(!_interruptArmed)
+    {
+        struct io_uring_sqe* sqe = getSqe();
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = _fdIntrRead;
+        sqe->poll32_events = pollEvents(POLLIN);
+        sqe->user_data = interruptToken;
+        _interruptArmed = true;
+    }
+    set<EventHandler*> rearm;
+    rearm.swap(_rearm); // arm() can update _rearm.
+    for(set<EventHandler*>::const_iterator p = rearm.begin(); p != rearm.end(); ++p)
+    {
+        if(_tokens.find(*p) == _tokens.end())
+        {
+            arm(*p);
+        }
+    }
+#elif !defined(ICE_USE_EPOLL)
     if(!_changes.empty())
     {
         updateSelector();
@@ -650,6 +826,8 @@ Selector::finishSelect(vector<pair<EventHandler*, SocketOperation> >& handlers)
 
 #if defined(ICE_USE_POLL)
     for(vector<struct pollfd>::const_iterator r = _pollFdSet.begin(); r != _pollFdSet.end(); ++r)
+#elif defined(ICE_USE_IO_URING)
+    for(int i = 0; i < _count; ++i)
 #else
     for(int i = 0; i < _count; ++i)
 #endif
@@ -663,6 +841,61 @@ Selector::finishSelect(vector<pair<EventHandler*, SocketOperation> >& handlers)
                                                  SocketOperationRead : SocketOperationNone) |
                                                 ((ev.events & (EPOLLOUT | EPOLLERR)) ?
                                                  SocketOperationWrite : SocketOperationNone));
+#elif defined(ICE_USE_IO_URING)
+        struct io_uring_cqe& ev = _events[i];
+        if(ev.user_data == removeToken)
+        {
+            continue;
+        }
+        else if(ev.user_data == interruptToken)
+        {
+            _interruptArmed = false;
+            continue;
+        }
+
+        map<__u64, EventHandler*>::iterator a = _armed.find(ev.user_data);
+        if(a == _armed.end())
+        {
+            continue; // Completion of a removed or replaced poll request.
+        }
+        p.first = a->second;
+        _tokens.erase(p.first);
+        _armed.erase(a);
+        _rearm.insert(p.first);
+
+        SocketOperation status = static_cast<SocketOperation>(p.first->_registered & ~p.first->_disabled);
+        if(ev.res == -ECANCELED)
+        {
+            continue;
+        }
+        else if(ev.res < 0)
+        {
+            //
+            // Report the handler ready, like epoll does for a socket
+            // error. The handler gets the error when it reads or writes
+            // and it isn't re-armed once it's unregistered.
+            //
+            Ice::Error out(_instance->initializationData().logger);
+            out << "selector returned error:\n" << IceUtilInternal::errorToString(-ev.res);
+            p.second = status;
+        }
+        else
+        {
+            p.second = static_cast<SocketOperation>(((ev.res & (POLLIN | POLLERR | POLLHUP)) ?
+                                                     SocketOperationRead : SocketOperationNone) |
+                                                    ((ev.res & (POLLOUT | POLLERR | POLLHUP)) ?
+                                                     SocketOperationWrite : SocketOperationNone));
+        }
+
+        //
+        // The request can watch operations which were disabled since
+        // it was submitted (see arm()).
+        //
+        p.second = static_cast<SocketOperation>(p.second & status);
+        if(!p.second)
+        {
+            continue;
+        }
 #elif defined(ICE_USE_KQUEUE)
         struct kevent& ev = _events[i];
         if(ev.flags & EV_ERROR)
@@ -777,6 +1010,66 @@ Selector::select(int timeout)
     {
 #if defined(ICE_USE_EPOLL)
         _count = epoll_wait(_queueFd, &_events[0], _events.size(), timeout);
+#elif defined(ICE_USE_IO_URING)
+        //
+        // Submit the pending poll requests and wait for completions
+        // with a single system call. There's no need to enter the
+        // kernel for a non-blocking select if there's nothing to
+        // submit.
+        //
+        //
+        // The kernel doesn't wait for completions if it submits less
+        // requests than requested, the number of pending requests must
+        // be exact. It can be off if another thread concurrently submits
+        // requests in which case we retry if no completions are
+        // available.
+        //
+        _count = 0;
+        bool timedOut = timeout == 0;
+        unsigned toSubmit = __atomic_load_n(_sqTail, __ATOMIC_ACQUIRE) - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+        if(timeout != 0 || toSubmit > 0)
+        {
+            struct __kernel_timespec ts;
+            ts.tv_sec = timeout / 1000;
+            ts.tv_nsec = (timeout % 1000) * 1000000;
+            struct io_uring_getevents_arg arg;
+            memset(&arg, 0, sizeof(io_uring_getevents_arg));
+            arg.sigmask_sz = _NSIG / 8;
+            arg.ts = timeout >= 0 ? reinterpret_cast<__u64>(&ts) : 0;
+            if(ioUringEnter(_queueFd, toSubmit, timeout != 0 ? 1 : 0, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                            &arg, sizeof(io_uring_getevents_arg)) == SOCKET_ERROR)
+            {
+                //
+                // ETIME is returned if the wait timed out and EBUSY if the
+                // completion queue overflowed, in both cases we retrieve the
+                // available completions.
+                //
+                int error = IceInternal::getSocketErrno();
+                if(error == ETIME)
+                {
+                    timedOut = true;
+                }
+                else if(error != EBUSY)
+                {
+                    _count = SOCKET_ERROR;
+                }
+            }
+        }
+        if(_count != SOCKET_ERROR)
+        {
+            unsigned head = *_cqHead;
+            unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+            while(head != tail && _count < static_cast<int>(_events.size()))
+            {
+                _events[_count++] = _cqes[head & *_cqMask];
+                ++head;
+            }
+            __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+            if(_count == 0 && !timedOut)
+            {
+                continue;
+            }
+        }
 #elif defined(ICE_USE_KQUEUE)
         assert(!_events.empty());
         if(timeout >= 0)
@@ -863,7 +1156,22 @@ Selector::checkReady(EventHandler* handler)
 void
 Selector::updateSelector()
 {
-#if defined(ICE_USE_KQUEUE)
+#if defined(ICE_USE_IO_URING)
+    if(__atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) == *_sqTail)
+    {
+        return;
+    }
+    while(ioUringEnter(_queueFd, _sqEntries, 0, 0, 0, 0) == SOCKET_ERROR)
+    {
+        if(interrupted())
+        {
+            continue;
+        }
+        Ice::Error out(_instance->initializationData().logger);
+        out << "error while updating selector:\n" << IceUtilInternal::errorToString(IceInternal::getSocketErrno());
+        break;
+    }
+#elif defined(ICE_USE_KQUEUE)
     int rs = kevent(_queueFd, &_changes[0], _changes.size(), 0, 0, 0);
     if(rs < 0)
     {
@@ -966,6 +1274,99 @@ Selector::updateSelector()
 #endif
 }
 
+#if defined(ICE_USE_IO_URING)
+
+struct io_uring_sqe*
+Selector::getSqe()
+{
+    //
+    // If the submission queue is full, submit the queued requests to
+    // make room for the new request.
+    //
+    unsigned tail = *_sqTail;
+    while(tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries)
+    {
+        updateSelector();
+    }
+
+    unsigned index = tail & *_sqMask;
+    struct io_uring_sqe* sqe = &_sqes[index];
+    memset(sqe, 0, sizeof(io_uring_sqe));
+    _sqArray[index] = index;
+    __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+    return sqe;
+}
+
+void
+Selector::arm(EventHandler* handler)
+{
+    SocketOperation status = static_cast<SocketOperation>(handler->_registered & ~handler->_disabled);
+
+    //
+    // Keep the current poll request of the handler if it watches all
+    // the operations the handler is now interested in. The thread pool
+    // disables and enables handlers while it processes them, this
+    // doesn't require replacing the request, the completions for
+    // disabled operations are filtered by finishSelect. The request is
+    // removed once the handler is unregistered.
+    //
+    map<EventHandler*, pair<__u64, SocketOperation> >::const_iterator p = _tokens.find(handler);
+    if(p != _tokens.end() && handler->_registered && (p->second.second & status) == status)
+    {
+        return;
+    }
+
+    //
+    // Otherwise, replace the current poll request of the handler, if
+    // any, with a request for the operations the handler is now
+    // interested in.
+    //
+    disarm(handler);
+
+    NativeInfoPtr nativeInfo = handler->getNativeInfo();
+    if(status && nativeInfo && nativeInfo->fd() != INVALID_SOCKET)
+    {
+        __u64 token = _nextToken++;
+        struct io_uring_sqe* sqe = getSqe();
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = nativeInfo->fd();
+        sqe->poll32_events = pollEvents((status & SocketOperationRead ? POLLIN : 0) |
+                                        (status & SocketOperationWrite ? POLLOUT : 0));
+        sqe->user_data = token;
+        _armed.insert(make_pair(token, handler));
+        _tokens.insert(make_pair(handler, make_pair(token, status)));
+    }
+    else
+    {
+        _rearm.erase(handler);
+    }
+
+    if(_selecting)
+    {
+        updateSelector();
+    }
+}
+
+void
+Selector::disarm(EventHandler* handler)
+{
+    map<EventHandler*, pair<__u64, SocketOperation> >::iterator p = _tokens.find(handler);
+    if(p == _tokens.end())
+    {
+        return;
+    }
+
+    struct io_uring_sqe* sqe = getSqe();
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = p->second.first;
+    sqe->user_data = removeToken;
+    _armed.erase(p->second.first);
+    _tokens.erase(p);
+}
+
+#endif
+
 #elif defined(ICE_USE_CFSTREAM)
 
 namespace
@@ -20,6 +20,9 @@
 
 #if defined(ICE_USE_EPOLL)
 #   include <sys/epoll.h>
+#elif defined(ICE_USE_IO_URING)
+#   include <linux/io_uring.h>
+#   include <set>
 #elif defined(ICE_USE_KQUEUE)
 #   include <sys/event.h>
 #elif defined(ICE_USE_IOCP)
@@ -109,7 +112,8 @@ private:
 #endif
 };
 
-#elif defined(ICE_USE_KQUEUE) || defined(ICE_USE_EPOLL) || defined(ICE_USE_SELECT) || defined(ICE_USE_POLL)
+#elif defined(ICE_USE_KQUEUE) || defined(ICE_USE_EPOLL) || defined(ICE_USE_SELECT) || defined(ICE_USE_POLL) || \
+      defined(ICE_USE_IO_URING)
 
 class Selector
 {
@@ -140,6 +144,11 @@ private:
     void wakeup();
     void checkReady(EventHandler*);
     void updateSelector();
+#if defined(ICE_USE_IO_URING)
+    struct io_uring_sqe* getSqe();
+    void arm(EventHandler*);
+    void disarm(EventHandler*);
+#endif
 
     const InstancePtr _instance;
 
@@ -154,6 +163,36 @@ private:
 #if defined(ICE_USE_EPOLL)
     std::vector<struct epoll_event> _events;
     int _queueFd;
+#elif defined(ICE_USE_IO_URING)
+    //
+    // The io_uring selector uses one-shot poll requests. A request is
+    // identified by a token, the handler is re-armed once its request
+    // completed. Completions for unknown tokens (requests which were
+    // removed or replaced) are ignored. The token of the request of
+    // a handler is stored with the operations it watches.
+    //
+    std::vector<struct io_uring_cqe> _events;
+    int _queueFd;
+    unsigned _sqEntries;
+    unsigned* _sqHead;
+    unsigned* _sqTail;
+    unsigned* _sqMask;
+    unsigned* _sqArray;
+    unsigned* _cqHead;
+    unsigned* _cqTail;
+    unsigned* _cqMask;
+    struct io_uring_cqe* _cqes;
+    struct io_uring_sqe* _sqes;
+    void* _sqRing;
+    size_t _sqRingSize;
+    void* _cqRing;
+    size_t _cqRingSize;
+    size_t _sqesSize;
+    __u64 _nextToken;
+    bool _interruptArmed;
+    std::map<__u64, EventHandler*> _armed;
+    std::map<EventHandler*, std::pair<__u64, SocketOperation> > _tokens;
+    std::set<EventHandler*> _rearm;
 #elif defined(ICE_USE_KQUEUE)
     std::vector<struct kevent> _events;
     std::vector<struct kevent> _changes;
@@ -238,6 +238,13 @@ InputStreamI::read(pair<const Byte*, const Byte*>& p)
 {
     _is->read(p);
 }
+
+void
+InputStreamI::read(ByteView& v)
+{
+    _is->read(v);
+}
+
 void
 InputStreamI::read(pair<const Short*, const Short*>& p, ::IceUtil::ScopedArray<Short>& result)
 {
@@ -86,6 +86,7 @@ public:
     virtual void read(std::vector<bool>&);
     virtual void read(std::pair<const bool*, const bool*>&, ::IceUtil::ScopedArray<bool>&);
     virtual void read(std::pair<const Byte*, const Byte*>&);
+    virtual void read(ByteView&);
     virtual void read(std::pair<const Short*, const Short*>&, ::IceUtil::ScopedArray<Short>&);
     virtual void read(std::pair<const Int*, const Int*>&, ::IceUtil::ScopedArray<Int>&);
     virtual void read(std::pair<const Long*, const Long*>&, ::IceUtil::ScopedArray<Long>&);
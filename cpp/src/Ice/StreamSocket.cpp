@@ -11,8 +11,24 @@
 #include <Ice/NetworkProxy.h>
 #include <Ice/ProtocolInstance.h>
 
+#ifndef _WIN32
+#   include <sys/uio.h>
+#endif
+
 using namespace IceInternal;
 
+#ifndef _WIN32
+namespace
+{
+
+//
+// Maximum number of buffers written with a single writev call.
+//
+const int maxIovecs = 64;
+
+}
+#endif
+
 StreamSocket::StreamSocket(const ProtocolInstancePtr& instance,
                            const NetworkProxyPtr& proxy,
                            const Address& addr,
@@ -182,6 +198,113 @@ StreamSocket::write(Buffer& buf)
     return buf.i != buf.b.end() ? SocketOperationWrite : SocketOperationNone;
 }
 
+SocketOperation
+StreamSocket::write(const std::vector<Buffer*>& buffers)
+{
+    std::vector<Buffer*>::const_iterator first = buffers.begin();
+#ifndef _WIN32
+    if(_state == StateConnected)
+    {
+        assert(_fd != INVALID_SOCKET);
+
+        //
+        // Write the buffers with writev to send them with a single
+        // system call, this is used to send queued messages together.
+        //
+        struct iovec iov[maxIovecs];
+        while(true)
+        {
+            while(first != buffers.end() && (*first)->i == (*first)->b.end())
+            {
+                ++first;
+            }
+            if(first == buffers.end())
+            {
+                return SocketOperationNone;
+            }
+
+            int count = 0;
+            for(std::vector<Buffer*>::const_iterator p = first; p != buffers.end() && count < maxIovecs; ++p)
+            {
+                if((*p)->i != (*p)->b.end())
+                {
+                    iov[count].iov_base = &*(*p)->i;
+                    iov[count].iov_len = (*p)->b.end() - (*p)->i;
+                    ++count;
+                }
+            }
+
+            ssize_t ret = ::writev(_fd, iov, count);
+            if(ret == 0)
+            {
+                Ice::ConnectionLostException ex(__FILE__, __LINE__);
+                ex.error = 0;
+                throw ex;
+            }
+            else if(ret == SOCKET_ERROR)
+            {
+                if(interrupted())
+                {
+                    continue;
+                }
+
+                if(noBuffers())
+                {
+                    break; // Fallback to writing the buffers one by one with a smaller packet size.
+                }
+
+                if(wouldBlock())
+                {
+                    return SocketOperationWrite;
+                }
+
+                if(connectionLost())
+                {
+                    Ice::ConnectionLostException ex(__FILE__, __LINE__);
+                    ex.error = getSocketErrno();
+                    throw ex;
+                }
+                else
+                {
+                    Ice::SocketException ex(__FILE__, __LINE__);
+                    ex.error = getSocketErrno();
+                    throw ex;
+                }
+            }
+
+            size_t sent = static_cast<size_t>(ret);
+            for(std::vector<Buffer*>::const_iterator p = first; p != buffers.end() && sent > 0; ++p)
+            {
+                size_t length = static_cast<size_t>((*p)->b.end() - (*p)->i);
+                if(sent >= length)
+                {
+                    (*p)->i = (*p)->b.end();
+                    sent -= length;
+                }
+                else
+                {
+                    (*p)->i += sent;
+                    sent = 0;
+                }
+            }
+        }
+    }
+#endif
+
+    for(std::vector<Buffer*>::const_iterator p = first; p != buffers.end(); ++p)
+    {
+        if((*p)->i != (*p)->b.end())
+        {
+            SocketOperation op = write(**p);
+            if(op)
+            {
+                return op;
+            }
+        }
+    }
+    return SocketOperationNone;
+}
+
 ssize_t
 StreamSocket::read(char* buf, size_t length)
 {
@@ -15,6 +15,8 @@
 #include <Ice/Buffer.h>
 #include <Ice/ProtocolInstanceF.h>
 
+#include <vector>
+
 namespace IceInternal
 {
 
@@ -35,6 +37,7 @@ public:
 
     SocketOperation read(Buffer&);
     SocketOperation write(Buffer&);
+    SocketOperation write(const std::vector<Buffer*>&);
 
     ssize_t read(char*, size_t);
     ssize_t write(const char*, size_t);
@@ -185,6 +185,7 @@ IceInternal::TcpAcceptor::effectivePort() const
 
 IceInternal::TcpAcceptor::TcpAcceptor(const TcpEndpointIPtr& endpoint,
                                       const ProtocolInstancePtr& instance,
+                                      const string& adapterName,
                                       const string& host,
                                       int port) :
     _endpoint(endpoint),
@@ -222,6 +223,17 @@ IceInternal::TcpAcceptor::TcpAcceptor(const TcpEndpointIPtr& endpoint,
     // versions (XP SP2, Windows Server 2003).
     //
     setReuseAddress(_fd, true);
+
+    //
+    // When the adapter is configured with several acceptors per
+    // endpoint, each acceptor binds its own listening socket to the
+    // same address and the kernel load balances incoming connections
+    // between them.
+    //
+    if(instance->properties()->getPropertyAsIntWithDefault(adapterName + ".Acceptors", 1) > 1)
+    {
+        setReusePort(_fd, true);
+    }
 #endif
 }
 
@@ -45,7 +45,7 @@ public:
 
 private:
 
-    TcpAcceptor(const TcpEndpointIPtr&, const ProtocolInstancePtr&, const std::string&, int);
+    TcpAcceptor(const TcpEndpointIPtr&, const ProtocolInstancePtr&, const std::string&, const std::string&, int);
     virtual ~TcpAcceptor();
     friend class TcpEndpointI;
 
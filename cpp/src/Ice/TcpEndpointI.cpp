@@ -130,9 +130,9 @@ IceInternal::TcpEndpointI::transceiver() const
 }
 
 AcceptorPtr
-IceInternal::TcpEndpointI::acceptor(const string&) const
+IceInternal::TcpEndpointI::acceptor(const string& adapterName) const
 {
-    return new TcpAcceptor(ICE_DYNAMIC_CAST(TcpEndpointI, shared_from_this()), _instance, _host, _port);
+    return new TcpAcceptor(ICE_DYNAMIC_CAST(TcpEndpointI, shared_from_this()), _instance, adapterName, _host, _port);
 }
 
 TcpEndpointIPtr
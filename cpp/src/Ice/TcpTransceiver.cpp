@@ -50,6 +50,12 @@ IceInternal::TcpTransceiver::write(Buffer& buf)
     return _stream->write(buf);
 }
 
+SocketOperation
+IceInternal::TcpTransceiver::writeBuffers(const vector<Buffer*>& buffers)
+{
+    return _stream->write(buffers);
+}
+
 SocketOperation
 IceInternal::TcpTransceiver::read(Buffer& buf)
 {
@@ -32,6 +32,7 @@ public:
     virtual SocketOperation closing(bool, const Ice::LocalException&);
     virtual void close();
     virtual SocketOperation write(Buffer&);
+    virtual SocketOperation writeBuffers(const std::vector<Buffer*>&);
     virtual SocketOperation read(Buffer&);
 #ifdef ICE_USE_IOCP
     virtual bool startWrite(Buffer&);
@@ -99,6 +99,20 @@ private:
     IceUtil::ThreadPtr _thread;
 };
 
+//
+// The stub work item of the work queue, it's never executed.
+//
+class StubWorkItem : public ThreadPoolWorkItem
+{
+public:
+
+    virtual void
+    execute(ThreadPoolCurrent&)
+    {
+        assert(false);
+    }
+};
+
 //
 // Exception raised by the thread pool work queue when the thread pool
 // is destroyed.
@@ -126,17 +140,41 @@ IceInternal::DispatchWorkItem::execute(ThreadPoolCurrent& current)
 
 IceInternal::ThreadPoolWorkQueue::ThreadPoolWorkQueue(ThreadPool& threadPool) :
     _threadPool(threadPool),
-    _destroyed(false)
+    _head(0),
+    _tail(0),
+    _stub(new StubWorkItem),
+    _waiting(0),
+    _pending(0),
+    _signaled(0),
+    _destroyed(0),
+    _producers(0)
 {
+    _head = _stub.get();
+    _tail = _stub.get();
     _registered = SocketOperationRead;
 }
 
+IceInternal::ThreadPoolWorkQueue::~ThreadPoolWorkQueue()
+{
+    //
+    // Release the work items which were queued after the thread pool
+    // threads terminated.
+    //
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+    ThreadPoolWorkItem* item = pop();
+    while(item)
+    {
+        item->__decRef();
+        item = pop();
+    }
+}
+
 void
 IceInternal::ThreadPoolWorkQueue::destroy()
 {
     //Lock sync(*this); Called with the thread pool locked
-    assert(!_destroyed);
-    _destroyed = true;
+    assert(_destroyed == 0);
+    _destroyed.exchange(1);
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
     _threadPool._selector.completed(this, SocketOperationRead);
 #else
@@ -148,17 +186,50 @@ void
 IceInternal::ThreadPoolWorkQueue::queue(const ThreadPoolWorkItemPtr& item)
 {
     //Lock sync(*this); Called with the thread pool locked
-    _workItems.push_back(item);
+    enqueue(item);
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
     _threadPool._selector.completed(this, SocketOperationRead);
 #else
-    if(_workItems.size() == 1)
+    if(signal())
     {
         _threadPool._selector.ready(this, SocketOperationRead, true);
     }
 #endif
 }
 
+void
+IceInternal::ThreadPoolWorkQueue::dispatch(const ThreadPoolWorkItemPtr& item)
+{
+    //
+    // The producer count prevents the thread pool threads from
+    // terminating while the work item is being queued.
+    //
+    ++_producers;
+    if(_destroyed > 0)
+    {
+        --_producers;
+        throw CommunicatorDestroyedException(__FILE__, __LINE__);
+    }
+    enqueue(item);
+    --_producers;
+
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
+    _threadPool._selector.completed(this, SocketOperationRead);
+#else
+    if(signal())
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_threadPool);
+        _threadPool._selector.ready(this, SocketOperationRead, true);
+    }
+#endif
+}
+
+bool
+IceInternal::ThreadPoolWorkQueue::pending() const
+{
+    return _pending > 0;
+}
+
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
 bool
 IceInternal::ThreadPoolWorkQueue::startAsync(SocketOperation)
@@ -178,37 +249,84 @@ IceInternal::ThreadPoolWorkQueue::finishAsync(SocketOperation)
 void
 IceInternal::ThreadPoolWorkQueue::message(ThreadPoolCurrent& current)
 {
-    ThreadPoolWorkItemPtr workItem;
+    const int maxSpins = 16;
+    ThreadPoolWorkItem* item;
+    bool drained;
+    int spins = 0;
+    while(true)
     {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_threadPool);
-        if(!_workItems.empty())
         {
-            workItem = _workItems.front();
-            _workItems.pop_front();
-        }
-#if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
-        else
-        {
-            assert(_destroyed);
-            _threadPool._selector.completed(this, SocketOperationRead);
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+            item = pop();
+            drained = empty();
+            if(!item && !drained && ++spins > maxSpins)
+            {
+                //
+                // The producer of the next work item was preempted
+                // before linking it, wait for the producer to notify.
+                // _waiting is incremented before checking the queue
+                // again so that the producer can't miss this thread.
+                //
+                ++_waiting;
+                item = pop();
+                drained = empty();
+                while(!item && !drained)
+                {
+                    _monitor.wait();
+                    item = pop();
+                    drained = empty();
+                }
+                --_waiting;
+            }
         }
-#else
-        if(_workItems.empty() && !_destroyed)
+        if(item || drained)
         {
-            _threadPool._selector.ready(this, SocketOperationRead, false);
+            break;
         }
-#endif
+
+        //
+        // The next work item is still being linked by its producer.
+        //
+        IceUtil::ThreadControl::yield();
+    }
+
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_WINRT)
+    if(drained && _destroyed == 0)
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_threadPool);
+        unsignal();
     }
+#endif
 
-    if(workItem)
+    if(item)
     {
+        --_pending;
+        ThreadPoolWorkItemPtr workItem = item;
+        item->__decRef(); // Release the reference of the work queue.
         workItem->execute(current);
+        return;
     }
-    else
+
+    if(_destroyed > 0)
     {
-        assert(_destroyed);
-        current.ioCompleted();
-        throw ThreadPoolDestroyedException();
+        bool terminate = false;
+        if(_producers == 0)
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+            terminate = empty();
+        }
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
+        //
+        // Post the completion again for the next thread, either to
+        // terminate it or to wait for the work items being queued.
+        //
+        _threadPool._selector.completed(this, SocketOperationRead);
+#endif
+        if(terminate)
+        {
+            current.ioCompleted();
+            throw ThreadPoolDestroyedException();
+        }
     }
 }
 
@@ -230,7 +348,122 @@ IceInternal::ThreadPoolWorkQueue::getNativeInfo()
     return 0;
 }
 
-IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& prefix, int timeout) :
+void
+IceInternal::ThreadPoolWorkQueue::enqueue(const ThreadPoolWorkItemPtr& item)
+{
+    item->__incRef(); // Released by message() once the work item is removed.
+    ++_pending;
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+    push(item.get());
+    if(_waiting > 0)
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+        _monitor.notifyAll();
+    }
+#else
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+    push(item.get());
+#endif
+}
+
+void
+IceInternal::ThreadPoolWorkQueue::push(ThreadPoolWorkItem* item)
+{
+    //
+    // Called with _monitor locked if C++11 atomics aren't available.
+    //
+    item->_next = 0;
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+    ThreadPoolWorkItem* prev = _head.exchange(item);
+#else
+    ThreadPoolWorkItem* prev = _head;
+    _head = item;
+#endif
+    prev->_next = item;
+}
+
+ThreadPoolWorkItem*
+IceInternal::ThreadPoolWorkQueue::pop()
+{
+    //
+    // Called with _monitor locked. Returns 0 if the queue is empty or
+    // if the next work item isn't linked yet.
+    //
+    ThreadPoolWorkItem* tail = _tail;
+    ThreadPoolWorkItem* next = tail->_next;
+    if(tail == _stub.get())
+    {
+        if(!next)
+        {
+            return 0;
+        }
+        _tail = next;
+        tail = next;
+        next = next->_next;
+    }
+
+    if(next)
+    {
+        _tail = next;
+        return tail;
+    }
+
+    if(tail != _head)
+    {
+        return 0;
+    }
+
+    //
+    // Re-queue the stub to remove the last work item.
+    //
+    push(_stub.get());
+    next = tail->_next;
+    if(next)
+    {
+        _tail = next;
+        return tail;
+    }
+    return 0;
+}
+
+bool
+IceInternal::ThreadPoolWorkQueue::empty() const
+{
+    //
+    // Called with _monitor locked.
+    //
+    return _tail == _stub.get() && _head == _stub.get();
+}
+
+bool
+IceInternal::ThreadPoolWorkQueue::signal()
+{
+    //
+    // Returns true if the caller must mark the work queue as ready
+    // with the selector.
+    //
+    return _signaled.exchange(1) == 0;
+}
+
+void
+IceInternal::ThreadPoolWorkQueue::unsignal()
+{
+    //
+    // Called with the thread pool locked.
+    //
+    _signaled.exchange(0);
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+    if(empty() && _destroyed == 0)
+    {
+        _threadPool._selector.ready(this, SocketOperationRead, false);
+    }
+    else
+    {
+        _signaled.exchange(1);
+    }
+}
+
+IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& prefix, int timeout, ThreadPool* parent) :
     _instance(instance),
     _dispatcher(_instance->initializationData().dispatcher),
     _destroyed(false),
@@ -252,7 +485,13 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
     _inUseIO(0),
     _nextHandler(_handlers.end()),
 #endif
-    _promote(true)
+    _promote(true),
+    _parent(parent),
+    _shard(parent ? static_cast<int>(parent->_shards.size()) : 0),
+    _nextShard(0),
+    _workStealing(!_serialize &&
+                  _instance->initializationData().properties->getPropertyAsInt(_prefix + ".WorkStealing") > 0),
+    _idle(false)
 {
     PropertiesPtr properties = _instance->initializationData().properties;
 #ifndef ICE_OS_WINRT
@@ -345,14 +584,55 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
         const_cast<int&>(_priority) = properties->getPropertyAsInt("Ice.ThreadPriority");
     }
 
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_WINRT)
+    if(!_parent)
+    {
+        int shards = properties->getPropertyAsIntWithDefault(_prefix + ".Shards", 1);
+        if(shards == -1)
+        {
+            shards = nProcessors;
+        }
+        if(shards > 1)
+        {
+            if(_instance->traceLevels()->threadPool >= 1)
+            {
+                Trace out(_instance->initializationData().logger, _instance->traceLevels()->threadPoolCat);
+                out << "creating " << _prefix << ": Shards = " << shards;
+            }
+
+            //
+            // The Size, SizeMax and SizeWarn properties apply to each shard.
+            //
+            try
+            {
+                for(int i = 0; i < shards; ++i)
+                {
+                    _shards.push_back(new ThreadPool(_instance, _prefix, timeout, this));
+                }
+            }
+            catch(...)
+            {
+                destroy();
+                joinWithAllThreads();
+                throw;
+            }
+            return;
+        }
+    }
+#endif
+
     _workQueue = ICE_MAKE_SHARED(ThreadPoolWorkQueue, *this);
     _selector.initialize(_workQueue.get());
 
     if(_instance->traceLevels()->threadPool >= 1)
     {
         Trace out(_instance->initializationData().logger, _instance->traceLevels()->threadPoolCat);
-        out << "creating " << _prefix << ": Size = " << _size << ", SizeMax = " << _sizeMax << ", SizeWarn = "
-            << _sizeWarn;
+        out << "creating " << _prefix;
+        if(_parent)
+        {
+            out << " shard " << _shard;
+        }
+        out << ": Size = " << _size << ", SizeMax = " << _sizeMax << ", SizeWarn = " << _sizeWarn;
     }
 
     __setNoDelete(true);
@@ -406,12 +686,25 @@ IceInternal::ThreadPool::destroy()
         return;
     }
     _destroyed = true;
+    if(!_shards.empty())
+    {
+        for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+        {
+            (*p)->destroy();
+        }
+        return;
+    }
     _workQueue->destroy();
 }
 
 void
 IceInternal::ThreadPool::updateObservers()
 {
+    for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        (*p)->updateObservers();
+    }
+
     Lock sync(*this);
     for(set<EventHandlerThreadPtr>::iterator p = _threads.begin(); p != _threads.end(); ++p)
     {
@@ -420,10 +713,28 @@ IceInternal::ThreadPool::updateObservers()
 }
 
 void
-IceInternal::ThreadPool::initialize(const EventHandlerPtr& handler)
+IceInternal::ThreadPool::initialize(const EventHandlerPtr& handler, int shard)
 {
     Lock sync(*this);
     assert(!_destroyed);
+    if(!_shards.empty())
+    {
+        //
+        // Assign the handler to the given shard or, if none is given,
+        // to the next shard. All the subsequent calls for this handler
+        // are forwarded to this shard.
+        //
+        if(shard >= 0)
+        {
+            handler->_shard = static_cast<unsigned int>(shard) % _shards.size();
+        }
+        else
+        {
+            handler->_shard = static_cast<unsigned int>(_nextShard++) % _shards.size();
+        }
+        _shards[handler->_shard]->initialize(handler);
+        return;
+    }
     _selector.initialize(handler.get());
 
     class ReadyCallbackI : public ReadyCallback
@@ -452,6 +763,12 @@ IceInternal::ThreadPool::initialize(const EventHandlerPtr& handler)
 void
 IceInternal::ThreadPool::update(const EventHandlerPtr& handler, SocketOperation remove, SocketOperation add)
 {
+    if(!_shards.empty())
+    {
+        shard(handler)->update(handler, remove, add);
+        return;
+    }
+
     Lock sync(*this);
     assert(!_destroyed);
 
@@ -472,6 +789,11 @@ IceInternal::ThreadPool::update(const EventHandlerPtr& handler, SocketOperation
 bool
 IceInternal::ThreadPool::finish(const EventHandlerPtr& handler, bool closeNow)
 {
+    if(!_shards.empty())
+    {
+        return shard(handler)->finish(handler, closeNow);
+    }
+
     Lock sync(*this);
     assert(!_destroyed);
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_WINRT)
@@ -496,6 +818,12 @@ IceInternal::ThreadPool::finish(const EventHandlerPtr& handler, bool closeNow)
 void
 IceInternal::ThreadPool::ready(const EventHandlerPtr& handler, SocketOperation op, bool value)
 {
+    if(!_shards.empty())
+    {
+        shard(handler)->ready(handler, op, value);
+        return;
+    }
+
     Lock sync(*this);
     if(_destroyed)
     {
@@ -547,12 +875,45 @@ IceInternal::ThreadPool::dispatchFromThisThread(const DispatchWorkItemPtr& workI
 void
 IceInternal::ThreadPool::dispatch(const DispatchWorkItemPtr& workItem)
 {
-    Lock sync(*this);
-    if(_destroyed)
+    if(!_shards.empty())
     {
-        throw CommunicatorDestroyedException(__FILE__, __LINE__);
+        //
+        // Dispatch the work item with the shard of its connection to
+        // keep the connection state on the same threads. Work items
+        // without a connection are assigned in turn to the shards.
+        //
+        ThreadPool* threadPool;
+        EventHandler* handler = dynamic_cast<EventHandler*>(workItem->getConnection().get());
+        if(handler)
+        {
+            threadPool = _shards[handler->_shard % _shards.size()].get();
+        }
+        else
+        {
+            threadPool = _shards[static_cast<unsigned int>(_nextShard++) % _shards.size()].get();
+        }
+
+        //
+        // With work stealing enabled, the work item is instead given
+        // to the first shard that can execute it right away if the
+        // shard of the connection is busy.
+        //
+        if(_workStealing && threadPool->saturated())
+        {
+            for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+            {
+                if(p->get() != threadPool && !(*p)->saturated())
+                {
+                    threadPool = p->get();
+                    break;
+                }
+            }
+        }
+        threadPool->dispatch(workItem);
+        return;
     }
-    _workQueue->queue(workItem);
+
+    _workQueue->dispatch(workItem);
 }
 
 void
@@ -566,6 +927,10 @@ IceInternal::ThreadPool::joinWithAllThreads()
     // wouldn't be possible here anyway, because otherwise the other
     // threads would never terminate.)
     //
+    for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        (*p)->joinWithAllThreads();
+    }
     for(set<EventHandlerThreadPtr>::iterator p = _threads.begin(); p != _threads.end(); ++p)
     {
         (*p)->getThreadControl().join();
@@ -617,6 +982,21 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
             }
             catch(const SelectorTimeoutException&)
             {
+                if(_parent)
+                {
+                    //
+                    // Only shutdown if all the shards are idle.
+                    //
+                    {
+                        Lock sync(*this);
+                        _idle = _inUse == 0;
+                    }
+                    if(!_parent->idle())
+                    {
+                        continue;
+                    }
+                }
+
                 Lock sync(*this);
                 if(!_destroyed && _inUse == 0)
                 {
@@ -634,6 +1014,7 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
                 {
                     _selector.finishSelect(_handlers);
                     _nextHandler = _handlers.begin();
+                    _idle = _idle && _handlers.empty();
                     select = false;
                 }
                 else if(!current._leader && followerWait(current))
@@ -1133,10 +1514,51 @@ string
 IceInternal::ThreadPool::nextThreadId()
 {
     ostringstream os;
-    os << _prefix << "-" << _nextThreadId++;
+    os << _prefix << "-";
+    if(_parent)
+    {
+        os << _shard << "-";
+    }
+    os << _nextThreadId++;
     return os.str();
 }
 
+ThreadPool*
+IceInternal::ThreadPool::shard(const EventHandlerPtr& handler) const
+{
+    assert(handler->_shard < _shards.size());
+    return _shards[handler->_shard].get();
+}
+
+bool
+IceInternal::ThreadPool::idle()
+{
+    //
+    // Called by a shard without its mutex locked, the shard mutexes
+    // are locked one at a time.
+    //
+    for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        Lock sync(**p);
+        if(!(*p)->_idle || (*p)->_inUse > 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+IceInternal::ThreadPool::saturated()
+{
+    //
+    // Called for each work item dispatched with work stealing, don't
+    // lock the shard: _inUse and the pending count of the work queue
+    // are atomic. A destroyed shard raises when dispatching to it.
+    //
+    return (_sizeMax > 1 && _inUse >= _sizeMax) || _workQueue->pending();
+}
+
 IceInternal::ThreadPool::EventHandlerThread::EventHandlerThread(const ThreadPoolPtr& pool, const string& name) :
     IceUtil::Thread(name),
     _pool(pool),
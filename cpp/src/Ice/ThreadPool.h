@@ -14,6 +14,7 @@
 #include <IceUtil/Mutex.h>
 #include <IceUtil/Monitor.h>
 #include <IceUtil/Thread.h>
+#include <IceUtil/Atomic.h>
 
 #include <Ice/Config.h>
 #include <Ice/Dispatcher.h>
@@ -41,7 +42,24 @@ class ThreadPoolWorkItem : virtual public IceUtil::Shared
 {
 public:
 
+    ThreadPoolWorkItem() : _next(0)
+    {
+    }
+
     virtual void execute(ThreadPoolCurrent&) = 0;
+
+private:
+
+    //
+    // Link to the next work item of the work queue, a work item can
+    // only be queued once at a time.
+    //
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+    std::atomic<ThreadPoolWorkItem*> _next;
+#else
+    ThreadPoolWorkItem* _next;
+#endif
+    friend class ThreadPoolWorkQueue;
 };
 typedef IceUtil::Handle<ThreadPoolWorkItem> ThreadPoolWorkItemPtr;
 
@@ -88,14 +106,14 @@ class ThreadPool : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mut
 
 public:
 
-    ThreadPool(const InstancePtr&, const std::string&, int);
+    ThreadPool(const InstancePtr&, const std::string&, int, ThreadPool* = 0);
     virtual ~ThreadPool();
 
     void destroy();
 
     void updateObservers();
 
-    void initialize(const EventHandlerPtr&);
+    void initialize(const EventHandlerPtr&, int = -1);
     void _register(const EventHandlerPtr& handler, SocketOperation status)
     {
         update(handler, SocketOperationNone, status);
@@ -131,6 +149,10 @@ private:
 
     std::string nextThreadId();
 
+    ThreadPool* shard(const EventHandlerPtr&) const;
+    bool idle();
+    bool saturated();
+
     const InstancePtr _instance;
 #ifdef ICE_CPP11_MAPPING
     std::function<void (std::function<void ()>, const std::shared_ptr<Ice::Connection>&)> _dispatcher;
@@ -159,7 +181,7 @@ private:
     const size_t _stackSize;
 
     std::set<EventHandlerThreadPtr> _threads; // All threads, running or not.
-    int _inUse; // Number of threads that are currently in use.
+    IceUtilInternal::Atomic _inUse; // Number of threads that are currently in use, read by saturated().
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_WINRT)
     int _inUseIO; // Number of threads that are currently performing IO.
     std::vector<std::pair<EventHandler*, SocketOperation> > _handlers;
@@ -167,6 +189,20 @@ private:
 #endif
 
     bool _promote;
+
+    //
+    // With <prefix>.Shards > 1, the thread pool doesn't create any
+    // threads. It instead creates the given number of shards, each
+    // with its own selector, threads and mutex, and forwards the
+    // event handlers to them. An event handler remains with the
+    // same shard until it's finished.
+    //
+    ThreadPool* const _parent;
+    const int _shard;
+    std::vector<ThreadPoolPtr> _shards;
+    IceUtilInternal::Atomic _nextShard;
+    const bool _workStealing;
+    bool _idle;
 };
 
 class ThreadPoolCurrent
@@ -225,10 +261,23 @@ class ThreadPoolWorkQueue : public EventHandler
 public:
 
     ThreadPoolWorkQueue(ThreadPool&);
+    virtual ~ThreadPoolWorkQueue();
 
     void destroy();
+
+    //
+    // Queue a work item, called with the thread pool locked.
+    //
     void queue(const ThreadPoolWorkItemPtr&);
 
+    //
+    // Queue a work item without the thread pool locked, raises
+    // CommunicatorDestroyedException if the work queue is destroyed.
+    //
+    void dispatch(const ThreadPoolWorkItemPtr&);
+
+    bool pending() const;
+
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
     bool startAsync(SocketOperation);
     bool finishAsync(SocketOperation);
@@ -241,9 +290,40 @@ public:
 
 private:
 
+    void enqueue(const ThreadPoolWorkItemPtr&);
+    void push(ThreadPoolWorkItem*);
+    ThreadPoolWorkItem* pop();
+    bool empty() const;
+    bool signal();
+    void unsignal();
+
     ThreadPool& _threadPool;
-    bool _destroyed;
-    std::list<ThreadPoolWorkItemPtr> _workItems;
+
+    //
+    // The work items are queued in an intrusive multi-producer queue:
+    // producers append work items to _head with an atomic exchange
+    // and the thread pool threads remove them from _tail, one at a
+    // time with _monitor locked. A thread which finds the next work
+    // item not linked yet by its producer spins for a few iterations
+    // and then waits, producers notify the waiting threads once the
+    // work item is linked. _signaled is set once the work queue
+    // is marked ready with the selector and is only reset once the
+    // queue is empty, the thread pool mutex is therefore only locked
+    // by the producer which queues the first work item.
+    //
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+    std::atomic<ThreadPoolWorkItem*> _head;
+#else
+    ThreadPoolWorkItem* _head;
+#endif
+    ThreadPoolWorkItem* _tail;
+    ThreadPoolWorkItemPtr _stub;
+    mutable IceUtil::Monitor<IceUtil::Mutex> _monitor;
+    IceUtilInternal::Atomic _waiting; // Number of threads waiting for a work item to be linked.
+    IceUtilInternal::Atomic _pending; // Number of queued work items.
+    IceUtilInternal::Atomic _signaled;
+    IceUtilInternal::Atomic _destroyed;
+    IceUtilInternal::Atomic _producers; // Number of dispatch() calls in progress.
 };
 
 //
@@ -152,30 +152,60 @@ printHeader(ostream& s, BasicStream& stream)
     stream.read(compress);
     s << "\ncompression status = "  << static_cast<int>(compress) << ' ';
 
-    switch(compress)
+    if(type == validateConnectionMsg)
     {
-        case 0:
+        //
+        // The compression status of the validate connection message
+        // advertises the codecs supported in addition to bzip2.
+        //
+        if(compress & (1 << 3))
         {
-            s << "(not compressed; do not compress response, if any)";
-            break;
+            s << "(LZ4 supported)";
         }
-
-        case 1:
+        if(compress & (1 << 4))
         {
-            s << "(not compressed; compress response, if any)";
-            break;
-        }
-
-        case 2:
-        {
-            s << "(compressed; compress response, if any)";
-            break;
+            s << "(zstd supported)";
         }
-
-        default:
+    }
+    else
+    {
+        switch(compress)
         {
-            s << "(unknown)";
-            break;
+            case 0:
+            {
+                s << "(not compressed; do not compress response, if any)";
+                break;
+            }
+
+            case 1:
+            {
+                s << "(not compressed; compress response, if any)";
+                break;
+            }
+
+            case 2:
+            {
+                s << "(compressed; compress response, if any)";
+                break;
+            }
+
+            case 3:
+            {
+                s << "(compressed with LZ4; compress response, if any)";
+                break;
+            }
+
+            case 4:
+            {
+                s << "(compressed with zstd; compress response, if any)";
+                break;
+            }
+
+            default:
+            {
+                s << "(unknown)";
+                break;
+            }
         }
     }
 
@@ -8,6 +8,7 @@
 // **********************************************************************
 
 #include <Ice/Transceiver.h>
+#include <Ice/Buffer.h>
 
 using namespace std;
 using namespace Ice;
@@ -22,3 +23,24 @@ IceInternal::Transceiver::bind()
     return 0;
 }
 
+SocketOperation
+IceInternal::Transceiver::writeBuffers(const vector<Buffer*>& buffers)
+{
+    //
+    // Write the buffers one after the other, transceivers which can
+    // write several buffers at once override this method.
+    //
+    for(vector<Buffer*>::const_iterator p = buffers.begin(); p != buffers.end(); ++p)
+    {
+        if((*p)->i != (*p)->b.end())
+        {
+            SocketOperation op = write(**p);
+            if(op)
+            {
+                return op;
+            }
+        }
+    }
+    return SocketOperationNone;
+}
+
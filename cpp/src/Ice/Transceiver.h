@@ -16,6 +16,8 @@
 #include <Ice/EndpointIF.h>
 #include <Ice/Network.h>
 
+#include <vector>
+
 namespace IceInternal
 {
 
@@ -32,6 +34,7 @@ public:
     virtual void close() = 0;
     virtual EndpointIPtr bind();
     virtual SocketOperation write(Buffer&) = 0;
+    virtual SocketOperation writeBuffers(const std::vector<Buffer*>&);
     virtual SocketOperation read(Buffer&) = 0;
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_WINRT)
     virtual bool startWrite(Buffer&) = 0;
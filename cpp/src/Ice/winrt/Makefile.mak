@@ -17,11 +17,13 @@ OBJS		= $(ARCH)\$(CONFIG)\Acceptor.obj \
 		  $(ARCH)\$(CONFIG)\AsyncResult.obj \
 		  $(ARCH)\$(CONFIG)\Base64.obj \
 		  $(ARCH)\$(CONFIG)\Buffer.obj \
+		  $(ARCH)\$(CONFIG)\BufferPool.obj \
 		  $(ARCH)\$(CONFIG)\BasicStream.obj \
 		  $(ARCH)\$(CONFIG)\BatchRequestQueue.obj \
 		  $(ARCH)\$(CONFIG)\BuiltinSequences.obj \
 		  $(ARCH)\$(CONFIG)\CommunicatorI.obj \
 		  $(ARCH)\$(CONFIG)\Communicator.obj \
+		  $(ARCH)\$(CONFIG)\Compressor.obj \
 		  $(ARCH)\$(CONFIG)\CollocatedRequestHandler.obj \
 		  $(ARCH)\$(CONFIG)\ConnectRequestHandler.obj \
 		  $(ARCH)\$(CONFIG)\ConnectionFactory.obj \
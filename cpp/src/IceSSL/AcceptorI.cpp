@@ -246,6 +246,15 @@ IceSSL::AcceptorI::AcceptorI(const EndpointIPtr& endpoint, const InstancePtr& in
     // versions (XP SP2, Windows Server 2003).
     //
     IceInternal::setReuseAddress(_fd, true);
+
+    //
+    // Allow the other acceptors of this endpoint to bind to the same
+    // port (see TcpAcceptor).
+    //
+    if(instance->properties()->getPropertyAsIntWithDefault(_adapterName + ".Acceptors", 1) > 1)
+    {
+        IceInternal::setReusePort(_fd, true);
+    }
 #endif
 }
 
@@ -0,0 +1,128 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <IceStorm/DeliveryPool.h>
+#include <IceStorm/Subscriber.h>
+#include <sstream>
+
+using namespace std;
+using namespace IceStorm;
+
+DeliveryPool::DeliveryPool(const string& name, int size)
+{
+    assert(size > 0);
+    try
+    {
+        for(int i = 0; i < size; ++i)
+        {
+            ostringstream os;
+            os << name << "-Delivery-" << i;
+            DeliveryThreadPtr thread = new DeliveryThread(os.str());
+            thread->start();
+            _threads.push_back(thread);
+        }
+    }
+    catch(...)
+    {
+        destroy();
+        throw;
+    }
+}
+
+int
+DeliveryPool::shard(const Ice::Identity& id) const
+{
+    //
+    // FNV-1a hash of the identity.
+    //
+    unsigned int h = 2166136261U;
+    for(string::const_iterator p = id.category.begin(); p != id.category.end(); ++p)
+    {
+        h = (h ^ static_cast<unsigned char>(*p)) * 16777619U;
+    }
+    h = (h ^ '/') * 16777619U;
+    for(string::const_iterator p = id.name.begin(); p != id.name.end(); ++p)
+    {
+        h = (h ^ static_cast<unsigned char>(*p)) * 16777619U;
+    }
+    return static_cast<int>(h % _threads.size());
+}
+
+void
+DeliveryPool::schedule(int shard, const SubscriberPtr& subscriber)
+{
+    _threads[shard]->schedule(subscriber);
+}
+
+void
+DeliveryPool::destroy()
+{
+    for(vector<DeliveryThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->destroy();
+    }
+    for(vector<DeliveryThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+    _threads.clear();
+}
+
+DeliveryPool::DeliveryThread::DeliveryThread(const string& name) :
+    IceUtil::Thread(name),
+    _destroyed(false)
+{
+}
+
+void
+DeliveryPool::DeliveryThread::schedule(const SubscriberPtr& subscriber)
+{
+    Lock sync(*this);
+    if(_destroyed)
+    {
+        return;
+    }
+    _subscribers.push_back(subscriber);
+    if(_subscribers.size() == 1)
+    {
+        notify();
+    }
+}
+
+void
+DeliveryPool::DeliveryThread::destroy()
+{
+    Lock sync(*this);
+    _destroyed = true;
+    _subscribers.clear();
+    notify();
+}
+
+void
+DeliveryPool::DeliveryThread::run()
+{
+    while(true)
+    {
+        SubscriberPtr subscriber;
+        {
+            Lock sync(*this);
+            while(!_destroyed && _subscribers.empty())
+            {
+                wait();
+            }
+            if(_destroyed)
+            {
+                return;
+            }
+            subscriber = _subscribers.front();
+            _subscribers.pop_front();
+        }
+        subscriber->deliver();
+    }
+}
@@ -0,0 +1,78 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef DELIVERY_POOL_H
+#define DELIVERY_POOL_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Handle.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Thread.h>
+#include <Ice/Identity.h>
+
+#include <deque>
+#include <vector>
+
+namespace IceStorm
+{
+
+class Subscriber;
+typedef IceUtil::Handle<Subscriber> SubscriberPtr;
+
+//
+// The delivery pool sends the queued events of the subscribers with
+// a fixed set of threads. Each subscriber is assigned to a thread
+// by hashing its identity: the events of a subscriber are always
+// sent by the same thread and in order, while the publishers return
+// as soon as the events are queued.
+//
+class DeliveryPool : public IceUtil::Shared
+{
+public:
+
+    DeliveryPool(const std::string&, int);
+
+    int shard(const Ice::Identity&) const;
+
+    //
+    // Schedule the sending of the queued events of the subscriber
+    // with the thread of the given shard.
+    //
+    void schedule(int, const SubscriberPtr&);
+
+    void destroy();
+
+private:
+
+    class DeliveryThread : public IceUtil::Thread, private IceUtil::Monitor<IceUtil::Mutex>
+    {
+    public:
+
+        DeliveryThread(const std::string&);
+
+        void schedule(const SubscriberPtr&);
+        void destroy();
+
+        virtual void run();
+
+    private:
+
+        std::deque<SubscriberPtr> _subscribers;
+        bool _destroyed;
+    };
+    typedef IceUtil::Handle<DeliveryThread> DeliveryThreadPtr;
+
+    std::vector<DeliveryThreadPtr> _threads;
+};
+typedef IceUtil::Handle<DeliveryPool> DeliveryPoolPtr;
+
+} // End namespace IceStorm
+
+#endif
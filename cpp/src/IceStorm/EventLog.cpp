@@ -0,0 +1,638 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <IceStorm/EventLog.h>
+#include <IceUtil/FileUtil.h>
+#include <IceUtil/StringUtil.h>
+#include <IceUtil/StringConverter.h>
+#include <Ice/Initialize.h>
+#include <Ice/Stream.h>
+#include <Ice/LocalException.h>
+#include <Ice/LoggerUtil.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <errno.h>
+
+#ifdef _WIN32
+#   include <io.h>
+#else
+#   include <dirent.h>
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+using namespace std;
+using namespace IceStorm;
+
+namespace
+{
+
+string
+segmentName(Ice::Long first)
+{
+    ostringstream os;
+    os << setfill('0') << setw(20) << first << ".log";
+    return os.str();
+}
+
+vector<string>
+listSegments(const string& path)
+{
+    vector<string> names;
+#ifdef _WIN32
+    WIN32_FIND_DATAW data;
+    HANDLE handle = FindFirstFileW(IceUtil::stringToWstring(path + "\\*.log").c_str(), &data);
+    if(handle == INVALID_HANDLE_VALUE)
+    {
+        if(GetLastError() == ERROR_FILE_NOT_FOUND)
+        {
+            return names;
+        }
+        throw Ice::FileException(__FILE__, __LINE__, GetLastError(), path);
+    }
+    do
+    {
+        names.push_back(IceUtil::wstringToString(data.cFileName));
+    }
+    while(FindNextFileW(handle, &data));
+    FindClose(handle);
+#else
+    DIR* dir = opendir(path.c_str());
+    if(dir == 0)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, errno, path);
+    }
+    struct dirent* entry;
+    while((entry = readdir(dir)) != 0)
+    {
+        string name = entry->d_name;
+        if(name.size() > 4 && name.compare(name.size() - 4, 4, ".log") == 0)
+        {
+            names.push_back(name);
+        }
+    }
+    closedir(dir);
+#endif
+    sort(names.begin(), names.end());
+    return names;
+}
+
+void
+truncateFile(const string& path, size_t size)
+{
+#ifdef _WIN32
+    int fd = IceUtilInternal::open(path, _O_RDWR | _O_BINARY);
+    if(fd < 0 || _chsize_s(fd, size) != 0)
+    {
+        int error = errno;
+        if(fd >= 0)
+        {
+            IceUtilInternal::close(fd);
+        }
+        throw Ice::FileException(__FILE__, __LINE__, error, path);
+    }
+    IceUtilInternal::close(fd);
+#else
+    if(truncate(path.c_str(), static_cast<off_t>(size)) != 0)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, errno, path);
+    }
+#endif
+}
+
+//
+// A read-only memory mapping of the beginning of a file.
+//
+class MappedFile : public IceUtil::noncopyable
+{
+public:
+
+    MappedFile(const string& path, size_t size) :
+        _data(0), _size(0)
+    {
+        if(size == 0)
+        {
+            return;
+        }
+#ifdef _WIN32
+        HANDLE file = CreateFileW(IceUtil::stringToWstring(path).c_str(), GENERIC_READ,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, 0, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, 0);
+        if(file == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+        HANDLE mapping = CreateFileMappingW(file, 0, PAGE_READONLY, 0, 0, 0);
+        if(mapping != 0)
+        {
+            _data = static_cast<const Ice::Byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size));
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+#else
+        int fd = IceUtilInternal::open(path, O_RDONLY);
+        if(fd < 0)
+        {
+            return;
+        }
+        void* data = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+        if(data != MAP_FAILED)
+        {
+            _data = static_cast<const Ice::Byte*>(data);
+        }
+        IceUtilInternal::close(fd);
+#endif
+        if(_data)
+        {
+            _size = size;
+        }
+    }
+
+    ~MappedFile()
+    {
+        if(_data)
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(_data);
+#else
+            munmap(const_cast<Ice::Byte*>(_data), _size);
+#endif
+        }
+    }
+
+    bool valid() const
+    {
+        return _size > 0;
+    }
+
+    const Ice::Byte* begin() const
+    {
+        return _data;
+    }
+
+    const Ice::Byte* end() const
+    {
+        return _data + _size;
+    }
+
+private:
+
+    const Ice::Byte* _data;
+    size_t _size;
+};
+
+//
+// Scan the records of a segment. The events whose sequence number is
+// in [from, to) are added to the given sequence until it holds max
+// events. The sequence number of the last scanned record is returned
+// with last. Returns the size of the scanned records, the size of the
+// valid records if the scan stopped on a truncated record.
+//
+size_t
+scan(const Ice::CommunicatorPtr& communicator, const Ice::Byte* beg, const Ice::Byte* end, Ice::Long from,
+     Ice::Long to, size_t max, EventDataSeq& events, Ice::Long& last)
+{
+    const size_t size = static_cast<size_t>(end - beg);
+    if(size == 0)
+    {
+        return 0;
+    }
+
+    Ice::InputStreamPtr in = Ice::wrapInputStream(communicator, make_pair(beg, end));
+    size_t pos = 0;
+    try
+    {
+        while(size - pos >= sizeof(Ice::Int) + sizeof(Ice::Long))
+        {
+            Ice::Int sz;
+            in->read(sz);
+            if(sz < static_cast<Ice::Int>(sizeof(Ice::Long)) ||
+               static_cast<size_t>(sz) > size - pos - sizeof(Ice::Int))
+            {
+                break;
+            }
+
+            Ice::Long seq;
+            in->read(seq);
+            if(seq >= to)
+            {
+                break;
+            }
+
+            const size_t next = pos + sizeof(Ice::Int) + static_cast<size_t>(sz);
+            if(seq >= from)
+            {
+                if(events.size() >= max)
+                {
+                    break;
+                }
+
+                string op;
+                Ice::Byte mode;
+                pair<const Ice::Byte*, const Ice::Byte*> data;
+                Ice::Context ctx;
+                in->read(op);
+                in->read(mode);
+                in->read(data);
+                in->read(ctx);
+                if(in->pos() > next)
+                {
+                    break; // The record is corrupted.
+                }
+                events.push_back(new EventData(op, static_cast<Ice::OperationMode>(mode),
+                                               Ice::ByteSeq(data.first, data.second), ctx));
+            }
+
+            last = seq;
+            pos = next;
+            if(in->pos() < pos)
+            {
+                in->skip(static_cast<Ice::Int>(pos - in->pos()));
+            }
+        }
+    }
+    catch(const Ice::MarshalException&)
+    {
+        // A corrupted record, the scan stops before it.
+    }
+    return pos;
+}
+
+}
+
+EventLog::EventLog(const Ice::CommunicatorPtr& communicator, const string& path, size_t segmentSize,
+                   Ice::Long retentionSize, const IceUtil::Time& retentionTime, bool sync) :
+    _communicator(communicator),
+    _path(path),
+    _segmentSize(segmentSize),
+    _retentionSize(retentionSize),
+    _retentionTime(retentionTime),
+    _sync(sync),
+    _size(0),
+    _next(1),
+    _file(0)
+{
+    if(!IceUtilInternal::directoryExists(_path) && IceUtilInternal::mkdir(_path, 0777) != 0)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, errno, _path);
+    }
+    load();
+}
+
+EventLog::~EventLog()
+{
+    if(_file)
+    {
+        fclose(_file);
+    }
+}
+
+void
+EventLog::append(EventDataSeq& events)
+{
+    Lock sync(*this);
+    if(!_file)
+    {
+        return;
+    }
+
+    for(EventDataSeq::iterator p = events.begin(); p != events.end(); ++p)
+    {
+        //
+        // The event can be shared with other topics, the sequence
+        // number is added to a copy of the context.
+        //
+        ostringstream os;
+        os << _next;
+        Ice::Context ctx = (*p)->context;
+        ctx[sequenceContextKey] = os.str();
+        *p = new EventData((*p)->op, (*p)->mode, (*p)->data, ctx);
+
+        Pending pending;
+        pending.seq = _next++;
+        pending.event = *p;
+        _pending.push_back(pending);
+    }
+}
+
+void
+EventLog::flush()
+{
+    IceUtil::Mutex::Lock writeSync(_writeMutex);
+
+    //
+    // Write all the events appended so far, the events appended by
+    // concurrent publishers are written together. The events stay in
+    // the pending events until they are written so that they can
+    // still be read.
+    //
+    vector<Pending> pending;
+    {
+        Lock sync(*this);
+        if(!_file)
+        {
+            _pending.clear(); // The events are no longer logged.
+            return;
+        }
+        pending.assign(_pending.begin(), _pending.end());
+    }
+    if(pending.empty())
+    {
+        return;
+    }
+
+    Ice::OutputStreamPtr out = Ice::createOutputStream(_communicator);
+    for(vector<Pending>::const_iterator p = pending.begin(); p != pending.end(); ++p)
+    {
+        Ice::OutputStream::size_type pos = out->startSize();
+        out->write(p->seq);
+        out->write(p->event->op);
+        out->write(static_cast<Ice::Byte>(p->event->mode));
+        out->write(p->event->data);
+        out->write(p->event->context);
+        out->endSize(pos);
+    }
+
+    pair<const Ice::Byte*, const Ice::Byte*> bytes = out->finished();
+    const size_t size = static_cast<size_t>(bytes.second - bytes.first);
+    bool written = fwrite(bytes.first, 1, size, _file) == size && fflush(_file) == 0;
+    if(written && _sync)
+    {
+#ifdef _WIN32
+        written = _commit(_fileno(_file)) == 0;
+#else
+        written = fsync(fileno(_file)) == 0;
+#endif
+    }
+    const string reason = written ? string() : IceUtilInternal::lastErrorToString();
+
+    Lock sync(*this);
+    _pending.erase(_pending.begin(), _pending.begin() + static_cast<ptrdiff_t>(pending.size()));
+
+    Segment& last = _segments.back();
+    if(!written)
+    {
+        Ice::Error error(_communicator->getLogger());
+        error << "cannot write event log segment `" << last.path << "':\n" << reason;
+    }
+    else
+    {
+        last.size += size;
+        last.modified = IceUtil::Time::now();
+        _size += static_cast<Ice::Long>(size);
+        if(last.size < _segmentSize)
+        {
+            return;
+        }
+    }
+
+    //
+    // Start a new segment once the last segment is full or if it
+    // can't be written, the records of a segment are read until the
+    // first incomplete record.
+    //
+    try
+    {
+        roll();
+        retain();
+    }
+    catch(const Ice::FileException& ex)
+    {
+        Ice::Error error(_communicator->getLogger());
+        error << "cannot create event log segment, events are no longer logged:\n" << ex;
+    }
+}
+
+Ice::Long
+EventLog::read(Ice::Long from, Ice::Long to, size_t max, EventDataSeq& events) const
+{
+    //
+    // Copy the segments to read and the events not written yet, the
+    // segments are read without the lock so that the events can be
+    // appended and written during the read.
+    //
+    vector<Segment> segments;
+    vector<Pending> pending;
+    {
+        Lock sync(*this);
+        to = min(to, _next);
+        for(deque<Segment>::const_iterator p = _segments.begin(); p != _segments.end() && p->first < to; ++p)
+        {
+            deque<Segment>::const_iterator q = p + 1;
+            if(q == _segments.end() || q->first > from)
+            {
+                segments.push_back(*p);
+            }
+        }
+        for(deque<Pending>::const_iterator p = _pending.begin(); p != _pending.end() && p->seq < to; ++p)
+        {
+            if(p->seq >= from)
+            {
+                pending.push_back(*p);
+            }
+        }
+    }
+
+    if(from >= to)
+    {
+        return to;
+    }
+
+    const size_t count = events.size() + max;
+    Ice::Long last = from - 1;
+    for(vector<Segment>::const_iterator p = segments.begin(); p != segments.end(); ++p)
+    {
+        //
+        // The segment can't be mapped if it was just removed by the
+        // retention, its events are skipped.
+        //
+        MappedFile file(p->path, p->size);
+        if(file.valid())
+        {
+            scan(_communicator, file.begin(), file.end(), from, to, count, events, last);
+            if(events.size() >= count)
+            {
+                return last + 1;
+            }
+        }
+    }
+
+    for(vector<Pending>::const_iterator p = pending.begin(); p != pending.end(); ++p)
+    {
+        if(p->seq > last)
+        {
+            if(events.size() >= count)
+            {
+                return last + 1;
+            }
+            events.push_back(p->event);
+            last = p->seq;
+        }
+    }
+    return to;
+}
+
+Ice::Long
+EventLog::next() const
+{
+    Lock sync(*this);
+    return _next;
+}
+
+void
+EventLog::close()
+{
+    flush();
+
+    IceUtil::Mutex::Lock writeSync(_writeMutex);
+    Lock sync(*this);
+    if(_file)
+    {
+        fclose(_file);
+        _file = 0;
+    }
+}
+
+void
+EventLog::destroy()
+{
+    IceUtil::Mutex::Lock writeSync(_writeMutex);
+    Lock sync(*this);
+    _pending.clear();
+    if(_file)
+    {
+        fclose(_file);
+        _file = 0;
+    }
+    for(deque<Segment>::const_iterator p = _segments.begin(); p != _segments.end(); ++p)
+    {
+        IceUtilInternal::remove(p->path);
+    }
+    _segments.clear();
+    _size = 0;
+    IceUtilInternal::rmdir(_path);
+}
+
+void
+EventLog::load()
+{
+    vector<string> names = listSegments(_path);
+    for(vector<string>::const_iterator p = names.begin(); p != names.end(); ++p)
+    {
+        //
+        // The segment names are zero padded decimal numbers.
+        //
+        Segment segment;
+        istringstream is(p->substr(0, p->size() - 4));
+        if(!(is >> segment.first) || !is.eof())
+        {
+            continue;
+        }
+        segment.path = _path + "/" + *p;
+
+        IceUtilInternal::structstat buf;
+        if(IceUtilInternal::stat(segment.path, &buf) != 0)
+        {
+            throw Ice::FileException(__FILE__, __LINE__, errno, segment.path);
+        }
+        segment.size = static_cast<size_t>(buf.st_size);
+        segment.modified = IceUtil::Time::seconds(buf.st_mtime);
+        _size += static_cast<Ice::Long>(segment.size);
+        _segments.push_back(segment);
+    }
+
+    if(_segments.empty())
+    {
+        roll();
+        return;
+    }
+
+    //
+    // Scan the last segment to find the next sequence number and
+    // remove the incomplete record left by a crash, if any.
+    //
+    Segment& last = _segments.back();
+    Ice::Long seq = last.first - 1;
+    size_t size;
+    {
+        MappedFile file(last.path, last.size);
+        EventDataSeq events;
+        size = scan(_communicator, file.begin(), file.end(), numeric_limits<Ice::Long>::max(),
+                    numeric_limits<Ice::Long>::max(), 0, events, seq);
+    }
+    if(size < last.size)
+    {
+        truncateFile(last.path, size);
+        _size -= static_cast<Ice::Long>(last.size - size);
+        last.size = size;
+    }
+    _next = seq + 1;
+
+    _file = IceUtilInternal::fopen(last.path, "ab");
+    if(!_file)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, errno, last.path);
+    }
+
+    retain();
+}
+
+void
+EventLog::roll()
+{
+    if(_file)
+    {
+        fclose(_file);
+        _file = 0;
+    }
+
+    Segment segment;
+    segment.first = _next;
+    segment.path = _path + "/" + segmentName(_next);
+    segment.size = 0;
+    segment.modified = IceUtil::Time::now();
+
+    _file = IceUtilInternal::fopen(segment.path, "ab");
+    if(!_file)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, errno, segment.path);
+    }
+    _segments.push_back(segment);
+}
+
+void
+EventLog::retain()
+{
+    //
+    // A segment is removed for the retention size only if the
+    // remaining segments still hold at least the retention size.
+    //
+    const IceUtil::Time now = IceUtil::Time::now();
+    while(_segments.size() > 1)
+    {
+        const Segment& segment = _segments.front();
+        if((_retentionSize <= 0 || _size - static_cast<Ice::Long>(segment.size) < _retentionSize) &&
+           (_retentionTime <= IceUtil::Time() || now - segment.modified <= _retentionTime))
+        {
+            break;
+        }
+
+        if(IceUtilInternal::remove(segment.path) != 0)
+        {
+            Ice::Warning warn(_communicator->getLogger());
+            warn << "cannot remove event log segment `" << segment.path << "':\n"
+                 << IceUtilInternal::lastErrorToString();
+        }
+        _size -= static_cast<Ice::Long>(segment.size);
+        _segments.pop_front();
+    }
+}
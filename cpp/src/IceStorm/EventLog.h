@@ -0,0 +1,140 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Handle.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Time.h>
+#include <IceStorm/IceStormInternal.h>
+
+#include <deque>
+#include <stdio.h>
+
+namespace IceStorm
+{
+
+//
+// The context key of the sequence number of a logged event.
+//
+const std::string sequenceContextKey = "IceStorm.Sequence";
+
+//
+// The append-only log of the events published on a topic. The log
+// is a directory of segment files, each segment is named after the
+// sequence number of its first event. A new segment is started once
+// the last segment reaches the segment size, the oldest segments are
+// then removed according to the retention size and time. The last
+// segment is never removed so that the sequence numbers keep
+// increasing across restarts.
+//
+// Each event is stored as an Ice encoded record:
+//
+// - the size of the record (int)
+// - the sequence number of the event (long)
+// - the operation (string), the mode (byte), the parameters (byte
+//   sequence) and the context (dictionary) of the event.
+//
+// Events are read by mapping the segment files in memory.
+//
+// Appending an event only assigns its sequence number, the events are
+// written to the segment by flush() which is called without the topic
+// locks held. The appended events which aren't written yet are read
+// from memory. The segment is flushed to the operating system after
+// each write but it's only synced to the disk if sync is enabled: an
+// event published before a crash of the host can otherwise be lost.
+//
+class EventLog : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    EventLog(const Ice::CommunicatorPtr&, const std::string&, size_t, Ice::Long, const IceUtil::Time&, bool);
+    ~EventLog();
+
+    //
+    // Append the events to the log. Each event gets the next sequence
+    // number and is replaced with a copy whose context also holds the
+    // sequence number with the sequenceContextKey key, the given
+    // events are not modified.
+    //
+    void append(EventDataSeq&);
+
+    //
+    // Write the appended events to the log.
+    //
+    void flush();
+
+    //
+    // Read up to the given number of events, starting with the first
+    // logged event whose sequence number is greater or equal to the
+    // first given sequence number and stopping before the second. The
+    // events are added to the given sequence. Returns the sequence
+    // number following the last event read, or the end sequence
+    // number if there are no more events to read.
+    //
+    Ice::Long read(Ice::Long, Ice::Long, size_t, EventDataSeq&) const;
+
+    //
+    // The sequence number of the next appended event.
+    //
+    Ice::Long next() const;
+
+    void close();
+
+    //
+    // Close the log and remove its files.
+    //
+    void destroy();
+
+private:
+
+    struct Segment
+    {
+        Ice::Long first; // The sequence number of the first event.
+        std::string path;
+        size_t size;
+        IceUtil::Time modified;
+    };
+
+    struct Pending
+    {
+        Ice::Long seq;
+        EventDataPtr event;
+    };
+
+    void load();
+    void roll();
+    void retain();
+
+    const Ice::CommunicatorPtr _communicator;
+    const std::string _path;
+    const size_t _segmentSize;
+    const Ice::Long _retentionSize;
+    const IceUtil::Time _retentionTime;
+    const bool _sync;
+
+    std::deque<Segment> _segments;
+    Ice::Long _size; // The size of all the segments.
+    Ice::Long _next;
+    std::deque<Pending> _pending; // The appended events not written yet.
+
+    //
+    // Serializes the writes, it's locked before the log mutex. The
+    // file and the segments are only changed with both mutexes locked.
+    //
+    IceUtil::Mutex _writeMutex;
+    FILE* _file; // The last segment, opened for appending.
+};
+typedef IceUtil::Handle<EventLog> EventLogPtr;
+
+} // End namespace IceStorm
+
+#endif
@@ -12,11 +12,19 @@
 #include <IceStorm/Observers.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/InstrumentationI.h>
+#include <IceStorm/DeliveryPool.h>
+#include <IceStorm/EventLog.h>
+#include <IceStorm/Subscriber.h>
 #include <IceUtil/Timer.h>
+#include <IceUtil/FileUtil.h>
 
 #include <Ice/InstrumentationI.h>
 #include <Ice/Communicator.h>
 #include <Ice/Properties.h>
+#include <Ice/LoggerUtil.h>
+
+#include <iomanip>
+#include <errno.h>
 
 using namespace std;
 using namespace IceStorm;
@@ -53,8 +61,26 @@ PersistentInstance::PersistentInstance(
     const Ice::ObjectAdapterPtr& nodeAdapter,
     const NodePrx& nodeProxy) :
     Instance(instanceName, name, communicator, publishAdapter, topicAdapter, nodeAdapter, nodeProxy),
+    _commitWindow(IceUtil::Time::milliSeconds(
+                      max(0, communicator->getProperties()->getPropertyAsInt(name + ".LMDB.CommitWindow")))),
+    _commitBatchMax(static_cast<size_t>(
+                        max(1, communicator->getProperties()->getPropertyAsIntWithDefault(name + ".LMDB.CommitBatchMax",
+                                                                                           1000)))),
+    _eventLogPath(communicator->getProperties()->getPropertyAsInt(name + ".EventLog.Enabled") > 0 ?
+                  communicator->getProperties()->getPropertyWithDefault(name + ".LMDB.Path", name) + "/events" : ""),
+    // Sizes in MB
+    _eventLogSegmentSize(static_cast<size_t>(
+                             max(1, communicator->getProperties()->getPropertyAsIntWithDefault(
+                                     name + ".EventLog.SegmentSize", 64))) * 1024 * 1024),
+    _eventLogRetentionSize(static_cast<Ice::Long>(
+                               max(0, communicator->getProperties()->getPropertyAsIntWithDefault(
+                                       name + ".EventLog.RetentionSize", 1024))) * 1024 * 1024),
+    _eventLogRetentionTime(IceUtil::Time::seconds(
+                               max(0, communicator->getProperties()->getPropertyAsInt(
+                                       name + ".EventLog.RetentionTime")))),
+    _eventLogSync(communicator->getProperties()->getPropertyAsInt(name + ".EventLog.Sync") > 0),
     _dbLock(communicator->getProperties()->getPropertyWithDefault(name + ".LMDB.Path", name) + "/icedb.lock"),
-    _dbEnv(communicator->getProperties()->getPropertyWithDefault(name + ".LMDB.Path", name), 2,
+    _dbEnv(communicator->getProperties()->getPropertyWithDefault(name + ".LMDB.Path", name), 3,
            IceDB::getMapSize(communicator->getProperties()->getPropertyAsInt(name + ".LMDB.MapSize")))
 {
     try
@@ -67,8 +93,17 @@ PersistentInstance::PersistentInstance(
 
         _lluMap = LLUMap(txn, "llu", dbContext, MDB_CREATE);
         _subscriberMap = SubscriberMap(txn, "subscribers", dbContext, MDB_CREATE, compareSubscriberRecordKey);
+        _replicationLog = ReplicationLog(txn, dbContext, static_cast<size_t>(
+                                             max(0, communicator->getProperties()->getPropertyAsIntWithDefault(
+                                                     name + ".LMDB.ReplicationLogSize", 10000))));
 
         txn.commit();
+
+        if(!_eventLogPath.empty() && !IceUtilInternal::directoryExists(_eventLogPath) &&
+           IceUtilInternal::mkdir(_eventLogPath, 0777) != 0)
+        {
+            throw Ice::FileException(__FILE__, __LINE__, errno, _eventLogPath);
+        }
     }
     catch(...)
     {
@@ -79,6 +114,28 @@ PersistentInstance::PersistentInstance(
     }
 }
 
+EventLogPtr
+PersistentInstance::createEventLog(const string& topic) const
+{
+    if(_eventLogPath.empty())
+    {
+        return 0;
+    }
+
+    //
+    // The topic name can contain any character, the directory of the
+    // log is named after its hexadecimal encoding.
+    //
+    ostringstream os;
+    os << _eventLogPath << '/' << hex << setfill('0');
+    for(string::const_iterator p = topic.begin(); p != topic.end(); ++p)
+    {
+        os << setw(2) << static_cast<int>(static_cast<unsigned char>(*p));
+    }
+    return new EventLog(communicator(), os.str(), _eventLogSegmentSize, _eventLogRetentionSize,
+                        _eventLogRetentionTime, _eventLogSync);
+}
+
 void
 PersistentInstance::destroy()
 {
@@ -110,6 +167,21 @@ Instance::Instance(
                                                    name + ".Flush.Timeout", 1000))), // default one second.
     // default one minute.
     _sendTimeout(communicator->getProperties()->getPropertyAsIntWithDefault(name + ".Send.Timeout", 60 * 1000)),
+    // default no limit.
+    _sendQueueSizeMax(communicator->getProperties()->getPropertyAsInt(name + ".Send.QueueSizeMax")),
+    _sendQueueMemoryMax(communicator->getProperties()->getPropertyAsInt(name + ".Send.QueueMemoryMax")),
+    _sendQueueOverflow(communicator->getProperties()->getPropertyWithDefault(name + ".Send.QueueOverflow",
+                                                                             "DropOldest")),
+    // default 1000 cached events per coalescing topic.
+    _lastValuesSizeMax(max(0, communicator->getProperties()->getPropertyAsIntWithDefault(
+                                  name + ".LastValues.SizeMax", 1000))),
+    // default one call outstanding per link, no batch limit and no batch timeout.
+    _linkOutstandingMax(max(1, communicator->getProperties()->getPropertyAsIntWithDefault(
+                                   name + ".Link.OutstandingMax", 1))),
+    _linkBatchSizeMax(max(0, communicator->getProperties()->getPropertyAsInt(name + ".Link.BatchSizeMax"))),
+    _linkBatchTimeout(IceUtil::Time::milliSeconds(
+                          max(0, communicator->getProperties()->getPropertyAsInt(name + ".Link.BatchTimeout")))),
+    _linkCompress(communicator->getProperties()->getPropertyAsInt(name + ".Link.Compress") > 0),
     _topicReaper(new TopicReaper())
 {
     try
@@ -130,10 +202,63 @@ Instance::Instance(
                 const_cast<Ice::ObjectPrx&>(_publisherReplicaProxy) = communicator->stringToProxy("dummy:" + p);
             }
         }
+        if(_sendQueueOverflow != "DropOldest" && _sendQueueOverflow != "DropNewest" &&
+           _sendQueueOverflow != "Disconnect")
+        {
+            Ice::Warning out(communicator->getLogger());
+            out << "invalid value for " << name << ".Send.QueueOverflow: `" << _sendQueueOverflow
+                << "', using DropOldest";
+            const_cast<string&>(_sendQueueOverflow) = "DropOldest";
+        }
+
+        //
+        // Forward calls dispatched concurrently by the downstream
+        // service can deliver the events out of order. Only pipeline
+        // the calls of a link if the downstream services serialize
+        // their dispatch (Publish.ThreadPool.Serialize).
+        //
+        if(_linkOutstandingMax > 1 && properties->getPropertyAsInt(name + ".Link.Serialized") <= 0)
+        {
+            Ice::Warning out(communicator->getLogger());
+            out << name << ".Link.OutstandingMax is ignored unless " << name
+                << ".Link.Serialized is set, using 1";
+            _linkOutstandingMax = 1;
+        }
+
+        //
+        // The topics configured with <service>.Coalesce.<topic>
+        // coalesce their events.
+        //
+        const string coalescePrefix = name + ".Coalesce.";
+        Ice::PropertyDict coalesce = properties->getPropertiesForPrefix(coalescePrefix);
+        for(Ice::PropertyDict::const_iterator p = coalesce.begin(); p != coalesce.end(); ++p)
+        {
+            EventCoalescerPtr coalescer = EventCoalescer::create(p->second);
+            if(!coalescer)
+            {
+                Ice::Warning out(communicator->getLogger());
+                out << "invalid value for " << p->first << ": `" << p->second
+                    << "', the events of the topic are not coalesced";
+                continue;
+            }
+            _coalescers[p->first.substr(coalescePrefix.size())] = coalescer;
+        }
+
         _observers = new Observers(this);
         _batchFlusher = new IceUtil::Timer();
         _timer = new IceUtil::Timer();
 
+        //
+        // With <service>.Send.Threads > 0, the events are sent to the
+        // subscribers by a pool of delivery threads rather than by the
+        // publisher threads.
+        //
+        int deliveryThreads = properties->getPropertyAsInt(name + ".Send.Threads");
+        if(deliveryThreads > 0)
+        {
+            _deliveryPool = new DeliveryPool(name, deliveryThreads);
+        }
+
         //
         // If an Ice metrics observer is setup on the communicator, also
         // enable metrics for IceStorm.
@@ -245,6 +370,12 @@ Instance::timer() const
     return _timer;
 }
 
+DeliveryPoolPtr
+Instance::deliveryPool() const
+{
+    return _deliveryPool;
+}
+
 Ice::ObjectPrx
 Instance::topicReplicaProxy() const
 {
@@ -287,6 +418,61 @@ Instance::sendTimeout() const
     return _sendTimeout;
 }
 
+int
+Instance::sendQueueSizeMax() const
+{
+    return _sendQueueSizeMax;
+}
+
+int
+Instance::sendQueueMemoryMax() const
+{
+    return _sendQueueMemoryMax;
+}
+
+string
+Instance::sendQueueOverflow() const
+{
+    return _sendQueueOverflow;
+}
+
+int
+Instance::linkOutstandingMax() const
+{
+    return _linkOutstandingMax;
+}
+
+int
+Instance::linkBatchSizeMax() const
+{
+    return _linkBatchSizeMax;
+}
+
+IceUtil::Time
+Instance::linkBatchTimeout() const
+{
+    return _linkBatchTimeout;
+}
+
+bool
+Instance::linkCompress() const
+{
+    return _linkCompress;
+}
+
+EventCoalescerPtr
+Instance::coalescer(const string& topic) const
+{
+    map<string, EventCoalescerPtr>::const_iterator p = _coalescers.find(topic);
+    return p != _coalescers.end() ? p->second : EventCoalescerPtr();
+}
+
+int
+Instance::lastValuesSizeMax() const
+{
+    return _lastValuesSizeMax;
+}
+
 void
 Instance::shutdown()
 {
@@ -314,6 +500,11 @@ Instance::destroy()
         _batchFlusher->destroy();
     }
 
+    if(_deliveryPool)
+    {
+        _deliveryPool->destroy();
+    }
+
     // The node instance must be cleared as the node holds the
     // replica (TopicManager) which holds the instance causing a
     // cyclic reference.
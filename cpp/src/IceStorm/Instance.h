@@ -18,6 +18,7 @@
 #include <IceStorm/Election.h>
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Util.h>
+#include <IceStorm/ReplicationLog.h>
 
 namespace IceUtil
 {
@@ -44,6 +45,15 @@ namespace IceStorm
 class TraceLevels;
 typedef IceUtil::Handle<TraceLevels> TraceLevelsPtr;
 
+class DeliveryPool;
+typedef IceUtil::Handle<DeliveryPool> DeliveryPoolPtr;
+
+class EventLog;
+typedef IceUtil::Handle<EventLog> EventLogPtr;
+
+class EventCoalescer;
+typedef IceUtil::Handle<EventCoalescer> EventCoalescerPtr;
+
 class TopicReaper : public IceUtil::Shared, private IceUtil::Mutex
 {
 public:
@@ -80,6 +90,7 @@ public:
     TraceLevelsPtr traceLevels() const;
     IceUtil::TimerPtr batchFlusher() const;
     IceUtil::TimerPtr timer() const;
+    DeliveryPoolPtr deliveryPool() const;
     Ice::ObjectPrx topicReplicaProxy() const;
     Ice::ObjectPrx publisherReplicaProxy() const;
     IceStorm::Instrumentation::TopicManagerObserverPtr observer() const;
@@ -88,6 +99,15 @@ public:
     IceUtil::Time discardInterval() const;
     IceUtil::Time flushInterval() const;
     int sendTimeout() const;
+    int sendQueueSizeMax() const;
+    int sendQueueMemoryMax() const;
+    std::string sendQueueOverflow() const;
+    EventCoalescerPtr coalescer(const std::string&) const; // The coalescer of the given topic, 0 if none.
+    int lastValuesSizeMax() const;
+    int linkOutstandingMax() const;
+    int linkBatchSizeMax() const;
+    IceUtil::Time linkBatchTimeout() const;
+    bool linkCompress() const;
 
     void shutdown();
     virtual void destroy();
@@ -105,13 +125,23 @@ private:
     const IceUtil::Time _discardInterval;
     const IceUtil::Time _flushInterval;
     const int _sendTimeout;
+    const int _sendQueueSizeMax;
+    const int _sendQueueMemoryMax;
+    const std::string _sendQueueOverflow;
+    const int _lastValuesSizeMax;
+    int _linkOutstandingMax;
+    const int _linkBatchSizeMax;
+    const IceUtil::Time _linkBatchTimeout;
+    const bool _linkCompress;
     const Ice::ObjectPrx _topicReplicaProxy;
     const Ice::ObjectPrx _publisherReplicaProxy;
     const TopicReaperPtr _topicReaper;
+    std::map<std::string, EventCoalescerPtr> _coalescers; // The coalescer of each topic, immutable once created.
     IceStormElection::NodeIPtr _node;
     IceStormElection::ObserversPtr _observers;
     IceUtil::TimerPtr _batchFlusher;
     IceUtil::TimerPtr _timer;
+    DeliveryPoolPtr _deliveryPool;
     IceStorm::Instrumentation::TopicManagerObserverPtr _observer;
 
 
@@ -132,15 +162,33 @@ public:
     const IceDB::Env& dbEnv() const { return _dbEnv; }
     LLUMap lluMap() const { return _lluMap; }
     SubscriberMap subscriberMap() const { return _subscriberMap; }
+    ReplicationLog replicationLog() const { return _replicationLog; }
+
+    IceUtil::Time commitWindow() const { return _commitWindow; }
+    size_t commitBatchMax() const { return _commitBatchMax; }
+
+    //
+    // Create the event log of the given topic, returns 0 if the
+    // events aren't logged.
+    //
+    EventLogPtr createEventLog(const std::string&) const;
 
     virtual void destroy();
 
 private:
 
+    const IceUtil::Time _commitWindow;
+    const size_t _commitBatchMax;
+    const std::string _eventLogPath; // Empty if the events aren't logged.
+    const size_t _eventLogSegmentSize;
+    const Ice::Long _eventLogRetentionSize;
+    const IceUtil::Time _eventLogRetentionTime;
+    const bool _eventLogSync;
     IceUtilInternal::FileLock _dbLock;
     IceDB::Env _dbEnv;
     LLUMap _lluMap;
     SubscriberMap _subscriberMap;
+    ReplicationLog _replicationLog;
 };
 typedef IceUtil::Handle<PersistentInstance> PersistentInstancePtr;
 
@@ -271,10 +271,7 @@ struct OutstandingUpdate
 
     void operator()(const SubscriberMetricsPtr& v)
     {
-        if(v->queued > 0)
-        {
-            v->queued -= count;
-        }
+        v->queued = v->queued > count ? v->queued - count : 0;
         v->outstanding += count;
     }
 
@@ -318,6 +315,32 @@ SubscriberObserverI::delivered(int count)
     forEach(DeliveredUpdate(count));
 }
 
+namespace
+{
+
+struct DroppedUpdate
+{
+    DroppedUpdate(int count) : count(count)
+    {
+    }
+
+    void operator()(const SubscriberMetricsPtr& v)
+    {
+        v->queued = v->queued > count ? v->queued - count : 0;
+        v->dropped = (v->dropped ? *v->dropped : 0) + count;
+    }
+
+    int count;
+};
+
+}
+
+void
+SubscriberObserverI::dropped(int count)
+{
+    forEach(DroppedUpdate(count));
+}
+
 TopicManagerObserverI::TopicManagerObserverI(const IceInternal::MetricsAdminIPtr& metrics) : 
     _metrics(metrics),
     _topics(metrics, "Topic"),
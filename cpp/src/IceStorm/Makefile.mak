@@ -27,10 +27,13 @@ LSLICE_OBJS      = .\Election.obj \
 BISON_FLEX_OBJS = .\Grammar.obj \
                   .\Scanner.obj
 
-LIB_OBJS	= .\Instance.obj \
+LIB_OBJS	= .\DeliveryPool.obj \
+		  .\EventLog.obj \
+		  .\Instance.obj \
 		  .\InstrumentationI.obj \
 		  .\NodeI.obj \
 		  .\Observers.obj \
+		  .\ReplicationLog.obj \
 		  .\Service.obj \
 		  .\Subscriber.obj \
 		  .\TopicI.obj \
@@ -646,7 +646,13 @@ NodeI::mergeContinue()
         max = _max;
     }
 
-    // Prepare the LogUpdate for this generation.
+    // Prepare the LogUpdate for this generation. The generation must
+    // also follow the generation of this node, a node never starts
+    // the same generation twice (see the replication log).
+    if(myLlu > maxllu)
+    {
+        maxllu = myLlu;
+    }
     maxllu.generation++;
     maxllu.iteration = 0;
 
@@ -654,7 +660,7 @@ NodeI::mergeContinue()
     {
         // Tell the replica that it is now the master with the given
         // set of slaves and llu generation.
-        _replica->initMaster(tmpSet, maxllu);
+        _replica->initMaster(tmpSet, maxllu, _id);
     }
     catch(const Ice::Exception& ex)
     {
@@ -78,7 +78,8 @@ Observers::getReapedSlaves(std::vector<int>& d)
 }
 
 void
-Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const TopicContentSeq& content)
+Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, int master, const TopicContentSeq& content,
+                const map<int, LogEntrySeq>& logs)
 {
     {
         IceUtil::Mutex::Lock sync(_reapedMutex);
@@ -97,8 +98,25 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
             // 60s timeout for reliability in the event that a replica
             // becomes unresponsive.
             ReplicaObserverPrx observer = ReplicaObserverPrx::uncheckedCast(p->observer->ice_timeout(60 * 1000));
-            observer->init(llu, content);
-            _observers.push_back(ObserverInfo(p->id, observer));
+            ObserverInfo info(p->id, observer);
+            map<int, LogEntrySeq>::const_iterator q = logs.find(p->id);
+            if(q == logs.end() || !applyLog(p->id, observer, q->second))
+            {
+                try
+                {
+                    observer->initWithMaster(llu, master, content);
+                }
+                catch(const Ice::OperationNotExistException&)
+                {
+                    //
+                    // The replica runs an older version, it doesn't
+                    // support the replication log nor updateSubscribers.
+                    //
+                    info.legacy = true;
+                    observer->init(llu, content);
+                }
+            }
+            _observers.push_back(info);
         }
         catch(const Ice::Exception& ex)
         {
@@ -112,6 +130,40 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
     }
 }
 
+bool
+Observers::applyLog(int id, const ReplicaObserverPrx& observer, const LogEntrySeq& entries)
+{
+    //
+    // The first entry is the last update of the observer, the updates
+    // that follow are sent in chunks.
+    //
+    assert(!entries.empty());
+    LogEntrySeq::const_iterator p = entries.begin();
+    try
+    {
+        while(p + 1 != entries.end())
+        {
+            LogEntrySeq::const_iterator q = p + 1 + min<ptrdiff_t>(logChunkSize, entries.end() - p - 1);
+            observer->applyLog(p->llu, p->master, LogEntrySeq(p + 1, q));
+            p = q - 1;
+        }
+    }
+    catch(const ObserverInconsistencyException& ex)
+    {
+        if(_traceLevels->replication > 0)
+        {
+            Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+            out << "cannot apply the log on " << id << ", sending the topic content: " << ex.reason;
+        }
+        return false;
+    }
+    catch(const Ice::OperationNotExistException&)
+    {
+        return false; // The replica runs an older version.
+    }
+    return true;
+}
+
 void
 Observers::createTopic(const LogUpdate& llu, const string& name)
 {
@@ -157,12 +209,67 @@ Observers::removeSubscriber(const LogUpdate& llu, const string& name, const Ice:
     wait("removeSubscriber");
 }
 
+void
+Observers::updateSubscribers(const LogUpdate& llu, const string& name, const SubscriberRecordSeq& added,
+                             const Ice::IdentitySeq& removed)
+{
+    Lock sync(*this);
+    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
+    {
+        if(!p->legacy)
+        {
+            p->result = p->observer->begin_updateSubscribers(llu, name, added, removed);
+        }
+        else
+        {
+            p->result = 0;
+        }
+    }
+
+    //
+    // The replicas running an older version receive the removed and
+    // added subscribers with separate calls, which must be dispatched
+    // in order.
+    //
+    vector<ObserverInfo>::iterator p = _observers.begin();
+    while(p != _observers.end())
+    {
+        if(p->legacy)
+        {
+            try
+            {
+                if(!removed.empty())
+                {
+                    p->observer->removeSubscriber(llu, name, removed);
+                }
+                for(SubscriberRecordSeq::const_iterator q = added.begin(); q != added.end(); ++q)
+                {
+                    p->observer->addSubscriber(llu, name, *q);
+                }
+            }
+            catch(const Ice::Exception& ex)
+            {
+                p = reap(p, "updateSubscribers", ex);
+                continue;
+            }
+        }
+        ++p;
+    }
+    wait("updateSubscribers");
+}
+
 void
 Observers::wait(const string& op)
 {
     vector<ObserverInfo>::iterator p = _observers.begin();
     while(p != _observers.end())
     {
+        if(!p->result)
+        {
+            ++p; // Already completed.
+            continue;
+        }
+
         try
         {
             p->result->waitForCompleted();
@@ -170,16 +277,7 @@ Observers::wait(const string& op)
         }
         catch(const Ice::Exception& ex)
         {
-            if(_traceLevels->replication > 0)
-            {
-                Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
-                out << op << ": " << ex;
-            }
-            int id = p->id;
-            p = _observers.erase(p);
-
-            IceUtil::Mutex::Lock sync(_reapedMutex);
-            _reaped.push_back(id);
+            p = reap(p, op, ex);
             continue;
         }
         ++p;
@@ -194,3 +292,18 @@ Observers::wait(const string& op)
     }
 }
 
+vector<Observers::ObserverInfo>::iterator
+Observers::reap(vector<ObserverInfo>::iterator p, const string& op, const Ice::Exception& ex)
+{
+    if(_traceLevels->replication > 0)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+        out << op << ": " << ex;
+    }
+    int id = p->id;
+    p = _observers.erase(p);
+
+    IceUtil::Mutex::Lock sync(_reapedMutex);
+    _reaped.push_back(id);
+    return p;
+}
@@ -42,27 +42,40 @@ public:
     bool check();
     void clear();
 
-    void init(const std::set<IceStormElection::GroupNodeInfo>&, const LogUpdate&, const TopicContentSeq&);
+    //
+    // Initialize the observers of the given slaves. The slaves with
+    // logged updates are sent the updates they missed, the other
+    // slaves are sent the topic content.
+    //
+    void init(const std::set<IceStormElection::GroupNodeInfo>&, const LogUpdate&, int, const TopicContentSeq&,
+              const std::map<int, LogEntrySeq>&);
     void createTopic(const LogUpdate&, const std::string&);
     void destroyTopic(const LogUpdate&, const std::string&);
     void addSubscriber(const LogUpdate&, const std::string&, const IceStorm::SubscriberRecord&);
     void removeSubscriber(const LogUpdate&, const std::string&, const Ice::IdentitySeq&);
+    void updateSubscribers(const LogUpdate&, const std::string&, const IceStorm::SubscriberRecordSeq&,
+                           const Ice::IdentitySeq&);
     void getReapedSlaves(std::vector<int>&);
 
 private:
 
-    void wait(const std::string&);
-
-    const IceStorm::TraceLevelsPtr _traceLevels;
-    unsigned int _majority;
     struct ObserverInfo
     {
         ObserverInfo(int i, const ReplicaObserverPrx& o) :
-            id(i), observer(o) {}
+            id(i), observer(o), legacy(false) {}
         int id;
         ReplicaObserverPrx observer;
         ::Ice::AsyncResultPtr result;
+        bool legacy; // True if the replica doesn't support the operations added with the replication log.
     };
+
+    void wait(const std::string&);
+    std::vector<ObserverInfo>::iterator reap(std::vector<ObserverInfo>::iterator, const std::string&,
+                                             const Ice::Exception&);
+    bool applyLog(int, const ReplicaObserverPrx&, const LogEntrySeq&);
+
+    const IceStorm::TraceLevelsPtr _traceLevels;
+    unsigned int _majority;
     std::vector<ObserverInfo> _observers;
     IceUtil::Mutex _reapedMutex;
     std::vector<int> _reaped;
@@ -42,7 +42,7 @@ public:
 
     virtual LogUpdate getLastLogUpdate() const = 0;
     virtual void sync(const Ice::ObjectPrx&) = 0;
-    virtual void initMaster(const std::set<IceStormElection::GroupNodeInfo>&, const LogUpdate&) = 0;
+    virtual void initMaster(const std::set<IceStormElection::GroupNodeInfo>&, const LogUpdate&, int) = 0;
     virtual Ice::ObjectPrx getObserver() const = 0;
     virtual Ice::ObjectPrx getSync() const = 0;
 };
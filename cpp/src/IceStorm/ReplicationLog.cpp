@@ -0,0 +1,117 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <IceStorm/ReplicationLog.h>
+#include <IceStorm/Util.h>
+
+using namespace std;
+using namespace IceStorm;
+using namespace IceStormElection;
+
+namespace
+{
+
+typedef IceDB::Cursor<LogUpdate, LogEntry, IceDB::IceContext, Ice::OutputStreamPtr> LogMapCursor;
+typedef IceDB::ReadWriteCursor<LogUpdate, LogEntry, IceDB::IceContext, Ice::OutputStreamPtr> LogMapRWCursor;
+
+}
+
+ReplicationLog::ReplicationLog() :
+    _size(0)
+{
+}
+
+ReplicationLog::ReplicationLog(const IceDB::ReadWriteTxn& txn, const IceDB::IceContext& ctx, size_t size) :
+    _map(txn, "log", ctx, MDB_CREATE, IceStormInternal::compareLogUpdate),
+    _size(size)
+{
+    if(_size == 0)
+    {
+        _map.clear(txn);
+    }
+}
+
+void
+ReplicationLog::append(const IceDB::ReadWriteTxn& txn, const LogUpdate& llu, const TopicDelta& delta)
+{
+    if(_size == 0)
+    {
+        return;
+    }
+
+    LogEntry entry;
+    entry.llu = llu;
+    entry.master = -1;
+    entry.deltas.push_back(delta);
+
+    LogMapCursor cursor(_map, txn);
+    LogUpdate k;
+    LogEntry last;
+    if(cursor.get(k, last, MDB_LAST) && k.generation == llu.generation)
+    {
+        entry.master = last.master;
+    }
+    cursor.close();
+
+    append(txn, entry);
+}
+
+void
+ReplicationLog::append(const IceDB::ReadWriteTxn& txn, const LogEntry& entry)
+{
+    if(_size == 0)
+    {
+        return;
+    }
+
+    _map.put(txn, entry.llu, entry);
+
+    MDB_stat stat;
+    int rc = mdb_stat(txn.mtxn(), _map.mdbi(), &stat);
+    if(rc != MDB_SUCCESS)
+    {
+        throw IceDB::LMDBException(__FILE__, __LINE__, rc);
+    }
+
+    LogMapRWCursor cursor(_map, txn);
+    LogUpdate k;
+    LogEntry v;
+    for(size_t n = stat.ms_entries; n > _size && cursor.get(k, v, MDB_FIRST); --n)
+    {
+        cursor.del();
+    }
+}
+
+void
+ReplicationLog::reset(const IceDB::ReadWriteTxn& txn, const LogEntry& entry)
+{
+    _map.clear(txn);
+    append(txn, entry);
+}
+
+bool
+ReplicationLog::read(const IceDB::Txn& txn, const LogUpdate& from, size_t max, LogEntrySeq& entries) const
+{
+    entries.clear();
+
+    LogEntry entry;
+    LogMapCursor cursor(_map, txn);
+    if(_size == 0 || !cursor.find(from, entry) || entry.master < 0)
+    {
+        return false;
+    }
+
+    entries.push_back(entry);
+    LogUpdate k;
+    while(entries.size() <= max && cursor.get(k, entry, MDB_NEXT))
+    {
+        entries.push_back(entry);
+    }
+    return true;
+}
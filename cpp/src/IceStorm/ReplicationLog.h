@@ -0,0 +1,74 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef REPLICATION_LOG_H
+#define REPLICATION_LOG_H
+
+#include <IceDB/IceDB.h>
+#include <IceStorm/Election.h>
+
+namespace IceStorm
+{
+
+typedef IceDB::Dbi<IceStormElection::LogUpdate, IceStormElection::LogEntry, IceDB::IceContext, Ice::OutputStreamPtr>
+        LogMap;
+
+//
+// The maximum number of log entries sent with a single call when a
+// replica retrieves or sends missed updates.
+//
+const int logChunkSize = 1000;
+
+//
+// The replication log. Each replica logs the database updates with
+// their log update token, in the transaction of the update. When the
+// replica group is formed, a replica which missed updates retrieves
+// them from the log of an up to date replica instead of the whole
+// database content. Only the last updates are kept, the oldest
+// entries are removed once the log reaches its size.
+//
+class ReplicationLog
+{
+public:
+
+    ReplicationLog();
+    ReplicationLog(const IceDB::ReadWriteTxn&, const IceDB::IceContext&, size_t);
+
+    //
+    // Log an update of the current generation, the update has the
+    // master of the last logged update of its generation.
+    //
+    void append(const IceDB::ReadWriteTxn&, const IceStormElection::LogUpdate&,
+                const IceStormElection::TopicDelta&);
+
+    void append(const IceDB::ReadWriteTxn&, const IceStormElection::LogEntry&);
+
+    //
+    // Remove all the entries and log the given entry, called when the
+    // database content is replaced.
+    //
+    void reset(const IceDB::ReadWriteTxn&, const IceStormElection::LogEntry&);
+
+    //
+    // Read the entry with the given log update token and up to the
+    // given number of following entries. Returns false if the update
+    // isn't logged or if its master is unknown.
+    //
+    bool read(const IceDB::Txn&, const IceStormElection::LogUpdate&, size_t,
+              IceStormElection::LogEntrySeq&) const;
+
+private:
+
+    LogMap _map;
+    size_t _size;
+};
+
+} // End namespace IceStorm
+
+#endif
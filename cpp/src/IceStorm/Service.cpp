@@ -497,6 +497,7 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "Publish.PublishedEndpoints",
         "Publish.ReplicaGroupId",
         "Publish.Router",
+        "Publish.ThreadPool.Serialize",
         "Publish.ThreadPool.Size",
         "Publish.ThreadPool.SizeMax",
         "Publish.ThreadPool.SizeWarn",
@@ -535,9 +536,28 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "Trace.Topic",
         "Trace.TopicManager",
         "Send.Timeout",
+        "Send.QueueSizeMax",
+        "Send.QueueMemoryMax",
+        "Send.QueueOverflow",
+        "Send.Threads",
+        "Link.OutstandingMax",
+        "Link.BatchSizeMax",
+        "Link.BatchTimeout",
+        "Link.Compress",
+        "Link.Serialized",
         "Discard.Interval",
+        "Coalesce.*",
+        "LastValues.SizeMax",
         "LMDB.Path",
-        "LMDB.MapSize"
+        "LMDB.MapSize",
+        "LMDB.CommitWindow",
+        "LMDB.CommitBatchMax",
+        "LMDB.ReplicationLogSize",
+        "EventLog.Enabled",
+        "EventLog.SegmentSize",
+        "EventLog.RetentionSize",
+        "EventLog.RetentionTime",
+        "EventLog.Sync"
     };
 
     vector<string> unknownProps;
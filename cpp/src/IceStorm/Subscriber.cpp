@@ -11,8 +11,10 @@
 #include <IceStorm/Instance.h>
 #include <IceStorm/TraceLevels.h>
 #include <IceStorm/NodeI.h>
+#include <IceStorm/DeliveryPool.h>
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
+#include <IceUtil/StringUtil.h>
 #include <iterator>
 
 using namespace std;
@@ -67,7 +69,7 @@ public:
 
         EventDataSeq e;
         e.push_back(event);
-        _subscriber->queue(false, e);
+        _subscriber->queue(false, new EventBatch(e));
         return true;
     }
 
@@ -78,6 +80,101 @@ private:
 };
 typedef IceUtil::Handle<PerSubscriberPublisherI> PerSubscriberPublisherIPtr;
 
+//
+// The number of logged events read at once when replaying events.
+//
+const size_t replayChunkSize = 1000;
+
+size_t
+eventMemory(const EventDataPtr& event)
+{
+    return event->data.size();
+}
+
+size_t
+eventsMemory(EventDataSeq::const_iterator p, EventDataSeq::const_iterator end)
+{
+    size_t memory = 0;
+    for(; p != end; ++p)
+    {
+        memory += eventMemory(*p);
+    }
+    return memory;
+}
+
+EventQueue::OverflowPolicy
+toOverflowPolicy(const string& policy)
+{
+    if(policy == "DropOldest")
+    {
+        return EventQueue::DropOldest;
+    }
+    else if(policy == "DropNewest")
+    {
+        return EventQueue::DropNewest;
+    }
+    else if(policy == "Disconnect")
+    {
+        return EventQueue::Disconnect;
+    }
+    throw BadQoS("invalid queueOverflow: " + policy);
+}
+
+string
+queueOverflow(const QoS& qos, const string& defaultValue)
+{
+    QoS::const_iterator p = qos.find("queueOverflow");
+    return p != qos.end() ? p->second : defaultValue;
+}
+
+//
+// Get the event queue limit from the subscriber QoS or the default
+// from the configuration.
+//
+size_t
+queueLimit(const QoS& qos, const string& name, int defaultValue)
+{
+    int value = defaultValue;
+    QoS::const_iterator p = qos.find(name);
+    if(p != qos.end())
+    {
+        value = atoi(p->second.c_str());
+    }
+    return value > 0 ? static_cast<size_t>(value) : 0;
+}
+
+//
+// Check whether the subscriber requested the cached last values of a
+// coalescing topic.
+//
+bool
+lastValues(const QoS& qos)
+{
+    QoS::const_iterator p = qos.find("lastValues");
+    if(p == qos.end())
+    {
+        return false;
+    }
+
+    Ice::Long value;
+    if(!IceUtilInternal::stringToInt64(p->second, value) || value < 0 || value > 1)
+    {
+        throw BadQoS("invalid lastValues: " + p->second);
+    }
+    return value == 1;
+}
+
+//
+// The proxy used by a link to forward the events, protocol compression
+// is only enabled if Link.Compress is set.
+//
+TopicLinkPrx
+linkProxy(const InstancePtr& instance, const Ice::ObjectPrx& obj)
+{
+    Ice::ObjectPrx proxy = obj->ice_collocationOptimized(false)->ice_timeout(instance->sendTimeout());
+    return TopicLinkPrx::uncheckedCast(instance->linkCompress() ? proxy->ice_compress(true) : proxy);
+}
+
 IceStorm::Instrumentation::SubscriberState
 toSubscriberState(Subscriber::SubscriberState s)
 {
@@ -168,11 +265,39 @@ public:
     SubscriberLink(const InstancePtr&, const SubscriberRecord&);
 
     virtual void flush();
+    virtual void destroy();
+
+    void forwarded(const Ice::AsyncResultPtr&);
+    void batchTimeout(const IceUtil::TimerTaskPtr&);
 
 private:
 
+    void forward(bool);
+
     const TopicLinkPrx _obj;
+    const size_t _batchSizeMax; // The maximum number of events forwarded with a single call, 0 for no limit.
+    const IceUtil::Time _batchTimeout; // How long to wait for a batch to fill up, 0 to forward right away.
+
+    IceUtil::TimerTaskPtr _batchTask; // The pending batch timeout, 0 if none.
+};
+typedef IceUtil::Handle<SubscriberLink> SubscriberLinkPtr;
+
+//
+// The number of events forwarded by a link call, set as the cookie
+// of the call since a link can have several calls outstanding.
+//
+class ForwardCookie : public Ice::LocalObject
+{
+public:
+
+    ForwardCookie(Ice::Int c) :
+        count(c)
+    {
+    }
+
+    const Ice::Int count;
 };
+typedef IceUtil::Handle<ForwardCookie> ForwardCookiePtr;
 
 class FlushTimerTask : public IceUtil::TimerTask
 {
@@ -194,6 +319,26 @@ private:
     const SubscriberBatchPtr _subscriber;
 };
 
+class BatchTimeoutTask : public IceUtil::TimerTask
+{
+public:
+
+    BatchTimeoutTask(const SubscriberLinkPtr& subscriber) :
+        _subscriber(subscriber)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        _subscriber->batchTimeout(this);
+    }
+
+private:
+
+    const SubscriberLinkPtr _subscriber;
+};
+
 }
 
 SubscriberBatch::SubscriberBatch(
@@ -237,7 +382,7 @@ SubscriberBatch::doFlush()
     }
 
     EventDataSeq v;
-    v.swap(_events);
+    _events.popAll(v);
     assert(!v.empty());
     
     if(_observer)
@@ -350,8 +495,7 @@ SubscriberOneway::flush()
         // Dequeue the head event, count one more outstanding AMI
         // request.
         //
-        EventDataPtr e = _events.front();
-        _events.erase(_events.begin());
+        EventDataPtr e = _events.pop();
         if(_observer)
         {
             _observer->outstanding(1);
@@ -445,8 +589,7 @@ SubscriberTwoway::flush()
         // Dequeue the head event, count one more outstanding AMI
         // request.
         //
-        EventDataPtr e = _events.front();
-        _events.erase(_events.begin());
+        EventDataPtr e = _events.pop();
         ++_outstanding;
         if(_observer)
         {
@@ -472,8 +615,10 @@ namespace
 SubscriberLink::SubscriberLink(
     const InstancePtr& instance,
     const SubscriberRecord& rec) :
-    Subscriber(instance, rec, 0, -1, 1),
-    _obj(TopicLinkPrx::uncheckedCast(rec.obj->ice_collocationOptimized(false)->ice_timeout(instance->sendTimeout())))
+    Subscriber(instance, rec, 0, -1, instance->linkOutstandingMax()),
+    _obj(linkProxy(instance, rec.obj)),
+    _batchSizeMax(static_cast<size_t>(instance->linkBatchSizeMax())),
+    _batchTimeout(instance->linkBatchTimeout())
 {
 }
 
@@ -481,54 +626,732 @@ void
 SubscriberLink::flush()
 {
     IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
-    
-    if(_state != SubscriberStateOnline || _outstanding > 0)
+    forward(false);
+}
+
+void
+SubscriberLink::destroy()
+{
     {
-        return;
+        //
+        // The batch timeout task holds a reference on the link, cancel
+        // it so that the link isn't kept alive until it runs.
+        //
+        IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+        if(_batchTask)
+        {
+            _instance->batchFlusher()->cancel(_batchTask);
+            _batchTask = 0;
+        }
     }
+    Subscriber::destroy();
+}
 
-    EventDataSeq v;
-    v.swap(_events);
+void
+SubscriberLink::forwarded(const Ice::AsyncResultPtr& result)
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+    _outstandingCount = ForwardCookiePtr::dynamicCast(result->getCookie())->count;
+    completed(result);
+}
 
-    EventDataSeq::iterator p = v.begin();
-    while(p != v.end())
+void
+SubscriberLink::batchTimeout(const IceUtil::TimerTaskPtr& task)
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+    if(task != _batchTask)
+    {
+        return; // The batch was already forwarded.
+    }
+    _batchTask = 0;
+    forward(true);
+}
+
+void
+SubscriberLink::forward(bool timeout)
+{
+    if(_state != SubscriberStateOnline)
     {
-        if(_rec.cost != 0)
+        return;
+    }
+
+    //
+    // Forward the queued events in batches of up to _batchSizeMax
+    // events, with up to _maxOutstanding calls outstanding. If a batch
+    // timeout is configured, a partial batch is only forwarded once
+    // the timeout expires.
+    //
+    while(_outstanding < _maxOutstanding && !_events.empty())
+    {
+        if(!timeout && _batchTimeout > IceUtil::Time() && (_batchSizeMax == 0 || _events.size() < _batchSizeMax))
         {
-            int cost = 0;
-            Ice::Context::const_iterator q = (*p)->context.find("cost");
-            if(q != (*p)->context.end())
+            if(!_batchTask)
             {
-                cost = atoi(q->second.c_str());
+                _batchTask = new BatchTimeoutTask(this);
+                _instance->batchFlusher()->schedule(_batchTask, _batchTimeout);
             }
-            if(cost > _rec.cost)
+            return;
+        }
+
+        EventDataSeq v;
+        if(_batchSizeMax == 0)
+        {
+            _events.popAll(v);
+        }
+        else
+        {
+            while(v.size() < _batchSizeMax && !_events.empty())
             {
-                p = v.erase(p);
-                continue;
+                v.push_back(_events.pop());
             }
         }
-        ++p;
-    }
 
-    if(!v.empty())
-    {
+        EventDataSeq::iterator p = v.begin();
+        while(p != v.end())
+        {
+            if(_rec.cost != 0)
+            {
+                int cost = 0;
+                Ice::Context::const_iterator q = (*p)->context.find("cost");
+                if(q != (*p)->context.end())
+                {
+                    cost = atoi(q->second.c_str());
+                }
+                if(cost > _rec.cost)
+                {
+                    p = v.erase(p);
+                    continue;
+                }
+            }
+            ++p;
+        }
+
+        if(v.empty())
+        {
+            continue;
+        }
+
+        if(_batchTask)
+        {
+            _instance->batchFlusher()->cancel(_batchTask);
+            _batchTask = 0;
+        }
+
         try
         {
             ++_outstanding;
             if(_observer)
             {
-                _outstandingCount = static_cast<Ice::Int>(v.size());
-                _observer->outstanding(_outstandingCount);
+                _observer->outstanding(static_cast<Ice::Int>(v.size()));
             }
-            _obj->begin_forward(v, Ice::newCallback(static_cast<Subscriber*>(this), &Subscriber::completed));
+            _obj->begin_forward(v, Ice::newCallback(this, &SubscriberLink::forwarded),
+                                new ForwardCookie(static_cast<Ice::Int>(v.size())));
         }
         catch(const Ice::Exception& ex)
         {
             error(true, ex);
+            return;
+        }
+    }
+}
+
+}
+
+EventBatch::EventBatch(const EventDataSeq& e) :
+    events(e),
+    memory(eventsMemory(e.begin(), e.end()))
+{
+}
+
+EventCoalescerPtr
+EventCoalescer::create(const string& key)
+{
+    const string contextPrefix = "context.";
+    if(key == "operation")
+    {
+        return new EventCoalescer("");
+    }
+    else if(key.compare(0, contextPrefix.size(), contextPrefix) == 0 && key.size() > contextPrefix.size())
+    {
+        return new EventCoalescer(key.substr(contextPrefix.size()));
+    }
+    return 0;
+}
+
+bool
+EventCoalescer::key(const EventDataPtr& event, Key& k) const
+{
+    k.first = event->op;
+    if(_context.empty())
+    {
+        k.second.clear();
+        return true;
+    }
+
+    Ice::Context::const_iterator p = event->context.find(_context);
+    if(p == event->context.end())
+    {
+        return false;
+    }
+    k.second = p->second;
+    return true;
+}
+
+EventCoalescer::EventCoalescer(const string& context) :
+    _context(context)
+{
+}
+
+EventQueue::EventQueue(size_t sizeMax, size_t memoryMax, OverflowPolicy policy, const EventCoalescerPtr& coalescer) :
+    _sizeMax(sizeMax),
+    _memoryMax(memoryMax),
+    _policy(policy),
+    _first(0),
+    _count(0),
+    _size(0),
+    _memory(0),
+    _replayNext(0),
+    _replayEnd(0),
+    _coalescer(coalescer),
+    _coalescedFirst(0)
+{
+}
+
+bool
+EventQueue::push(const EventBatchPtr& batch, size_t& dropped)
+{
+    dropped = 0;
+
+    if(_coalescer)
+    {
+        return coalesce(batch, dropped);
+    }
+
+    size_t begin = 0;
+    size_t end = batch->events.size();
+    size_t memory = batch->memory;
+    if(begin == end)
+    {
+        return true;
+    }
+
+    if(overflows(end - begin, memory))
+    {
+        switch(_policy)
+        {
+        case Disconnect:
+        {
+            return false;
+        }
+
+        case DropNewest:
+        {
+            //
+            // Only queue the first events of the batch which fit in
+            // the queue.
+            //
+            memory = 0;
+            end = 0;
+            while(end < batch->events.size() &&
+                  !overflows(end + 1, memory + eventMemory(batch->events[end])))
+            {
+                memory += eventMemory(batch->events[end]);
+                ++end;
+            }
+            dropped = batch->events.size() - end;
+            break;
+        }
+
+        case DropOldest:
+        {
+            //
+            // Drop the first events of the batch if the batch doesn't
+            // fit in an empty queue, then drop the oldest queued
+            // events until the remaining events of the batch fit.
+            //
+            while(begin < end && ((_sizeMax > 0 && end - begin > _sizeMax) || (_memoryMax > 0 && memory > _memoryMax)))
+            {
+                memory -= eventMemory(batch->events[begin]);
+                ++begin;
+                ++dropped;
+            }
+            while(overflows(end - begin, memory))
+            {
+                popLive();
+                ++dropped;
+            }
+            break;
+        }
+        }
+    }
+
+    if(begin < end)
+    {
+        add(batch, begin, end, memory);
+    }
+    return true;
+}
+
+void
+EventQueue::replay(const EventLogPtr& log, Ice::Long from, Ice::Long to)
+{
+    _log = log;
+    _replayNext = from;
+    _replayEnd = to;
+    _replayed.clear();
+}
+
+EventDataPtr
+EventQueue::pop()
+{
+    fill();
+    if(!_replayed.empty())
+    {
+        EventDataPtr event = _replayed.front();
+        _replayed.pop_front();
+        return event;
+    }
+    return popLive();
+}
+
+EventDataPtr
+EventQueue::popLive()
+{
+    assert(_size > 0);
+    if(_coalescer)
+    {
+        EventDataPtr event = _coalesced.front();
+        _coalesced.pop_front();
+        ++_coalescedFirst;
+        EventCoalescer::Key key;
+        if(_coalescer->key(event, key))
+        {
+            _positions.erase(key);
+        }
+        --_size;
+        _memory -= eventMemory(event);
+        return event;
+    }
+
+    Range& range = _ring[_first];
+    EventDataPtr event = range.batch->events[range.begin];
+    if(++range.begin == range.end)
+    {
+        range.batch = 0;
+        _first = (_first + 1) & (_ring.size() - 1);
+        --_count;
+    }
+    --_size;
+    _memory -= eventMemory(event);
+    return event;
+}
+
+void
+EventQueue::popAll(EventDataSeq& v)
+{
+    fill();
+    if(!_replayed.empty())
+    {
+        v.insert(v.end(), _replayed.begin(), _replayed.end());
+        _replayed.clear();
+        return;
+    }
+
+    v.insert(v.end(), _coalesced.begin(), _coalesced.end());
+    for(size_t i = 0; i < _count; ++i)
+    {
+        const Range& range = _ring[(_first + i) & (_ring.size() - 1)];
+        v.insert(v.end(), range.batch->events.begin() + range.begin, range.batch->events.begin() + range.end);
+    }
+    clear();
+}
+
+void
+EventQueue::clear()
+{
+    for(size_t i = 0; i < _count; ++i)
+    {
+        _ring[(_first + i) & (_ring.size() - 1)].batch = 0;
+    }
+    _first = 0;
+    _count = 0;
+    _size = 0;
+    _memory = 0;
+
+    _log = 0;
+    _replayNext = 0;
+    _replayEnd = 0;
+    _replayed.clear();
+
+    _coalesced.clear();
+    _coalescedFirst = 0;
+    _positions.clear();
+}
+
+bool
+EventQueue::overflows(size_t size, size_t memory) const
+{
+    return (_sizeMax > 0 && _size + size > _sizeMax) || (_memoryMax > 0 && _memory + memory > _memoryMax);
+}
+
+void
+EventQueue::add(const EventBatchPtr& batch, size_t begin, size_t end, size_t memory)
+{
+    if(_count == _ring.size())
+    {
+        //
+        // Double the capacity of the ring and move the ranges to the
+        // beginning of the new ring.
+        //
+        vector<Range> ring(_ring.empty() ? 16 : _ring.size() * 2);
+        for(size_t i = 0; i < _count; ++i)
+        {
+            ring[i] = _ring[(_first + i) & (_ring.size() - 1)];
+        }
+        _ring.swap(ring);
+        _first = 0;
+    }
+
+    Range& range = _ring[(_first + _count) & (_ring.size() - 1)];
+    range.batch = batch;
+    range.begin = begin;
+    range.end = end;
+    ++_count;
+    _size += end - begin;
+    _memory += memory;
+}
+
+bool
+EventQueue::coalesce(const EventBatchPtr& batch, size_t& dropped)
+{
+    EventCoalescer::Key key;
+    for(EventDataSeq::const_iterator p = batch->events.begin(); p != batch->events.end(); ++p)
+    {
+        size_t memory = eventMemory(*p);
+        bool coalesced = _coalescer->key(*p, key);
+        if(coalesced)
+        {
+            map<EventCoalescer::Key, Ice::Long>::const_iterator q = _positions.find(key);
+            if(q != _positions.end())
+            {
+                //
+                // Replace the queued event of the same key, the
+                // replaced event is released right away.
+                //
+                EventDataPtr& queued = _coalesced[static_cast<size_t>(q->second - _coalescedFirst)];
+                _memory = _memory - eventMemory(queued) + memory;
+                queued = *p;
+                continue;
+            }
+        }
+
+        if(overflows(1, memory))
+        {
+            if(_policy == Disconnect)
+            {
+                return false;
+            }
+
+            //
+            // Drop the event if it doesn't fit in an empty queue,
+            // otherwise drop the oldest queued events.
+            //
+            if(_policy == DropNewest || (_memoryMax > 0 && memory > _memoryMax))
+            {
+                ++dropped;
+                continue;
+            }
+
+            while(_size > 0 && overflows(1, memory))
+            {
+                popLive();
+                ++dropped;
+            }
+        }
+
+        if(coalesced)
+        {
+            _positions[key] = _coalescedFirst + static_cast<Ice::Long>(_coalesced.size());
+        }
+        _coalesced.push_back(*p);
+        ++_size;
+        _memory += memory;
+    }
+    return true;
+}
+
+void
+EventQueue::fill()
+{
+    //
+    // Read the next chunk of logged events once the previous one is
+    // sent.
+    //
+    if(_log && _replayed.empty())
+    {
+        _replayNext = _log->read(_replayNext, _replayEnd, replayChunkSize, _replayed);
+        if(_replayNext >= _replayEnd)
+        {
+            _log = 0;
+        }
+    }
+}
+
+EventFilterPtr
+EventFilter::create(const QoS& qos)
+{
+    EventFilterPtr filter;
+    const string contextPrefix = "filter.context.";
+    for(QoS::const_iterator p = qos.begin(); p != qos.end(); ++p)
+    {
+        if(p->first == "filter.operation")
+        {
+            if(!filter)
+            {
+                filter = new EventFilter;
+            }
+
+            string::size_type beg = 0;
+            while(beg <= p->second.size())
+            {
+                string::size_type end = p->second.find(',', beg);
+                if(end == string::npos)
+                {
+                    end = p->second.size();
+                }
+                string operation = IceUtilInternal::trim(p->second.substr(beg, end - beg));
+                if(!operation.empty())
+                {
+                    filter->_operations.insert(operation);
+                }
+                beg = end + 1;
+            }
+            if(filter->_operations.empty())
+            {
+                throw BadQoS("invalid filter.operation: no operation names");
+            }
+        }
+        else if(p->first.compare(0, contextPrefix.size(), contextPrefix) == 0)
+        {
+            string key = p->first.substr(contextPrefix.size());
+            if(key.empty())
+            {
+                throw BadQoS("invalid " + p->first + ": no context key");
+            }
+            if(!filter)
+            {
+                filter = new EventFilter;
+            }
+            filter->_context[key] = p->second;
+        }
+        else if(p->first.compare(0, 7, "filter.") == 0)
+        {
+            throw BadQoS("unknown filter: " + p->first);
+        }
+    }
+    return filter;
+}
+
+bool
+EventFilter::match(const EventDataPtr& event) const
+{
+    if(!_operations.empty() && _operations.find(event->op) == _operations.end())
+    {
+        return false;
+    }
+
+    for(map<string, string>::const_iterator p = _context.begin(); p != _context.end(); ++p)
+    {
+        Ice::Context::const_iterator q = event->context.find(p->first);
+        if(q == event->context.end() || (!p->second.empty() && q->second != p->second))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+LastValueCache::LastValueCache(const EventCoalescerPtr& coalescer, size_t sizeMax) :
+    _coalescer(coalescer),
+    _sizeMax(sizeMax)
+{
+}
+
+void
+LastValueCache::update(const EventDataSeq& events)
+{
+    EventCoalescer::Key key;
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        if(!_coalescer->key(*p, key))
+        {
+            continue;
+        }
+
+        map<EventCoalescer::Key, EventList::iterator>::iterator q = _positions.find(key);
+        if(q != _positions.end())
+        {
+            _events.erase(q->second);
+            q->second = _events.insert(_events.end(), make_pair(key, *p));
+            continue;
+        }
+
+        if(_sizeMax > 0 && _positions.size() == _sizeMax)
+        {
+            _positions.erase(_events.front().first);
+            _events.pop_front();
+        }
+        _positions[key] = _events.insert(_events.end(), make_pair(key, *p));
+    }
+}
+
+void
+LastValueCache::queue(const SubscriberPtr& subscriber) const
+{
+    if(!lastValues(subscriber->record().theQoS) || _events.empty())
+    {
+        return;
+    }
+
+    EventFilterPtr filter = subscriber->filter();
+    EventDataSeq events;
+    for(EventList::const_iterator p = _events.begin(); p != _events.end(); ++p)
+    {
+        if(!filter || filter->match(p->second))
+        {
+            events.push_back(p->second);
+        }
+    }
+    if(!events.empty())
+    {
+        subscriber->queue(false, new EventBatch(events));
+    }
+}
+
+void
+LastValueCache::clear()
+{
+    _events.clear();
+    _positions.clear();
+}
+
+SubscriberSnapshot::SubscriberSnapshot(const vector<SubscriberPtr>& s) :
+    subscribers(s)
+{
+    for(vector<SubscriberPtr>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+    {
+        EventFilterPtr filter = (*p)->filter();
+        if(!filter)
+        {
+            _unfiltered.push_back(*p);
+            continue;
+        }
+
+        //
+        // Index the subscriber with the operations of its filter or,
+        // if there are none, with the first context entry. An event
+        // has a single operation and context keys are unique so the
+        // lookup of an event returns a subscriber at most once.
+        //
+        size_t index = _filtered.size();
+        _filtered.push_back(*p);
+        if(!filter->operations().empty())
+        {
+            for(set<string>::const_iterator q = filter->operations().begin(); q != filter->operations().end(); ++q)
+            {
+                _operations[*q].push_back(index);
+            }
+        }
+        else
+        {
+            assert(!filter->context().empty());
+            _context[*filter->context().begin()].push_back(index);
+        }
+    }
+}
+
+void
+SubscriberSnapshot::queue(bool forwarded, const EventDataSeq& events, Ice::IdentitySeq& reap) const
+{
+    //
+    // The subscribers without filter share the same batch of events.
+    //
+    if(!_unfiltered.empty())
+    {
+        EventBatchPtr batch = new EventBatch(events);
+        for(vector<SubscriberPtr>::const_iterator p = _unfiltered.begin(); p != _unfiltered.end(); ++p)
+        {
+            if(!(*p)->queue(forwarded, batch) && (*p)->reap())
+            {
+                reap.push_back((*p)->id());
+            }
+        }
+    }
+
+    if(_filtered.empty())
+    {
+        return;
+    }
+
+    //
+    // Match each event with the index and gather the events of each
+    // interested subscriber.
+    //
+    map<size_t, EventDataSeq> matched;
+    vector<size_t> candidates;
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        candidates.clear();
+        lookup(*p, candidates);
+        for(vector<size_t>::const_iterator q = candidates.begin(); q != candidates.end(); ++q)
+        {
+            if(_filtered[*q]->filter()->match(*p))
+            {
+                matched[*q].push_back(*p);
+            }
+        }
+    }
+
+    for(map<size_t, EventDataSeq>::const_iterator p = matched.begin(); p != matched.end(); ++p)
+    {
+        const SubscriberPtr& subscriber = _filtered[p->first];
+        if(!subscriber->queue(forwarded, new EventBatch(p->second)) && subscriber->reap())
+        {
+            reap.push_back(subscriber->id());
         }
     }
 }
 
+void
+SubscriberSnapshot::lookup(const EventDataPtr& event, vector<size_t>& candidates) const
+{
+    OperationIndex::const_iterator p = _operations.find(event->op);
+    if(p != _operations.end())
+    {
+        candidates.insert(candidates.end(), p->second.begin(), p->second.end());
+    }
+
+    if(_context.empty())
+    {
+        return;
+    }
+
+    for(Ice::Context::const_iterator q = event->context.begin(); q != event->context.end(); ++q)
+    {
+        ContextIndex::const_iterator r = _context.find(*q);
+        if(r != _context.end())
+        {
+            candidates.insert(candidates.end(), r->second.begin(), r->second.end());
+        }
+        if(!q->second.empty())
+        {
+            r = _context.find(make_pair(q->first, string()));
+            if(r != _context.end())
+            {
+                candidates.insert(candidates.end(), r->second.begin(), r->second.end());
+            }
+        }
+    }
 }
 
 SubscriberPtr
@@ -571,6 +1394,12 @@ Subscriber::create(
                 throw BadQoS("invalid reliability: " + reliability);
             }
 
+            //
+            // Reject an invalid lastValues QoS before the subscriber
+            // is added to the topic.
+            //
+            lastValues(rec.theQoS);
+
             //
             // Override the timeout.
             //
@@ -646,6 +1475,12 @@ Subscriber::id() const
     return _rec.id;
 }
 
+EventFilterPtr
+Subscriber::filter() const
+{
+    return _filter;
+}
+
 SubscriberRecord
 Subscriber::record() const
 {
@@ -653,7 +1488,7 @@ Subscriber::record() const
 }
 
 bool
-Subscriber::queue(bool forwarded, const EventDataSeq& events)
+Subscriber::queue(bool forwarded, const EventBatchPtr& batch)
 {
     IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
 
@@ -682,13 +1517,86 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
     }
     
     case SubscriberStateOnline:
-        copy(events.begin(), events.end(), back_inserter(_events));
+    {
+        size_t dropped;
+        if(!_events.push(batch, dropped))
+        {
+            //
+            // The event queue overflowed with the Disconnect policy.
+            //
+            _events.clear();
+
+            TraceLevelsPtr traceLevels = _instance->traceLevels();
+            if(_rec.link)
+            {
+                //
+                // A link isn't reaped, that would remove it from all
+                // the replicas. The events are discarded until the
+                // downstream topic catches up, as if it was
+                // unreachable.
+                //
+                _next = IceUtil::Time::now(IceUtil::Time::Monotonic) + _instance->discardInterval();
+                setState(SubscriberStateOffline);
+                if(traceLevels->subscriber > 0)
+                {
+                    Ice::Trace out(traceLevels->logger, traceLevels->subscriberCat);
+                    out << _instance->communicator()->identityToString(_rec.id);
+                    if(traceLevels->subscriber > 1)
+                    {
+                        out << " endpoints: " << IceStormInternal::describeEndpoints(_rec.obj);
+                    }
+                    out << " subscriber offline: event queue overflow discarding events: "
+                        << _instance->discardInterval() << "s";
+                }
+                if(_shutdown)
+                {
+                    _lock.notify();
+                }
+                return true;
+            }
+
+            setState(SubscriberStateError);
+            if(traceLevels->subscriber > 0)
+            {
+                Ice::Trace out(traceLevels->logger, traceLevels->subscriberCat);
+                out << _instance->communicator()->identityToString(_rec.id);
+                if(traceLevels->subscriber > 1)
+                {
+                    out << " endpoints: " << IceStormInternal::describeEndpoints(_rec.obj);
+                }
+                out << " subscriber errored out: event queue overflow";
+            }
+
+            if(_shutdown)
+            {
+                _lock.notify();
+            }
+            return false;
+        }
+
         if(_observer)
         {
-            _observer->queued(static_cast<Ice::Int>(events.size()));
+            _observer->queued(static_cast<Ice::Int>(batch->events.size()));
+            if(dropped > 0)
+            {
+                _observer->dropped(static_cast<Ice::Int>(dropped));
+            }
         }
-        flush();
+
+        if(dropped > 0)
+        {
+            TraceLevelsPtr traceLevels = _instance->traceLevels();
+            if(traceLevels->subscriber > 1)
+            {
+                Ice::Trace out(traceLevels->logger, traceLevels->subscriberCat);
+                out << _instance->communicator()->identityToString(_rec.id) << " event queue overflow: dropped "
+                    << dropped << " events";
+            }
+        }
+
+        send();
         break;
+    }
 
     case SubscriberStateError:
         return false;
@@ -700,6 +1608,27 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
     return true;
 }
 
+void
+Subscriber::replay(const EventLogPtr& log, Ice::Long from, Ice::Long to)
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+    if(_state != SubscriberStateOnline)
+    {
+        return;
+    }
+
+    _events.replay(log, from, to);
+    send();
+}
+
+void
+Subscriber::deliver()
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+    _scheduled = false;
+    flush();
+}
+
 bool
 Subscriber::reap()
 {
@@ -936,10 +1865,17 @@ Subscriber::Subscriber(
     _maxOutstanding(maxOutstanding),
     _proxy(proxy),
     _proxyReplica(proxy),
+    _filter(rec.link ? EventFilterPtr() : EventFilter::create(rec.theQoS)),
     _shutdown(false),
     _state(SubscriberStateOnline),
     _outstanding(0),
     _outstandingCount(1),
+    _events(queueLimit(rec.theQoS, "queueSizeMax", instance->sendQueueSizeMax()),
+            queueLimit(rec.theQoS, "queueMemoryMax", instance->sendQueueMemoryMax()),
+            toOverflowPolicy(queueOverflow(rec.theQoS, instance->sendQueueOverflow())),
+            rec.link ? EventCoalescerPtr() : instance->coalescer(rec.topicName)),
+    _shard(instance->deliveryPool() ? instance->deliveryPool()->shard(rec.id) : -1),
+    _scheduled(false),
     _currentRetry(0)
 {
     if(_proxy && _instance->publisherReplicaProxy())
@@ -983,6 +1919,24 @@ stateToString(Subscriber::SubscriberState state)
 
 }
 
+void
+Subscriber::send()
+{
+    //
+    // Send the queued events with this thread or schedule the sending
+    // with the delivery pool.
+    //
+    if(_shard < 0)
+    {
+        flush();
+    }
+    else if(!_scheduled)
+    {
+        _scheduled = true;
+        _instance->deliveryPool()->schedule(_shard, this);
+    }
+}
+
 void
 Subscriber::setState(Subscriber::SubscriberState state)
 {
@@ -13,9 +13,15 @@
 #include <IceStorm/IceStormInternal.h>
 #include <IceStorm/SubscriberRecord.h>
 #include <IceStorm/Instrumentation.h>
+#include <IceStorm/EventLog.h>
 #include <Ice/ObserverHelper.h>
 #include <IceUtil/RecMutex.h>
 
+#include <set>
+#include <map>
+#include <list>
+#include <deque>
+
 namespace IceStorm
 {
 
@@ -25,6 +31,276 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+//
+// A batch of published events. The batch is shared by all the
+// subscribers of the topic, queueing the batch with a subscriber
+// doesn't copy the events.
+//
+class EventBatch : public IceUtil::Shared
+{
+public:
+
+    EventBatch(const EventDataSeq&);
+
+    const EventDataSeq events;
+    const size_t memory; // The size of the parameters of the events.
+};
+typedef IceUtil::Handle<EventBatch> EventBatchPtr;
+
+class EventCoalescer;
+typedef IceUtil::Handle<EventCoalescer> EventCoalescerPtr;
+
+//
+// The coalescing key of the events of a topic, configured with the
+// <service>.Coalesce.<topic> property:
+//
+// - operation: the events are coalesced by operation name.
+//
+// - context.<key>: the events are coalesced by operation name and
+//   value of the given context entry. The events without this entry
+//   are not coalesced.
+//
+// The queue of a subscriber only keeps the last event of each key
+// and the topic caches the last event of each key for the new
+// subscribers.
+//
+class EventCoalescer : public IceUtil::Shared
+{
+public:
+
+    typedef std::pair<std::string, std::string> Key;
+
+    //
+    // Returns 0 if the key isn't valid.
+    //
+    static EventCoalescerPtr create(const std::string&);
+
+    //
+    // Get the key of the event, returns false if the event isn't
+    // coalesced.
+    //
+    bool key(const EventDataPtr&, Key&) const;
+
+private:
+
+    EventCoalescer(const std::string&);
+
+    const std::string _context; // The context key, empty to coalesce by operation.
+};
+
+//
+// The queue of events of a subscriber. The queue is a ring buffer of
+// ranges of queued batches. It's bounded by the maximum number of
+// events and the maximum size of the event parameters (0 for no
+// limit). Once a limit is reached, the overflow policy decides which
+// events are dropped.
+//
+// Events replayed from the topic event log are read in chunks as the
+// queue is drained and are returned before the queued events, they
+// don't count for the limits.
+//
+// If the topic coalesces its events, the events are queued one by one
+// instead: an event replaces the queued event with the same key, if
+// any, and takes its position in the queue. Replacing an event never
+// overflows the queue.
+//
+class EventQueue
+{
+public:
+
+    enum OverflowPolicy
+    {
+        DropOldest, // Drop the oldest queued events.
+        DropNewest, // Drop the events being queued.
+        Disconnect // Don't queue the events, the subscriber is disconnected.
+    };
+
+    EventQueue(size_t, size_t, OverflowPolicy, const EventCoalescerPtr& = 0);
+
+    //
+    // Queue a batch of events and set the number of dropped events.
+    // Returns false if the queue overflows with the Disconnect policy,
+    // the events are not queued in this case.
+    //
+    bool push(const EventBatchPtr&, size_t&);
+
+    //
+    // Replay the logged events whose sequence number is in [from, to)
+    // before the queued events.
+    //
+    void replay(const EventLogPtr&, Ice::Long, Ice::Long);
+
+    EventDataPtr pop();
+    void popAll(EventDataSeq&); // Only returns the replayed events while replaying.
+    void clear();
+
+    bool empty()
+    {
+        fill();
+        return _size == 0 && _replayed.empty();
+    }
+
+    size_t size() const
+    {
+        return _size + _replayed.size();
+    }
+
+    size_t memory() const
+    {
+        return _memory;
+    }
+
+private:
+
+    struct Range
+    {
+        EventBatchPtr batch;
+        size_t begin;
+        size_t end;
+    };
+
+    bool overflows(size_t, size_t) const;
+    void add(const EventBatchPtr&, size_t, size_t, size_t);
+    bool coalesce(const EventBatchPtr&, size_t&);
+    void fill();
+    EventDataPtr popLive(); // Pops the oldest queued event, never a replayed one.
+
+    const size_t _sizeMax;
+    const size_t _memoryMax;
+    const OverflowPolicy _policy;
+
+    std::vector<Range> _ring; // The capacity is a power of 2.
+    size_t _first; // The position of the first range in the ring.
+    size_t _count; // The number of ranges.
+    size_t _size; // The number of queued events.
+    size_t _memory; // The size of the parameters of the queued events.
+
+    EventLogPtr _log; // The log of the replayed events, 0 if not replaying.
+    Ice::Long _replayNext; // The sequence number of the next replayed event.
+    Ice::Long _replayEnd;
+    EventDataSeq _replayed; // The replayed events read from the log.
+
+    const EventCoalescerPtr _coalescer; // 0 if the events aren't coalesced.
+    std::deque<EventDataPtr> _coalesced; // The queued events if coalescing, the ring isn't used.
+    Ice::Long _coalescedFirst; // The position of the first coalesced event.
+    std::map<EventCoalescer::Key, Ice::Long> _positions; // The position of the queued event of each key.
+};
+
+class EventFilter;
+typedef IceUtil::Handle<EventFilter> EventFilterPtr;
+
+//
+// The filter of a subscriber, created from the filter QoS of the
+// subscriber:
+//
+// - filter.operation: a comma separated list of operation names, the
+//   operation of the event must be one of them.
+//
+// - filter.context.<key>: the context of the event must contain the
+//   given key with the given value, or just the key if the value is
+//   empty.
+//
+// An event is sent to the subscriber only if it matches all the
+// filters.
+//
+class EventFilter : public IceUtil::Shared
+{
+public:
+
+    //
+    // Returns 0 if the QoS doesn't define a filter.
+    //
+    static EventFilterPtr create(const QoS&);
+
+    bool match(const EventDataPtr&) const;
+
+    const std::set<std::string>& operations() const
+    {
+        return _operations;
+    }
+
+    const std::map<std::string, std::string>& context() const
+    {
+        return _context;
+    }
+
+private:
+
+    std::set<std::string> _operations;
+    std::map<std::string, std::string> _context;
+};
+
+class LastValueCache;
+typedef IceUtil::Handle<LastValueCache> LastValueCachePtr;
+
+//
+// The last event of each key published on a coalescing topic. A new
+// subscriber with the lastValues QoS set to 1 first receives these
+// events, filtered with its filter, in the order they were published.
+//
+// The cache is bounded by the maximum number of keys (0 for no
+// limit), the event of the key updated least recently is evicted
+// once the limit is reached.
+//
+// The cache isn't synchronized, it's protected by the topic.
+//
+class LastValueCache : public IceUtil::Shared
+{
+public:
+
+    LastValueCache(const EventCoalescerPtr&, size_t);
+
+    void update(const EventDataSeq&);
+    void queue(const SubscriberPtr&) const;
+    void clear();
+
+private:
+
+    typedef std::list<std::pair<EventCoalescer::Key, EventDataPtr> > EventList;
+
+    const EventCoalescerPtr _coalescer;
+    const size_t _sizeMax;
+    EventList _events; // The last event of each key, the least recently updated first.
+    std::map<EventCoalescer::Key, EventList::iterator> _positions;
+};
+
+//
+// An immutable copy of the subscribers of a topic, shared by the
+// concurrent publish calls. The topic only creates a new copy once
+// its subscribers are modified.
+//
+// The subscribers with a filter are indexed by the operation or the
+// first context entry of their filter, this allows each event to be
+// matched once against the index to find the interested subscribers.
+//
+class SubscriberSnapshot : public IceUtil::Shared
+{
+public:
+
+    SubscriberSnapshot(const std::vector<SubscriberPtr>&);
+
+    //
+    // Queue the events with the subscribers and add the identity of
+    // the subscribers that must be reaped to the given sequence.
+    //
+    void queue(bool, const EventDataSeq&, Ice::IdentitySeq&) const;
+
+    const std::vector<SubscriberPtr> subscribers;
+
+private:
+
+    typedef std::map<std::string, std::vector<size_t> > OperationIndex;
+    typedef std::map<std::pair<std::string, std::string>, std::vector<size_t> > ContextIndex;
+
+    void lookup(const EventDataPtr&, std::vector<size_t>&) const;
+
+    std::vector<SubscriberPtr> _unfiltered;
+    std::vector<SubscriberPtr> _filtered;
+    OperationIndex _operations;
+    ContextIndex _context;
+};
+typedef IceUtil::Handle<SubscriberSnapshot> SubscriberSnapshotPtr;
+
 class Subscriber : public IceUtil::Shared
 {
 public:
@@ -35,15 +311,17 @@ public:
 
     Ice::ObjectPrx proxy() const; // Get the per subscriber object.
     Ice::Identity id() const; // Return the id of the subscriber.
+    EventFilterPtr filter() const; // Return the filter of the subscriber, 0 if none.
     IceStorm::SubscriberRecord record() const; // Get the subscriber record.
 
     // Returns false if the subscriber should be reaped.
-    bool queue(bool, const EventDataSeq&);
+    bool queue(bool, const EventBatchPtr&);
+    void replay(const EventLogPtr&, Ice::Long, Ice::Long); // Replay the logged events in [from, to).
     bool reap();
     void resetIfReaped();
     bool errored() const;
 
-    void destroy();
+    virtual void destroy();
 
     // To be called by the AMI callbacks only.
     void completed(const Ice::AsyncResultPtr&);
@@ -63,9 +341,13 @@ public:
 
     virtual void flush() = 0;
 
+    // To be called by the delivery pool only.
+    void deliver();
+
 protected:
 
     void setState(SubscriberState);
+    void send();
 
     Subscriber(const InstancePtr&, const IceStorm::SubscriberRecord&, const Ice::ObjectPrx&, int, int);
 
@@ -76,6 +358,7 @@ protected:
     const int _maxOutstanding; // The maximum number of oustanding events.
     const Ice::ObjectPrx _proxy; // The per subscriber object proxy, if any.
     const Ice::ObjectPrx _proxyReplica; // The replicated per subscriber object proxy, if any.
+    const EventFilterPtr _filter; // The filter of the subscriber, if any.
 
     IceUtil::Monitor<IceUtil::RecMutex> _lock;
 
@@ -85,7 +368,10 @@ protected:
 
     int _outstanding; // The current number of outstanding responses.
     int _outstandingCount; // The current number of outstanding events when batching events (only used for metrics).
-    EventDataSeq _events; // The queue of events to send.
+    EventQueue _events; // The queue of events to send.
+
+    const int _shard; // The delivery pool shard, -1 if events are sent by the publisher thread.
+    bool _scheduled; // True if the delivery is scheduled with the delivery pool.
 
     // The next time to try sending a new event if we're offline.
     IceUtil::Time _next;
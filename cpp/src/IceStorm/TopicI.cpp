@@ -15,6 +15,7 @@
 #include <IceStorm/Observers.h>
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
+#include <IceUtil/InputUtil.h>
 #include <algorithm>
 
 using namespace std;
@@ -347,8 +348,10 @@ TopicImpl::TopicImpl(
     _name(name),
     _id(id),
     _destroyed(false),
+    _committing(false),
     _lluMap(_instance->lluMap()),
-    _subscriberMap(_instance->subscriberMap())
+    _subscriberMap(_instance->subscriberMap()),
+    _replicationLog(_instance->replicationLog())
 {
     try
     {
@@ -385,6 +388,14 @@ TopicImpl::TopicImpl(
             linkid.name = _name + ".link";
         }
 
+        _eventLog = _instance->createEventLog(_name);
+
+        EventCoalescerPtr coalescer = _instance->coalescer(_name);
+        if(coalescer)
+        {
+            _lastValues = new LastValueCache(coalescer, static_cast<size_t>(_instance->lastValuesSizeMax()));
+        }
+
         _publisherPrx = _instance->publishAdapter()->add(new PublisherI(this, instance), pubid);
         _linkPrx = TopicLinkPrx::uncheckedCast(
             _instance->publishAdapter()->add(new TopicLinkI(this, instance), linkid));
@@ -414,6 +425,7 @@ TopicImpl::TopicImpl(
                 //
                 SubscriberPtr subscriber = Subscriber::create(_instance, *p);
                 _subscribers.push_back(subscriber);
+                _snapshot = 0;
             }
             catch(const Ice::Exception& ex)
             {
@@ -531,12 +543,12 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
 
             }
             out << " subscriptions: ";
+
+            IceUtil::Mutex::Lock sync(_subscribersMutex);
             trace(out, _instance, _subscribers);
         }
     }
 
-    IceUtil::Mutex::Lock sync(_subscribersMutex);
-
     SubscriberRecord record;
     record.id = id;
     record.obj = obj;
@@ -545,40 +557,9 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
     record.link = false;
     record.cost = 0;
 
-    vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), record.id);
-    if(p != _subscribers.end())
-    {
-        throw AlreadySubscribed();
-    }
-
-    LogUpdate llu;
-
-    SubscriberPtr subscriber = Subscriber::create(_instance, record);
-    try
-    {
-        IceDB::ReadWriteTxn txn(_instance->dbEnv());
-
-        SubscriberRecordKey key;
-        key.topic = _id;
-        key.id = subscriber->id();
-
-        _subscriberMap.put(txn, key, record);
-
-        llu = getIncrementedLLU(txn, _lluMap);
-
-        txn.commit();
-    }
-    catch(const IceDB::LMDBException& ex)
-    {
-        logError(_instance->communicator(), ex);
-        throw; // will become UnknownException in caller
-    }
-
-    _subscribers.push_back(subscriber);
-
-    _instance->observers()->addSubscriber(llu, _name, record);
-
-    return subscriber->proxy();
+    SubscriberUpdatePtr update = new SubscriberUpdate(record);
+    commitUpdate(update);
+    return update->proxy;
 }
 
 void
@@ -605,14 +586,13 @@ TopicImpl::unsubscribe(const Ice::ObjectPrx& subscriber)
         if(traceLevels->topic > 1)
         {
             out << " endpoints: " << IceStormInternal::describeEndpoints(subscriber);
+
+            IceUtil::Mutex::Lock sync(_subscribersMutex);
             trace(out, _instance, _subscribers);
         }
     }
 
-    IceUtil::Mutex::Lock sync(_subscribersMutex);
-    Ice::IdentitySeq ids;
-    ids.push_back(id);
-    removeSubscribers(ids);
+    commitUpdate(new SubscriberUpdate(id));
 }
 
 TopicLinkPrx
@@ -678,6 +658,12 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
 
         llu = getIncrementedLLU(txn, _lluMap);
 
+        TopicDelta delta;
+        delta.id = _id;
+        delta.destroyed = false;
+        delta.added.push_back(record);
+        _replicationLog.append(txn, llu, delta);
+
         txn.commit();
     }
     catch(const IceDB::LMDBException& ex)
@@ -687,6 +673,7 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
     }
 
     _subscribers.push_back(subscriber);
+    _snapshot = 0;
 
     _instance->observers()->addSubscriber(llu, _name, record);
 }
@@ -765,6 +752,11 @@ TopicImpl::shutdown()
         (*p)->shutdown();
     }
 
+    if(_eventLog)
+    {
+        _eventLog->close();
+    }
+
     _observer.detach();
 }
 
@@ -875,6 +867,7 @@ TopicImpl::update(const SubscriberRecordSeq& records)
             {
                 (*p)->destroy();
                 p = _subscribers.erase(p);
+                _snapshot = 0;
             }
             else
             {
@@ -899,6 +892,7 @@ TopicImpl::update(const SubscriberRecordSeq& records)
         {
             SubscriberPtr subscriber = Subscriber::create(_instance, *p);
             _subscribers.push_back(subscriber);
+            _snapshot = 0;
         }
     }
 }
@@ -975,10 +969,13 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
         CachedReadHelper unlock(_instance->node(), __FILE__, __LINE__);
 
         //
-        // Copy of the subscriber list so that event publishing can occur
-        // in parallel.
+        // Snapshot of the subscriber list so that event publishing can
+        // occur in parallel. The snapshot is shared with the other
+        // publish calls until the subscribers are modified.
         //
-        vector<SubscriberPtr> copy;
+        SubscriberSnapshotPtr snapshot;
+        EventDataSeq logged;
+        const EventDataSeq* queued = &events;
         {
             IceUtil::Mutex::Lock sync(_subscribersMutex);
             if(_observer)
@@ -992,21 +989,46 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
                     _observer->published();
                 }
             }
-            copy = _subscribers;
+            if(_eventLog)
+            {
+                //
+                // The sequence numbers are assigned with the mutex
+                // locked so that a subscriber resuming from the log
+                // doesn't miss or receive twice the events being
+                // published. The events are written once the mutex
+                // is unlocked.
+                //
+                logged = events;
+                _eventLog->append(logged);
+                queued = &logged;
+            }
+            if(_lastValues)
+            {
+                _lastValues->update(*queued);
+            }
+            if(!_snapshot)
+            {
+                _snapshot = new SubscriberSnapshot(_subscribers);
+            }
+            snapshot = _snapshot;
         }
 
-        //
-        // Queue each event, gathering a list of those subscribers that
-        // must be reaped.
-        //
-        for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
+        if(_eventLog)
         {
-            if(!(*p)->queue(forwarded, events) && (*p)->reap())
-            {
-                reap.push_back((*p)->id());
-            }
+            _eventLog->flush();
         }
 
+        if(snapshot->subscribers.empty())
+        {
+            return;
+        }
+
+        //
+        // Queue the events with each subscriber whose filter matches,
+        // gathering a list of those subscribers that must be reaped.
+        //
+        snapshot->queue(forwarded, *queued, reap);
+
         // If there are no subscribers in error then we're done.
         if(reap.empty())
         {
@@ -1091,6 +1113,12 @@ TopicImpl::observerAddSubscriber(const LogUpdate& llu, const SubscriberRecord& r
         // Update the LLU.
         _lluMap.put(txn, lluDbKey, llu);
 
+        TopicDelta delta;
+        delta.id = _id;
+        delta.destroyed = false;
+        delta.added.push_back(record);
+        _replicationLog.append(txn, llu, delta);
+
         txn.commit();
     }
     catch(const IceDB::LMDBException& ex)
@@ -1100,6 +1128,7 @@ TopicImpl::observerAddSubscriber(const LogUpdate& llu, const SubscriberRecord& r
     }
 
     _subscribers.push_back(subscriber);
+    _snapshot = 0;
 }
 
 void
@@ -1140,6 +1169,12 @@ TopicImpl::observerRemoveSubscriber(const LogUpdate& llu, const Ice::IdentitySeq
 
         _lluMap.put(txn, lluDbKey, llu);
 
+        TopicDelta delta;
+        delta.id = _id;
+        delta.destroyed = false;
+        delta.removed = ids;
+        _replicationLog.append(txn, llu, delta);
+
         txn.commit();
     }
     catch(const IceDB::LMDBException& ex)
@@ -1158,8 +1193,90 @@ TopicImpl::observerRemoveSubscriber(const LogUpdate& llu, const Ice::IdentitySeq
         {
             (*p)->destroy();
             _subscribers.erase(p);
+            _snapshot = 0;
+        }
+    }
+}
+
+void
+TopicImpl::observerUpdateSubscribers(const LogUpdate& llu, const SubscriberRecordSeq& added,
+                                     const Ice::IdentitySeq& removed)
+{
+    IceUtil::Mutex::Lock sync(_subscribersMutex);
+
+    TraceLevelsPtr traceLevels = _instance->traceLevels();
+    if(traceLevels->topic > 0)
+    {
+        Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+        out << _name << ": update replica observers: added: " << added.size() << " removed: " << removed.size();
+        out << " llu: " << llu.generation << "/" << llu.iteration;
+    }
+
+    //
+    // The subscribers are removed before the subscribers are added, a
+    // subscriber can be in both lists if it re-subscribed.
+    //
+    vector<SubscriberPtr> subscribers;
+    for(SubscriberRecordSeq::const_iterator p = added.begin(); p != added.end(); ++p)
+    {
+        if(find(_subscribers.begin(), _subscribers.end(), p->id) != _subscribers.end() &&
+           find(removed.begin(), removed.end(), p->id) == removed.end())
+        {
+            if(traceLevels->topic > 0)
+            {
+                Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+                out << _instance->communicator()->identityToString(p->id) << ": already subscribed";
+            }
+            continue;
+        }
+        subscribers.push_back(Subscriber::create(_instance, *p));
+    }
+
+    try
+    {
+        IceDB::ReadWriteTxn txn(_instance->dbEnv());
+
+        TopicDelta delta;
+        delta.id = _id;
+        delta.destroyed = false;
+        delta.removed = removed;
+
+        SubscriberRecordKey key;
+        key.topic = _id;
+        for(Ice::IdentitySeq::const_iterator p = removed.begin(); p != removed.end(); ++p)
+        {
+            key.id = *p;
+            _subscriberMap.del(txn, key);
+        }
+        for(vector<SubscriberPtr>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+        {
+            key.id = (*p)->id();
+            _subscriberMap.put(txn, key, (*p)->record());
+            delta.added.push_back((*p)->record());
+        }
+
+        _lluMap.put(txn, lluDbKey, llu);
+        _replicationLog.append(txn, llu, delta);
+
+        txn.commit();
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(_instance->communicator(), ex);
+        throw; // will become UnknownException in caller
+    }
+
+    for(Ice::IdentitySeq::const_iterator p = removed.begin(); p != removed.end(); ++p)
+    {
+        vector<SubscriberPtr>::iterator q = find(_subscribers.begin(), _subscribers.end(), *p);
+        if(q != _subscribers.end())
+        {
+            (*q)->destroy();
+            _subscribers.erase(q);
         }
     }
+    _subscribers.insert(_subscribers.end(), subscribers.begin(), subscribers.end());
+    _snapshot = 0;
 }
 
 void
@@ -1183,6 +1300,26 @@ TopicImpl::observerDestroyTopic(const LogUpdate& llu)
     destroyInternal(llu, false);
 }
 
+void
+TopicImpl::observerSyncDestroy()
+{
+    IceUtil::Mutex::Lock sync(_subscribersMutex);
+
+    if(_destroyed)
+    {
+        return;
+    }
+    _destroyed = true;
+
+    TraceLevelsPtr traceLevels = _instance->traceLevels();
+    if(traceLevels->topic > 0)
+    {
+        Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+        out << _name << ": destroyed by sync";
+    }
+    destroyServants();
+}
+
 Ice::ObjectPtr
 TopicImpl::getServant() const
 {
@@ -1247,6 +1384,11 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
             _lluMap.put(txn, lluDbKey, llu);
         }
 
+        TopicDelta delta;
+        delta.id = _id;
+        delta.destroyed = true;
+        _replicationLog.append(txn, llu, delta);
+
         txn.commit();
     }
     catch(const IceDB::LMDBException& ex)
@@ -1255,6 +1397,13 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
         throw; // will become UnknownException in caller
     }
 
+    destroyServants();
+    return llu;
+}
+
+void
+TopicImpl::destroyServants()
+{
     _instance->publishAdapter()->remove(_linkPrx->ice_getIdentity());
     _instance->publishAdapter()->remove(_publisherPrx->ice_getIdentity());
     _instance->topicReaper()->add(_name);
@@ -1265,12 +1414,304 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
         (*p)->destroy();
     }
     _subscribers.clear();
+    _snapshot = 0;
+
+    if(_eventLog)
+    {
+        _eventLog->destroy();
+    }
+    if(_lastValues)
+    {
+        _lastValues->clear();
+    }
 
     _instance->topicAdapter()->remove(_id);
 
     _servant = 0;
+}
 
-    return llu;
+void
+TopicImpl::commitUpdate(const SubscriberUpdatePtr& update)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_updateMonitor);
+
+    const size_t batchMax = _instance->commitBatchMax();
+    _updates.push_back(update);
+    if(_committing && _updates.size() == batchMax)
+    {
+        _updateMonitor.notifyAll(); // Wake up the thread waiting for the commit window.
+    }
+
+    while(!update->done)
+    {
+        if(_committing)
+        {
+            _updateMonitor.wait();
+            continue;
+        }
+
+        //
+        // No other thread is committing, this thread commits the
+        // pending updates. The updates of the requests received while
+        // the commit is in progress are committed together by the
+        // next thread. The commit window, if set, bounds the time
+        // spent waiting for more updates before committing.
+        //
+        _committing = true;
+
+        const IceUtil::Time window = _instance->commitWindow();
+        if(window > IceUtil::Time())
+        {
+            const IceUtil::Time deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + window;
+            while(_updates.size() < batchMax)
+            {
+                IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                if(now >= deadline)
+                {
+                    break;
+                }
+                _updateMonitor.timedWait(deadline - now);
+            }
+        }
+
+        const size_t count = min(_updates.size(), batchMax);
+        vector<SubscriberUpdatePtr> updates(_updates.begin(), _updates.begin() + count);
+        _updates.erase(_updates.begin(), _updates.begin() + count);
+
+        sync.release();
+        try
+        {
+            commitUpdates(updates);
+        }
+        catch(const IceUtil::Exception& ex)
+        {
+            for(vector<SubscriberUpdatePtr>::const_iterator p = updates.begin(); p != updates.end(); ++p)
+            {
+                if(!(*p)->exception.get())
+                {
+                    (*p)->exception.reset(ex.ice_clone());
+                }
+            }
+        }
+        catch(...)
+        {
+            for(vector<SubscriberUpdatePtr>::const_iterator p = updates.begin(); p != updates.end(); ++p)
+            {
+                if(!(*p)->exception.get())
+                {
+                    (*p)->exception.reset(new Ice::UnknownException(__FILE__, __LINE__));
+                }
+            }
+        }
+        sync.acquire();
+
+        for(vector<SubscriberUpdatePtr>::const_iterator p = updates.begin(); p != updates.end(); ++p)
+        {
+            (*p)->done = true;
+        }
+        _committing = false;
+        _updateMonitor.notifyAll();
+    }
+
+    if(update->exception.get())
+    {
+        update->exception->ice_throw();
+    }
+}
+
+void
+TopicImpl::commitUpdates(const vector<SubscriberUpdatePtr>& updates)
+{
+    IceUtil::Mutex::Lock sync(_subscribersMutex);
+
+    //
+    // Compute the subscribers to add or remove by applying the updates
+    // in order, a null update removes the subscriber. Updates that
+    // cancel each other, such as a subscribe followed by an
+    // unsubscribe, are dropped.
+    //
+    map<Ice::Identity, SubscriberUpdatePtr> changes;
+    map<Ice::Identity, Ice::Long> resume; // The sequence number to resume from of the new subscribers.
+    for(vector<SubscriberUpdatePtr>::const_iterator p = updates.begin(); p != updates.end(); ++p)
+    {
+        const SubscriberUpdatePtr& update = *p;
+        const Ice::Identity& id = update->record.id;
+
+        bool existing = find(_subscribers.begin(), _subscribers.end(), id) != _subscribers.end();
+        map<Ice::Identity, SubscriberUpdatePtr>::iterator q = changes.find(id);
+        bool subscribed = q == changes.end() ? existing : q->second.get() != 0;
+        if(update->subscribe)
+        {
+            if(subscribed)
+            {
+                update->exception.reset(new AlreadySubscribed());
+                continue;
+            }
+
+            resume.erase(id);
+            QoS::const_iterator r = update->record.theQoS.find("resumeFrom");
+            if(r != update->record.theQoS.end())
+            {
+                Ice::Long seq;
+                if(!IceUtilInternal::stringToInt64(r->second, seq) || seq < 0)
+                {
+                    update->exception.reset(new BadQoS("invalid resumeFrom: " + r->second));
+                    continue;
+                }
+                resume[id] = seq;
+            }
+            changes[id] = update;
+        }
+        else if(subscribed)
+        {
+            if(existing)
+            {
+                changes[id] = 0;
+            }
+            else
+            {
+                changes.erase(id);
+            }
+        }
+    }
+
+    if(changes.empty())
+    {
+        return;
+    }
+
+    //
+    // Remove the existing subscribers before creating the new ones. A
+    // subscriber which unsubscribes and subscribes again in the same
+    // batch keeps its identity, and its per-subscriber object must be
+    // removed from the publish adapter before it's added again.
+    //
+    Ice::IdentitySeq removed;
+    for(map<Ice::Identity, SubscriberUpdatePtr>::const_iterator p = changes.begin(); p != changes.end(); ++p)
+    {
+        vector<SubscriberPtr>::iterator q = find(_subscribers.begin(), _subscribers.end(), p->first);
+        if(q != _subscribers.end())
+        {
+            (*q)->destroy();
+            _subscribers.erase(q);
+            removed.push_back(p->first);
+            _snapshot = 0;
+        }
+    }
+
+    map<Ice::Identity, SubscriberPtr> subscribers;
+    for(map<Ice::Identity, SubscriberUpdatePtr>::const_iterator p = changes.begin(); p != changes.end(); ++p)
+    {
+        if(p->second)
+        {
+            try
+            {
+                SubscriberPtr subscriber = Subscriber::create(_instance, p->second->record);
+                subscribers[p->first] = subscriber;
+                p->second->proxy = subscriber->proxy();
+            }
+            catch(const IceUtil::Exception& ex)
+            {
+                p->second->exception.reset(ex.ice_clone());
+            }
+        }
+    }
+
+    if(removed.empty() && subscribers.empty())
+    {
+        return;
+    }
+
+    LogUpdate llu;
+    try
+    {
+        IceDB::ReadWriteTxn txn(_instance->dbEnv());
+
+        TopicDelta delta;
+        delta.id = _id;
+        delta.destroyed = false;
+        delta.removed = removed;
+
+        SubscriberRecordKey key;
+        key.topic = _id;
+        for(Ice::IdentitySeq::const_iterator p = removed.begin(); p != removed.end(); ++p)
+        {
+            key.id = *p;
+            _subscriberMap.del(txn, key);
+        }
+        for(map<Ice::Identity, SubscriberPtr>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+        {
+            key.id = p->first;
+            _subscriberMap.put(txn, key, p->second->record());
+            delta.added.push_back(p->second->record());
+        }
+
+        llu = getIncrementedLLU(txn, _lluMap);
+        _replicationLog.append(txn, llu, delta);
+
+        txn.commit();
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        //
+        // The removed subscribers aren't restored, the requests fail
+        // and the subscribers can subscribe again.
+        //
+        for(map<Ice::Identity, SubscriberPtr>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+        {
+            p->second->destroy();
+        }
+        logError(_instance->communicator(), ex);
+        throw; // will become UnknownException in caller
+    }
+
+    TraceLevelsPtr traceLevels = _instance->traceLevels();
+    if(traceLevels->topic > 0)
+    {
+        Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+        out << _name << ": commit: added " << subscribers.size() << " removed " << removed.size()
+            << " llu: " << llu.generation << "/" << llu.iteration;
+    }
+
+    SubscriberRecordSeq added;
+    for(map<Ice::Identity, SubscriberPtr>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+    {
+        _subscribers.push_back(p->second);
+        added.push_back(p->second->record());
+
+        //
+        // The subscriber first receives the logged events from the
+        // requested sequence number, the events published once it's
+        // added are queued after them.
+        //
+        map<Ice::Identity, Ice::Long>::const_iterator r = resume.find(p->first);
+        if(r != resume.end() && _eventLog)
+        {
+            p->second->replay(_eventLog, r->second, _eventLog->next());
+        }
+        if(_lastValues)
+        {
+            _lastValues->queue(p->second);
+        }
+    }
+    _snapshot = 0;
+
+    //
+    // Use the single subscriber updates when possible, the replicas
+    // only receive one update for all the changes.
+    //
+    if(removed.empty() && added.size() == 1)
+    {
+        _instance->observers()->addSubscriber(llu, _name, added.front());
+    }
+    else if(added.empty())
+    {
+        _instance->observers()->removeSubscriber(llu, _name, removed);
+    }
+    else
+    {
+        _instance->observers()->updateSubscribers(llu, _name, added, removed);
+    }
 }
 
 void
@@ -1299,6 +1740,13 @@ TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
         if(found)
         {
             llu = getIncrementedLLU(txn, _lluMap);
+
+            TopicDelta delta;
+            delta.id = _id;
+            delta.destroyed = false;
+            delta.removed = ids;
+            _replicationLog.append(txn, llu, delta);
+
             txn.commit();
         }
         else
@@ -1327,6 +1775,7 @@ TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
             {
                 (*p)->destroy();
                 _subscribers.erase(p);
+                _snapshot = 0;
             }
         }
 
@@ -14,7 +14,11 @@
 #include <IceStorm/Election.h>
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Util.h>
+#include <IceStorm/ReplicationLog.h>
 #include <Ice/ObserverHelper.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/UniquePtr.h>
+#include <deque>
 #include <list>
 
 namespace IceStorm
@@ -27,6 +31,15 @@ typedef IceUtil::Handle<PersistentInstance> PersistentInstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+class SubscriberSnapshot;
+typedef IceUtil::Handle<SubscriberSnapshot> SubscriberSnapshotPtr;
+
+class EventLog;
+typedef IceUtil::Handle<EventLog> EventLogPtr;
+
+class LastValueCache;
+typedef IceUtil::Handle<LastValueCache> LastValueCachePtr;
+
 class TopicImpl : public IceUtil::Shared
 {
 public:
@@ -61,8 +74,16 @@ public:
     // Observer methods.
     void observerAddSubscriber(const IceStormElection::LogUpdate&, const SubscriberRecord&);
     void observerRemoveSubscriber(const IceStormElection::LogUpdate&, const Ice::IdentitySeq&);
+    void observerUpdateSubscribers(const IceStormElection::LogUpdate&, const SubscriberRecordSeq&,
+                                   const Ice::IdentitySeq&);
     void observerDestroyTopic(const IceStormElection::LogUpdate&);
 
+    //
+    // Destroy the topic removed by a sync, the database is already up
+    // to date.
+    //
+    void observerSyncDestroy();
+
     Ice::ObjectPtr getServant() const;
 
     void updateObserver();
@@ -70,8 +91,37 @@ public:
 
 private:
 
+    //
+    // A subscribe or unsubscribe request. The pending requests are
+    // committed together with a single database transaction and a
+    // single replica update.
+    //
+    struct SubscriberUpdate : public IceUtil::Shared
+    {
+        SubscriberUpdate(const SubscriberRecord& r) :
+            record(r), subscribe(true), done(false)
+        {
+        }
+
+        SubscriberUpdate(const Ice::Identity& id) :
+            subscribe(false), done(false)
+        {
+            record.id = id;
+        }
+
+        SubscriberRecord record;
+        const bool subscribe;
+        bool done;
+        Ice::ObjectPrx proxy; // The per subscriber object proxy, set once a subscribe request is committed.
+        IceUtil::UniquePtr<IceUtil::Exception> exception; // The failure of the request, if any.
+    };
+    typedef IceUtil::Handle<SubscriberUpdate> SubscriberUpdatePtr;
+
     IceStormElection::LogUpdate destroyInternal(const IceStormElection::LogUpdate&, bool);
+    void destroyServants();
     void removeSubscribers(const Ice::IdentitySeq&);
+    void commitUpdate(const SubscriberUpdatePtr&);
+    void commitUpdates(const std::vector<SubscriberUpdatePtr>&);
 
     //
     // Immutable members.
@@ -87,6 +137,7 @@ private:
     /*const*/ TopicLinkPrx _linkPrx; // The link proxy.
 
     Ice::ObjectPtr _servant; // The topic implementation servant.
+    EventLogPtr _eventLog; // The log of the published events, 0 if not enabled.
 
     // Mutex protecting the subscribers.
     IceUtil::Mutex _subscribersMutex;
@@ -99,11 +150,19 @@ private:
     // was the fastest of the three.
     //
     std::vector<SubscriberPtr> _subscribers;
+    SubscriberSnapshotPtr _snapshot; // The subscribers to publish to, 0 if it must be re-created.
+    LastValueCachePtr _lastValues; // The last value of each key, 0 if the topic doesn't coalesce its events.
 
     bool _destroyed; // Has this Topic been destroyed?
 
+    // Monitor protecting the pending subscriber updates.
+    IceUtil::Monitor<IceUtil::Mutex> _updateMonitor;
+    std::deque<SubscriberUpdatePtr> _updates; // The subscriber updates waiting to be committed.
+    bool _committing; // True if a thread is committing subscriber updates.
+
     LLUMap _lluMap;
     SubscriberMap _subscriberMap;
+    ReplicationLog _replicationLog;
 };
 
 typedef IceUtil::Handle<TopicImpl> TopicImplPtr;
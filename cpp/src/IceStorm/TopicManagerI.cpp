@@ -18,6 +18,7 @@
 #include <Ice/SliceChecksums.h>
 
 #include <functional>
+#include <limits>
 
 using namespace std;
 using namespace IceStorm;
@@ -139,14 +140,29 @@ public:
         //cout << "~ReplicaObserverI" << endl;
     }
 
-    virtual void init(const LogUpdate& llu, const TopicContentSeq& content, const Ice::Current&)
+    virtual void init(const LogUpdate& llu, const TopicContentSeq& content, const Ice::Current& current)
+    {
+        initWithMaster(llu, -1, content, current); // The master runs an older version.
+    }
+
+    virtual void initWithMaster(const LogUpdate& llu, int master, const TopicContentSeq& content, const Ice::Current&)
     {
         NodeIPtr node = _instance->node();
         if(node)
         {
             node->checkObserverInit(llu.generation);
         }
-        _impl->observerInit(llu, content);
+        _impl->observerInit(llu, master, content);
+    }
+
+    virtual void applyLog(const LogUpdate& from, int master, const LogEntrySeq& entries, const Ice::Current&)
+    {
+        NodeIPtr node = _instance->node();
+        if(node)
+        {
+            node->checkObserverInit(from.generation);
+        }
+        _impl->observerApplyLog(from, master, entries);
     }
 
     virtual void createTopic(const LogUpdate& llu, const string& name, const Ice::Current&)
@@ -216,6 +232,23 @@ public:
         }
     }
 
+    virtual void updateSubscribers(const LogUpdate& llu, const string& name, const SubscriberRecordSeq& added,
+                                   const Ice::IdentitySeq& removed, const Ice::Current&)
+    {
+        try
+        {
+            ObserverUpdateHelper unlock(_instance->node(), llu.generation, __FILE__, __LINE__);
+            _impl->observerUpdateSubscribers(llu, name, added, removed);
+        }
+        catch(const ObserverInconsistencyException& e)
+        {
+            Ice::Warning warn(_instance->traceLevels()->logger);
+            warn << "ReplicaObserverI::update: ObserverInconsistencyException: " << e.reason;
+            _instance->node()->recovery(llu.generation);
+            throw;
+        }
+    }
+
 private:
 
     const PersistentInstancePtr _instance;
@@ -241,6 +274,11 @@ public:
         _impl->getContent(llu, content);
     }
 
+    virtual bool getLog(const LogUpdate& from, int master, int max, LogEntrySeq& entries, const Ice::Current&)
+    {
+        return _impl->getLog(from, master, max, entries);
+    }
+
 private:
 
     const TopicManagerImplPtr _impl;
@@ -251,7 +289,8 @@ private:
 TopicManagerImpl::TopicManagerImpl(const PersistentInstancePtr& instance) :
     _instance(instance),
     _lluMap(instance->lluMap()),
-    _subscriberMap(instance->subscriberMap())
+    _subscriberMap(instance->subscriberMap()),
+    _replicationLog(instance->replicationLog())
 {
     try
     {
@@ -280,9 +319,15 @@ TopicManagerImpl::TopicManagerImpl(const PersistentInstancePtr& instance) :
         {
             IceDB::ReadWriteTxn txn(_instance->dbEnv());
 
-            // Ensure that the llu counter is present in the log.
-            LogUpdate empty = {0, 0};
-            _instance->lluMap().put(txn, lluDbKey, empty);
+            // Ensure that the llu counter is present in the log. The
+            // counter must not be reset, a replica which restarts
+            // only retrieves the updates it missed.
+            LogUpdate llu;
+            if(!_lluMap.get(txn, lluDbKey, llu))
+            {
+                LogUpdate empty = {0, 0};
+                _lluMap.put(txn, lluDbKey, empty);
+            }
 
 
             // Recreate each of the topics.
@@ -361,6 +406,11 @@ TopicManagerImpl::create(const string& name)
 
         llu = getIncrementedLLU(txn, _lluMap);
 
+        TopicDelta delta;
+        delta.id = id;
+        delta.destroyed = false;
+        _replicationLog.append(txn, llu, delta);
+
         txn.commit();
     }
     catch(const IceDB::LMDBException& ex)
@@ -410,7 +460,7 @@ TopicManagerImpl::retrieveAll() const
 }
 
 void
-TopicManagerImpl::observerInit(const LogUpdate& llu, const TopicContentSeq& content)
+TopicManagerImpl::observerInit(const LogUpdate& llu, int master, const TopicContentSeq& content)
 {
     Lock sync(*this);
 
@@ -466,6 +516,12 @@ TopicManagerImpl::observerInit(const LogUpdate& llu, const TopicContentSeq& cont
                 _subscriberMap.put(txn, key, *q);
             }
         }
+
+        LogEntry entry;
+        entry.llu = llu;
+        entry.master = master;
+        _replicationLog.reset(txn, entry);
+
         txn.commit();
     }
     catch(const IceDB::LMDBException& ex)
@@ -479,27 +535,20 @@ TopicManagerImpl::observerInit(const LogUpdate& llu, const TopicContentSeq& cont
     // runs through the init list and either adds the ones that don't
     // exist, or updates those that do.
 
+    set<Ice::Identity> ids;
+    for(TopicContentSeq::const_iterator q = content.begin(); q != content.end(); ++q)
+    {
+        ids.insert(q->id);
+    }
+
     map<string, TopicImplPtr>::iterator p = _topics.begin();
     while(p != _topics.end())
     {
-        TopicContentSeq::const_iterator q;
-        for(q = content.begin(); q != content.end(); ++q)
+        if(ids.find(p->second->id()) == ids.end())
         {
-            if(q->id == p->second->id())
-            {
-                break;
-            }
-        }
-
-        if(q == content.end())
-        {
-            // Note that this destroy should not remove anything from
-            // the database since we've already synced up the db
-            // state.
-            //
-            // TODO: We could short circuit the database operations in
-            // the topic by calling a third form of destroy.
-            p->second->observerDestroyTopic(llu);
+            // The database state is already synced up, the topic
+            // doesn't remove anything from the database.
+            p->second->observerSyncDestroy();
             _topics.erase(p++);
         }
         else
@@ -527,6 +576,144 @@ TopicManagerImpl::observerInit(const LogUpdate& llu, const TopicContentSeq& cont
     _instance->observers()->clear();
 }
 
+void
+TopicManagerImpl::observerApplyLog(const LogUpdate& from, int master, const LogEntrySeq& entries)
+{
+    Lock sync(*this);
+
+    TraceLevelsPtr traceLevels = _instance->traceLevels();
+    if(traceLevels->topicMgr > 0)
+    {
+        Ice::Trace out(traceLevels->logger, traceLevels->topicMgrCat);
+        out << "apply log: from: " << from.generation << "/" << from.iteration << " updates: " << entries.size();
+    }
+
+    //
+    // The updates are applied to the database with a single
+    // transaction, the content of the updated topics is then read to
+    // update the topics.
+    //
+    TopicContentSeq content;
+    vector<Ice::Identity> destroyed;
+    try
+    {
+        IceDB::ReadWriteTxn txn(_instance->dbEnv());
+
+        LogUpdate llu;
+        LogEntrySeq last;
+        _lluMap.get(txn, lluDbKey, llu);
+        if(llu != from || !_replicationLog.read(txn, from, 0, last) || last.front().master != master)
+        {
+            throw ObserverInconsistencyException("last update is not logged or doesn't match");
+        }
+
+        set<Ice::Identity> topics;
+        for(LogEntrySeq::const_iterator p = entries.begin(); p != entries.end(); ++p)
+        {
+            for(TopicDeltaSeq::const_iterator q = p->deltas.begin(); q != p->deltas.end(); ++q)
+            {
+                SubscriberRecordKey key;
+                key.topic = q->id;
+                if(q->destroyed)
+                {
+                    SubscriberMapRWCursor cursor(_subscriberMap, txn);
+                    SubscriberRecordKey k;
+                    SubscriberRecord v;
+                    if(cursor.find(key))
+                    {
+                        cursor.del();
+                        while(cursor.get(k, v, MDB_NEXT) && k.topic == key.topic)
+                        {
+                            cursor.del();
+                        }
+                    }
+                }
+                else
+                {
+                    SubscriberRecord rec;
+                    rec.link = false;
+                    rec.cost = 0;
+                    _subscriberMap.put(txn, key, rec);
+
+                    for(Ice::IdentitySeq::const_iterator r = q->removed.begin(); r != q->removed.end(); ++r)
+                    {
+                        key.id = *r;
+                        _subscriberMap.del(txn, key);
+                    }
+                    for(SubscriberRecordSeq::const_iterator r = q->added.begin(); r != q->added.end(); ++r)
+                    {
+                        key.id = r->id;
+                        _subscriberMap.put(txn, key, *r);
+                    }
+                }
+                topics.insert(q->id);
+            }
+            _replicationLog.append(txn, *p);
+        }
+
+        if(!entries.empty())
+        {
+            _lluMap.put(txn, lluDbKey, entries.back().llu);
+        }
+
+        for(set<Ice::Identity>::const_iterator p = topics.begin(); p != topics.end(); ++p)
+        {
+            SubscriberRecordKey key;
+            key.topic = *p;
+            SubscriberMapRWCursor cursor(_subscriberMap, txn);
+            if(!cursor.find(key))
+            {
+                destroyed.push_back(*p);
+                continue;
+            }
+
+            TopicContent rec;
+            rec.id = *p;
+            SubscriberRecordKey k;
+            SubscriberRecord v;
+            while(cursor.get(k, v, MDB_NEXT) && k.topic == key.topic)
+            {
+                rec.records.push_back(v);
+            }
+            content.push_back(rec);
+        }
+
+        txn.commit();
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(_instance->communicator(), ex);
+        throw; // will become UnknownException in caller
+    }
+
+    for(vector<Ice::Identity>::const_iterator p = destroyed.begin(); p != destroyed.end(); ++p)
+    {
+        map<string, TopicImplPtr>::iterator q = _topics.find(identityToTopicName(*p));
+        if(q != _topics.end())
+        {
+            q->second->observerSyncDestroy();
+            _topics.erase(q);
+        }
+    }
+
+    for(TopicContentSeq::const_iterator p = content.begin(); p != content.end(); ++p)
+    {
+        string name = identityToTopicName(p->id);
+        map<string, TopicImplPtr>::const_iterator q = _topics.find(name);
+        if(q == _topics.end())
+        {
+            installTopic(name, p->id, true, p->records);
+        }
+        else
+        {
+            q->second->update(p->records);
+        }
+    }
+
+    // Clear the set of observers.
+    _instance->observers()->clear();
+}
+
 void
 TopicManagerImpl::observerCreateTopic(const LogUpdate& llu, const string& name)
 {
@@ -551,6 +738,11 @@ TopicManagerImpl::observerCreateTopic(const LogUpdate& llu, const string& name)
 
         _lluMap.put(txn, lluDbKey, llu);
 
+        TopicDelta delta;
+        delta.id = id;
+        delta.destroyed = false;
+        _replicationLog.append(txn, llu, delta);
+
         txn.commit();
     }
     catch(const IceDB::LMDBException& ex)
@@ -613,6 +805,24 @@ TopicManagerImpl::observerRemoveSubscriber(const LogUpdate& llu, const string& n
     topic->observerRemoveSubscriber(llu, id);
 }
 
+void
+TopicManagerImpl::observerUpdateSubscribers(const LogUpdate& llu, const string& name, const SubscriberRecordSeq& added,
+                                            const Ice::IdentitySeq& removed)
+{
+    TopicImplPtr topic;
+    {
+        Lock sync(*this);
+
+        map<string, TopicImplPtr>::iterator q = _topics.find(name);
+        if(q == _topics.end())
+        {
+            throw ObserverInconsistencyException("no topic: " + name);
+        }
+        topic = q->second;
+    }
+    topic->observerUpdateSubscribers(llu, added, removed);
+}
+
 void
 TopicManagerImpl::getContent(LogUpdate& llu, TopicContentSeq& content)
 {
@@ -640,6 +850,28 @@ TopicManagerImpl::getContent(LogUpdate& llu, TopicContentSeq& content)
     }
 }
 
+bool
+TopicManagerImpl::getLog(const LogUpdate& from, int master, int max, LogEntrySeq& entries)
+{
+    try
+    {
+        IceDB::ReadOnlyTxn txn(_instance->dbEnv());
+        if(!_replicationLog.read(txn, from, static_cast<size_t>(std::max(max, 1)), entries) ||
+           entries.front().master != master)
+        {
+            entries.clear();
+            return false;
+        }
+        entries.erase(entries.begin());
+        return true;
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(_instance->communicator(), ex);
+        throw; // will become UnknownException in caller
+    }
+}
+
 LogUpdate
 TopicManagerImpl::getLastLogUpdate() const
 {
@@ -663,15 +895,60 @@ TopicManagerImpl::sync(const Ice::ObjectPrx& master)
 {
     TopicManagerSyncPrx sync = TopicManagerSyncPrx::uncheckedCast(master);
 
+    //
+    // Retrieve the updates that follow our last update if the replica
+    // logged them, otherwise retrieve the whole content.
+    //
+    LogEntrySeq last;
+    try
+    {
+        IceDB::ReadOnlyTxn txn(_instance->dbEnv());
+        LogUpdate llu;
+        _lluMap.get(txn, lluDbKey, llu);
+        _replicationLog.read(txn, llu, 0, last);
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(_instance->communicator(), ex);
+        throw; // will become UnknownException in caller
+    }
+
+    if(!last.empty())
+    {
+        LogUpdate from = last.front().llu;
+        int fromMaster = last.front().master;
+        LogEntrySeq entries;
+        try
+        {
+            while(sync->getLog(from, fromMaster, logChunkSize, entries))
+            {
+                if(!entries.empty())
+                {
+                    observerApplyLog(from, fromMaster, entries);
+                    from = entries.back().llu;
+                    fromMaster = entries.back().master;
+                }
+                if(entries.size() < static_cast<size_t>(logChunkSize))
+                {
+                    return;
+                }
+            }
+        }
+        catch(const Ice::OperationNotExistException&)
+        {
+            // The replica runs an older version, retrieve the content.
+        }
+    }
+
     LogUpdate llu;
     TopicContentSeq content;
     sync->getContent(llu, content);
 
-    observerInit(llu, content);
+    observerInit(llu, -1, content);
 }
 
 void
-TopicManagerImpl::initMaster(const set<GroupNodeInfo>& slaves, const LogUpdate& llu)
+TopicManagerImpl::initMaster(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, int master)
 {
     Lock sync(*this);
 
@@ -690,6 +967,11 @@ TopicManagerImpl::initMaster(const set<GroupNodeInfo>& slaves, const LogUpdate&
     // elected and gets the latest database state it immediately
     // updates the llu stamp.
     //
+    // The generation is logged so that the slaves which missed
+    // updates only receive the logged updates that follow their last
+    // update.
+    //
+    map<int, LogEntrySeq> logs;
     try
     {
         content.clear();
@@ -704,6 +986,20 @@ TopicManagerImpl::initMaster(const set<GroupNodeInfo>& slaves, const LogUpdate&
 
         _lluMap.put(txn, lluDbKey, llu);
 
+        LogEntry entry;
+        entry.llu = llu;
+        entry.master = master;
+        _replicationLog.append(txn, entry);
+
+        for(set<GroupNodeInfo>::const_iterator p = slaves.begin(); p != slaves.end(); ++p)
+        {
+            LogEntrySeq entries;
+            if(_replicationLog.read(txn, p->llu, numeric_limits<size_t>::max(), entries))
+            {
+                logs[p->id].swap(entries);
+            }
+        }
+
         txn.commit();
     }
     catch(const IceDB::LMDBException& ex)
@@ -713,7 +1009,7 @@ TopicManagerImpl::initMaster(const set<GroupNodeInfo>& slaves, const LogUpdate&
     }
 
     // Now initialize the observers.
-    _instance->observers()->init(slaves, llu, content);
+    _instance->observers()->init(slaves, llu, master, content, logs);
 }
 
 Ice::ObjectPrx
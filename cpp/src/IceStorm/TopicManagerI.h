@@ -16,6 +16,7 @@
 #include <IceStorm/Election.h>
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Util.h>
+#include <IceStorm/ReplicationLog.h>
 
 #include <IceUtil/RecMutex.h>
 
@@ -49,20 +50,24 @@ public:
     TopicDict retrieveAll() const;
 
     // Observer methods.
-    void observerInit(const IceStormElection::LogUpdate&, const IceStormElection::TopicContentSeq&);
+    void observerInit(const IceStormElection::LogUpdate&, int, const IceStormElection::TopicContentSeq&);
+    void observerApplyLog(const IceStormElection::LogUpdate&, int, const IceStormElection::LogEntrySeq&);
     void observerCreateTopic(const IceStormElection::LogUpdate&, const std::string&);
     void observerDestroyTopic(const IceStormElection::LogUpdate&, const std::string&);
     void observerAddSubscriber(const IceStormElection::LogUpdate&, const std::string&,
                                const IceStorm::SubscriberRecord&);
     void observerRemoveSubscriber(const IceStormElection::LogUpdate&, const std::string&, const Ice::IdentitySeq&);
+    void observerUpdateSubscribers(const IceStormElection::LogUpdate&, const std::string&,
+                                   const IceStorm::SubscriberRecordSeq&, const Ice::IdentitySeq&);
 
     // Sync methods.
     void getContent(IceStormElection::LogUpdate&, IceStormElection::TopicContentSeq&);
+    bool getLog(const IceStormElection::LogUpdate&, int, int, IceStormElection::LogEntrySeq&);
 
     // Replica methods.
     virtual IceStormElection::LogUpdate getLastLogUpdate() const;
     virtual void sync(const Ice::ObjectPrx&);
-    virtual void initMaster(const std::set<IceStormElection::GroupNodeInfo>&, const IceStormElection::LogUpdate&);
+    virtual void initMaster(const std::set<IceStormElection::GroupNodeInfo>&, const IceStormElection::LogUpdate&, int);
     virtual Ice::ObjectPrx getObserver() const;
     virtual Ice::ObjectPrx getSync() const;
 
@@ -92,6 +97,7 @@ private:
 
     LLUMap _lluMap;
     SubscriberMap _subscriberMap;
+    ReplicationLog _replicationLog;
 };
 typedef IceUtil::Handle<TopicManagerImpl> TopicManagerImplPtr;
 
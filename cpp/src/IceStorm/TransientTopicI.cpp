@@ -132,6 +132,12 @@ TransientTopicImpl::TransientTopicImpl(
 
     _publisherPrx = _instance->publishAdapter()->add(new TransientPublisherI(this), pubid);
     _linkPrx = TopicLinkPrx::uncheckedCast(_instance->publishAdapter()->add(new TransientTopicLinkI(this), linkid));
+
+    EventCoalescerPtr coalescer = _instance->coalescer(_name);
+    if(coalescer)
+    {
+        _lastValues = new LastValueCache(coalescer, static_cast<size_t>(_instance->lastValuesSizeMax()));
+    }
 }
 
 TransientTopicImpl::~TransientTopicImpl()
@@ -255,10 +261,16 @@ TransientTopicImpl::subscribe(const QoS& origQoS, const Ice::ObjectPrx& obj, con
         // subscriber list and remove it from the database.
         (*p)->destroy();
         _subscribers.erase(p);
+        _snapshot = 0;
     }
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
     _subscribers.push_back(subscriber);
+    _snapshot = 0;
+    if(_lastValues)
+    {
+        _lastValues->queue(subscriber);
+    }
 }
 
 Ice::ObjectPrx
@@ -315,6 +327,11 @@ TransientTopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPr
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
     _subscribers.push_back(subscriber);
+    _snapshot = 0;
+    if(_lastValues)
+    {
+        _lastValues->queue(subscriber);
+    }
 
     return subscriber->proxy();
 }
@@ -354,6 +371,7 @@ TransientTopicImpl::unsubscribe(const Ice::ObjectPrx& subscriber, const Ice::Cur
     {
         (*p)->destroy();
         _subscribers.erase(p);
+        _snapshot = 0;
     }
 }
 
@@ -401,6 +419,7 @@ TransientTopicImpl::link(const TopicPrx& topic, Ice::Int cost, const Ice::Curren
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
     _subscribers.push_back(subscriber);
+    _snapshot = 0;
 }
 
 void
@@ -445,6 +464,7 @@ TransientTopicImpl::unlink(const TopicPrx& topic, const Ice::Current&)
     {
         (*p)->destroy();
         _subscribers.erase(p);
+        _snapshot = 0;
     }
 }
 
@@ -515,6 +535,11 @@ TransientTopicImpl::destroy(const Ice::Current&)
         (*p)->destroy();
     }
     _subscribers.clear();
+    _snapshot = 0;
+    if(_lastValues)
+    {
+        _lastValues->clear();
+    }
 }
 
 void
@@ -540,27 +565,35 @@ void
 TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
 {
     //
-    // Copy of the subscriber list so that event publishing can occur
-    // in parallel.
+    // Snapshot of the subscriber list so that event publishing can
+    // occur in parallel. The snapshot is shared with the other
+    // publish calls until the subscribers are modified.
     //
-    vector<SubscriberPtr> copy;
+    SubscriberSnapshotPtr snapshot;
     {
         Lock sync(*this);
-        copy = _subscribers;
+        if(_lastValues)
+        {
+            _lastValues->update(events);
+        }
+        if(!_snapshot)
+        {
+            _snapshot = new SubscriberSnapshot(_subscribers);
+        }
+        snapshot = _snapshot;
+    }
+
+    if(snapshot->subscribers.empty())
+    {
+        return;
     }
 
     //
-    // Queue each event, gathering a list of those subscribers that
-    // must be reaped.
+    // Queue the events with each subscriber whose filter matches,
+    // gathering a list of those subscribers that must be reaped.
     //
     vector<Ice::Identity> e;
-    for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
-    {
-        if(!(*p)->queue(forwarded, events) && (*p)->reap())
-        {
-            e.push_back((*p)->id());
-        }
-    }
+    snapshot->queue(forwarded, events, e);
 
     //
     // Run through the error list removing those subscribers that are
@@ -594,6 +627,7 @@ TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
                 //
                 subscriber->destroy();
                 _subscribers.erase(q);
+                _snapshot = 0;
             }
         }
     }
@@ -22,6 +22,12 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+class SubscriberSnapshot;
+typedef IceUtil::Handle<SubscriberSnapshot> SubscriberSnapshotPtr;
+
+class LastValueCache;
+typedef IceUtil::Handle<LastValueCache> LastValueCachePtr;
+
 class TransientTopicImpl : public TopicInternal, public IceUtil::Mutex
 {
 public:
@@ -70,6 +76,8 @@ private:
     // was the fastest of the three.
     //
     std::vector<SubscriberPtr> _subscribers;
+    SubscriberSnapshotPtr _snapshot; // The subscribers to publish to, 0 if it must be re-created.
+    LastValueCachePtr _lastValues; // The last value of each key, 0 if the topic doesn't coalesce its events.
 
     bool _destroyed; // Has this Topic been destroyed?
 };
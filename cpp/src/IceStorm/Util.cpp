@@ -90,6 +90,26 @@ IceStormInternal::compareSubscriberRecordKey(const MDB_val* v1, const MDB_val* v
     }
 }
 
+int
+IceStormInternal::compareLogUpdate(const MDB_val* v1, const MDB_val* v2)
+{
+    IceStormElection::LogUpdate k1, k2;
+    IceDB::Codec<IceStormElection::LogUpdate, IceDB::IceContext, Ice::OutputStreamPtr>::read(k1, *v1, dbContext);
+    IceDB::Codec<IceStormElection::LogUpdate, IceDB::IceContext, Ice::OutputStreamPtr>::read(k2, *v2, dbContext);
+    if(k1 < k2)
+    {
+        return -1;
+    }
+    else if(k1 == k2)
+    {
+        return 0;
+    }
+    else
+    {
+        return 1;
+    }
+}
+
 IceStormElection::LogUpdate
 IceStormInternal::getIncrementedLLU(const IceDB::ReadWriteTxn& txn, LLUMap& lluMap)
 {
@@ -47,6 +47,9 @@ describeEndpoints(const Ice::ObjectPrx&);
 int
 compareSubscriberRecordKey(const MDB_val* v1, const MDB_val* v2);
 
+int
+compareLogUpdate(const MDB_val* v1, const MDB_val* v2);
+
 IceStormElection::LogUpdate
 getIncrementedLLU(const IceDB::ReadWriteTxn&, IceStorm::LLUMap&);
 
@@ -10,13 +10,90 @@
 #include <IceUtil/Timer.h>
 #include <IceUtil/Exception.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace IceUtil;
 
+namespace
+{
+
+//
+// The timing wheel has 4 levels: the first level has 256 slots of one
+// tick (one millisecond), each of the other levels has 64 slots which
+// span the whole previous level. Tasks scheduled beyond the span of
+// the last level (about 18 hours) are parked in the last level and
+// re-linked when it's cascaded.
+//
+const int levelCount = 4;
+const int firstLevelBits = 8;
+const int levelBits = 6;
+const int firstLevelSize = 1 << firstLevelBits;
+const int levelSize = 1 << levelBits;
+const Int64 tickMicroSeconds = 1000;
+
+inline int
+levelShift(int level)
+{
+    return level == 0 ? 0 : firstLevelBits + (level - 1) * levelBits;
+}
+
+inline int
+levelBase(int level)
+{
+    return level == 0 ? 0 : firstLevelSize + (level - 1) * levelSize;
+}
+
+inline int
+slotLevel(int slot)
+{
+    return slot < firstLevelSize ? 0 : 1 + (slot - firstLevelSize) / levelSize;
+}
+
+inline Int64
+currentTick()
+{
+    return IceUtil::Time::now(IceUtil::Time::Monotonic).toMicroSeconds() / tickMicroSeconds;
+}
+
+}
+
+class Timer::WorkerThread : public IceUtil::Thread
+{
+public:
+
+    WorkerThread(const TimerPtr& timer) :
+        Thread("IceUtil timer thread"),
+        _timer(timer)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _timer->run();
+    }
+
+private:
+
+    const TimerPtr _timer;
+};
+
 Timer::Timer() :
     Thread("IceUtil timer thread"),
-    _destroyed(false)
+    _destroyed(false),
+    _hasPriority(false),
+    _priority(0),
+    _wheel(firstLevelSize + (levelCount - 1) * levelSize, static_cast<Token*>(0)),
+    _readyHead(0),
+    _readyTail(0),
+    _currentTick(currentTick())
 {
+    for(int i = 0; i < levelCount; ++i)
+    {
+        _levelCount[i] = 0;
+    }
+
     __setNoDelete(true);
     start();
     __setNoDelete(false);
@@ -24,8 +101,19 @@ Timer::Timer() :
 
 Timer::Timer(int priority) :
     Thread("IceUtil timer thread"),
-    _destroyed(false)
+    _destroyed(false),
+    _hasPriority(true),
+    _priority(priority),
+    _wheel(firstLevelSize + (levelCount - 1) * levelSize, static_cast<Token*>(0)),
+    _readyHead(0),
+    _readyTail(0),
+    _currentTick(currentTick())
 {
+    for(int i = 0; i < levelCount; ++i)
+    {
+        _levelCount[i] = 0;
+    }
+
     __setNoDelete(true);
     start(0, priority);
     __setNoDelete(false);
@@ -34,6 +122,7 @@ Timer::Timer(int priority) :
 void
 Timer::destroy()
 {
+    vector<ThreadControl> threads;
     {
         IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
         if(_destroyed)
@@ -41,23 +130,45 @@ Timer::destroy()
             return;
         }
         _destroyed = true;
-        _monitor.notify();
+        _monitor.notifyAll();
+
+        //
+        // Running tokens are deleted by the thread running them.
+        //
+        for(TaskMap::const_iterator p = _tasks.begin(); p != _tasks.end(); ++p)
+        {
+            if(p->second->slot != Token::Running)
+            {
+                delete p->second;
+            }
+        }
         _tasks.clear();
-        _tokens.clear();
+        fill(_wheel.begin(), _wheel.end(), static_cast<Token*>(0));
+        for(int i = 0; i < levelCount; ++i)
+        {
+            _levelCount[i] = 0;
+        }
+        _readyHead = 0;
+        _readyTail = 0;
+        threads.swap(_threads);
     }
 
-    if(getThreadControl() == ThreadControl())
-    {
-        getThreadControl().detach();
-    }
-    else
+    threads.push_back(getThreadControl());
+    for(vector<ThreadControl>::iterator p = threads.begin(); p != threads.end(); ++p)
     {
-        getThreadControl().join();
+        if(*p == ThreadControl())
+        {
+            p->detach();
+        }
+        else
+        {
+            p->join();
+        }
     }
 }
 
 void
-Timer::schedule(const TimerTaskPtr& task, const IceUtil::Time& delay)
+Timer::addThreads(int count)
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
     if(_destroyed)
@@ -65,53 +176,23 @@ Timer::schedule(const TimerTaskPtr& task, const IceUtil::Time& delay)
         throw IllegalArgumentException(__FILE__, __LINE__, "timer destroyed");
     }
 
-    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
-    IceUtil::Time time = now + delay;
-    if(delay > IceUtil::Time() && time < now)
+    for(int i = 0; i < count; ++i)
     {
-        throw IllegalArgumentException(__FILE__, __LINE__, "invalid delay");
+        ThreadPtr thread = new WorkerThread(this);
+        _threads.push_back(_hasPriority ? thread->start(0, _priority) : thread->start());
     }
+}
 
-    bool inserted = _tasks.insert(make_pair(task, time)).second;
-    if(!inserted)
-    {
-        throw IllegalArgumentException(__FILE__, __LINE__, "task is already schedulded");
-    }
-    _tokens.insert(Token(time, IceUtil::Time(), task));
-
-    if(_wakeUpTime == IceUtil::Time() || time < _wakeUpTime)
-    {
-        _monitor.notify();
-    }
+void
+Timer::schedule(const TimerTaskPtr& task, const IceUtil::Time& delay)
+{
+    scheduleToken(task, delay, IceUtil::Time());
 }
 
 void
 Timer::scheduleRepeated(const TimerTaskPtr& task, const IceUtil::Time& delay)
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
-    if(_destroyed)
-    {
-        throw IllegalArgumentException(__FILE__, __LINE__, "timer destroyed");
-    }
-
-    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
-    const Token token(now + delay, delay, task);
-    if(delay > IceUtil::Time() && token.scheduledTime < now) 
-    {
-        throw IllegalArgumentException(__FILE__, __LINE__, "invalid delay");
-    }
-
-    bool inserted = _tasks.insert(make_pair(task, token.scheduledTime)).second;
-    if(!inserted)
-    {
-        throw IllegalArgumentException(__FILE__, __LINE__, "task is already schedulded");
-    }
-    _tokens.insert(token); 
-   
-    if(_wakeUpTime == IceUtil::Time() || token.scheduledTime < _wakeUpTime)
-    {
-        _monitor.notify();
-    }
+    scheduleToken(task, delay, delay);
 }
 
 bool
@@ -123,87 +204,108 @@ Timer::cancel(const TimerTaskPtr& task)
         return false;
     }
 
-    map<TimerTaskPtr, IceUtil::Time, TimerTaskCompare>::iterator p = _tasks.find(task);
+    TaskMap::iterator p = _tasks.find(task);
     if(p == _tasks.end())
     {
         return false;
     }
 
-    _tokens.erase(Token(p->second, IceUtil::Time(), p->first));
+    //
+    // A running token is a repeated task, it's not re-scheduled once
+    // it has run since it's no longer in the task map.
+    //
+    Token* token = p->second;
     _tasks.erase(p);
-
+    if(token->slot != Token::Running)
+    {
+        unlink(token);
+        delete token;
+    }
     return true;
 }
 
 void
 Timer::run()
 {
-    Token token(IceUtil::Time(), IceUtil::Time(), 0);
+    Token* token = 0;
     while(true)
     {
         {
             IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
 
-            if(!_destroyed)
+            if(token)
             {
                 //
                 // If the task we just ran is a repeated task, schedule it
                 // again for executation if it wasn't canceled.
                 //
-                if(token.delay != IceUtil::Time())
+                TaskMap::iterator p = token->delay != IceUtil::Time() ? _tasks.find(token->task) : _tasks.end();
+                if(!_destroyed && p != _tasks.end() && p->second == token)
+                {
+                    IceUtil::Time time = IceUtil::Time::now(IceUtil::Time::Monotonic) + token->delay;
+                    token->expires = (time.toMicroSeconds() + tickMicroSeconds - 1) / tickMicroSeconds;
+                    link(token);
+                }
+                else
+                {
+                    delete token;
+                }
+                token = 0;
+            }
+
+            while(!_destroyed)
+            {
+                advance(currentTick());
+
+                if(_readyHead)
                 {
-                    map<TimerTaskPtr, IceUtil::Time, TimerTaskCompare>::iterator p = _tasks.find(token.task);
-                    if(p != _tasks.end())
+                    token = _readyHead;
+                    unlink(token);
+                    token->slot = Token::Running;
+                    if(token->delay == IceUtil::Time())
+                    {
+                        _tasks.erase(token->task);
+                    }
+
+                    //
+                    // Wake up another execution thread if more tasks are ready.
+                    //
+                    if(_readyHead && !_threads.empty())
                     {
-                        token.scheduledTime = IceUtil::Time::now(IceUtil::Time::Monotonic) + token.delay;
-                        p->second = token.scheduledTime;
-                        _tokens.insert(token);
+                        _monitor.notify();
                     }
+                    break;
                 }
-                token = Token(IceUtil::Time(), IceUtil::Time(), 0);
 
-                if(_tokens.empty())
+                Int64 tick = nextTick();
+                if(tick < 0)
                 {
                     _wakeUpTime = IceUtil::Time();
                     _monitor.wait();
+                    continue;
                 }
-            }
-            
-            if(_destroyed)
-            {
-                break;
-            }
-            
-            while(!_tokens.empty() && !_destroyed)
-            {
+
+                _wakeUpTime = IceUtil::Time::microSeconds(tick * tickMicroSeconds);
                 const IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
-                const Token& first = *(_tokens.begin());
-                if(first.scheduledTime <= now)
+                if(_wakeUpTime <= now)
                 {
-                    token = first;
-                    _tokens.erase(_tokens.begin());
-                    if(token.delay == IceUtil::Time())
-                    {
-                        _tasks.erase(token.task);
-                    }
-                    break;
+                    continue;
                 }
-                
-                _wakeUpTime = first.scheduledTime;
-                try 
+
+                try
                 {
-                    _monitor.timedWait(first.scheduledTime - now);
-                } 
+                    _monitor.timedWait(_wakeUpTime - now);
+                }
                 catch(const IceUtil::InvalidTimeoutException&)
                 {
-                    IceUtil::Time timeout = (first.scheduledTime - now) / 2;
+                    IceUtil::Time timeout = (_wakeUpTime - now) / 2;
                     while(timeout > IceUtil::Time())
                     {
-                        try 
+                        try
                         {
                             _monitor.timedWait(timeout);
                             break;
-                        } 
+                        }
                         catch(const IceUtil::InvalidTimeoutException&)
                         {
                             timeout = timeout / 2;
@@ -214,38 +316,274 @@ Timer::run()
 
             if(_destroyed)
             {
+                delete token;
                 break;
             }
-        }     
+        }
 
-        if(token.task)
+        try
+        {
+            runTimerTask(token->task);
+        }
+        catch(const IceUtil::Exception& e)
+        {
+            cerr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what();
+#ifdef __GNUC__
+            cerr << "\n" << e.ice_stackTrace();
+#endif
+            cerr << endl;
+        }
+        catch(const std::exception& e)
+        {
+            cerr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what() << endl;
+        }
+        catch(...)
         {
-            try
+            cerr << "IceUtil::Timer::run(): uncaught exception" << endl;
+        }
+    }
+}
+
+void
+Timer::runTimerTask(const TimerTaskPtr& task)
+{
+    task->runTimerTask();
+}
+
+void
+Timer::scheduleToken(const TimerTaskPtr& task, const IceUtil::Time& delay, const IceUtil::Time& repeatDelay)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+    if(_destroyed)
+    {
+        throw IllegalArgumentException(__FILE__, __LINE__, "timer destroyed");
+    }
+
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    IceUtil::Time time = now + delay;
+    if(delay > IceUtil::Time() && time < now)
+    {
+        throw IllegalArgumentException(__FILE__, __LINE__, "invalid delay");
+    }
+
+    Token* token = new Token(task, repeatDelay);
+    bool inserted = _tasks.insert(make_pair(task, token)).second;
+    if(!inserted)
+    {
+        delete token;
+        throw IllegalArgumentException(__FILE__, __LINE__, "task is already schedulded");
+    }
+
+    //
+    // Round up the expiration to the next tick, the task never runs
+    // before its scheduled time.
+    //
+    token->expires = (time.toMicroSeconds() + tickMicroSeconds - 1) / tickMicroSeconds;
+    if(_tasks.size() == 1 && !_readyHead)
+    {
+        _currentTick = now.toMicroSeconds() / tickMicroSeconds; // The wheel is empty, no need to catch up.
+    }
+    link(token);
+
+    if(_wakeUpTime == IceUtil::Time() || time < _wakeUpTime)
+    {
+        _monitor.notify();
+    }
+}
+
+void
+Timer::link(Token* token)
+{
+    Int64 delta = token->expires - _currentTick;
+    if(delta <= 0)
+    {
+        token->slot = Token::Ready;
+        token->prev = _readyTail;
+        token->next = 0;
+        if(_readyTail)
+        {
+            _readyTail->next = token;
+        }
+        else
+        {
+            _readyHead = token;
+        }
+        _readyTail = token;
+        return;
+    }
+
+    int level = 0;
+    while(level < levelCount - 1 && delta >= (static_cast<Int64>(1) << levelShift(level + 1)))
+    {
+        ++level;
+    }
+
+    Int64 expires = token->expires;
+    const Int64 span = static_cast<Int64>(1) << (levelShift(levelCount - 1) + levelBits);
+    if(delta >= span)
+    {
+        expires = _currentTick + span - 1; // Parked, re-linked when the last level is cascaded.
+    }
+
+    int size = level == 0 ? firstLevelSize : levelSize;
+    token->slot = levelBase(level) + static_cast<int>((expires >> levelShift(level)) & (size - 1));
+    token->prev = 0;
+    token->next = _wheel[token->slot];
+    if(token->next)
+    {
+        token->next->prev = token;
+    }
+    _wheel[token->slot] = token;
+    ++_levelCount[level];
+}
+
+void
+Timer::unlink(Token* token)
+{
+    if(token->slot == Token::Ready)
+    {
+        if(token->prev)
+        {
+            token->prev->next = token->next;
+        }
+        else
+        {
+            _readyHead = token->next;
+        }
+
+        if(token->next)
+        {
+            token->next->prev = token->prev;
+        }
+        else
+        {
+            _readyTail = token->prev;
+        }
+    }
+    else
+    {
+        assert(token->slot >= 0);
+        if(token->prev)
+        {
+            token->prev->next = token->next;
+        }
+        else
+        {
+            _wheel[token->slot] = token->next;
+        }
+
+        if(token->next)
+        {
+            token->next->prev = token->prev;
+        }
+        --_levelCount[slotLevel(token->slot)];
+    }
+    token->prev = 0;
+    token->next = 0;
+}
+
+void
+Timer::advance(Int64 now)
+{
+    while(_currentTick < now)
+    {
+        if(_levelCount[0] == 0)
+        {
+            //
+            // Nothing expires before the next cascade of the first
+            // non-empty level, skip the ticks up to this cascade.
+            //
+            int level = 1;
+            while(level < levelCount && _levelCount[level] == 0)
             {
-                runTimerTask(token.task);
+                ++level;
             }
-            catch(const IceUtil::Exception& e)
+
+            if(level == levelCount)
             {
-                cerr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what();
-#ifdef __GNUC__
-                cerr << "\n" << e.ice_stackTrace();
-#endif
-                cerr << endl;
-            } 
-            catch(const std::exception& e)
+                _currentTick = now;
+                break;
+            }
+
+            Int64 boundary = ((_currentTick >> levelShift(level)) + 1) << levelShift(level);
+            if(boundary > now)
             {
-                cerr << "IceUtil::Timer::run(): uncaught exception:\n" << e.what() << endl;
-            } 
-            catch(...)
+                _currentTick = now;
+                break;
+            }
+            _currentTick = boundary - 1;
+        }
+
+        //
+        // Cascade the tokens of the next slot of the upper levels when
+        // the index of the lower level wraps around.
+        //
+        const Int64 tick = ++_currentTick;
+        if((tick & (firstLevelSize - 1)) == 0)
+        {
+            for(int level = 1; level < levelCount && cascade(level, tick) == 0; ++level)
             {
-                cerr << "IceUtil::Timer::run(): uncaught exception" << endl;
             }
         }
+
+        //
+        // Move the tokens expiring at this tick to the ready list.
+        //
+        const int slot = static_cast<int>(tick & (firstLevelSize - 1));
+        while(_wheel[slot])
+        {
+            Token* token = _wheel[slot];
+            unlink(token);
+            link(token);
+        }
     }
 }
 
-void
-Timer::runTimerTask(const TimerTaskPtr& task)
+int
+Timer::cascade(int level, Int64 tick)
 {
-    task->runTimerTask();
+    const int index = static_cast<int>((tick >> levelShift(level)) & (levelSize - 1));
+    const int slot = levelBase(level) + index;
+    while(_wheel[slot])
+    {
+        Token* token = _wheel[slot];
+        unlink(token);
+        link(token);
+    }
+    return index;
+}
+
+Int64
+Timer::nextTick() const
+{
+    Int64 tick = -1;
+    if(_levelCount[0] > 0)
+    {
+        for(Int64 t = _currentTick + 1; t <= _currentTick + firstLevelSize; ++t)
+        {
+            if(_wheel[static_cast<int>(t & (firstLevelSize - 1))])
+            {
+                tick = t;
+                break;
+            }
+        }
+    }
+
+    //
+    // The tokens of the next cascade might expire before the tokens
+    // of the first level.
+    //
+    for(int level = 1; level < levelCount; ++level)
+    {
+        if(_levelCount[level] > 0)
+        {
+            Int64 boundary = ((_currentTick >> levelShift(level)) + 1) << levelShift(level);
+            if(tick < 0 || boundary < tick)
+            {
+                tick = boundary;
+            }
+            break;
+        }
+    }
+    return tick;
 }
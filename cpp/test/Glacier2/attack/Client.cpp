@@ -46,8 +46,14 @@ main(int argc, char* argv[])
 }
 
 int
-AttackClient::run(int, char**)
+AttackClient::run(int argc, char* argv[])
 {
+    //
+    // With --maxMemory, the routing table of the router is bounded by
+    // Glacier2.RoutingTable.MaxMemory rather than by MaxSize.
+    //
+    bool maxMemory = argc >= 2 && strcmp(argv[1], "--maxMemory") == 0;
+
     cout << "getting router... " << flush;
     ObjectPrx routerBase = communicator()->stringToProxy("Glacier2/router:default -p 12347");
     Glacier2::RouterPrx router = Glacier2::RouterPrx::checkedCast(routerBase);
@@ -59,8 +65,53 @@ AttackClient::run(int, char**)
     Glacier2::SessionPrx session = router->createSession("userid", "abc123");
     cout << "ok" << endl;
 
-    cout << "making thousands of invocations on proxies... " << flush;
     ObjectPrx backendBase = communicator()->stringToProxy("dummy:tcp -p 12010");
+
+    cout << "testing routing table eviction... " << flush;
+    {
+        ObjectProxySeq proxies;
+        for(int i = 0; i < 20; ++i)
+        {
+            ostringstream os;
+            os << "evict-" << i;
+            proxies.push_back(backendBase->ice_identity(communicator()->stringToIdentity(os.str())));
+        }
+
+        if(maxMemory)
+        {
+            //
+            // The 1KB limit of the router holds less than 10 proxies
+            // but a single proxy always fits.
+            //
+            ObjectProxySeq evicted = router->addProxies(proxies);
+            test(evicted.size() >= 10 && evicted.size() < proxies.size());
+        }
+        else
+        {
+            //
+            // The table of the new session is empty, it's filled up
+            // to its maximum size of 10 proxies and each proxy added
+            // afterwards evicts a proxy.
+            //
+            test(router->addProxies(ObjectProxySeq(proxies.begin(), proxies.begin() + 10)).empty());
+            ObjectProxySeq evicted = router->addProxies(ObjectProxySeq(proxies.begin() + 10, proxies.begin() + 15));
+            test(evicted.size() == 5);
+
+            //
+            // Adding a proxy which is already in the table doesn't
+            // evict anything.
+            //
+            ObjectProxySeq added(proxies.begin() + 14, proxies.begin() + 15);
+            if(find(evicted.begin(), evicted.end(), added[0]) == evicted.end())
+            {
+                test(router->addProxies(added).empty());
+            }
+            test(router->addProxies(ObjectProxySeq(proxies.begin() + 15, proxies.end())).size() == 5);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "making thousands of invocations on proxies... " << flush;
     BackendPrx backend = BackendPrx::uncheckedCast(backendBase);
     backend->ice_ping();
 
@@ -31,20 +31,31 @@ if TestUtil.appverifier:
 #
 TestUtil.hashPasswords(os.path.join(os.getcwd(), "passwords"), {"userid": "abc123"})
 
-args = ' --Glacier2.RoutingTable.MaxSize=10' + \
-       ' --Glacier2.Client.Endpoints="default -p 12347"' + \
+args = ' --Glacier2.Client.Endpoints="default -p 12347"' + \
        ' --Ice.Admin.Endpoints="tcp -h 127.0.0.1 -p 12348"' + \
        ' --Ice.Admin.InstanceName=Glacier2' + \
        ' --Glacier2.CryptPasswords="' + os.path.join(testdir, "passwords")  + '"'
 
 sys.stdout.write("starting router... ")
 sys.stdout.flush()
-starterProc = TestUtil.startServer(router, args, count=2)
+starterProc = TestUtil.startServer(router, args + ' --Glacier2.RoutingTable.MaxSize=10', count=2)
 print("ok")
 
 TestUtil.clientServerTest()
 
 starterProc.waitTestSuccess()
 
+#
+# Run the test again with the routing table bounded by its memory.
+#
+sys.stdout.write("starting router with a routing table memory limit... ")
+sys.stdout.flush()
+starterProc = TestUtil.startServer(router, args + ' --Glacier2.RoutingTable.MaxMemory=1', count=2)
+print("ok")
+
+TestUtil.clientServerTest(additionalClientOptions = " --maxMemory")
+
+starterProc.waitTestSuccess()
+
 if TestUtil.appverifier:
     TestUtil.appVerifierAfterTestEnd([router])
@@ -48,8 +48,22 @@ main(int argc, char* argv[])
 }
 
 int
-CallbackClient::run(int, char**)
+CallbackClient::run(int argc, char* argv[])
 {
+    //
+    // With --flushSize, the router flushes the client request queues
+    // once they reach this size, the sleep time is too long for the
+    // override tests.
+    //
+    int flushSize = 0;
+    for(int i = 1; i < argc; ++i)
+    {
+        if(strncmp(argv[i], "--flushSize=", 12) == 0)
+        {
+            flushSize = atoi(argv[i] + 12);
+        }
+    }
+
     ObjectPrx routerBase = communicator()->stringToProxy("Glacier2/router:default -p 12347");
     Glacier2::RouterPrx router = Glacier2::RouterPrx::checkedCast(routerBase);
     communicator()->setDefaultRouter(router);
@@ -78,6 +92,7 @@ CallbackClient::run(int, char**)
         CallbackReceiverPrx::uncheckedCast(adapter->add(callbackReceiver, callbackReceiverIdent));
     CallbackReceiverPrx onewayR = twowayR->ice_oneway();
 
+    if(flushSize == 0)
     {
         cout << "testing client request override... " << flush;
         {
@@ -104,6 +119,7 @@ CallbackClient::run(int, char**)
         cout << "ok" << endl;
     }
 
+    if(flushSize == 0)
     {
         cout << "testing server request override... " << flush;
         Ice::Context ctx;
@@ -192,6 +208,36 @@ CallbackClient::run(int, char**)
         cout << "ok" << endl;
     }
 
+    if(flushSize > 0)
+    {
+        cout << "testing client request flush size... " << flush;
+
+        //
+        // The overriding requests are coalesced into a single queued
+        // request and the requests without override then fill up the
+        // queue, which is flushed without waiting for the sleep time.
+        // The last overriding request is queued after this flush so it
+        // doesn't override anything.
+        //
+        Ice::Context ctx;
+        ctx["_ovrd"] = "flushSize";
+        for(int i = 0; i < 5; i++)
+        {
+            oneway->initiateCallback(twowayR, 100, ctx);
+        }
+        for(int i = 0; i < flushSize - 1; i++)
+        {
+            oneway->initiateCallback(twowayR, 100);
+        }
+        oneway->initiateCallback(twowayR, 100, ctx);
+
+        callbackReceiverImpl->callbackOK(flushSize, 100);
+        callbackReceiverImpl->callbackOK(1, 100);
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+        test(callbackReceiverImpl->callbackOK(0, 100) == 0);
+        cout << "ok" << endl;
+    }
+
     {
         cout << "shutdown... " << flush;
         twoway->shutdown();
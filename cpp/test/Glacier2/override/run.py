@@ -25,7 +25,7 @@ router = TestUtil.getGlacier2Router()
 if TestUtil.appverifier:
     TestUtil.setAppVerifierSettings([router])
 
-def startRouter():
+def startRouter(flushSize = 0):
     #
     # Note: we limit the send buffer size with Ice.TCP.SndSize, the
     # test relies on send() blocking
@@ -48,9 +48,14 @@ def startRouter():
            ' --Glacier2.Server.Trace.Request=0' + \
            ' --Ice.Admin.InstanceName="Glacier2"' + \
            ' --Glacier2.Client.Buffered=1 --Glacier2.Server.Buffered=1' + \
-           ' --Glacier2.Client.SleepTime=50 --Glacier2.Server.SleepTime=50'
+           ' --Glacier2.Server.SleepTime=50'
 
-    sys.stdout.write("starting router in buffered mode... ")
+    if flushSize > 0:
+        args += ' --Glacier2.Client.SleepTime=1000 --Glacier2.Client.FlushSize=%d' % flushSize
+        sys.stdout.write("starting router in buffered mode with flush size... ")
+    else:
+        args += ' --Glacier2.Client.SleepTime=50'
+        sys.stdout.write("starting router in buffered mode... ")
     sys.stdout.flush()
     starterProc = TestUtil.startServer(router, args, count=2)
     print("ok")
@@ -62,5 +67,9 @@ starterProc = startRouter()
 TestUtil.clientServerTest(name, additionalClientOptions = " --shutdown")
 starterProc.waitTestSuccess()
 
+starterProc = startRouter(4)
+TestUtil.clientServerTest(name, additionalClientOptions = " --shutdown --flushSize=4")
+starterProc.waitTestSuccess()
+
 if TestUtil.appverifier:
     TestUtil.appVerifierAfterTestEnd([router])
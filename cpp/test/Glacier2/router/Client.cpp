@@ -13,6 +13,7 @@
 #include <Glacier2/Router.h>
 #include <TestCommon.h>
 #include <CallbackI.h>
+#include <set>
 
 using namespace std;
 using namespace Ice;
@@ -409,6 +410,66 @@ public:
     }
 };
 
+class SessionClient : public IceUtil::Thread
+{
+public:
+
+    SessionClient(int id) : _id(id)
+    {
+    }
+
+    virtual
+    void run()
+    {
+        CommunicatorPtr communicator = initialize(initData);
+        ObjectPrx routerBase = communicator->stringToProxy("Glacier2/router:default -p 12347");
+        Glacier2::RouterPrx router = Glacier2::RouterPrx::checkedCast(routerBase);
+        communicator->setDefaultRouter(router);
+
+        ostringstream os;
+        os << "userid-" << _id;
+        Glacier2::SessionPrx session = router->createSession(os.str(), "abc123");
+        communicator->getProperties()->setProperty("Ice.PrintAdapterReady", "");
+        ObjectAdapterPtr adapter = communicator->createObjectAdapterWithRouter("CallbackReceiverAdapter", router);
+        adapter->activate();
+
+        _category = router->getCategoryForClient();
+        CallbackReceiverIPtr callbackReceiver = new CallbackReceiverI;
+        Identity ident;
+        ident.name = "callbackReceiver";
+        ident.category = _category;
+        CallbackReceiverPrx receiver = CallbackReceiverPrx::uncheckedCast(adapter->add(callbackReceiver, ident));
+
+        //
+        // The requests from the client are routed with its connection
+        // and the callbacks with its category.
+        //
+        CallbackPrx callback = CallbackPrx::uncheckedCast(communicator->stringToProxy("c1/callback:tcp -p 12010"));
+        Context context;
+        context["_fwd"] = "t";
+        for(int i = 0; i < 10; ++i)
+        {
+            callback->initiateCallback(receiver, context);
+            callbackReceiver->callbackOK();
+        }
+
+        router->destroySession();
+        communicator->destroy();
+    }
+
+    string
+    category() const
+    {
+        return _category;
+    }
+
+private:
+
+    int _id;
+    string _category;
+};
+typedef IceUtil::Handle<SessionClient> SessionClientPtr;
+
 class CallbackClient : public Application
 {
 public:
@@ -826,6 +887,52 @@ CallbackClient::run(int argc, char* argv[])
         cout << "ok" << endl;
     }
 
+    {
+        cout << "testing concurrent sessions... " << flush;
+        const int nClients = 16; // Passwords need to be added to the password file if more clients are needed.
+        int i;
+        vector<SessionClientPtr> clients;
+        for(i = 0; i < nClients; ++i)
+        {
+            clients.push_back(new SessionClient(i + 5));
+            clients.back()->start();
+        }
+        set<string> categories;
+        for(vector<SessionClientPtr>::const_iterator p = clients.begin(); p != clients.end(); ++p)
+        {
+            (*p)->getThreadControl().join();
+            test(categories.insert((*p)->category()).second);
+        }
+
+        //
+        // The sessions are destroyed, callbacks to their categories
+        // are rejected.
+        //
+        Context context;
+        context["_fwd"] = "t";
+        for(set<string>::const_iterator q = categories.begin(); q != categories.end(); ++q)
+        {
+            Identity ident;
+            ident.name = "callbackReceiver";
+            ident.category = *q;
+            try
+            {
+                twoway->initiateCallback(CallbackReceiverPrx::uncheckedCast(twowayR->ice_identity(ident)), context);
+                test(false);
+            }
+            catch(const ObjectNotExistException&)
+            {
+            }
+        }
+
+        //
+        // The session of this client is still routed.
+        //
+        twoway->initiateCallback(twowayR, context);
+        callbackReceiverImpl->callbackOK();
+        cout << "ok" << endl;
+    }
+
     {
         cout << "testing server shutdown... " << flush;
         twoway->shutdown();
@@ -25,7 +25,7 @@ router = TestUtil.getGlacier2Router()
 if TestUtil.appverifier:
     TestUtil.setAppVerifierSettings([router])
 
-def startRouter(buffered):
+def startRouter(buffered, sleepTime = 0, flushSize = 0):
 
     args = ' --Ice.Warn.Dispatch=0' + \
            ' --Ice.Warn.Connections=0' + \
@@ -38,7 +38,13 @@ def startRouter(buffered):
            ' --Ice.Admin.InstanceName="Glacier2"' + \
            ' --Glacier2.CryptPasswords="%s"' % os.path.join(os.getcwd(), "passwords")
 
-    if buffered:
+    if buffered and sleepTime > 0:
+        args += ' --Glacier2.Client.Buffered=1 --Glacier2.Server.Buffered=1' + \
+                ' --Glacier2.Client.SleepTime=%d --Glacier2.Server.SleepTime=%d' % (sleepTime, sleepTime) + \
+                ' --Glacier2.Client.FlushSize=%d --Glacier2.Server.FlushSize=%d' % (flushSize, flushSize)
+        sys.stdout.write("starting router in buffered mode with sleep time and flush size... ")
+        sys.stdout.flush()
+    elif buffered:
         args += ' --Glacier2.Client.Buffered=1 --Glacier2.Server.Buffered=1' 
         sys.stdout.write("starting router in buffered mode... ")
         sys.stdout.flush()
@@ -57,9 +63,10 @@ name = os.path.join("Glacier2", "router")
 #
 # Generate the crypt passwords file
 #
-TestUtil.hashPasswords(os.path.join(os.getcwd(), "passwords"),
-                        {"userid": "abc123", "userid-0": "abc123", "userid-1": "abc123",
-                         "userid-2": "abc123", "userid-3": "abc123","userid-4": "abc123"})
+passwords = {"userid": "abc123"}
+for i in range(0, 21):
+    passwords["userid-%d" % i] = "abc123"
+TestUtil.hashPasswords(os.path.join(os.getcwd(), "passwords"), passwords)
 #
 # We first run the test with unbuffered mode.
 #
@@ -82,5 +89,13 @@ TestUtil.clientServerTest(name, additionalClientOptions = " --shutdown")
 
 starterProc.waitTestSuccess()
 
+#
+# Finally we run the test in buffered mode with the queues flushed
+# after a sleep time or once they reach the flush size.
+#
+starterProc = startRouter(True, 50, 4)
+TestUtil.clientServerTest(name, additionalClientOptions = " --shutdown")
+starterProc.waitTestSuccess()
+
 if TestUtil.appverifier:
     TestUtil.appVerifierAfterTestEnd([router])
@@ -29,37 +29,49 @@ if TestUtil.appverifier:
     targets = [server, client, router]
     TestUtil.setAppVerifierSettings(targets)
 
-sys.stdout.write("starting server... ")
-sys.stdout.flush()
-serverProc = TestUtil.startServer(server)
-print("ok")
+def runTest(additional = ""):
 
-args =    ' --Glacier2.Client.Endpoints="default -p 12347"' + \
-          ' --Ice.Admin.Endpoints="tcp -p 12348"' + \
-          ' --Ice.Admin.InstanceName=Glacier2' + \
-          ' --Glacier2.Server.Endpoints="default -p 12349"' + \
-          ' --Glacier2.SessionManager="SessionManager:tcp -p 12010"' \
-          ' --Glacier2.PermissionsVerifier="Glacier2/NullPermissionsVerifier"'
+    sys.stdout.write("starting server... ")
+    sys.stdout.flush()
+    serverProc = TestUtil.startServer(server)
+    print("ok")
 
-sys.stdout.write("starting router... ")
-sys.stdout.flush()
-starterProc = TestUtil.startServer(router, args, count = 2)
-print("ok")
+    args =    ' --Glacier2.Client.Endpoints="default -p 12347"' + \
+              ' --Ice.Admin.Endpoints="tcp -p 12348"' + \
+              ' --Ice.Admin.InstanceName=Glacier2' + \
+              ' --Glacier2.Server.Endpoints="default -p 12349"' + \
+              ' --Glacier2.SessionManager="SessionManager:tcp -p 12010"' \
+              ' --Glacier2.PermissionsVerifier="Glacier2/NullPermissionsVerifier"' + \
+              additional
 
-#
-# The test may sporadically fail without this slight pause.
-#
-time.sleep(1)
+    sys.stdout.write("starting router... ")
+    sys.stdout.flush()
+    starterProc = TestUtil.startServer(router, args, count = 2)
+    print("ok")
+
+    #
+    # The test may sporadically fail without this slight pause.
+    #
+    time.sleep(1)
+
+    sys.stdout.write("starting client... ")
+    sys.stdout.flush()
+    clientProc = TestUtil.startClient(client, startReader = False)
+    print("ok")
+    clientProc.startReader()
 
-sys.stdout.write("starting client... ")
-sys.stdout.flush()
-clientProc = TestUtil.startClient(client, startReader = False)
-print("ok")
-clientProc.startReader()
+    clientProc.waitTestSuccess()
+    serverProc.waitTestSuccess()
+    starterProc.waitTestSuccess()
 
-clientProc.waitTestSuccess()
-serverProc.waitTestSuccess()
-starterProc.waitTestSuccess()
+runTest()
+
+#
+# Run the test again with the request queues flushed after a sleep
+# time or once they reach the flush size.
+#
+runTest(' --Glacier2.Client.SleepTime=50 --Glacier2.Server.SleepTime=50' + \
+        ' --Glacier2.Client.FlushSize=4 --Glacier2.Server.FlushSize=4')
 
 if TestUtil.appverifier:
     TestUtil.appVerifierAfterTestEnd(targets)
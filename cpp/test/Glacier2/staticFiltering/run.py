@@ -222,6 +222,38 @@ if not limitedTests:
                 ("127.0.0.1", fqdn, '', '', '', ''),
                 [(False, 'hello:tcp -h %s -p 12010:tcp -h 127.0.0.1 -p 12010' % fqdn),
                 (True, 'bar:tcp -h 127.0.0.1 -p 12010')], []),
+            ('testing prefix address rule',
+                ('127.0.*', '', '', '', '', ''),
+                [(True, 'hello:tcp -h 127.0.0.1 -p 12010'),
+                (False, 'hello:tcp -h localhost -p 12010'),
+                (False, 'hello:tcp -h 127.0.0.1 -p 12010:tcp -h localhost -p 12010'),
+                (True, 'hello2:tcp -h 127.0.0.1 -p 12010'),
+                (False, 'hello2:tcp -h localhost -p 12010')], []),
+            ('testing suffix address rule',
+                ('*host', '', '', '', '', ''),
+                [(True, 'hello:tcp -h localhost -p 12010'),
+                (False, 'hello:tcp -h 127.0.0.1 -p 12010'),
+                (True, 'hello2:tcp -h localhost -p 12010'),
+                (False, 'hello2:tcp -h 127.0.0.1 -p 12010')], []),
+            ('testing mixed prefix and suffix address rules',
+                ('127.0.* *host', '*.0.0.1:12011 local*:12011', '', '', '', ''),
+                [(True, 'hello:tcp -h 127.0.0.1 -p 12010'),
+                (True, 'hello:tcp -h localhost -p 12010'),
+                (False, 'hello:tcp -h 127.0.0.1 -p 12011'),
+                (False, 'hello:tcp -h localhost -p 12011'),
+                (False, 'hello:tcp -h 127.0.0.1 -p 12010:tcp -h localhost -p 12010'),
+                (True, 'hello:tcp -h 127.0.0.1 -p 12011:tcp -h 127.0.0.1 -p 12010'),
+                (True, 'hello2:tcp -h 127.0.0.1 -p 12010'),
+                (True, 'hello3:tcp -h localhost -p 12010'),
+                (False, 'hello2:tcp -h 127.0.0.1 -p 12011'),
+                (False, 'hello3:tcp -h localhost -p 12011')], []),
+            ('testing address rules with repeated endpoints and category filter',
+                ('127.0.*', '', '', 'foo', '', ''),
+                [(True, 'foo/a:tcp -h 127.0.0.1 -p 12010'),
+                (False, 'bar/a:tcp -h 127.0.0.1 -p 12010'),
+                (True, 'foo/b:tcp -h 127.0.0.1 -p 12010'),
+                (False, 'foo/c:tcp -h localhost -p 12010'),
+                (False, 'foo/d:tcp -h localhost -p 12010')], []),
             ('testing maximum proxy length rule',
                 ('', '', '53', '', '', ''),
                 [(True, 'hello:tcp -h 127.0.0.1 -p 12010 -t infinite'),
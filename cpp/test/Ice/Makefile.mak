@@ -84,6 +84,11 @@ SUBDIRS		= $(SUBDIRS) \
 		  stringConverter \
 		  background \
 		  threadPoolPriority \
+		  sendQueue \
+		  acceptors \
+		  threadPoolShards \
+		  threadPoolWorkQueue \
+		  compression \
 		  custom \
 		  properties \
 		  servantLocator \
@@ -0,0 +1,75 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    cout << "testing stringToProxy... " << flush;
+    TestIntfPrx proxy = TestIntfPrx::checkedCast(
+        communicator->stringToProxy("test:" + getTestEndpoint(communicator, 0)));
+    test(proxy);
+    TestIntfControllerPrx controller = TestIntfControllerPrx::checkedCast(
+        communicator->stringToProxy("testController:" + getTestEndpoint(communicator, 1, "tcp")));
+    test(controller);
+    cout << "ok" << endl;
+
+    cout << "testing connections to several acceptors... " << flush;
+    {
+        //
+        // Each connection dispatches a request that blocks until it's
+        // released. The shard of each acceptor has a single thread, so
+        // the requests are only dispatched concurrently by the shards of
+        // the acceptors which accepted a connection.
+        //
+        const int nConnections = 64;
+        vector<TestIntfPrx> proxies;
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < nConnections; ++i)
+        {
+            ostringstream os;
+            os << "connection-" << i;
+            proxies.push_back(proxy->ice_connectionId(os.str()));
+            results.push_back(proxies.back()->begin_block());
+        }
+
+#if defined(__linux)
+        //
+        // Linux spreads the connections over the acceptors listening
+        // with SO_REUSEPORT, each acceptor accepts some connections.
+        //
+        test(controller->waitForDispatches(4));
+#else
+        test(controller->waitForDispatches(1));
+#endif
+
+        controller->release();
+        for(int i = 0; i < nConnections; ++i)
+        {
+            proxies[i]->end_block(results[i]);
+        }
+
+        //
+        // All the connections remain usable.
+        //
+        for(vector<TestIntfPrx>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+        {
+            (*p)->ice_ping();
+        }
+    }
+    cout << "ok" << endl;
+
+    proxy->shutdown();
+}
@@ -0,0 +1,47 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+DEFINE_TEST("client")
+
+using namespace std;
+using namespace Test;
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    void allTests(const Ice::CommunicatorPtr&);
+    allTests(communicator);
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL();
+#endif
+
+    try
+    {
+        Ice::CommunicatorHolder ich = Ice::initialize(argc, argv);
+        RemoteConfig rc("Ice/acceptors", argc, argv, ich.communicator());
+        int status = run(argc, argv, ich.communicator());
+        rc.finished(status);
+        return status;
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,65 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+DEFINE_TEST("server")
+
+using namespace std;
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    //
+    // The adapter listens with 4 acceptors and its thread pool has a
+    // shard with a single thread for each acceptor.
+    //
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    properties->setProperty("TestAdapter.Endpoints", getTestEndpoint(communicator, 0));
+    properties->setProperty("TestAdapter.Acceptors", "4");
+    properties->setProperty("TestAdapter.ThreadPool.Size", "1");
+    properties->setProperty("TestAdapter.ThreadPool.Shards", "4");
+    properties->setProperty("ControllerAdapter.Endpoints", getTestEndpoint(communicator, 1, "tcp"));
+    properties->setProperty("ControllerAdapter.ThreadPool.Size", "1");
+
+    DispatchesPtr dispatches = new Dispatches();
+
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(new TestIntfI(dispatches), communicator->stringToIdentity("test"));
+    adapter->activate();
+
+    Ice::ObjectAdapterPtr adapter2 = communicator->createObjectAdapter("ControllerAdapter");
+    adapter2->add(new TestIntfControllerI(dispatches), communicator->stringToIdentity("testController"));
+    adapter2->activate();
+
+    TEST_READY
+
+    communicator->waitForShutdown();
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL();
+#endif
+    try
+    {
+        Ice::CommunicatorHolder ich = Ice::initialize(argc, argv);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
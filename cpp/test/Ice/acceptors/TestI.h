@@ -0,0 +1,60 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class Dispatches : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    Dispatches();
+
+    void block();
+    bool waitForDispatches(int);
+    void release();
+
+private:
+
+    int _dispatches;
+    bool _released;
+};
+typedef IceUtil::Handle<Dispatches> DispatchesPtr;
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    TestIntfI(const DispatchesPtr&);
+
+    virtual void block(const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    const DispatchesPtr _dispatches;
+};
+
+class TestIntfControllerI : public Test::TestIntfController
+{
+public:
+
+    TestIntfControllerI(const DispatchesPtr&);
+
+    virtual bool waitForDispatches(Ice::Int, const Ice::Current&);
+    virtual void release(const Ice::Current&);
+
+private:
+
+    const DispatchesPtr _dispatches;
+};
+
+#endif
@@ -0,0 +1,359 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <Ice/Network.h>
+#include <IceUtil/Thread.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+using namespace IceInternal;
+
+//
+// The peers below talk to the Ice peers with raw sockets, like a peer
+// running Ice 3.6 or earlier would: they only check the compression
+// status of the messages and never uncompress them.
+//
+namespace
+{
+
+void
+writeInt(vector<Ice::Byte>& bytes, Ice::Int value)
+{
+    for(int i = 0; i < 4; ++i)
+    {
+        bytes.push_back(static_cast<Ice::Byte>((value >> (i * 8)) & 0xff));
+    }
+}
+
+Ice::Int
+readInt(const vector<Ice::Byte>& bytes, size_t pos)
+{
+    Ice::Int value = 0;
+    for(int i = 0; i < 4; ++i)
+    {
+        value |= static_cast<Ice::Int>(bytes[pos + i]) << (i * 8);
+    }
+    return value;
+}
+
+void
+writeString(vector<Ice::Byte>& bytes, const string& value)
+{
+    bytes.push_back(static_cast<Ice::Byte>(value.size()));
+    bytes.insert(bytes.end(), value.begin(), value.end());
+}
+
+vector<Ice::Byte>
+createHeader(Ice::Byte messageType, Ice::Byte compress)
+{
+    vector<Ice::Byte> header(magic, magic + sizeof(magic));
+    header.push_back(protocolMajor);
+    header.push_back(protocolMinor);
+    header.push_back(protocolEncodingMajor);
+    header.push_back(protocolEncodingMinor);
+    header.push_back(messageType);
+    header.push_back(compress);
+    writeInt(header, headerSize);
+    return header;
+}
+
+void
+writeBytes(SOCKET fd, const vector<Ice::Byte>& bytes)
+{
+    size_t offset = 0;
+    while(offset < bytes.size())
+    {
+        int n = static_cast<int>(::send(fd, reinterpret_cast<const char*>(&bytes[offset]),
+                                        static_cast<int>(bytes.size() - offset), 0));
+        if(n == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            Ice::SocketException ex(__FILE__, __LINE__);
+            ex.error = getSocketErrno();
+            throw ex;
+        }
+        offset += n;
+    }
+}
+
+void
+writeMessage(SOCKET fd, vector<Ice::Byte>& message)
+{
+    Ice::Int size = static_cast<Ice::Int>(message.size());
+    for(int i = 0; i < 4; ++i)
+    {
+        message[10 + i] = static_cast<Ice::Byte>((size >> (i * 8)) & 0xff);
+    }
+    writeBytes(fd, message);
+}
+
+//
+// Read the given number of bytes, returns false if the peer closed
+// the connection.
+//
+bool
+readBytes(SOCKET fd, vector<Ice::Byte>& bytes, size_t size)
+{
+    bytes.resize(size);
+    size_t offset = 0;
+    while(offset < size)
+    {
+        int n = static_cast<int>(::recv(fd, reinterpret_cast<char*>(&bytes[offset]),
+                                        static_cast<int>(size - offset), 0));
+        if(n == 0)
+        {
+            return false;
+        }
+        else if(n == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            Ice::SocketException ex(__FILE__, __LINE__);
+            ex.error = getSocketErrno();
+            throw ex;
+        }
+        offset += n;
+    }
+    return true;
+}
+
+//
+// Read a message and return its header, the body is discarded.
+//
+void
+readMessage(SOCKET fd, vector<Ice::Byte>& header)
+{
+    test(readBytes(fd, header, headerSize));
+    test(equal(magic, magic + sizeof(magic), header.begin()));
+    Ice::Int size = readInt(header, 10);
+    test(size >= headerSize);
+    vector<Ice::Byte> body;
+    test(readBytes(fd, body, static_cast<size_t>(size - headerSize)));
+}
+
+//
+// A server which advertises the given codecs and records the
+// compression status of the request it receives.
+//
+class PeerServer : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    PeerServer(const string& host, Ice::Byte codecs) : _host(host), _codecs(codecs), _compress(0)
+    {
+        Address addr = getAddressForServer(host, 0, EnableBoth, false);
+        _fd = createServerSocket(false, addr, EnableBoth);
+        _port = getPort(doBind(_fd, addr));
+        doListen(_fd, 1);
+    }
+
+    virtual void
+    run()
+    {
+        SOCKET fd = doAccept(_fd);
+        closeSocket(_fd);
+
+        vector<Ice::Byte> message = createHeader(validateConnectionMsg, _codecs);
+        writeMessage(fd, message);
+
+        vector<Ice::Byte> header;
+        readMessage(fd, header);
+        test(header[8] == requestMsg);
+        {
+            Lock sync(*this);
+            _compress = header[9];
+        }
+
+        //
+        // Wait for the client to close the connection.
+        //
+        readMessage(fd, header);
+        test(header[8] == closeConnectionMsg);
+        closeSocket(fd);
+    }
+
+    string
+    getEndpoint() const
+    {
+        ostringstream os;
+        os << "tcp -h \"" << _host << "\" -p " << _port;
+        return os.str();
+    }
+
+    Ice::Byte
+    getCompressionStatus()
+    {
+        Lock sync(*this);
+        return _compress;
+    }
+
+private:
+
+    const string _host;
+    const Ice::Byte _codecs;
+    SOCKET _fd;
+    int _port;
+    Ice::Byte _compress;
+};
+typedef IceUtil::Handle<PeerServer> PeerServerPtr;
+
+Ice::Byte
+sendToPeerServer(const Ice::CommunicatorPtr& communicator, const string& host, Ice::Byte codecs)
+{
+    PeerServerPtr server = new PeerServer(host, codecs);
+    IceUtil::ThreadControl thread = server->start();
+
+    TestIntfPrx proxy = TestIntfPrx::uncheckedCast(
+        communicator->stringToProxy("test:" + server->getEndpoint())->ice_compress(true)->ice_oneway());
+    proxy->opByteSeq(ByteSeq(10000));
+    proxy->ice_getConnection()->close(false);
+    thread.join();
+    return server->getCompressionStatus();
+}
+
+Ice::Byte
+getCodecStatus(const string& codec)
+{
+    if(codec == "lz4")
+    {
+        return 3;
+    }
+    else if(codec == "zstd")
+    {
+        return 4;
+    }
+    return 2;
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    cout << "testing stringToProxy... " << flush;
+    TestIntfPrx proxy = TestIntfPrx::checkedCast(
+        communicator->stringToProxy("test:" + getTestEndpoint(communicator, 0)));
+    test(proxy);
+    cout << "ok" << endl;
+
+    //
+    // The codec used by the server adapter, empty if Ice is built
+    // without LZ4 and zstd.
+    //
+    string codec = proxy->getCodec();
+    Ice::Byte status = getCodecStatus(codec);
+
+    Ice::CommunicatorPtr codecCommunicator;
+    if(!codec.empty())
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.Compression.Codec", codec);
+        codecCommunicator = Ice::initialize(initData);
+    }
+
+    Ice::IPEndpointInfoPtr info = ICE_DYNAMIC_CAST(Ice::IPEndpointInfo,
+        communicator->stringToProxy("test:" + getTestEndpoint(communicator, 1, "tcp"))->ice_getEndpoints()[0]->getInfo());
+    string host = info->host.empty() ? "127.0.0.1" : info->host;
+
+    cout << "testing compressed requests and replies... " << flush;
+    {
+        ByteSeq seq = proxy->getByteSeq(10000);
+        proxy->ice_compress(true)->opByteSeq(seq);
+        test(proxy->ice_compress(true)->getByteSeq(10000) == seq);
+        if(codecCommunicator)
+        {
+            TestIntfPrx p = TestIntfPrx::uncheckedCast(
+                codecCommunicator->stringToProxy(proxy->ice_toString())->ice_compress(true));
+            p->opByteSeq(seq);
+            test(p->getByteSeq(10000) == seq);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing server with a client which doesn't support the codecs... " << flush;
+    {
+        Address addr = getAddresses(host, info->port, EnableBoth, Ice::Ordered, false, true)[0];
+        SOCKET fd = createSocket(false, addr);
+        doConnect(fd, addr, Address());
+
+        //
+        // The server advertises the codecs it supports with the
+        // compression status of the validate connection message.
+        //
+        vector<Ice::Byte> header;
+        readMessage(fd, header);
+        test(header[8] == validateConnectionMsg);
+        if(codec.empty())
+        {
+            test(header[9] == 0);
+        }
+        else
+        {
+            test((header[9] & (1 << status)) && (header[9] & 0x07) == 0);
+        }
+
+        //
+        // Send getByteSeq with compression status 1, the server replies
+        // with bzip2 since the client never used its codec.
+        //
+        vector<Ice::Byte> message = createHeader(requestMsg, 1);
+        writeInt(message, 1); // Request id.
+        writeString(message, "test"); // Identity name.
+        writeString(message, ""); // Identity category.
+        message.push_back(0); // Facet.
+        writeString(message, "getByteSeq");
+        message.push_back(0); // Normal operation mode.
+        message.push_back(0); // Empty context.
+        writeInt(message, 10); // Encapsulation size.
+        message.push_back(encodingMajor);
+        message.push_back(encodingMinor);
+        writeInt(message, 10000);
+        writeMessage(fd, message);
+
+        readMessage(fd, header);
+        test(header[8] == replyMsg);
+        test(header[9] == 2);
+
+        message = createHeader(closeConnectionMsg, 0);
+        writeMessage(fd, message);
+        test(!readBytes(fd, header, 1));
+        closeSocket(fd);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing client with a server which doesn't support the codecs... " << flush;
+    {
+        test(sendToPeerServer(communicator, host, 0) == 2);
+        if(codecCommunicator)
+        {
+            //
+            // The client falls back to bzip2 unless the server
+            // advertises the codec.
+            //
+            test(sendToPeerServer(codecCommunicator, host, 0) == 2);
+            test(sendToPeerServer(codecCommunicator, host, static_cast<Ice::Byte>(1 << status)) == status);
+        }
+    }
+    cout << "ok" << endl;
+
+    if(codecCommunicator)
+    {
+        codecCommunicator->destroy();
+    }
+    proxy->shutdown();
+}
@@ -0,0 +1,91 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+DEFINE_TEST("server")
+
+using namespace std;
+
+namespace
+{
+
+//
+// Return the first codec other than bzip2 supported by this build of
+// Ice, or an empty string if Ice is built without LZ4 and zstd.
+//
+string
+getCodec()
+{
+    const char* codecs[] = { "zstd", "lz4" };
+    for(size_t i = 0; i < sizeof(codecs) / sizeof(codecs[0]); ++i)
+    {
+        Ice::InitializationData initData;
+        initData.properties = Ice::createProperties();
+        initData.properties->setProperty("Ice.Compression.Codec", codecs[i]);
+        try
+        {
+            Ice::initialize(initData)->destroy();
+            return codecs[i];
+        }
+        catch(const Ice::InitializationException&)
+        {
+        }
+    }
+    return "";
+}
+
+}
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    //
+    // The replies of the adapter are compressed with the codec if the
+    // client supports it. The second endpoint is used by the client to
+    // talk to the server without Ice.
+    //
+    string codec = getCodec();
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    properties->setProperty("TestAdapter.Endpoints",
+                            getTestEndpoint(communicator, 0) + ":" + getTestEndpoint(communicator, 1, "tcp"));
+    if(!codec.empty())
+    {
+        properties->setProperty("TestAdapter.Compression.Codec", codec);
+    }
+
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(new TestIntfI(codec), communicator->stringToIdentity("test"));
+    adapter->activate();
+
+    TEST_READY
+
+    communicator->waitForShutdown();
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL();
+#endif
+    try
+    {
+        Ice::CommunicatorHolder ich = Ice::initialize(argc, argv);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,50 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+#include <TestCommon.h>
+
+using namespace std;
+
+TestIntfI::TestIntfI(const string& codec) : _codec(codec)
+{
+}
+
+string
+TestIntfI::getCodec(const Ice::Current&)
+{
+    return _codec;
+}
+
+void
+TestIntfI::opByteSeq(const Test::ByteSeq& seq, const Ice::Current&)
+{
+    for(Test::ByteSeq::size_type i = 0; i < seq.size(); ++i)
+    {
+        test(seq[i] == static_cast<Ice::Byte>(i % 256));
+    }
+}
+
+Test::ByteSeq
+TestIntfI::getByteSeq(Ice::Int size, const Ice::Current&)
+{
+    Test::ByteSeq seq(size);
+    for(Test::ByteSeq::size_type i = 0; i < seq.size(); ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>(i % 256);
+    }
+    return seq;
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
@@ -0,0 +1,31 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    TestIntfI(const std::string&);
+
+    virtual std::string getCodec(const Ice::Current&);
+    virtual void opByteSeq(const Test::ByteSeq&, const Ice::Current&);
+    virtual Test::ByteSeq getByteSeq(Ice::Int, const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    const std::string _codec;
+};
+
+#endif
@@ -858,6 +858,45 @@ allTests(const Ice::CommunicatorPtr& communicator)
         test(ret == in);
     }
 
+    {
+        //
+        // The views returned by opByteView share the memory of the
+        // reply buffer. They must remain valid after the connection
+        // reads the next replies, whether smaller or larger.
+        //
+        vector<Ice::ByteView> views;
+        vector<vector<Ice::Byte> > seqs;
+        for(int i = 0; i < 10; ++i)
+        {
+            vector<Ice::Byte> seq(i % 2 == 0 ? 100 * (i + 1) : 10 * 1024 * (i + 1));
+            for(vector<Ice::Byte>::size_type j = 0; j < seq.size(); ++j)
+            {
+                seq[j] = static_cast<Ice::Byte>(i + j);
+            }
+
+            Ice::ByteView in(seq);
+            Ice::ByteView out;
+            Ice::ByteView ret = t->opByteView(in, out);
+            test(out == in);
+            test(ret == in);
+
+            views.push_back(out);
+            views.push_back(ret);
+            seqs.push_back(seq);
+            seqs.push_back(seq);
+        }
+
+        t->opByteView(Ice::ByteView(), views.back());
+        test(views.back().empty());
+        views.pop_back();
+        seqs.pop_back();
+
+        for(vector<Ice::ByteView>::size_type i = 0; i < views.size(); ++i)
+        {
+            test(views[i] == Ice::ByteView(seqs[i]));
+        }
+    }
+
     {
         deque<string> in(5);
         in[0] = "These";
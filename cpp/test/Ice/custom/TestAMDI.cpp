@@ -145,6 +145,14 @@ TestIntfI::opMyByteSeq_async(const Test::AMD_TestIntf_opMyByteSeqPtr& opMyByteSe
     opMyByteSeqCB->ice_response(outSeq, outSeq);
 }
 
+void
+TestIntfI::opByteView_async(const Test::AMD_TestIntf_opByteViewPtr& opByteViewCB,
+                            const Ice::ByteView& inSeq,
+                            const Ice::Current&)
+{
+    opByteViewCB->ice_response(inSeq, inSeq);
+}
+
 void 
 TestIntfI::opString_async(const Test::AMD_TestIntf_opStringPtr& opStringCB,
                          const Util::string_view& inString,
@@ -76,6 +76,10 @@ public:
                                    const MyByteSeq&,
                                    const Ice::Current&);
 
+    virtual void opByteView_async(const Test::AMD_TestIntf_opByteViewPtr&,
+                                  const Ice::ByteView&,
+                                  const Ice::Current&);
+
     virtual void opString_async(const Test::AMD_TestIntf_opStringPtr&,
                                 const Util::string_view&,
                                 const Ice::Current&);
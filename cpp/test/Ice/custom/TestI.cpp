@@ -187,6 +187,15 @@ TestIntfI::opMyByteSeq(const MyByteSeq& inSeq,
     return inSeq;
 }
 
+Ice::ByteView
+TestIntfI::opByteView(const Ice::ByteView& inSeq,
+                      Ice::ByteView& outSeq,
+                      const Ice::Current&)
+{
+    outSeq = inSeq;
+    return inSeq;
+}
+
 std::string
 TestIntfI::opString(const Util::string_view& inString,
                     std::string& outString,
@@ -96,6 +96,10 @@ public:
                                   MyByteSeq&,
                                   const Ice::Current&);
 
+    virtual Ice::ByteView opByteView(const Ice::ByteView&,
+                                     Ice::ByteView&,
+                                     const Ice::Current&);
+
     virtual std::string opString(const Util::string_view&,
                                  std::string&,
                                  const Ice::Current&);
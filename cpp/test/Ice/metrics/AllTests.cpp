@@ -1366,6 +1366,82 @@ allTests(const Ice::CommunicatorPtr& communicator, const CommunicatorObserverIPt
 
     cout << "ok" << endl;
 
+#if !defined(ICE_OS_WINRT) && TARGET_OS_IPHONE==0
+    if(!collocated)
+    {
+        cout << "testing compression metrics... " << flush;
+
+        props["IceMX.Metrics.View.Map.Compression.GroupBy"] = "operation";
+        updateProps(clientProps, serverProps, update.get(), props, "Compression");
+        test(clientMetrics->getMetricsView("View", timestamp)["Compression"].empty());
+        test(serverMetrics->getMetricsView("View", timestamp)["Compression"].empty());
+
+        //
+        // The request is compressed by the client and uncompressed
+        // by the server. The reply is too small to be compressed.
+        //
+        Test::ByteSeq bs(1024, 'x');
+        metrics->ice_compress(true)->opByteS(bs);
+
+        map = toMap(clientMetrics->getMetricsView("View", timestamp)["Compression"]);
+        test(map.size() == 1);
+        IceMX::CompressionMetricsPtr cm1 = ICE_DYNAMIC_CAST(IceMX::CompressionMetrics, map["compress"]);
+        test(cm1->current == 0 && cm1->total == 1 && cm1->failures == 0);
+        test(cm1->uncompressedSize > static_cast<Ice::Long>(bs.size()) && cm1->compressedSize > 0);
+        test(cm1->compressedSize < cm1->uncompressedSize);
+
+        map = toMap(serverMetrics->getMetricsView("View", timestamp)["Compression"]);
+        test(map.size() == 1);
+        IceMX::CompressionMetricsPtr cm2 = ICE_DYNAMIC_CAST(IceMX::CompressionMetrics, map["uncompress"]);
+        test(cm2->current == 0 && cm2->total == 1 && cm2->failures == 0);
+        test(cm2->uncompressedSize == cm1->uncompressedSize && cm2->compressedSize == cm1->compressedSize);
+
+        props["IceMX.Metrics.View.Map.Compression.GroupBy"] = "codec";
+        updateProps(clientProps, serverProps, update.get(), props, "Compression");
+        metrics->ice_compress(true)->opByteS(bs);
+        map = toMap(clientMetrics->getMetricsView("View", timestamp)["Compression"]);
+        test(map.size() == 1 && map["bzip2"] && map["bzip2"]->total == 1);
+
+        cout << "ok" << endl;
+    }
+#endif
+
+    cout << "testing buffer pool metrics... " << flush;
+
+    props["IceMX.Metrics.View.Map.BufferPool.GroupBy"] = "parent";
+    updateProps(clientProps, serverProps, update.get(), props, "BufferPool");
+
+    //
+    // The client caches its message buffers, the buffers of the
+    // requests are released once sent and re-used by the next
+    // requests.
+    //
+    for(int i = 0; i < 10; ++i)
+    {
+        metrics->op();
+    }
+
+    map = toMap(clientMetrics->getMetricsView("View", timestamp)["BufferPool"]);
+    test(map.size() == 1);
+    IceMX::BufferPoolMetricsPtr bm = ICE_DYNAMIC_CAST(IceMX::BufferPoolMetrics, map["Communicator"]);
+    test(bm->total >= 10 && bm->failures == 0);
+    test(bm->hits > 0 && bm->hits + bm->misses <= bm->total);
+
+    if(!collocated)
+    {
+        //
+        // Buffers larger than the largest size class (1MB) aren't cached.
+        //
+        props["IceMX.Metrics.View.Map.BufferPool.GroupBy"] = "sizeClass";
+        updateProps(clientProps, serverProps, update.get(), props, "BufferPool");
+        metrics->opByteS(Test::ByteSeq(2 * 1024 * 1024, 'x'));
+        map = toMap(clientMetrics->getMetricsView("View", timestamp)["BufferPool"]);
+        bm = ICE_DYNAMIC_CAST(IceMX::BufferPoolMetrics, map["uncached"]);
+        test(bm && bm->total >= 1 && bm->hits == 0 && bm->misses == bm->total);
+    }
+
+    cout << "ok" << endl;
+
     cout << "testing metrics view enable/disable..." << flush;
 
     Ice::StringSeq disabledViews;
@@ -42,6 +42,7 @@ main(int argc, char* argv[])
         initData.properties->setProperty("Ice.Warn.Connections", "0");
         initData.properties->setProperty("Ice.MessageSizeMax", "50000");
         initData.properties->setProperty("Ice.Default.Host", "127.0.0.1");
+        initData.properties->setProperty("Ice.CacheMessageBuffers", "1");
         CommunicatorObserverIPtr observer = ICE_MAKE_SHARED(CommunicatorObserverI);
         initData.observer = observer;
         Ice::CommunicatorHolder ich = Ice::initialize(argc, argv, initData);
@@ -191,4 +191,57 @@ batchOneways(const Test::MyClassPrxPtr& p)
         ic->destroy();
     }
 
+    if(batch->ice_getConnection() &&
+       p->ice_getCommunicator()->getProperties()->getProperty("Ice.Default.Protocol") != "bt")
+    {
+        Ice::InitializationData initData;
+        initData.properties = p->ice_getCommunicator()->getProperties()->clone();
+        initData.properties->setProperty("Ice.BatchAutoFlushDelay", "50000"); // 50ms
+        Ice::CommunicatorPtr ic = Ice::initialize(initData);
+
+        Test::MyClassPrxPtr batch =
+            ICE_UNCHECKED_CAST(Test::MyClassPrx, ic->stringToProxy(p->ice_toString()))->ice_batchOneway();
+
+        //
+        // The requests are flushed after the delay without an
+        // explicit flush.
+        //
+        const Test::ByteS bs2(100);
+        p->opByteSOnewayCallCount(); // Reset the call count
+        for(i = 0; i < 3; ++i)
+        {
+            batch->opByteSOneway(bs2);
+        }
+        int count = 0;
+        for(int j = 0; j < 500 && count < 3; ++j)
+        {
+            count += p->opByteSOnewayCallCount();
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        }
+        test(count == 3);
+
+        //
+        // The batch is flushed explicitly while the flush task is
+        // pending, the requests queued after the flush are flushed
+        // by the rescheduled task.
+        //
+        batch->opByteSOneway(bs2);
+        batch->ice_flushBatchRequests();
+        batch->opByteSOneway(bs2);
+        batch->opByteSOneway(bs2);
+        count = 0;
+        for(int j = 0; j < 500 && count < 3; ++j)
+        {
+            count += p->opByteSOnewayCallCount();
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        }
+        test(count == 3);
+
+        //
+        // The communicator is destroyed with a pending flush task.
+        //
+        batch->opByteSOneway(bs2);
+        ic->destroy();
+    }
+
 }
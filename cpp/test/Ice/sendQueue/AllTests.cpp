@@ -0,0 +1,161 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Random.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+//
+// Sends small oneway requests and, every largeEvery requests, a large
+// request with a payload of a random size. The requests of all the
+// producers are sent over the same connection, they are queued and
+// gathered together while a large request is being sent.
+//
+class Producer : public IceUtil::Thread
+{
+public:
+
+    Producer(const TestIntfPrx& proxy, int id, int count, int largeEvery, bool ami) :
+        _proxy(proxy), _id(id), _count(count), _largeEvery(largeEvery), _ami(ami)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        for(int seq = 0; seq < _count; ++seq)
+        {
+            if(seq % _largeEvery == 0)
+            {
+                ByteSeq data(1024 + IceUtilInternal::random(256 * 1024));
+                for(ByteSeq::size_type i = 0; i < data.size(); ++i)
+                {
+                    data[i] = static_cast<Ice::Byte>(_id + seq + i);
+                }
+                if(_ami)
+                {
+                    _result = _proxy->begin_opLarge(_id, seq, data);
+                }
+                else
+                {
+                    _proxy->opLarge(_id, seq, data);
+                }
+            }
+            else
+            {
+                if(_ami)
+                {
+                    _result = _proxy->begin_opSmall(_id, seq);
+                }
+                else
+                {
+                    _proxy->opSmall(_id, seq);
+                }
+            }
+        }
+    }
+
+    void
+    waitForSent()
+    {
+        if(_result)
+        {
+            _result->waitForSent();
+        }
+    }
+
+private:
+
+    const TestIntfPrx _proxy;
+    const int _id;
+    const int _count;
+    const int _largeEvery;
+    const bool _ami;
+    Ice::AsyncResultPtr _result;
+};
+typedef IceUtil::Handle<Producer> ProducerPtr;
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    cout << "testing stringToProxy... " << flush;
+    TestIntfPrx proxy = TestIntfPrx::checkedCast(
+        communicator->stringToProxy("test:" + getTestEndpoint(communicator, 0)));
+    test(proxy);
+    TestIntfPrx oneway = proxy->ice_oneway();
+    TestIntfControllerPrx controller = TestIntfControllerPrx::checkedCast(
+        communicator->stringToProxy("testController:" + getTestEndpoint(communicator, 1, "tcp")));
+    test(controller);
+    cout << "ok" << endl;
+
+    const int nProducers = 4;
+    Ice::Int count = 0;
+
+    cout << "testing concurrent oneway requests with large requests... " << flush;
+    {
+        vector<ProducerPtr> producers;
+        for(int i = 0; i < nProducers; ++i)
+        {
+            producers.push_back(new Producer(oneway, i, 1000, 20, false));
+            producers.back()->start();
+        }
+        for(vector<ProducerPtr>::const_iterator p = producers.begin(); p != producers.end(); ++p)
+        {
+            (*p)->getThreadControl().join();
+        }
+        count += nProducers * 1000;
+
+        //
+        // The twoway request is dispatched after the oneway requests
+        // sent before it over the same connection.
+        //
+        test(proxy->getCount() == count);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing queued requests with the server on hold... " << flush;
+    {
+        //
+        // The server doesn't read the requests while its adapter is on
+        // hold. The socket buffers fill up and the requests remain
+        // queued, once the adapter is activated they are written with
+        // partial writes that end in the middle of a request.
+        //
+        controller->holdAdapter();
+        vector<ProducerPtr> producers;
+        for(int i = 0; i < nProducers; ++i)
+        {
+            producers.push_back(new Producer(oneway, nProducers + i, 500, 10, true));
+            producers.back()->start();
+        }
+        for(vector<ProducerPtr>::const_iterator p = producers.begin(); p != producers.end(); ++p)
+        {
+            (*p)->getThreadControl().join();
+        }
+        controller->resumeAdapter();
+        for(vector<ProducerPtr>::const_iterator p = producers.begin(); p != producers.end(); ++p)
+        {
+            (*p)->waitForSent();
+        }
+        count += nProducers * 500;
+        test(proxy->getCount() == count);
+    }
+    cout << "ok" << endl;
+
+    proxy->shutdown();
+}
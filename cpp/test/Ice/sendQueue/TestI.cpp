@@ -0,0 +1,83 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+#include <TestCommon.h>
+
+using namespace std;
+
+TestIntfI::TestIntfI() : _count(0)
+{
+}
+
+void
+TestIntfI::opSmall(Ice::Int producer, Ice::Int seq, const Ice::Current&)
+{
+    received(producer, seq);
+}
+
+void
+TestIntfI::opLarge(Ice::Int producer, Ice::Int seq, const Test::ByteSeq& data, const Ice::Current&)
+{
+    //
+    // The payload is filled by the client with bytes derived from the
+    // producer and sequence number, any corruption of the gathered
+    // writes shows up as an unexpected byte.
+    //
+    test(!data.empty());
+    for(Test::ByteSeq::size_type i = 0; i < data.size(); ++i)
+    {
+        test(data[i] == static_cast<Ice::Byte>(producer + seq + i));
+    }
+    received(producer, seq);
+}
+
+Ice::Int
+TestIntfI::getCount(const Ice::Current&)
+{
+    Lock sync(*this);
+    return _count;
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
+
+void
+TestIntfI::received(Ice::Int producer, Ice::Int seq)
+{
+    //
+    // The requests of each producer must be dispatched in the order
+    // they were sent.
+    //
+    Lock sync(*this);
+    map<Ice::Int, Ice::Int>::iterator p = _last.insert(make_pair(producer, -1)).first;
+    test(seq == p->second + 1);
+    p->second = seq;
+    ++_count;
+}
+
+TestIntfControllerI::TestIntfControllerI(const Ice::ObjectAdapterPtr& adapter) : _adapter(adapter)
+{
+}
+
+void
+TestIntfControllerI::holdAdapter(const Ice::Current&)
+{
+    _adapter->hold();
+}
+
+void
+TestIntfControllerI::resumeAdapter(const Ice::Current&)
+{
+    _adapter->activate();
+}
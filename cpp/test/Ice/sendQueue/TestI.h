@@ -0,0 +1,50 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+#include <map>
+
+class TestIntfI : public Test::TestIntf, public IceUtil::Mutex
+{
+public:
+
+    TestIntfI();
+
+    virtual void opSmall(Ice::Int, Ice::Int, const Ice::Current&);
+    virtual void opLarge(Ice::Int, Ice::Int, const Test::ByteSeq&, const Ice::Current&);
+    virtual Ice::Int getCount(const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    void received(Ice::Int, Ice::Int);
+
+    std::map<Ice::Int, Ice::Int> _last;
+    Ice::Int _count;
+};
+
+class TestIntfControllerI : public Test::TestIntfController
+{
+public:
+
+    TestIntfControllerI(const Ice::ObjectAdapterPtr&);
+
+    virtual void holdAdapter(const Ice::Current&);
+    virtual void resumeAdapter(const Ice::Current&);
+
+private:
+
+    const Ice::ObjectAdapterPtr _adapter;
+};
+
+#endif
@@ -0,0 +1,173 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+vector<TestIntfPrx>
+connect(const TestIntfPrx& proxy, int count)
+{
+    //
+    // Establish the connections before sending any request, the shard
+    // of the acceptor can't accept connections while it's blocked.
+    //
+    vector<TestIntfPrx> proxies;
+    for(int i = 0; i < count; ++i)
+    {
+        ostringstream os;
+        os << "connection-" << i;
+        proxies.push_back(proxy->ice_connectionId(os.str()));
+        proxies.back()->ice_getConnection();
+    }
+    return proxies;
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    cout << "testing stringToProxy... " << flush;
+    TestIntfPrx proxy = TestIntfPrx::checkedCast(
+        communicator->stringToProxy("test:" + getTestEndpoint(communicator, 0)));
+    test(proxy);
+    TestIntfPrx serialized = TestIntfPrx::checkedCast(
+        communicator->stringToProxy("test:" + getTestEndpoint(communicator, 1)));
+    test(serialized);
+    TestIntfControllerPrx controller = TestIntfControllerPrx::checkedCast(
+        communicator->stringToProxy("testController:" + getTestEndpoint(communicator, 2, "tcp")));
+    test(controller);
+    cout << "ok" << endl;
+
+    const int nConnections = 8;
+    vector<TestIntfPrx> proxies = connect(proxy, nConnections);
+
+    cout << "testing dispatch across shards... " << flush;
+    {
+        //
+        // The connections are assigned to the shards in turn. Each
+        // shard has a single thread, a blocked request only blocks the
+        // connections of its shard.
+        //
+        vector<Ice::AsyncResultPtr> results;
+        for(vector<TestIntfPrx>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+        {
+            results.push_back((*p)->begin_block());
+        }
+        test(controller->waitForDispatches(4));
+        controller->release();
+        for(int i = 0; i < nConnections; ++i)
+        {
+            proxies[i]->end_block(results[i]);
+        }
+        controller->reset();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing serialization across shards... " << flush;
+    {
+        vector<TestIntfPrx> serializedProxies = connect(serialized, nConnections);
+        for(int value = 0; value < 1000; ++value)
+        {
+            for(vector<TestIntfPrx>::const_iterator p = serializedProxies.begin(); p != serializedProxies.end(); ++p)
+            {
+                (*p)->ice_oneway()->setOneway(value + 1, value);
+            }
+        }
+        for(vector<TestIntfPrx>::const_iterator p = serializedProxies.begin(); p != serializedProxies.end(); ++p)
+        {
+            (*p)->ice_ping();
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing work stealing... " << flush;
+    {
+        //
+        // The collocated requests are dispatched by the adapter thread
+        // pool and given to its shards in turn. Once a shard is blocked
+        // and has a queued request, the following requests are given to
+        // the other shard instead.
+        //
+        Ice::PropertiesPtr properties = communicator->getProperties();
+        properties->setProperty("Collocated.ThreadPool.Size", "1");
+        properties->setProperty("Collocated.ThreadPool.Shards", "2");
+        properties->setProperty("Collocated.ThreadPool.WorkStealing", "1");
+        Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("Collocated");
+        DispatchesPtr dispatches = new Dispatches();
+        TestIntfPrx collocated = TestIntfPrx::uncheckedCast(
+            adapter->add(new TestIntfI(dispatches), communicator->stringToIdentity("collocated")));
+        adapter->activate();
+
+        Ice::AsyncResultPtr result = collocated->begin_block();
+        test(dispatches->waitForDispatches(1));
+
+        //
+        // Without work stealing, every other request would wait for the
+        // blocked shard. With work stealing, only the request queued
+        // while the shard wasn't known to be busy waits. The requests
+        // are sent one after the other so that the other shard isn't
+        // busy when a request is given to it.
+        //
+        const int nPings = 10;
+        vector<Ice::AsyncResultPtr> pings;
+        int blocked = 0;
+        for(int i = 0; i < nPings; ++i)
+        {
+            pings.push_back(collocated->begin_ice_ping());
+            IceUtil::Time timeout = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(1);
+            while(!pings.back()->isCompleted() && IceUtil::Time::now(IceUtil::Time::Monotonic) < timeout)
+            {
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1));
+            }
+            if(!pings.back()->isCompleted())
+            {
+                ++blocked;
+            }
+        }
+        test(blocked <= 1);
+
+        dispatches->release();
+        collocated->end_block(result);
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = pings.begin(); p != pings.end(); ++p)
+        {
+            collocated->end_ice_ping(*p);
+        }
+        adapter->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing shutdown with blocked requests on all shards... " << flush;
+    {
+        vector<Ice::AsyncResultPtr> results;
+        for(vector<TestIntfPrx>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+        {
+            results.push_back((*p)->begin_block());
+        }
+        test(controller->waitForDispatches(4));
+
+        //
+        // The requests blocked when the server shuts down complete
+        // before the connections are closed.
+        //
+        controller->shutdown();
+        for(int i = 0; i < nConnections; ++i)
+        {
+            proxies[i]->end_block(results[i]);
+        }
+    }
+    cout << "ok" << endl;
+}
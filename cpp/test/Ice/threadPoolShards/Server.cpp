@@ -0,0 +1,78 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+DEFINE_TEST("server")
+
+using namespace std;
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    Ice::PropertiesPtr properties = communicator->getProperties();
+
+    //
+    // The thread pool of TestAdapter has 4 shards with a single thread.
+    //
+    properties->setProperty("TestAdapter.Endpoints", getTestEndpoint(communicator, 0));
+    properties->setProperty("TestAdapter.ThreadPool.Size", "1");
+    properties->setProperty("TestAdapter.ThreadPool.Shards", "4");
+
+    //
+    // The thread pool of SerializeAdapter has 4 shards with 2 threads,
+    // the requests of a connection are still dispatched in order.
+    //
+    properties->setProperty("SerializeAdapter.Endpoints", getTestEndpoint(communicator, 1));
+    properties->setProperty("SerializeAdapter.ThreadPool.Size", "2");
+    properties->setProperty("SerializeAdapter.ThreadPool.Shards", "4");
+    properties->setProperty("SerializeAdapter.ThreadPool.Serialize", "1");
+
+    properties->setProperty("ControllerAdapter.Endpoints", getTestEndpoint(communicator, 2, "tcp"));
+    properties->setProperty("ControllerAdapter.ThreadPool.Size", "1");
+
+    DispatchesPtr dispatches = new Dispatches();
+
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(new TestIntfI(dispatches), communicator->stringToIdentity("test"));
+    adapter->activate();
+
+    Ice::ObjectAdapterPtr adapter2 = communicator->createObjectAdapter("SerializeAdapter");
+    adapter2->add(new TestIntfI(dispatches), communicator->stringToIdentity("test"));
+    adapter2->activate();
+
+    Ice::ObjectAdapterPtr adapter3 = communicator->createObjectAdapter("ControllerAdapter");
+    adapter3->add(new TestIntfControllerI(dispatches), communicator->stringToIdentity("testController"));
+    adapter3->activate();
+
+    TEST_READY
+
+    communicator->waitForShutdown();
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL();
+#endif
+    try
+    {
+        Ice::CommunicatorHolder ich = Ice::initialize(argc, argv);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,118 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+#include <TestCommon.h>
+
+using namespace std;
+
+Dispatches::Dispatches() : _dispatches(0), _released(false)
+{
+}
+
+void
+Dispatches::block()
+{
+    Lock sync(*this);
+    ++_dispatches;
+    notifyAll();
+    while(!_released)
+    {
+        wait();
+    }
+}
+
+bool
+Dispatches::waitForDispatches(int count)
+{
+    Lock sync(*this);
+    IceUtil::Time timeout = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(10);
+    while(_dispatches < count)
+    {
+        IceUtil::Time delay = timeout - IceUtil::Time::now(IceUtil::Time::Monotonic);
+        if(delay <= IceUtil::Time() || !timedWait(delay))
+        {
+            break;
+        }
+    }
+    return _dispatches >= count;
+}
+
+void
+Dispatches::release()
+{
+    Lock sync(*this);
+    _released = true;
+    notifyAll();
+}
+
+void
+Dispatches::reset()
+{
+    Lock sync(*this);
+    _dispatches = 0;
+    _released = false;
+}
+
+TestIntfI::TestIntfI(const DispatchesPtr& dispatches) : _dispatches(dispatches)
+{
+}
+
+void
+TestIntfI::block(const Ice::Current&)
+{
+    _dispatches->block();
+}
+
+void
+TestIntfI::setOneway(Ice::Int value, Ice::Int expected, const Ice::Current& current)
+{
+    //
+    // The requests of each connection must be dispatched one after the
+    // other and in order.
+    //
+    Lock sync(*this);
+    Ice::Int& last = _last[current.con];
+    test(last == expected);
+    last = value;
+}
+
+TestIntfControllerI::TestIntfControllerI(const DispatchesPtr& dispatches) : _dispatches(dispatches)
+{
+}
+
+bool
+TestIntfControllerI::waitForDispatches(Ice::Int count, const Ice::Current&)
+{
+    return _dispatches->waitForDispatches(count);
+}
+
+void
+TestIntfControllerI::release(const Ice::Current&)
+{
+    _dispatches->release();
+}
+
+void
+TestIntfControllerI::reset(const Ice::Current&)
+{
+    _dispatches->reset();
+}
+
+void
+TestIntfControllerI::shutdown(const Ice::Current& current)
+{
+    //
+    // Shutdown the communicator while requests are blocked on the
+    // shards, the shutdown waits for these requests to complete.
+    //
+    current.adapter->getCommunicator()->shutdown();
+    _dispatches->release();
+}
@@ -0,0 +1,207 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+DEFINE_TEST("client")
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+//
+// The collocated requests are queued with the work queue of the
+// adapter thread pool by the thread which sends them. With a single
+// thread to execute them, the requests of each producer are dispatched
+// in the order they were sent.
+//
+class TestIntfI : public TestIntf, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    TestIntfI(int producers, bool ordered) : _last(producers, -1), _ordered(ordered), _count(0)
+    {
+    }
+
+    virtual void
+    op(Ice::Int producer, Ice::Int seq, const Ice::Current&)
+    {
+        Lock sync(*this);
+        test(producer >= 0 && producer < static_cast<int>(_last.size()));
+        if(_ordered)
+        {
+            test(seq == _last[producer] + 1);
+        }
+        _last[producer] = seq;
+        ++_count;
+    }
+
+    int
+    getCount()
+    {
+        Lock sync(*this);
+        return _count;
+    }
+
+private:
+
+    vector<Ice::Int> _last;
+    const bool _ordered;
+    int _count;
+};
+typedef IceUtil::Handle<TestIntfI> TestIntfIPtr;
+
+class Producer : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    Producer(const TestIntfPrx& proxy, int id, int count) : _proxy(proxy), _id(id), _count(count), _started(false)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        {
+            Lock sync(*this);
+            while(!_started)
+            {
+                wait();
+            }
+        }
+
+        vector<Ice::AsyncResultPtr> results;
+        results.reserve(_count);
+        for(int i = 0; i < _count; ++i)
+        {
+            results.push_back(_proxy->begin_op(_id, i));
+
+            //
+            // Pause from time to time so that the consumers also wait
+            // for new work items.
+            //
+            if(i % 1000 == 999)
+            {
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1));
+            }
+        }
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            _proxy->end_op(*p);
+        }
+    }
+
+    void
+    go()
+    {
+        Lock sync(*this);
+        _started = true;
+        notifyAll();
+    }
+
+private:
+
+    const TestIntfPrx _proxy;
+    const int _id;
+    const int _count;
+    bool _started;
+};
+typedef IceUtil::Handle<Producer> ProducerPtr;
+
+void
+runProducers(const TestIntfPrx& proxy, int nProducers, int count)
+{
+    vector<ProducerPtr> producers;
+    vector<IceUtil::ThreadControl> threads;
+    for(int i = 0; i < nProducers; ++i)
+    {
+        producers.push_back(new Producer(proxy, i, count));
+        threads.push_back(producers.back()->start());
+    }
+
+    //
+    // Start the producers together to increase the contention on the
+    // work queue.
+    //
+    for(vector<ProducerPtr>::const_iterator p = producers.begin(); p != producers.end(); ++p)
+    {
+        (*p)->go();
+    }
+    for(vector<IceUtil::ThreadControl>::iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        p->join();
+    }
+}
+
+}
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    const int nProducers = 8;
+    const int count = 5000;
+
+    Ice::PropertiesPtr properties = communicator->getProperties();
+
+    cout << "testing work queue ordering with several producers... " << flush;
+    {
+        properties->setProperty("OrderedAdapter.ThreadPool.Size", "1");
+        Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("OrderedAdapter");
+        TestIntfIPtr servant = new TestIntfI(nProducers, true);
+        TestIntfPrx proxy = TestIntfPrx::uncheckedCast(
+            adapter->add(servant, communicator->stringToIdentity("test")));
+        adapter->activate();
+
+        runProducers(proxy, nProducers, count);
+        test(servant->getCount() == nProducers * count);
+        adapter->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing work queue with several producers and consumers... " << flush;
+    {
+        properties->setProperty("Adapter.ThreadPool.Size", "4");
+        Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("Adapter");
+        TestIntfIPtr servant = new TestIntfI(nProducers, false);
+        TestIntfPrx proxy = TestIntfPrx::uncheckedCast(
+            adapter->add(servant, communicator->stringToIdentity("test")));
+        adapter->activate();
+
+        runProducers(proxy, nProducers, count);
+        test(servant->getCount() == nProducers * count);
+        adapter->destroy();
+    }
+    cout << "ok" << endl;
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL();
+#endif
+
+    try
+    {
+        Ice::CommunicatorHolder ich = Ice::initialize(argc, argv);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
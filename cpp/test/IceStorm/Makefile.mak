@@ -17,7 +17,15 @@ SUBDIRS		= single \
 		  stress \
 		  rep1 \
 		  repstress \
-		  repgrid
+		  repgrid \
+		  replay \
+		  commit \
+		  filter \
+		  overflow \
+		  delivery \
+		  coalesce \
+		  link \
+		  bench
 
 $(EVERYTHING)::
 	@for %i in ( $(SUBDIRS) ) do \
@@ -0,0 +1,211 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Options.h>
+#include <IceUtil/Thread.h>
+#include <IceUtil/Time.h>
+#include <IceStorm/IceStorm.h>
+#include <Event.h>
+#include <fstream>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+int
+run(int argc, char* argv[], const CommunicatorPtr& communicator)
+{
+    IceUtilInternal::Options opts;
+    opts.addOpt("", "events", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "payload", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "rate", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "topic", IceUtilInternal::Options::NeedArg, "bench");
+    opts.addOpt("", "output", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "twoway");
+
+    try
+    {
+        opts.parse(argc, (const char**)argv);
+    }
+    catch(const IceUtilInternal::BadOptException& e)
+    {
+        cerr << argv[0] << ": " << e.reason << endl;
+        return EXIT_FAILURE;
+    }
+
+    int events = 1000;
+    string s = opts.optArg("events");
+    if(!s.empty())
+    {
+        events = atoi(s.c_str());
+    }
+    if(events <= 0)
+    {
+        cerr << argv[0] << ": events must be > 0." << endl;
+        return EXIT_FAILURE;
+    }
+
+    int payloadSize = 0;
+    s = opts.optArg("payload");
+    if(!s.empty())
+    {
+        payloadSize = atoi(s.c_str());
+    }
+    if(payloadSize < 0)
+    {
+        cerr << argv[0] << ": payload must be >= 0." << endl;
+        return EXIT_FAILURE;
+    }
+
+    //
+    // The publishing rate in events per second, 0 publishes the events
+    // as fast as possible.
+    //
+    int rate = 0;
+    s = opts.optArg("rate");
+    if(!s.empty())
+    {
+        rate = atoi(s.c_str());
+    }
+    if(rate < 0)
+    {
+        cerr << argv[0] << ": rate must be >= 0." << endl;
+        return EXIT_FAILURE;
+    }
+
+    bool twoway = opts.isSet("twoway");
+
+    PropertiesPtr properties = communicator->getProperties();
+    const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
+    string managerProxy = properties->getProperty(managerProxyProperty);
+    if(managerProxy.empty())
+    {
+        cerr << argv[0] << ": property `" << managerProxyProperty << "' is not set" << endl;
+        return EXIT_FAILURE;
+    }
+
+    IceStorm::TopicManagerPrx manager = IceStorm::TopicManagerPrx::checkedCast(
+        communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        cerr << argv[0] << ": `" << managerProxy << "' is not running" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicPrx topic;
+    try
+    {
+        topic = manager->retrieve(opts.optArg("topic"));
+    }
+    catch(const NoSuchTopic& e)
+    {
+        cerr << argv[0] << ": NoSuchTopic: " << e.name << endl;
+        return EXIT_FAILURE;
+    }
+
+    EventPrx twowayProxy = EventPrx::uncheckedCast(topic->getPublisher()->ice_twoway());
+    EventPrx proxy;
+    if(twoway)
+    {
+        proxy = twowayProxy;
+    }
+    else
+    {
+        proxy = EventPrx::uncheckedCast(twowayProxy->ice_oneway());
+    }
+
+    //
+    // Establish the connection before starting the clock.
+    //
+    twowayProxy->ice_ping();
+
+    Ice::ByteSeq payload(payloadSize);
+    for(int i = 0; i < payloadSize; ++i)
+    {
+        payload[i] = static_cast<Ice::Byte>(i);
+    }
+
+    IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(int i = 0; i < events; ++i)
+    {
+        if(rate > 0)
+        {
+            IceUtil::Time next = start + IceUtil::Time::microSeconds(static_cast<Ice::Long>(i) * 1000000 / rate);
+            IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            if(next > now)
+            {
+                IceUtil::ThreadControl::sleep(next - now);
+            }
+        }
+        proxy->pub(IceUtil::Time::now(IceUtil::Time::Monotonic).toMicroSeconds(), payload);
+    }
+
+    if(!twoway)
+    {
+        //
+        // Before we exit, we ping the publisher as twoway, to make sure
+        // that all oneways are delivered to IceStorm.
+        //
+        twowayProxy->ice_ping();
+    }
+    IceUtil::Time elapsed = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+
+    s = opts.optArg("output");
+    if(!s.empty())
+    {
+        ofstream out(s.c_str());
+        if(!out)
+        {
+            cerr << argv[0] << ": can't open `" << s << "'" << endl;
+            return EXIT_FAILURE;
+        }
+        out << "{ \"events\": " << events
+            << ", \"payload\": " << payloadSize
+            << ", \"elapsed\": " << elapsed.toSecondsDouble()
+            << ", \"rate\": " << events / elapsed.toSecondsDouble()
+            << " }" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    CommunicatorPtr communicator;
+
+    try
+    {
+        communicator = initialize(argc, argv);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        try
+        {
+            communicator->destroy();
+        }
+        catch(const Exception& ex)
+        {
+            cerr << ex << endl;
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,400 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <IceUtil/Options.h>
+#include <IceUtil/Time.h>
+#include <IceUtil/Monitor.h>
+#include <Event.h>
+#include <algorithm>
+#include <fstream>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+//
+// Keeps track of the events received by all the subscribers of this
+// process, the main thread waits on it for the delivery to complete.
+//
+class Progress : public IceUtil::Monitor<IceUtil::Mutex>, public IceUtil::Shared
+{
+public:
+
+    Progress(int subscribers) :
+        _remaining(subscribers), _received(0)
+    {
+    }
+
+    void received()
+    {
+        Lock sync(*this);
+        ++_received;
+    }
+
+    void completed()
+    {
+        Lock sync(*this);
+        if(--_remaining == 0)
+        {
+            notifyAll();
+        }
+    }
+
+    //
+    // Wait for all the subscribers to receive their events. Returns
+    // false if no event is received during the given timeout.
+    //
+    bool waitForCompletion(const IceUtil::Time& timeout)
+    {
+        Lock sync(*this);
+        while(_remaining > 0)
+        {
+            Ice::Long received = _received;
+            if(!timedWait(timeout) && received == _received)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+
+    int _remaining;
+    Ice::Long _received;
+};
+typedef IceUtil::Handle<Progress> ProgressPtr;
+
+class EventI : public Event, public IceUtil::Mutex
+{
+public:
+
+    EventI(const ProgressPtr& progress, int total) :
+        _progress(progress), _total(total)
+    {
+        _latencies.reserve(total);
+    }
+
+    virtual void
+    pub(Ice::Long timestamp, const Ice::ByteSeq&, const Ice::Current&)
+    {
+        IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+
+        Lock sync(*this);
+        if(static_cast<int>(_latencies.size()) == _total)
+        {
+            return;
+        }
+        if(_latencies.empty())
+        {
+            _first = now;
+        }
+        _last = now;
+        _latencies.push_back(now.toMicroSeconds() - timestamp);
+        _progress->received();
+        if(static_cast<int>(_latencies.size()) == _total)
+        {
+            _progress->completed();
+        }
+    }
+
+    const vector<Ice::Long>& latencies() const
+    {
+        return _latencies;
+    }
+
+    IceUtil::Time first() const
+    {
+        return _first;
+    }
+
+    IceUtil::Time last() const
+    {
+        return _last;
+    }
+
+private:
+
+    const ProgressPtr _progress;
+    const int _total;
+    vector<Ice::Long> _latencies;
+    IceUtil::Time _first;
+    IceUtil::Time _last;
+};
+typedef IceUtil::Handle<EventI> EventIPtr;
+
+namespace
+{
+
+Ice::Long
+percentile(vector<Ice::Long>& latencies, double p)
+{
+    if(latencies.empty())
+    {
+        return 0;
+    }
+    vector<Ice::Long>::iterator nth = latencies.begin() + static_cast<size_t>(p * (latencies.size() - 1));
+    nth_element(latencies.begin(), nth, latencies.end());
+    return *nth;
+}
+
+}
+
+int
+run(int argc, char* argv[], const CommunicatorPtr& communicator)
+{
+    IceUtilInternal::Options opts;
+    opts.addOpt("", "events", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "subscribers", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "qos", IceUtilInternal::Options::NeedArg, "", IceUtilInternal::Options::Repeat);
+    opts.addOpt("", "topic", IceUtilInternal::Options::NeedArg, "bench");
+    opts.addOpt("", "timeout", IceUtilInternal::Options::NeedArg, "30");
+    opts.addOpt("", "output", IceUtilInternal::Options::NeedArg);
+
+    try
+    {
+        opts.parse(argc, (const char**)argv);
+    }
+    catch(const IceUtilInternal::BadOptException& e)
+    {
+        cerr << argv[0] << ": " << e.reason << endl;
+        return EXIT_FAILURE;
+    }
+
+    int events = 1000;
+    string s = opts.optArg("events");
+    if(!s.empty())
+    {
+        events = atoi(s.c_str());
+    }
+    if(events <= 0)
+    {
+        cerr << argv[0] << ": events must be > 0." << endl;
+        return EXIT_FAILURE;
+    }
+
+    int subscribers = 1;
+    s = opts.optArg("subscribers");
+    if(!s.empty())
+    {
+        subscribers = atoi(s.c_str());
+    }
+    if(subscribers <= 0)
+    {
+        cerr << argv[0] << ": subscribers must be > 0." << endl;
+        return EXIT_FAILURE;
+    }
+
+    int timeout = atoi(opts.optArg("timeout").c_str());
+    if(timeout <= 0)
+    {
+        cerr << argv[0] << ": timeout must be > 0." << endl;
+        return EXIT_FAILURE;
+    }
+
+    IceStorm::QoS cmdLineQos;
+
+    vector<string> sqos = opts.argVec("qos");
+    for(vector<string>::const_iterator q = sqos.begin(); q != sqos.end(); ++q)
+    {
+        string::size_type off = q->find(",");
+        if(off == string::npos)
+        {
+            cerr << argv[0] << ": parse error: no , in QoS" << endl;
+            return EXIT_FAILURE;
+        }
+        cmdLineQos[q->substr(0, off)] = q->substr(off+1);
+    }
+
+    PropertiesPtr properties = communicator->getProperties();
+    const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
+    string managerProxy = properties->getProperty(managerProxyProperty);
+    if(managerProxy.empty())
+    {
+        cerr << argv[0] << ": property `" << managerProxyProperty << "' is not set" << endl;
+        return EXIT_FAILURE;
+    }
+
+    IceStorm::TopicManagerPrx manager = IceStorm::TopicManagerPrx::checkedCast(
+        communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        cerr << argv[0] << ": `" << managerProxy << "' is not running" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicPrx topic;
+    try
+    {
+        topic = manager->retrieve(opts.optArg("topic"));
+    }
+    catch(const IceStorm::NoSuchTopic& e)
+    {
+        cerr << argv[0] << ": NoSuchTopic: " << e.name << endl;
+        return EXIT_FAILURE;
+    }
+
+    //
+    // The oneway, batch and twoway reliability are set with the mode
+    // of the subscriber proxy, only ordered is passed as a QoS.
+    //
+    IceStorm::QoS qos = cmdLineQos;
+    string reliability;
+    IceStorm::QoS::iterator q = qos.find("reliability");
+    if(q != qos.end())
+    {
+        reliability = q->second;
+        if(reliability != "ordered")
+        {
+            qos.erase(q);
+        }
+    }
+
+    ProgressPtr progress = new Progress(subscribers);
+    ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SubscriberAdapter", "default");
+    vector<EventIPtr> servants;
+    vector<ObjectPrx> objs;
+    for(int i = 0; i < subscribers; ++i)
+    {
+        EventIPtr servant = new EventI(progress, events);
+        ObjectPrx obj = adapter->addWithUUID(servant);
+        if(reliability == "twoway" || reliability == "ordered")
+        {
+            // Do nothing.
+        }
+        else if(reliability == "batch")
+        {
+            obj = obj->ice_batchOneway();
+        }
+        else //if(reliability == "oneway")
+        {
+            obj = obj->ice_oneway();
+        }
+        topic->subscribeAndGetPublisher(qos, obj);
+        servants.push_back(servant);
+        objs.push_back(obj);
+    }
+
+    adapter->activate();
+
+    //
+    // Oneway events can be lost if IceStorm drops a subscriber, the
+    // results are reported for the received events if the delivery
+    // stalls.
+    //
+    bool completed = progress->waitForCompletion(IceUtil::Time::seconds(timeout));
+
+    for(vector<ObjectPrx>::const_iterator p = objs.begin(); p != objs.end(); ++p)
+    {
+        topic->unsubscribe(*p);
+    }
+    adapter->deactivate();
+    adapter->waitForDeactivate();
+
+    vector<Ice::Long> latencies;
+    latencies.reserve(static_cast<size_t>(events) * subscribers);
+    IceUtil::Time first;
+    IceUtil::Time last;
+    double sum = 0;
+    for(vector<EventIPtr>::const_iterator p = servants.begin(); p != servants.end(); ++p)
+    {
+        const vector<Ice::Long>& l = (*p)->latencies();
+        if(l.empty())
+        {
+            continue;
+        }
+        if(first == IceUtil::Time() || (*p)->first() < first)
+        {
+            first = (*p)->first();
+        }
+        if((*p)->last() > last)
+        {
+            last = (*p)->last();
+        }
+        for(vector<Ice::Long>::const_iterator r = l.begin(); r != l.end(); ++r)
+        {
+            sum += static_cast<double>(*r);
+        }
+        latencies.insert(latencies.end(), l.begin(), l.end());
+    }
+
+    double elapsed = (last - first).toSecondsDouble();
+    double throughput = elapsed > 0 ? latencies.size() / elapsed : 0;
+    double mean = latencies.empty() ? 0 : sum / latencies.size();
+    Ice::Long p50 = percentile(latencies, 0.5);
+    Ice::Long p99 = percentile(latencies, 0.99);
+    Ice::Long p999 = percentile(latencies, 0.999);
+    Ice::Long maxLatency = latencies.empty() ? 0 : *max_element(latencies.begin(), latencies.end());
+
+    if(!completed)
+    {
+        cerr << argv[0] << ": received " << latencies.size() << " events out of "
+             << static_cast<Ice::Long>(events) * subscribers << endl;
+    }
+
+    s = opts.optArg("output");
+    if(!s.empty())
+    {
+        ofstream out(s.c_str());
+        if(!out)
+        {
+            cerr << argv[0] << ": can't open `" << s << "'" << endl;
+            return EXIT_FAILURE;
+        }
+        out << "{ \"subscribers\": " << subscribers
+            << ", \"expected\": " << static_cast<Ice::Long>(events) * subscribers
+            << ", \"received\": " << latencies.size()
+            << ", \"elapsed\": " << elapsed
+            << ", \"throughput\": " << throughput
+            << ", \"latency\": { \"mean\": " << mean
+            << ", \"p50\": " << p50
+            << ", \"p99\": " << p99
+            << ", \"p999\": " << p999
+            << ", \"max\": " << maxLatency
+            << " } }" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    CommunicatorPtr communicator;
+
+    try
+    {
+        communicator = initialize(argc, argv);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        try
+        {
+            communicator->destroy();
+        }
+        catch(const Exception& ex)
+        {
+            cerr << ex << endl;
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
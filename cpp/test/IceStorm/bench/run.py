@@ -0,0 +1,212 @@
+#!/usr/bin/env python
+# **********************************************************************
+#
+# Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+import os, sys, json, tempfile
+
+path = [ ".", "..", "../..", "../../..", "../../../.." ]
+head = os.path.dirname(sys.argv[0])
+if len(head) > 0:
+    path = [os.path.join(head, p) for p in path]
+path = [os.path.abspath(p) for p in path if os.path.exists(os.path.join(p, "scripts", "TestUtil.py")) ]
+if len(path) == 0:
+    raise RuntimeError("can't find toplevel directory!")
+sys.path.append(os.path.join(path[0], "scripts"))
+
+#
+# The benchmark options are removed from the command line before
+# TestUtil processes the remaining options.
+#
+config = {
+    "subscribers": "1,10,100",
+    "payloads": "16,1024,16384",
+    "qos": "oneway,batch,twoway,ordered",
+    "depths": "0,1,2",
+    "events": "5000",
+    "rate": "0",
+    "type": "persistent",
+    "output": "results.json",
+}
+
+def usage():
+    print("usage: " + sys.argv[0] + """
+          --subscribers=<n,...>  Number of subscribers (default 1,10,100).
+          --payloads=<n,...>     Event payload sizes in bytes (default 16,1024,16384).
+          --qos=<qos,...>        Subscriber reliability (default oneway,batch,twoway,ordered).
+          --depths=<n,...>       Number of federation links between the publisher and
+                                 the subscribers, up to 2 (default 0,1,2).
+          --events=<n>           Number of events published for each run (default 5000).
+          --rate=<n>             Publishing rate in events/s, 0 for no limit (default 0).
+          --type=<type>          IceStorm type, persistent or transient (default persistent).
+          --output=<file>        Results file (default results.json).
+
+          The other options are passed to the test driver.
+        """)
+    sys.exit(2)
+
+args = []
+for arg in sys.argv[1:]:
+    if arg.startswith("--") and arg[2:].split("=")[0] in config:
+        if arg.find("=") == -1:
+            usage()
+        (key, value) = arg[2:].split("=", 1)
+        config[key] = value
+    elif arg == "--help":
+        usage()
+    else:
+        args.append(arg)
+sys.argv[1:] = args
+
+import TestUtil, IceStormUtil
+
+try:
+    subscriberCounts = [int(s) for s in config["subscribers"].split(",")]
+    payloads = [int(s) for s in config["payloads"].split(",")]
+    depths = [int(s) for s in config["depths"].split(",")]
+    events = int(config["events"])
+    rate = int(config["rate"])
+except ValueError:
+    usage()
+qosList = config["qos"].split(",")
+for q in qosList:
+    if q not in ["oneway", "batch", "twoway", "ordered"]:
+        usage()
+for d in depths:
+    if d < 0 or d > 2:
+        usage()
+if config["type"] not in ["persistent", "transient"]:
+    usage()
+
+iceStormAdmin = TestUtil.getIceStormAdmin()
+
+publisher = os.path.join(os.getcwd(), "publisher")
+subscriber = os.path.join(os.getcwd(), "subscriber")
+
+def runAdmin(servers, cmd):
+    ref = ""
+    for i in range(0, len(servers)):
+        ref += ' --IceStormAdmin.TopicManager.Proxy%d="%s"' % (i, servers[i].proxy())
+    proc = TestUtil.startClient(iceStormAdmin, ref + r' -e "%s"' % cmd, echo = False)
+    proc.waitTestSuccess()
+
+#
+# Returns the resident and peak resident set sizes of the given IceBox
+# server in KB, the memory usage is only available on Linux.
+#
+def memory(server):
+    rss = None
+    peak = None
+    try:
+        f = open("/proc/%d/status" % server.proc.p.pid, "r")
+        try:
+            for line in f:
+                if line.startswith("VmRSS:"):
+                    rss = int(line.split()[1])
+                elif line.startswith("VmHWM:"):
+                    peak = int(line.split()[1])
+        finally:
+            f.close()
+    except (IOError, OSError, AttributeError):
+        pass
+    return (rss, peak)
+
+def readResults(file):
+    f = open(file, "r")
+    try:
+        return json.load(f)
+    finally:
+        f.close()
+
+def runScenario(depth, subscribers, payload, qos):
+    #
+    # Each scenario runs with new IceStorm servers to not measure the
+    # memory retained by the previous scenarios. The publisher uses the
+    # first server and the subscribers the last one, the topics are
+    # linked to form a chain of the given depth.
+    #
+    servers = []
+    for i in range(0, depth + 1):
+        servers.append(IceStormUtil.init(TestUtil.toplevel, os.getcwd(), config["type"], dbDir = "db%d" % i,
+                                         instanceName = "BenchIceStorm%d" % i, port = 12000 + i * 500))
+    for s in servers:
+        s.start(echo = False)
+
+    topics = " ".join(["BenchIceStorm%d/bench" % i for i in range(0, depth + 1)])
+    runAdmin(servers, "create " + topics)
+    for i in range(0, depth):
+        runAdmin(servers, "link BenchIceStorm%d/bench BenchIceStorm%d/bench" % (i, i + 1))
+
+    (fd, subscriberOutput) = tempfile.mkstemp(suffix = ".json")
+    os.close(fd)
+    (fd, publisherOutput) = tempfile.mkstemp(suffix = ".json")
+    os.close(fd)
+
+    try:
+        (idle, idlePeak) = memory(servers[-1])
+
+        subscriberProc = TestUtil.startServer(subscriber,
+                                              ' --Ice.ServerIdleTime=0 --events %d --subscribers %d' % (events, subscribers) +
+                                              ' --qos "reliability,%s" --output "%s"' % (qos, subscriberOutput) +
+                                              servers[-1].reference(), adapter = "SubscriberAdapter")
+
+        (subscribed, subscribedPeak) = memory(servers[-1])
+
+        publisherOpts = ' --events %d --payload %d --rate %d --output "%s"' % (events, payload, rate, publisherOutput)
+        publisherProc = TestUtil.startClient(publisher, servers[0].reference() + publisherOpts)
+        publisherProc.waitTestSuccess(timeout = 600)
+        subscriberProc.waitTestSuccess(timeout = 600)
+
+        (delivered, peak) = memory(servers[-1])
+
+        result = {
+            "depth": depth,
+            "subscribers": subscribers,
+            "payload": payload,
+            "qos": qos,
+            "publisher": readResults(publisherOutput),
+            "subscriber": readResults(subscriberOutput),
+            "memory": {
+                "idle": idle,
+                "subscribed": subscribed,
+                "delivered": delivered,
+                "peak": peak,
+                "perSubscriber": None
+            }
+        }
+        if idle is not None and subscribed is not None:
+            result["memory"]["perSubscriber"] = float(subscribed - idle) / subscribers
+    finally:
+        os.remove(subscriberOutput)
+        os.remove(publisherOutput)
+
+    for s in servers:
+        s.stop()
+
+    return result
+
+results = []
+for depth in depths:
+    for subscribers in subscriberCounts:
+        for payload in payloads:
+            for qos in qosList:
+                sys.stdout.write("depth %d, %d %s subscribers, %d bytes payload... " % (depth, subscribers, qos, payload))
+                sys.stdout.flush()
+                result = runScenario(depth, subscribers, payload, qos)
+                results.append(result)
+                latency = result["subscriber"]["latency"]
+                print("%.0f events/s, latency p50 %dus p99 %dus p999 %dus" % (
+                    result["subscriber"]["throughput"], latency["p50"], latency["p99"], latency["p999"]))
+
+f = open(config["output"], "w")
+try:
+    json.dump({ "type": config["type"], "events": events, "rate": rate, "results": results }, f, indent = 2)
+    f.write("\n")
+finally:
+    f.close()
+print("results written to " + config["output"])
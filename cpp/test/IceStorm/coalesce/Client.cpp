@@ -0,0 +1,289 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <Single.h>
+#include <TestCommon.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+//
+// A subscriber which can be slowed down: once blocked, the dispatch of
+// the event 0 blocks until the subscriber is released and the next
+// events are queued by IceStorm.
+//
+class SingleI : public Single, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    SingleI(bool blocked) : _blocked(blocked)
+    {
+    }
+
+    virtual void
+    event(int i, const Current&)
+    {
+        Lock sync(*this);
+        _events.push_back(i);
+        notifyAll();
+        while(i == 0 && _blocked)
+        {
+            wait();
+        }
+    }
+
+    virtual void
+    other(int, const Current&)
+    {
+        test(false);
+    }
+
+    void
+    release()
+    {
+        Lock sync(*this);
+        _blocked = false;
+        notifyAll();
+    }
+
+    void
+    waitForEvents(size_t count)
+    {
+        Lock sync(*this);
+        while(_events.size() < count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(20)))
+            {
+                test(false);
+            }
+        }
+    }
+
+    vector<int>
+    events()
+    {
+        Lock sync(*this);
+        return _events;
+    }
+
+private:
+
+    vector<int> _events;
+    bool _blocked;
+};
+typedef IceUtil::Handle<SingleI> SingleIPtr;
+
+namespace
+{
+
+const int nEvents = 20;
+const int nKeys = 3;
+
+//
+// Publish the events first to last, the event i is coalesced with the
+// other events of the key i % nKeys.
+//
+void
+publish(const SinglePrx& publisher, int first, int last)
+{
+    for(int i = first; i <= last; ++i)
+    {
+        ostringstream os;
+        os << "key" << i % nKeys;
+        Context ctx;
+        ctx["key"] = os.str();
+        publisher->event(i, ctx);
+    }
+}
+
+vector<int>
+events(int a, int b, int c = -1, int d = -1)
+{
+    vector<int> v;
+    v.push_back(a);
+    v.push_back(b);
+    if(c >= 0)
+    {
+        v.push_back(c);
+    }
+    if(d >= 0)
+    {
+        v.push_back(d);
+    }
+    return v;
+}
+
+//
+// Wait for the given events and make sure no other event is received.
+//
+void
+checkEvents(const SingleIPtr& servant, const vector<int>& expected)
+{
+    servant->waitForEvents(expected.size());
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(500));
+    test(servant->events() == expected);
+}
+
+}
+
+int
+run(int, char* argv[], const CommunicatorPtr& communicator)
+{
+    PropertiesPtr properties = communicator->getProperties();
+    const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
+    string managerProxy = properties->getProperty(managerProxyProperty);
+    if(managerProxy.empty())
+    {
+        cerr << argv[0] << ": property `" << managerProxyProperty << "' is not set" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicManagerPrx manager = TopicManagerPrx::checkedCast(communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        cerr << argv[0] << ": `" << managerProxy << "' is not running" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicPrx topic;
+    try
+    {
+        topic = manager->retrieve("single");
+    }
+    catch(const NoSuchTopic& e)
+    {
+        cerr << argv[0] << ": NoSuchTopic: " << e.name << endl;
+        return EXIT_FAILURE;
+    }
+
+    ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SingleAdapter", "default");
+    adapter->activate();
+
+    SinglePrx publisher = SinglePrx::uncheckedCast(topic->getPublisher()->ice_twoway());
+
+    {
+        cout << "testing invalid lastValues... " << flush;
+        const char* values[] = { "x", "2", "-1" };
+        for(size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+        {
+            QoS qos;
+            qos["lastValues"] = values[i];
+            ObjectPrx subscriber = adapter->addWithUUID(new SingleI(false));
+            try
+            {
+                topic->subscribeAndGetPublisher(qos, subscriber);
+                test(false);
+            }
+            catch(const BadQoS&)
+            {
+            }
+            adapter->remove(subscriber->ice_getIdentity());
+        }
+        test(topic->getSubscribers().empty());
+        cout << "ok" << endl;
+    }
+
+    {
+        //
+        // With ordered reliability, IceStorm only sends an event once
+        // the previous event was dispatched. The events published
+        // while the event 0 is being dispatched are queued and the
+        // queue only keeps the last event of each key, at the place of
+        // the first queued event of the key: 1 (key1), 2 (key2) and
+        // 3 (key0) are replaced with 19, 17 and 18.
+        //
+        cout << "testing coalescing of the queued events... " << flush;
+        SingleIPtr servant = new SingleI(true);
+        ObjectPrx subscriber = adapter->addWithUUID(servant);
+        QoS qos;
+        qos["reliability"] = "ordered";
+        topic->subscribeAndGetPublisher(qos, subscriber);
+
+        publish(publisher, 0, 0);
+        servant->waitForEvents(1);
+        publish(publisher, 1, nEvents - 1);
+
+        servant->release();
+        checkEvents(servant, events(0, 19, 17, 18));
+
+        topic->unsubscribe(subscriber);
+        adapter->remove(subscriber->ice_getIdentity());
+        cout << "ok" << endl;
+    }
+
+    {
+        //
+        // The service caches the last events of 2 keys, the event 17
+        // of key2 was evicted when the event 19 of key1 was cached. A
+        // subscriber with the lastValues QoS first receives the cached
+        // events, the other subscribers only receive the new events.
+        //
+        cout << "testing last values... " << flush;
+        SingleIPtr servant = new SingleI(false);
+        ObjectPrx subscriber = adapter->addWithUUID(servant);
+        QoS qos;
+        qos["reliability"] = "ordered";
+        qos["lastValues"] = "1";
+        topic->subscribeAndGetPublisher(qos, subscriber);
+        servant->waitForEvents(2);
+        test(servant->events() == events(18, 19));
+
+        SingleIPtr other = new SingleI(false);
+        ObjectPrx otherSubscriber = adapter->addWithUUID(other);
+        qos["lastValues"] = "0";
+        topic->subscribeAndGetPublisher(qos, otherSubscriber);
+
+        publish(publisher, nEvents, nEvents);
+        checkEvents(servant, events(18, 19, nEvents));
+        checkEvents(other, vector<int>(1, nEvents));
+
+        topic->unsubscribe(subscriber);
+        topic->unsubscribe(otherSubscriber);
+        cout << "ok" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    CommunicatorPtr communicator;
+
+    try
+    {
+        communicator = initialize(argc, argv);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        try
+        {
+            communicator->destroy();
+        }
+        catch(const Exception& ex)
+        {
+            cerr << ex << endl;
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,51 @@
+# **********************************************************************
+#
+# Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+top_srcdir	= ..\..\..
+
+CLIENT		= client.exe
+
+TARGETS		= $(CLIENT)
+
+SLICE_OBJS	= .\Single.obj
+
+OBJS		= $(SLICE_OBJS) \
+		  .\Client.obj
+
+
+!include $(top_srcdir)/config/Make.rules.mak
+
+CPPFLAGS	= -I. -I../../include $(CPPFLAGS) -DWIN32_LEAN_AND_MEAN
+LIBS		=  $(LIBS)
+
+!if "$(GENERATE_PDB)" == "yes"
+PDBFLAGS        = /pdb:$(CLIENT:.exe=.pdb)
+!endif
+
+$(CLIENT): $(OBJS)
+	$(LINK) $(LD_EXEFLAGS) $(PDBFLAGS) $(SETARGV) $(OBJS) $(PREOUT)$@ $(PRELIBS)$(LIBS)
+	@if exist $@.manifest echo ^ ^ ^ Embedding manifest using $(MT) && \
+	    $(MT) -nologo -manifest $@.manifest -outputresource:$@;#1 && del /q $@.manifest
+
+!if "$(OPTIMIZE)" == "yes"
+
+all::
+	@echo release > build.txt
+
+!else
+
+all::
+	@echo debug > build.txt
+
+!endif
+
+clean::
+	del /q build.txt
+	del /q Single.cpp Single.h
+	-for %f in (db\*) do if not %f == db\.gitignore del /q %f
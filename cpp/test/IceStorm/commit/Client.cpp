@@ -0,0 +1,373 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <Single.h>
+#include <TestCommon.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+class SingleI : public Single, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    virtual void
+    event(int i, const Current&)
+    {
+        Lock sync(*this);
+        _events.push_back(i);
+        notifyAll();
+    }
+
+    void
+    waitForEvents(size_t count)
+    {
+        Lock sync(*this);
+        while(_events.size() < count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(20)))
+            {
+                test(false);
+            }
+        }
+    }
+
+    vector<int>
+    events()
+    {
+        Lock sync(*this);
+        return _events;
+    }
+
+private:
+
+    vector<int> _events;
+};
+typedef IceUtil::Handle<SingleI> SingleIPtr;
+
+bool
+isSubscribed(const TopicPrx& topic, const ObjectPrx& subscriber)
+{
+    IdentitySeq ids = topic->getSubscribers();
+    return find(ids.begin(), ids.end(), subscriber->ice_getIdentity()) != ids.end();
+}
+
+//
+// Reads the Topic traces of IceStorm with the logger admin facet of the
+// service. IceStorm traces the subscribe and unsubscribe requests when
+// it dispatches them and each commit with its log update token.
+//
+class TopicTraces
+{
+public:
+
+    TopicTraces(const LoggerAdminPrx& logger, const string& topic) :
+        _logger(logger), _topic(topic), _next(0)
+    {
+    }
+
+    //
+    // Wait for IceStorm to dispatch the request of the given
+    // subscriber.
+    //
+    void
+    waitForRequest(const string& operation, const ObjectPrx& subscriber)
+    {
+        const string message = _topic + ": " + operation + ": " +
+            subscriber->ice_getCommunicator()->identityToString(subscriber->ice_getIdentity());
+        for(int i = 0; i < 1000; ++i)
+        {
+            LogMessageSeq traces = getTraces();
+            for(; _next < traces.size(); ++_next)
+            {
+                if(traces[_next].message == message)
+                {
+                    ++_next;
+                    return;
+                }
+            }
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        }
+        test(false);
+    }
+
+    //
+    // Get the commit traces, the commits of a request are traced
+    // before the request returns.
+    //
+    vector<string>
+    getCommits()
+    {
+        const string prefix = _topic + ": commit: ";
+        vector<string> commits;
+        LogMessageSeq traces = getTraces();
+        for(LogMessageSeq::const_iterator p = traces.begin(); p != traces.end(); ++p)
+        {
+            if(p->message.compare(0, prefix.size(), prefix) == 0)
+            {
+                commits.push_back(p->message.substr(prefix.size()));
+            }
+        }
+        return commits;
+    }
+
+private:
+
+    LogMessageSeq
+    getTraces()
+    {
+        LogMessageTypeSeq messageTypes;
+        messageTypes.push_back(TraceMessage);
+        StringSeq categories;
+        categories.push_back("Topic");
+        string prefix;
+        return _logger->getLog(messageTypes, categories, -1, prefix);
+    }
+
+    const LoggerAdminPrx _logger;
+    const string _topic;
+    size_t _next;
+};
+
+//
+// Check that the requests sent since the given commits were committed
+// together, with a single log update.
+//
+void
+testCommit(TopicTraces& traces, const vector<string>& commits, size_t added, size_t removed)
+{
+    vector<string> c = traces.getCommits();
+    test(c.size() == commits.size() + 1);
+
+    ostringstream os;
+    os << "added " << added << " removed " << removed << " llu: ";
+    test(c.back().compare(0, os.str().size(), os.str()) == 0);
+
+    //
+    // The log update token is only incremented once.
+    //
+    if(!commits.empty())
+    {
+        string last = commits.back().substr(commits.back().rfind('/') + 1);
+        string next = c.back().substr(c.back().rfind('/') + 1);
+        test(atoi(next.c_str()) == atoi(last.c_str()) + 1);
+    }
+}
+
+int
+run(int, char* argv[], const CommunicatorPtr& communicator)
+{
+    PropertiesPtr properties = communicator->getProperties();
+    const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
+    string managerProxy = properties->getProperty(managerProxyProperty);
+    if(managerProxy.empty())
+    {
+        cerr << argv[0] << ": property `" << managerProxyProperty << "' is not set" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicManagerPrx manager = TopicManagerPrx::checkedCast(communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        cerr << argv[0] << ": `" << managerProxy << "' is not running" << endl;
+        return EXIT_FAILURE;
+    }
+
+    const char* loggerProxyProperty = "Test.Logger";
+    LoggerAdminPrx logger = LoggerAdminPrx::checkedCast(communicator->propertyToProxy(loggerProxyProperty));
+    if(!logger)
+    {
+        cerr << argv[0] << ": property `" << loggerProxyProperty << "' is not set" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicPrx topic;
+    try
+    {
+        topic = manager->retrieve("single");
+    }
+    catch(const NoSuchTopic& e)
+    {
+        cerr << argv[0] << ": NoSuchTopic: " << e.name << endl;
+        return EXIT_FAILURE;
+    }
+
+    ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SingleAdapter", "default");
+    adapter->activate();
+
+    //
+    // IceStorm is started with a commit window, the requests sent
+    // while a commit is pending are committed together. The requests
+    // sent to the same subscriber are only sent once IceStorm traced
+    // the previous request, so that it receives them in order.
+    //
+    TopicTraces traces(logger, "single");
+
+    vector<SingleIPtr> servants;
+    vector<ObjectPrx> subscribers;
+    {
+        cout << "testing batched subscribe... " << flush;
+        vector<string> commits = traces.getCommits();
+        vector<AsyncResultPtr> results;
+        for(int i = 0; i < 10; ++i)
+        {
+            servants.push_back(new SingleI());
+            subscribers.push_back(adapter->addWithUUID(servants.back())->ice_oneway());
+            results.push_back(topic->begin_subscribeAndGetPublisher(QoS(), subscribers.back()));
+        }
+        for(vector<AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            test(topic->end_subscribeAndGetPublisher(*p));
+        }
+        test(topic->getSubscribers().size() == 10);
+        testCommit(traces, commits, 10, 0);
+        cout << "ok" << endl;
+    }
+
+    {
+        cout << "testing batched subscribe of the same subscriber... " << flush;
+        vector<string> commits = traces.getCommits();
+        AsyncResultPtr r1 = topic->begin_subscribeAndGetPublisher(QoS(), subscribers[1]);
+        AsyncResultPtr r2 = topic->begin_unsubscribe(subscribers[2]);
+        traces.waitForRequest("unsubscribe", subscribers[2]);
+        AsyncResultPtr r3 = topic->begin_subscribeAndGetPublisher(QoS(), subscribers[2]);
+        traces.waitForRequest("subscribeAndGetPublisher", subscribers[2]);
+        AsyncResultPtr r4 = topic->begin_subscribeAndGetPublisher(QoS(), subscribers[2]);
+        try
+        {
+            topic->end_subscribeAndGetPublisher(r1);
+            test(false);
+        }
+        catch(const AlreadySubscribed&)
+        {
+        }
+        topic->end_unsubscribe(r2);
+        test(topic->end_subscribeAndGetPublisher(r3));
+        try
+        {
+            topic->end_subscribeAndGetPublisher(r4);
+            test(false);
+        }
+        catch(const AlreadySubscribed&)
+        {
+        }
+        test(topic->getSubscribers().size() == 10);
+        testCommit(traces, commits, 1, 1);
+        cout << "ok" << endl;
+    }
+
+    {
+        cout << "testing batched unsubscribe and subscribe... " << flush;
+
+        //
+        // The subscriber is removed and added again in the same
+        // batch, with the same identity.
+        //
+        vector<string> commits = traces.getCommits();
+        AsyncResultPtr r1 = topic->begin_unsubscribe(subscribers[0]);
+        traces.waitForRequest("unsubscribe", subscribers[0]);
+        AsyncResultPtr r2 = topic->begin_subscribeAndGetPublisher(QoS(), subscribers[0]);
+        topic->end_unsubscribe(r1);
+        test(topic->end_subscribeAndGetPublisher(r2));
+        test(isSubscribed(topic, subscribers[0]));
+        testCommit(traces, commits, 1, 1);
+
+        //
+        // The subscriber is added and removed in the same batch, the
+        // updates cancel each other and nothing is committed.
+        //
+        commits = traces.getCommits();
+        SingleIPtr servant = new SingleI();
+        ObjectPrx subscriber = adapter->addWithUUID(servant)->ice_oneway();
+        r1 = topic->begin_subscribeAndGetPublisher(QoS(), subscriber);
+        traces.waitForRequest("subscribeAndGetPublisher", subscriber);
+        r2 = topic->begin_unsubscribe(subscriber);
+        topic->end_subscribeAndGetPublisher(r1);
+        topic->end_unsubscribe(r2);
+        test(!isSubscribed(topic, subscriber));
+        test(topic->getSubscribers().size() == 10);
+        test(traces.getCommits() == commits);
+
+        //
+        // Each subscriber receives each event once. The events are
+        // sent in order over the same connection, a subscriber which
+        // received the first event twice receives it before the second
+        // event.
+        //
+        SinglePrx publisher = SinglePrx::uncheckedCast(topic->getPublisher()->ice_twoway());
+        publisher->event(0);
+        publisher->event(1);
+        vector<int> expected;
+        expected.push_back(0);
+        expected.push_back(1);
+        for(vector<SingleIPtr>::const_iterator p = servants.begin(); p != servants.end(); ++p)
+        {
+            (*p)->waitForEvents(expected.size());
+            test((*p)->events() == expected);
+        }
+        test(servant->events().empty());
+        cout << "ok" << endl;
+    }
+
+    {
+        cout << "testing batched unsubscribe... " << flush;
+        vector<string> commits = traces.getCommits();
+        vector<AsyncResultPtr> results;
+        for(vector<ObjectPrx>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+        {
+            results.push_back(topic->begin_unsubscribe(*p));
+        }
+        for(vector<AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            topic->end_unsubscribe(*p);
+        }
+        test(topic->getSubscribers().empty());
+        testCommit(traces, commits, 0, 10);
+        cout << "ok" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    CommunicatorPtr communicator;
+
+    try
+    {
+        communicator = initialize(argc, argv);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        try
+        {
+            communicator->destroy();
+        }
+        catch(const Exception& ex)
+        {
+            cerr << ex << endl;
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,304 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <IceStorm/IceStorm.h>
+#include <Single.h>
+#include <TestCommon.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+namespace
+{
+
+const int nPublishers = 4;
+const int nEvents = 500;
+
+}
+
+//
+// Check that the events of each publisher are received in order.
+//
+class SingleI : public Single, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    SingleI(int first = 0) : _last(nPublishers, first - 1), _count(0), _blocked(false)
+    {
+    }
+
+    virtual void
+    event(int publisher, int i, const Current&)
+    {
+        Lock sync(*this);
+        test(publisher >= 0 && publisher < nPublishers);
+        test(i == _last[publisher] + 1);
+        _last[publisher] = i;
+        ++_count;
+        notifyAll();
+        while(_blocked)
+        {
+            wait();
+        }
+    }
+
+    void
+    block()
+    {
+        Lock sync(*this);
+        _blocked = true;
+    }
+
+    void
+    release()
+    {
+        Lock sync(*this);
+        _blocked = false;
+        notifyAll();
+    }
+
+    void
+    waitForEvents(int count)
+    {
+        Lock sync(*this);
+        while(_count < count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(20)))
+            {
+                test(false);
+            }
+        }
+    }
+
+    int
+    count()
+    {
+        Lock sync(*this);
+        return _count;
+    }
+
+private:
+
+    vector<int> _last;
+    int _count;
+    bool _blocked;
+};
+typedef IceUtil::Handle<SingleI> SingleIPtr;
+
+//
+// Each publisher uses its own connection and sends its events with
+// twoway calls, so IceStorm queues them in order.
+//
+class Publisher : public IceUtil::Thread
+{
+public:
+
+    Publisher(const SinglePrx& publisher, int id, int first) : _publisher(publisher), _id(id), _first(first)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        for(int i = _first; i < _first + nEvents; ++i)
+        {
+            _publisher->event(_id, i);
+        }
+    }
+
+private:
+
+    const SinglePrx _publisher;
+    const int _id;
+    const int _first;
+};
+typedef IceUtil::Handle<Publisher> PublisherPtr;
+
+namespace
+{
+
+void
+publish(const TopicPrx& topic, int first)
+{
+    vector<IceUtil::ThreadControl> threads;
+    for(int i = 0; i < nPublishers; ++i)
+    {
+        ostringstream os;
+        os << "publisher" << i;
+        SinglePrx publisher =
+            SinglePrx::uncheckedCast(topic->getPublisher()->ice_twoway()->ice_connectionId(os.str()));
+        threads.push_back((new Publisher(publisher, i, first))->start());
+    }
+    for(vector<IceUtil::ThreadControl>::iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        p->join();
+    }
+}
+
+}
+
+int
+run(int, char* argv[], const CommunicatorPtr& communicator)
+{
+    PropertiesPtr properties = communicator->getProperties();
+    const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
+    string managerProxy = properties->getProperty(managerProxyProperty);
+    if(managerProxy.empty())
+    {
+        cerr << argv[0] << ": property `" << managerProxyProperty << "' is not set" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicManagerPrx manager = TopicManagerPrx::checkedCast(communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        cerr << argv[0] << ": `" << managerProxy << "' is not running" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicPrx topic;
+    try
+    {
+        topic = manager->retrieve("single");
+    }
+    catch(const NoSuchTopic& e)
+    {
+        cerr << argv[0] << ": NoSuchTopic: " << e.name << endl;
+        return EXIT_FAILURE;
+    }
+
+    ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SingleAdapter", "default");
+    adapter->activate();
+
+    //
+    // The subscribers are assigned to the delivery threads by hashing
+    // their identity, with enough subscribers each thread sends the
+    // events of several subscribers.
+    //
+    vector<SingleIPtr> servants;
+    vector<ObjectPrx> subscribers;
+    {
+        cout << "subscribing... " << flush;
+        for(int i = 0; i < 12; ++i)
+        {
+            servants.push_back(new SingleI());
+            ObjectPrx subscriber = adapter->addWithUUID(servants.back());
+            QoS qos;
+            switch(i % 3)
+            {
+            case 0:
+            {
+                subscriber = subscriber->ice_oneway();
+                break;
+            }
+            case 1:
+            {
+                break;
+            }
+            case 2:
+            {
+                qos["reliability"] = "ordered";
+                break;
+            }
+            }
+            subscribers.push_back(subscriber);
+            topic->subscribeAndGetPublisher(qos, subscriber);
+        }
+        test(topic->getSubscribers().size() == subscribers.size());
+        cout << "ok" << endl;
+    }
+
+    {
+        cout << "testing event order with several delivery threads... " << flush;
+        publish(topic, 0);
+        for(vector<SingleIPtr>::const_iterator p = servants.begin(); p != servants.end(); ++p)
+        {
+            (*p)->waitForEvents(nPublishers * nEvents);
+        }
+        cout << "ok" << endl;
+    }
+
+    {
+        //
+        // A slow subscriber doesn't delay the events of the other
+        // subscribers, including the subscribers sent by the same
+        // delivery thread. The slow subscriber uses its own adapter so
+        // that its blocked dispatch doesn't prevent the dispatch of the
+        // events of the other subscribers.
+        //
+        cout << "testing delivery with a slow subscriber... " << flush;
+        properties->setProperty("SlowAdapter.ThreadPool.Size", "1");
+        ObjectAdapterPtr slowAdapter = communicator->createObjectAdapterWithEndpoints("SlowAdapter", "default");
+        slowAdapter->activate();
+        SingleIPtr slow = new SingleI(nEvents);
+        slow->block();
+        ObjectPrx slowSubscriber = slowAdapter->addWithUUID(slow);
+        QoS qos;
+        qos["reliability"] = "ordered";
+        topic->subscribeAndGetPublisher(qos, slowSubscriber);
+
+        publish(topic, nEvents);
+        for(vector<SingleIPtr>::const_iterator p = servants.begin(); p != servants.end(); ++p)
+        {
+            (*p)->waitForEvents(2 * nPublishers * nEvents);
+        }
+        test(slow->count() < nPublishers * nEvents);
+
+        slow->release();
+        slow->waitForEvents(nPublishers * nEvents);
+
+        topic->unsubscribe(slowSubscriber);
+        slowAdapter->destroy();
+        cout << "ok" << endl;
+    }
+
+    for(vector<ObjectPrx>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+    {
+        topic->unsubscribe(*p);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    CommunicatorPtr communicator;
+
+    try
+    {
+        communicator = initialize(argc, argv);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        try
+        {
+            communicator->destroy();
+        }
+        catch(const Exception& ex)
+        {
+            cerr << ex << endl;
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
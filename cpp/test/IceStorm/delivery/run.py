@@ -0,0 +1,48 @@
+#!/usr/bin/env python
+# **********************************************************************
+#
+# Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+import os, sys
+
+path = [ ".", "..", "../..", "../../..", "../../../.." ]
+head = os.path.dirname(sys.argv[0])
+if len(head) > 0:
+    path = [os.path.join(head, p) for p in path]
+path = [os.path.abspath(p) for p in path if os.path.exists(os.path.join(p, "scripts", "TestUtil.py")) ]
+if len(path) == 0:
+    raise RuntimeError("can't find toplevel directory!")
+sys.path.append(os.path.join(path[0], "scripts"))
+import TestUtil, IceStormUtil
+
+client = os.path.join(os.getcwd(), "client")
+
+#
+# The events are sent to the subscribers by 4 delivery threads, the
+# publishers are dispatched concurrently.
+#
+icestorm = IceStormUtil.init(TestUtil.toplevel, os.getcwd(), "transient",
+                             additional = ' --IceStorm.Send.Threads=4' +
+                                          ' --IceStorm.Publish.ThreadPool.Size=4')
+icestorm.start()
+
+sys.stdout.write("creating topic... ")
+sys.stdout.flush()
+icestorm.admin("create single")
+print("ok")
+
+TestUtil.startClient(client, icestorm.reference()).waitTestSuccess()
+
+sys.stdout.write("destroy topic... ")
+sys.stdout.flush()
+icestorm.admin("destroy single")
+print("ok")
+
+icestorm.stop()
+
+sys.exit(0)
@@ -0,0 +1,353 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <Single.h>
+#include <TestCommon.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+class SingleI : public Single, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    virtual void
+    event(int i, const Current&)
+    {
+        received(i);
+    }
+
+    virtual void
+    other(int i, const Current&)
+    {
+        received(i);
+    }
+
+    void
+    waitForEvents(size_t count)
+    {
+        Lock sync(*this);
+        while(_events.size() < count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(20)))
+            {
+                test(false);
+            }
+        }
+    }
+
+    set<int>
+    events()
+    {
+        Lock sync(*this);
+        return _events;
+    }
+
+private:
+
+    void
+    received(int i)
+    {
+        Lock sync(*this);
+        test(_events.insert(i).second);
+        notifyAll();
+    }
+
+    set<int> _events;
+};
+typedef IceUtil::Handle<SingleI> SingleIPtr;
+
+//
+// Check an event against the filter of a subscriber, the same way
+// IceStorm checks each subscriber in turn without the index.
+//
+bool
+match(const QoS& qos, const string& operation, const Context& ctx)
+{
+    const string contextPrefix = "filter.context.";
+    for(QoS::const_iterator p = qos.begin(); p != qos.end(); ++p)
+    {
+        if(p->first == "filter.operation")
+        {
+            if(("," + p->second + ",").find("," + operation + ",") == string::npos)
+            {
+                return false;
+            }
+        }
+        else if(p->first.compare(0, contextPrefix.size(), contextPrefix) == 0)
+        {
+            Context::const_iterator q = ctx.find(p->first.substr(contextPrefix.size()));
+            if(q == ctx.end() || (!p->second.empty() && q->second != p->second))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int
+run(int, char* argv[], const CommunicatorPtr& communicator)
+{
+    PropertiesPtr properties = communicator->getProperties();
+    const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
+    string managerProxy = properties->getProperty(managerProxyProperty);
+    if(managerProxy.empty())
+    {
+        cerr << argv[0] << ": property `" << managerProxyProperty << "' is not set" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicManagerPrx manager = TopicManagerPrx::checkedCast(communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        cerr << argv[0] << ": `" << managerProxy << "' is not running" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicPrx topic;
+    try
+    {
+        topic = manager->retrieve("single");
+    }
+    catch(const NoSuchTopic& e)
+    {
+        cerr << argv[0] << ": NoSuchTopic: " << e.name << endl;
+        return EXIT_FAILURE;
+    }
+
+    ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SingleAdapter", "default");
+    adapter->activate();
+
+    {
+        cout << "testing invalid filters... " << flush;
+        const char* invalid[][2] =
+        {
+            { "filter.operation", "" },
+            { "filter.operation", " , " },
+            { "filter.context.", "red" },
+            { "filter.unknown", "event" }
+        };
+        for(size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+        {
+            QoS qos;
+            qos[invalid[i][0]] = invalid[i][1];
+            ObjectPrx subscriber = adapter->addWithUUID(new SingleI());
+            try
+            {
+                topic->subscribeAndGetPublisher(qos, subscriber);
+                test(false);
+            }
+            catch(const BadQoS&)
+            {
+            }
+            adapter->remove(subscriber->ice_getIdentity());
+        }
+        test(topic->getSubscribers().empty());
+        cout << "ok" << endl;
+    }
+
+    //
+    // The filters below share index entries: several subscribers are
+    // indexed with the same operation or context entry, and the
+    // subscribers indexed with their first context entry also require
+    // other entries that only the match of the filter checks.
+    //
+    vector<QoS> filters;
+    {
+        QoS qos;
+        filters.push_back(qos);
+    }
+    {
+        QoS qos;
+        qos["filter.operation"] = "event";
+        filters.push_back(qos);
+    }
+    {
+        QoS qos;
+        qos["filter.operation"] = "event,other";
+        filters.push_back(qos);
+    }
+    {
+        QoS qos;
+        qos["filter.context.color"] = "red";
+        filters.push_back(qos);
+        filters.push_back(qos);
+    }
+    {
+        QoS qos;
+        qos["filter.context.color"] = "";
+        filters.push_back(qos);
+    }
+    {
+        QoS qos;
+        qos["filter.operation"] = "other";
+        qos["filter.context.color"] = "red";
+        filters.push_back(qos);
+    }
+    {
+        QoS qos;
+        qos["filter.context.color"] = "red";
+        qos["filter.context.size"] = "big";
+        filters.push_back(qos);
+    }
+    {
+        QoS qos;
+        qos["filter.context.color"] = "blue";
+        qos["filter.context.size"] = "";
+        filters.push_back(qos);
+    }
+    {
+        QoS qos;
+        qos["filter.context.size"] = "small";
+        filters.push_back(qos);
+    }
+    {
+        QoS qos;
+        qos["filter.operation"] = "event";
+        qos["filter.context.size"] = "";
+        filters.push_back(qos);
+    }
+
+    vector<SingleIPtr> servants;
+    vector<ObjectPrx> subscribers;
+    {
+        cout << "subscribing with filters... " << flush;
+        for(vector<QoS>::const_iterator p = filters.begin(); p != filters.end(); ++p)
+        {
+            servants.push_back(new SingleI());
+            subscribers.push_back(adapter->addWithUUID(servants.back())->ice_oneway());
+            topic->subscribeAndGetPublisher(*p, subscribers.back());
+        }
+        test(topic->getSubscribers().size() == filters.size());
+        cout << "ok" << endl;
+    }
+
+    {
+        cout << "testing filtered events... " << flush;
+
+        vector<Context> contexts;
+        contexts.push_back(Context());
+        contexts.push_back(Context());
+        contexts.back()["color"] = "red";
+        contexts.push_back(Context());
+        contexts.back()["color"] = "blue";
+        contexts.push_back(Context());
+        contexts.back()["color"] = "red";
+        contexts.back()["size"] = "big";
+        contexts.push_back(Context());
+        contexts.back()["color"] = "red";
+        contexts.back()["size"] = "small";
+        contexts.push_back(Context());
+        contexts.back()["color"] = "blue";
+        contexts.back()["size"] = "big";
+        contexts.push_back(Context());
+        contexts.back()["color"] = "green";
+        contexts.back()["size"] = "small";
+        contexts.push_back(Context());
+        contexts.back()["size"] = "small";
+        contexts.push_back(Context());
+        contexts.back()["shape"] = "round";
+
+        //
+        // Each event is published with a distinct number, the
+        // expected events of each subscriber are computed with the
+        // linear check of its filter.
+        //
+        SinglePrx publisher = SinglePrx::uncheckedCast(topic->getPublisher()->ice_twoway());
+        vector<set<int> > expected(filters.size());
+        int i = 0;
+        for(int n = 0; n < 2; ++n)
+        {
+            for(vector<Context>::const_iterator p = contexts.begin(); p != contexts.end(); ++p)
+            {
+                for(int op = 0; op < 2; ++op)
+                {
+                    const string operation = op == 0 ? "event" : "other";
+                    if(op == 0)
+                    {
+                        publisher->event(i, *p);
+                    }
+                    else
+                    {
+                        publisher->other(i, *p);
+                    }
+                    for(size_t j = 0; j < filters.size(); ++j)
+                    {
+                        if(match(filters[j], operation, *p))
+                        {
+                            expected[j].insert(i);
+                        }
+                    }
+                    ++i;
+                }
+            }
+        }
+
+        for(size_t j = 0; j < servants.size(); ++j)
+        {
+            servants[j]->waitForEvents(expected[j].size());
+        }
+
+        //
+        // Make sure no other event is received.
+        //
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(500));
+        for(size_t j = 0; j < servants.size(); ++j)
+        {
+            test(servants[j]->events() == expected[j]);
+        }
+        test(expected[0].size() == static_cast<size_t>(i));
+        cout << "ok" << endl;
+    }
+
+    for(vector<ObjectPrx>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+    {
+        topic->unsubscribe(*p);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    CommunicatorPtr communicator;
+
+    try
+    {
+        communicator = initialize(argc, argv);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        try
+        {
+            communicator->destroy();
+        }
+        catch(const Exception& ex)
+        {
+            cerr << ex << endl;
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
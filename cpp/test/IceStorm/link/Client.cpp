@@ -0,0 +1,211 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <Single.h>
+#include <TestCommon.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+class SingleI : public Single, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    virtual void
+    event(int i, const Current&)
+    {
+        Lock sync(*this);
+        _events.push_back(i);
+        notifyAll();
+    }
+
+    virtual void
+    other(int, const Current&)
+    {
+        test(false);
+    }
+
+    void
+    waitForEvents(size_t count)
+    {
+        Lock sync(*this);
+        while(_events.size() < count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(20)))
+            {
+                test(false);
+            }
+        }
+    }
+
+    vector<int>
+    events()
+    {
+        Lock sync(*this);
+        return _events;
+    }
+
+private:
+
+    vector<int> _events;
+};
+typedef IceUtil::Handle<SingleI> SingleIPtr;
+
+namespace
+{
+
+vector<int>
+range(int first, int last)
+{
+    vector<int> v;
+    for(int i = first; i <= last; ++i)
+    {
+        v.push_back(i);
+    }
+    return v;
+}
+
+void
+publish(const SinglePrx& publisher, int first, int last)
+{
+    for(int i = first; i <= last; ++i)
+    {
+        publisher->event(i);
+    }
+}
+
+TopicManagerPrx
+getManager(const CommunicatorPtr& communicator, const char* property, const char* prog)
+{
+    string proxy = communicator->getProperties()->getProperty(property);
+    if(proxy.empty())
+    {
+        cerr << prog << ": property `" << property << "' is not set" << endl;
+        return 0;
+    }
+
+    TopicManagerPrx manager = TopicManagerPrx::checkedCast(communicator->stringToProxy(proxy));
+    if(!manager)
+    {
+        cerr << prog << ": `" << proxy << "' is not running" << endl;
+    }
+    return manager;
+}
+
+}
+
+int
+run(int, char* argv[], const CommunicatorPtr& communicator)
+{
+    TopicManagerPrx manager = getManager(communicator, "IceStormAdmin.TopicManager.Default", argv[0]);
+    TopicManagerPrx downstreamManager = getManager(communicator, "Test.Downstream", argv[0]);
+    if(!manager || !downstreamManager)
+    {
+        return EXIT_FAILURE;
+    }
+
+    TopicPrx topic = manager->create("single");
+    TopicPrx downstream = downstreamManager->create("single");
+    topic->link(downstream, 0);
+
+    ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SingleAdapter", "default");
+    adapter->activate();
+
+    SingleIPtr servant = new SingleI();
+    ObjectPrx subscriber = adapter->addWithUUID(servant);
+    QoS qos;
+    qos["reliability"] = "ordered";
+    downstream->subscribeAndGetPublisher(qos, subscriber);
+
+    SinglePrx publisher = SinglePrx::uncheckedCast(topic->getPublisher()->ice_twoway());
+
+    const int nEvents = 1005;
+    {
+        //
+        // The events are forwarded with several batches outstanding,
+        // the last 5 events are forwarded once the batch timeout
+        // expires.
+        //
+        cout << "testing event order over a link... " << flush;
+        publish(publisher, 0, nEvents - 1);
+        servant->waitForEvents(nEvents);
+        test(servant->events() == range(0, nEvents - 1));
+        cout << "ok" << endl;
+    }
+
+    {
+        //
+        // The events of a partial batch are discarded with the link,
+        // the batch timeout of the destroyed link must not forward
+        // them once it expires.
+        //
+        cout << "testing batch timeout cancellation on unlink... " << flush;
+        publish(publisher, nEvents, nEvents + 4);
+        topic->unlink(downstream);
+        IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(3));
+        test(servant->events() == range(0, nEvents - 1));
+
+        //
+        // The new link forwards the next events, a full batch is
+        // forwarded without waiting for the batch timeout.
+        //
+        topic->link(downstream, 0);
+        publish(publisher, nEvents + 5, nEvents + 14);
+        servant->waitForEvents(nEvents + 10);
+        vector<int> expected = range(0, nEvents - 1);
+        vector<int> next = range(nEvents + 5, nEvents + 14);
+        expected.insert(expected.end(), next.begin(), next.end());
+        test(servant->events() == expected);
+        cout << "ok" << endl;
+    }
+
+    downstream->unsubscribe(subscriber);
+    topic->unlink(downstream);
+    topic->destroy();
+    downstream->destroy();
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    CommunicatorPtr communicator;
+
+    try
+    {
+        communicator = initialize(argc, argv);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        try
+        {
+            communicator->destroy();
+        }
+        catch(const Exception& ex)
+        {
+            cerr << ex << endl;
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,52 @@
+#!/usr/bin/env python
+# **********************************************************************
+#
+# Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+import os, sys
+
+path = [ ".", "..", "../..", "../../..", "../../../.." ]
+head = os.path.dirname(sys.argv[0])
+if len(head) > 0:
+    path = [os.path.join(head, p) for p in path]
+path = [os.path.abspath(p) for p in path if os.path.exists(os.path.join(p, "scripts", "TestUtil.py")) ]
+if len(path) == 0:
+    raise RuntimeError("can't find toplevel directory!")
+sys.path.append(os.path.join(path[0], "scripts"))
+import TestUtil, IceStormUtil
+
+client = os.path.join(os.getcwd(), "client")
+
+#
+# The upstream service forwards the events with up to 5 outstanding
+# compressed calls of up to 10 events, and waits up to 2 seconds for a
+# batch to fill up. The downstream service serializes the dispatch of
+# the forwarded events, which is required to pipeline the calls.
+#
+link = ' --IceStorm.Link.OutstandingMax=5' + \
+       ' --IceStorm.Link.Serialized=1' + \
+       ' --IceStorm.Link.BatchSizeMax=10' + \
+       ' --IceStorm.Link.BatchTimeout=2000' + \
+       ' --IceStorm.Link.Compress=1' + \
+       ' --IceStorm.Publish.ThreadPool.Size=4' + \
+       ' --IceStorm.Publish.ThreadPool.Serialize=1'
+
+icestorm1 = IceStormUtil.init(TestUtil.toplevel, os.getcwd(), "transient", additional = link,
+                              instanceName = "TestIceStorm1", port = 12000)
+icestorm1.start()
+icestorm2 = IceStormUtil.init(TestUtil.toplevel, os.getcwd(), "transient", additional = link,
+                              instanceName = "TestIceStorm2", port = 12500)
+icestorm2.start()
+
+downstream = ' --Test.Downstream="%s"' % icestorm2.proxy()
+TestUtil.startClient(client, icestorm1.reference() + downstream).waitTestSuccess()
+
+icestorm1.stop()
+icestorm2.stop()
+
+sys.exit(0)
@@ -0,0 +1,347 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <IceStorm/Metrics.h>
+#include <Single.h>
+#include <TestCommon.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+//
+// A slow subscriber: the dispatch of the event 0 blocks until the
+// subscriber is released, the next events are queued by IceStorm.
+//
+class SingleI : public Single, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    SingleI() : _released(false)
+    {
+    }
+
+    virtual void
+    event(int i, const Current&)
+    {
+        Lock sync(*this);
+        _events.push_back(i);
+        notifyAll();
+        while(i == 0 && !_released)
+        {
+            wait();
+        }
+    }
+
+    virtual void
+    other(int, const Current&)
+    {
+        test(false);
+    }
+
+    void
+    release()
+    {
+        Lock sync(*this);
+        _released = true;
+        notifyAll();
+    }
+
+    void
+    waitForEvents(size_t count)
+    {
+        Lock sync(*this);
+        while(_events.size() < count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(20)))
+            {
+                test(false);
+            }
+        }
+    }
+
+    vector<int>
+    events()
+    {
+        Lock sync(*this);
+        return _events;
+    }
+
+private:
+
+    vector<int> _events;
+    bool _released;
+};
+typedef IceUtil::Handle<SingleI> SingleIPtr;
+
+namespace
+{
+
+const int nEvents = 20;
+
+vector<int>
+range(int first, int last)
+{
+    vector<int> v;
+    for(int i = first; i <= last; ++i)
+    {
+        v.push_back(i);
+    }
+    return v;
+}
+
+//
+// Get the number of events dropped for the given subscriber from the
+// subscriber metrics of the IceStorm service, the metrics are grouped
+// by identity.
+//
+Long
+getDropped(const IceMX::MetricsAdminPrx& metrics, const ObjectPrx& subscriber)
+{
+    const string id = subscriber->ice_getCommunicator()->identityToString(subscriber->ice_getIdentity());
+    Long timestamp;
+    IceMX::MetricsView view = metrics->getMetricsView("View", timestamp);
+    const IceMX::MetricsMap& map = view["Subscriber"];
+    for(IceMX::MetricsMap::const_iterator p = map.begin(); p != map.end(); ++p)
+    {
+        if((*p)->id == id)
+        {
+            IceMX::SubscriberMetricsPtr m = IceMX::SubscriberMetricsPtr::dynamicCast(*p);
+            test(m);
+            return m->dropped ? *m->dropped : 0;
+        }
+    }
+    test(false);
+    return 0;
+}
+
+//
+// Subscribe a slow subscriber with the given QoS, publish the events
+// while its first event is being dispatched, check the dropped metric
+// and the events received once the subscriber is released.
+//
+void
+testOverflow(const ObjectAdapterPtr& adapter, const TopicPrx& topic, const IceMX::MetricsAdminPrx& metrics,
+             const QoS& qos, const vector<int>& expected)
+{
+    SingleIPtr servant = new SingleI();
+    ObjectPrx subscriber = adapter->addWithUUID(servant);
+
+    //
+    // With ordered reliability, IceStorm only sends an event once the
+    // previous event was dispatched: the event 0 is sent and the next
+    // events are queued.
+    //
+    QoS q = qos;
+    q["reliability"] = "ordered";
+    topic->subscribeAndGetPublisher(q, subscriber);
+
+    SinglePrx publisher = SinglePrx::uncheckedCast(topic->getPublisher()->ice_twoway());
+    for(int i = 0; i < nEvents; ++i)
+    {
+        publisher->event(i);
+    }
+
+    test(getDropped(metrics, subscriber) == nEvents - static_cast<Long>(expected.size()));
+
+    servant->release();
+    servant->waitForEvents(expected.size());
+
+    //
+    // Make sure no other event is received.
+    //
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(500));
+    test(servant->events() == expected);
+
+    topic->unsubscribe(subscriber);
+    adapter->remove(subscriber->ice_getIdentity());
+}
+
+}
+
+int
+run(int, char* argv[], const CommunicatorPtr& communicator)
+{
+    PropertiesPtr properties = communicator->getProperties();
+    const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
+    string managerProxy = properties->getProperty(managerProxyProperty);
+    if(managerProxy.empty())
+    {
+        cerr << argv[0] << ": property `" << managerProxyProperty << "' is not set" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicManagerPrx manager = TopicManagerPrx::checkedCast(communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        cerr << argv[0] << ": `" << managerProxy << "' is not running" << endl;
+        return EXIT_FAILURE;
+    }
+
+    const char* metricsProxyProperty = "Test.Metrics";
+    IceMX::MetricsAdminPrx metrics = IceMX::MetricsAdminPrx::checkedCast(
+        communicator->propertyToProxy(metricsProxyProperty));
+    if(!metrics)
+    {
+        cerr << argv[0] << ": property `" << metricsProxyProperty << "' is not set" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicPrx topic;
+    try
+    {
+        topic = manager->retrieve("single");
+    }
+    catch(const NoSuchTopic& e)
+    {
+        cerr << argv[0] << ": NoSuchTopic: " << e.name << endl;
+        return EXIT_FAILURE;
+    }
+
+    ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SingleAdapter", "default");
+    adapter->activate();
+
+    {
+        cout << "testing invalid queueOverflow... " << flush;
+        QoS qos;
+        qos["queueOverflow"] = "DropAll";
+        ObjectPrx subscriber = adapter->addWithUUID(new SingleI());
+        try
+        {
+            topic->subscribeAndGetPublisher(qos, subscriber);
+            test(false);
+        }
+        catch(const BadQoS&)
+        {
+        }
+        adapter->remove(subscriber->ice_getIdentity());
+        test(topic->getSubscribers().empty());
+        cout << "ok" << endl;
+    }
+
+    {
+        //
+        // The service is configured with IceStorm.Send.QueueSizeMax=10
+        // and the default DropOldest policy.
+        //
+        cout << "testing default queue limit... " << flush;
+        vector<int> expected = range(10, nEvents - 1);
+        expected.insert(expected.begin(), 0);
+        testOverflow(adapter, topic, metrics, QoS(), expected);
+        cout << "ok" << endl;
+    }
+
+    {
+        cout << "testing DropNewest policy... " << flush;
+        QoS qos;
+        qos["queueSizeMax"] = "5";
+        qos["queueOverflow"] = "DropNewest";
+        testOverflow(adapter, topic, metrics, qos, range(0, 5));
+        cout << "ok" << endl;
+    }
+
+    {
+        cout << "testing DropOldest policy... " << flush;
+        QoS qos;
+        qos["queueSizeMax"] = "5";
+        qos["queueOverflow"] = "DropOldest";
+        vector<int> expected = range(nEvents - 5, nEvents - 1);
+        expected.insert(expected.begin(), 0);
+        testOverflow(adapter, topic, metrics, qos, expected);
+        cout << "ok" << endl;
+    }
+
+    {
+        //
+        // The parameters of each event are a 10 bytes encapsulation,
+        // the queue holds 5 events.
+        //
+        cout << "testing queue memory limit... " << flush;
+        QoS qos;
+        qos["queueSizeMax"] = "0";
+        qos["queueMemoryMax"] = "50";
+        vector<int> expected = range(nEvents - 5, nEvents - 1);
+        expected.insert(expected.begin(), 0);
+        testOverflow(adapter, topic, metrics, qos, expected);
+        cout << "ok" << endl;
+    }
+
+    {
+        cout << "testing Disconnect policy... " << flush;
+        SingleIPtr servant = new SingleI();
+        ObjectPrx subscriber = adapter->addWithUUID(servant);
+        QoS qos;
+        qos["reliability"] = "ordered";
+        qos["queueSizeMax"] = "5";
+        qos["queueOverflow"] = "Disconnect";
+        topic->subscribeAndGetPublisher(qos, subscriber);
+        test(topic->getSubscribers().size() == 1);
+
+        SinglePrx publisher = SinglePrx::uncheckedCast(topic->getPublisher()->ice_twoway());
+        for(int i = 0; i < nEvents; ++i)
+        {
+            publisher->event(i);
+        }
+
+        //
+        // The subscriber is removed from the topic once its queue
+        // overflows.
+        //
+        int retry = 200;
+        while(!topic->getSubscribers().empty() && --retry > 0)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        }
+        test(topic->getSubscribers().empty());
+
+        servant->waitForEvents(1);
+        servant->release();
+        test(servant->events() == range(0, 0));
+        adapter->remove(subscriber->ice_getIdentity());
+        cout << "ok" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    CommunicatorPtr communicator;
+
+    try
+    {
+        communicator = initialize(argc, argv);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        try
+        {
+            communicator->destroy();
+        }
+        catch(const Exception& ex)
+        {
+            cerr << ex << endl;
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
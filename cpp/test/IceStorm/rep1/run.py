@@ -283,6 +283,57 @@ sys.stdout.flush()
 runtest("twoway", icestorm.reference(), pubopt=" --cycle")
 print("ok")
 
+#
+# The master is killed while the topics are created and subscribers
+# added, the replica group elects a new master. Once restarted, the
+# replica retrieves the updates it missed and the new master sends the
+# other replicas the updates they missed from the replication log.
+#
+sys.stdout.write("testing master restart during updates... ")
+sys.stdout.flush()
+for i in range(0, 10):
+    icestorm.admin("create catchup%d" % i)
+    if i == 5:
+        icestorm.killReplica(2)
+runsub2()
+icestorm.startReplica(2, echo = False)
+for i in range(10, 20):
+    icestorm.admin("create catchup%d" % i)
+    if i == 15:
+        icestorm.killReplica(2)
+        icestorm.startReplica(2, echo = False)
+
+for replica in range(0, 3):
+    for i in range(0, 20):
+        icestorm.adminForReplica(replica, "create catchup%d" % i, "error: topic `catchup%d' exists" % i)
+    runsub2(replica, "IceStorm::AlreadySubscribed")
+print("ok")
+
+sys.stdout.write("testing replica restart after master restart... ")
+sys.stdout.flush()
+rununsub2()
+icestorm.stopReplica(0)
+for i in range(0, 20):
+    icestorm.admin("destroy catchup%d" % i)
+icestorm.killReplica(2)
+icestorm.startReplica(2, echo = False)
+icestorm.startReplica(0, echo = False, additionalOptions = " --IceStorm.Trace.TopicManager=1")
+for replica in range(0, 3):
+    icestorm.adminForReplica(replica, "destroy catchup0", "error: couldn't find topic `catchup0'")
+    icestorm.adminForReplica(replica, "destroy catchup19", "error: couldn't find topic `catchup19'")
+    rununsub2(replica)
+
+#
+# The replica applied the updates it missed from the replication log,
+# it didn't retrieve the content of the topics: the topic manager only
+# traces "init" when it receives the whole content.
+#
+if icestorm.procs[0].expect(["TopicManager: init", "TopicManager: apply log"]) != 1:
+    print("failed!")
+    print("replica 0 retrieved the content of the topics instead of the updates it missed")
+    sys.exit(1)
+print("ok")
+
 sys.stdout.write("stopping replicas... ")
 sys.stdout.flush()
 icestorm.stop()
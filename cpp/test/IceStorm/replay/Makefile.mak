@@ -0,0 +1,64 @@
+# **********************************************************************
+#
+# Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+top_srcdir	= ..\..\..
+
+PUBLISHER	= publisher.exe
+SUBSCRIBER	= subscriber.exe
+
+TARGETS		= $(PUBLISHER) $(SUBSCRIBER)
+
+SLICE_OBJS	= .\Single.obj
+
+POBJS		= $(SLICE_OBJS) \
+		  .\Publisher.obj
+
+SOBJS		= $(SLICE_OBJS) \
+		  .\Subscriber.obj
+
+OBJS		= $(POBJS) \
+		  $(SOBJS)
+
+
+!include $(top_srcdir)/config/Make.rules.mak
+
+CPPFLAGS	= -I. -I../../include $(CPPFLAGS) -DWIN32_LEAN_AND_MEAN
+LIBS		=  $(LIBS)
+
+!if "$(GENERATE_PDB)" == "yes"
+PPDBFLAGS        = /pdb:$(PUBLISHER:.exe=.pdb)
+SPDBFLAGS        = /pdb:$(SUBSCRIBER:.exe=.pdb)
+!endif
+
+$(PUBLISHER): $(POBJS)
+	$(LINK) $(LD_EXEFLAGS) $(PPDBFLAGS) $(SETARGV) $(POBJS) $(PREOUT)$@ $(PRELIBS)$(LIBS)
+	@if exist $@.manifest echo ^ ^ ^ Embedding manifest using $(MT) && \
+	    $(MT) -nologo -manifest $@.manifest -outputresource:$@;#1 && del /q $@.manifest
+
+$(SUBSCRIBER): $(SOBJS)
+	$(LINK) $(LD_EXEFLAGS) $(SPDBFLAGS) $(SETARGV) $(SOBJS) $(PREOUT)$@ $(PRELIBS)$(LIBS)
+	@if exist $@.manifest echo ^ ^ ^ Embedding manifest using $(MT) && \
+	    $(MT) -nologo -manifest $@.manifest -outputresource:$@;#1 && del /q $@.manifest
+
+!if "$(OPTIMIZE)" == "yes"
+
+all::
+	@echo release > build.txt
+
+!else
+
+all::
+	@echo debug > build.txt
+
+!endif
+
+clean::
+	del /q build.txt
+	del /q Single.cpp Single.h
+	-for %f in (db\*) do if not %f == db\.gitignore del /q %f
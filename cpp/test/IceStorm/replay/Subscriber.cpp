@@ -0,0 +1,209 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <IceUtil/Options.h>
+#include <Single.h>
+#include <TestCommon.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+//
+// Checks that the events are received in order, without gaps or
+// duplicates, each with the sequence number following the sequence
+// number of the previous event.
+//
+class SingleI : public Single, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    SingleI(int first, Ice::Long seq, int count) :
+        _next(first),
+        _seq(seq),
+        _count(count),
+        _received(0)
+    {
+    }
+
+    virtual void
+    event(int i, const Current& current)
+    {
+        Lock sync(*this);
+        if(i != _next)
+        {
+            cerr << endl << "received event " << i << " instead of " << _next;
+            test(false);
+        }
+        Context::const_iterator p = current.ctx.find("IceStorm.Sequence");
+        test(p != current.ctx.end());
+        ostringstream os;
+        os << _seq;
+        if(p->second != os.str())
+        {
+            cerr << endl << "received sequence number " << p->second << " instead of " << _seq;
+            test(false);
+        }
+        ++_next;
+        ++_seq;
+        if(++_received >= _count)
+        {
+            notify();
+        }
+    }
+
+    void
+    waitForEvents()
+    {
+        Lock sync(*this);
+        while(_received < _count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(20)))
+            {
+                cerr << endl << "received " << _received << " events out of " << _count;
+                test(false);
+            }
+        }
+
+        //
+        // Make sure no other event is received.
+        //
+        timedWait(IceUtil::Time::milliSeconds(500));
+        test(_received == _count);
+    }
+
+private:
+
+    int _next;
+    Ice::Long _seq;
+    const int _count;
+    int _received;
+};
+typedef IceUtil::Handle<SingleI> SingleIPtr;
+
+int
+run(int argc, char* argv[], const CommunicatorPtr& communicator)
+{
+    IceUtilInternal::Options opts;
+    opts.addOpt("", "from", IceUtilInternal::Options::NeedArg, "1");
+    opts.addOpt("", "first", IceUtilInternal::Options::NeedArg, "0");
+    opts.addOpt("", "count", IceUtilInternal::Options::NeedArg, "100");
+
+    try
+    {
+        opts.parse(argc, (const char**)argv);
+    }
+    catch(const IceUtilInternal::BadOptException& e)
+    {
+        cerr << argv[0] << ": " << e.reason << endl;
+        return EXIT_FAILURE;
+    }
+
+    //
+    // The events are published with consecutive numbers starting with
+    // 0, the event i is logged with the sequence number i + 1.
+    //
+    string from = opts.optArg("from");
+    int first = atoi(opts.optArg("first").c_str());
+    int count = atoi(opts.optArg("count").c_str());
+
+    PropertiesPtr properties = communicator->getProperties();
+    const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
+    string managerProxy = properties->getProperty(managerProxyProperty);
+    if(managerProxy.empty())
+    {
+        cerr << argv[0] << ": property `" << managerProxyProperty << "' is not set" << endl;
+        return EXIT_FAILURE;
+    }
+
+    IceStorm::TopicManagerPrx manager = IceStorm::TopicManagerPrx::checkedCast(
+        communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        cerr << argv[0] << ": `" << managerProxy << "' is not running" << endl;
+        return EXIT_FAILURE;
+    }
+
+    TopicPrx topic;
+    try
+    {
+        topic = manager->retrieve("replay");
+    }
+    catch(const IceStorm::NoSuchTopic& e)
+    {
+        cerr << argv[0] << ": NoSuchTopic: " << e.name << endl;
+        return EXIT_FAILURE;
+    }
+
+    ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SingleAdapter", "default");
+
+    {
+        IceStorm::QoS qos;
+        qos["resumeFrom"] = "invalid";
+        try
+        {
+            topic->subscribeAndGetPublisher(qos, adapter->addWithUUID(new SingleI(0, 0, 0)));
+            test(false);
+        }
+        catch(const IceStorm::BadQoS&)
+        {
+        }
+    }
+
+    SingleIPtr servant = new SingleI(first, atoi(from.c_str()), count);
+    IceStorm::QoS qos;
+    qos["reliability"] = "ordered";
+    qos["resumeFrom"] = from;
+    ObjectPrx subscriber = adapter->addWithUUID(servant);
+    topic->subscribeAndGetPublisher(qos, subscriber);
+
+    adapter->activate();
+
+    servant->waitForEvents();
+
+    topic->unsubscribe(subscriber);
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    CommunicatorPtr communicator;
+
+    try
+    {
+        communicator = initialize(argc, argv);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        try
+        {
+            communicator->destroy();
+        }
+        catch(const Exception& ex)
+        {
+            cerr << ex << endl;
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
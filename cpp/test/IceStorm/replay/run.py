@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+# **********************************************************************
+#
+# Copyright (c) 2003-2015 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+import os, sys
+
+path = [ ".", "..", "../..", "../../..", "../../../.." ]
+head = os.path.dirname(sys.argv[0])
+if len(head) > 0:
+    path = [os.path.join(head, p) for p in path]
+path = [os.path.abspath(p) for p in path if os.path.exists(os.path.join(p, "scripts", "TestUtil.py")) ]
+if len(path) == 0:
+    raise RuntimeError("can't find toplevel directory!")
+sys.path.append(os.path.join(path[0], "scripts"))
+import TestUtil, IceStormUtil
+
+publisher = os.path.join(os.getcwd(), "publisher")
+subscriber = os.path.join(os.getcwd(), "subscriber")
+
+icestorm = IceStormUtil.init(TestUtil.toplevel, os.getcwd(), "persistent",
+                             additional = " --IceStorm.EventLog.Enabled=1")
+icestorm.start()
+
+sys.stdout.write("creating topic... ")
+sys.stdout.flush()
+icestorm.admin("create replay")
+print("ok")
+
+def publish(first, count):
+    proc = TestUtil.startClient(publisher, icestorm.reference() + " --first %d --count %d" % (first, count),
+                                echo = False)
+    proc.waitTestSuccess()
+
+def replay(seq, first, count):
+    return TestUtil.startServer(subscriber,
+                                icestorm.reference() + " --from %d --first %d --count %d" % (seq, first, count),
+                                adapter = "SingleAdapter", echo = False)
+
+sys.stdout.write("publishing events without subscribers... ")
+sys.stdout.flush()
+publish(0, 100)
+print("ok")
+
+sys.stdout.write("replaying all the logged events... ")
+sys.stdout.flush()
+replay(1, 0, 100).waitTestSuccess()
+print("ok")
+
+sys.stdout.write("replaying from a sequence number... ")
+sys.stdout.flush()
+replay(51, 50, 50).waitTestSuccess()
+print("ok")
+
+#
+# The subscriber receives the last 10 logged events, then the events
+# published once it's subscribed, without gaps or duplicates.
+#
+sys.stdout.write("replaying and receiving published events... ")
+sys.stdout.flush()
+subscriberProc = replay(91, 90, 110)
+publish(100, 100)
+subscriberProc.waitTestSuccess()
+print("ok")
+
+sys.stdout.write("restarting icestorm... ")
+sys.stdout.flush()
+icestorm.stop()
+icestorm.start(echo = False)
+print("ok")
+
+sys.stdout.write("replaying after restart... ")
+sys.stdout.flush()
+replay(151, 150, 50).waitTestSuccess()
+print("ok")
+
+sys.stdout.write("checking sequence numbers after restart... ")
+sys.stdout.flush()
+subscriberProc = replay(200, 199, 11)
+publish(200, 10)
+subscriberProc.waitTestSuccess()
+print("ok")
+
+sys.stdout.write("destroy topic... ")
+sys.stdout.flush()
+icestorm.admin("destroy replay")
+print("ok")
+
+icestorm.stop()
+
+sys.exit(0)
@@ -152,6 +152,54 @@ private:
 };
 ICE_DEFINE_PTR(DestroyTaskPtr, DestroyTask);
 
+class BlockingTask : public IceUtil::TimerTask, IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    BlockingTask() : _running(false), _released(false)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        Lock sync(*this);
+        _running = true;
+        notifyAll();
+        while(!_released)
+        {
+            wait();
+        }
+    }
+
+    void
+    waitForRunning()
+    {
+        Lock sync(*this);
+        while(!_running)
+        {
+            if(!timedWait(IceUtil::Time::seconds(10)))
+            {
+                test(false); // Timeout.
+            }
+        }
+    }
+
+    void
+    release()
+    {
+        Lock sync(*this);
+        _released = true;
+        notifyAll();
+    }
+
+private:
+
+    bool _running;
+    bool _released;
+};
+ICE_DEFINE_PTR(BlockingTaskPtr, BlockingTask);
+
 int main(int, char**)
 {
     cout << "testing timer... " << flush;
@@ -243,6 +291,142 @@ int main(int, char**)
     }
     cout << "ok" << endl;
 
+    cout << "testing timer wheel cascading... " << flush;
+    {
+        IceUtil::TimerPtr timer = new IceUtil::Timer();
+
+        //
+        // The first level of the wheel spans 256ms, the tasks below are
+        // cascaded from the upper levels before they run.
+        //
+        vector<TestTaskPtr> tasks;
+        const IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        for(int i = 0; i < 10; ++i)
+        {
+            tasks.push_back(ICE_MAKE_SHARED(TestTask, IceUtil::Time::milliSeconds(200 + i * 100)));
+        }
+
+        random_shuffle(tasks.begin(), tasks.end());
+        vector<TestTaskPtr>::const_iterator p;
+        for(p = tasks.begin(); p != tasks.end(); ++p)
+        {
+            timer->schedule(*p, (*p)->getScheduledTime());
+        }
+
+        for(p = tasks.begin(); p != tasks.end(); ++p)
+        {
+            (*p)->waitForRun();
+            test((*p)->getRunTime() >= start + (*p)->getScheduledTime());
+            test((*p)->getCount() == 1);
+        }
+
+#ifdef ICE_CPP11_MAPPING
+        sort(tasks.begin(), tasks.end(), TargetLess<shared_ptr<TestTask>>());
+#else
+        sort(tasks.begin(), tasks.end());
+#endif
+        for(p = tasks.begin(); p + 1 != tasks.end(); ++p)
+        {
+            test((*p)->getRunTime() <= (*(p + 1))->getRunTime());
+        }
+
+        //
+        // A repeated task with a delay longer than the first level is
+        // cascaded each time it's rescheduled.
+        //
+        TestTaskPtr task = ICE_MAKE_SHARED(TestTask);
+        timer->scheduleRepeated(task, IceUtil::Time::milliSeconds(300));
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1050));
+        test(timer->cancel(task));
+        test(task->getCount() >= 2 && task->getCount() <= 3);
+
+        timer->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing delays longer than the timer wheel... " << flush;
+    {
+        IceUtil::TimerPtr timer = new IceUtil::Timer();
+
+        //
+        // The wheel spans about 18 hours, longer delays are parked in
+        // the last level.
+        //
+        TestTaskPtr longTask = ICE_MAKE_SHARED(TestTask);
+        timer->schedule(longTask, IceUtil::Time::seconds(48 * 3600));
+        TestTaskPtr repeatedTask = ICE_MAKE_SHARED(TestTask);
+        timer->scheduleRepeated(repeatedTask, IceUtil::Time::seconds(24 * 3600));
+
+        TestTaskPtr task = ICE_MAKE_SHARED(TestTask);
+        timer->schedule(task, IceUtil::Time::milliSeconds(50));
+        task->waitForRun();
+
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(300));
+        test(!longTask->hasRun());
+        test(!repeatedTask->hasRun());
+
+        test(timer->cancel(longTask));
+        test(!timer->cancel(longTask));
+        test(timer->cancel(repeatedTask));
+
+        //
+        // The canceled task can be scheduled again.
+        //
+        timer->schedule(longTask, IceUtil::Time::milliSeconds(10));
+        longTask->waitForRun();
+
+        timer->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing multiple timer threads... " << flush;
+    {
+        IceUtil::TimerPtr timer = new IceUtil::Timer();
+        timer->addThreads(2);
+
+        //
+        // The tasks run concurrently, a blocked task doesn't delay the
+        // other tasks.
+        //
+        vector<BlockingTaskPtr> blockingTasks;
+        for(int i = 0; i < 2; ++i)
+        {
+            blockingTasks.push_back(ICE_MAKE_SHARED(BlockingTask));
+            timer->schedule(blockingTasks.back(), IceUtil::Time());
+        }
+        for(vector<BlockingTaskPtr>::const_iterator p = blockingTasks.begin(); p != blockingTasks.end(); ++p)
+        {
+            (*p)->waitForRunning();
+        }
+
+        vector<TestTaskPtr> tasks;
+        for(int i = 0; i < 10; ++i)
+        {
+            tasks.push_back(ICE_MAKE_SHARED(TestTask));
+            timer->schedule(tasks.back(), IceUtil::Time::milliSeconds(i * 10));
+        }
+        for(vector<TestTaskPtr>::const_iterator p = tasks.begin(); p != tasks.end(); ++p)
+        {
+            (*p)->waitForRun();
+        }
+
+        //
+        // The repeated task runs on the thread which isn't blocked.
+        //
+        TestTaskPtr task = ICE_MAKE_SHARED(TestTask);
+        timer->scheduleRepeated(task, IceUtil::Time::milliSeconds(10));
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+        test(timer->cancel(task));
+        test(task->getCount() > 1);
+
+        for(vector<BlockingTaskPtr>::const_iterator p = blockingTasks.begin(); p != blockingTasks.end(); ++p)
+        {
+            (*p)->release();
+        }
+        timer->destroy();
+    }
+    cout << "ok" << endl;
+
     cout << "testing timer destroy... " << flush;
     {
         {
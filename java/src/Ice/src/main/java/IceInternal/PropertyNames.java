@@ -66,7 +66,12 @@ public final class PropertyNames
         new Property("Ice\\.Admin\\.ThreadPool\\.Serialize", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("Ice\\.Admin\\.ThreadPool\\.Shards", false, null),
+        new Property("Ice\\.Admin\\.ThreadPool\\.WorkStealing", false, null),
         new Property("Ice\\.Admin\\.MessageSizeMax", false, null),
+        new Property("Ice\\.Admin\\.Acceptors", false, null),
+        new Property("Ice\\.Admin\\.Compression\\.Codec", false, null),
+        new Property("Ice\\.Admin\\.Compression\\.Level", false, null),
         new Property("Ice\\.Admin\\.DelayCreation", false, null),
         new Property("Ice\\.Admin\\.Enabled", false, null),
         new Property("Ice\\.Admin\\.Facets", false, null),
@@ -77,9 +82,11 @@ public final class PropertyNames
         new Property("Ice\\.Admin\\.ServerId", false, null),
         new Property("Ice\\.BackgroundLocatorCacheUpdates", false, null),
         new Property("Ice\\.BatchAutoFlush", true, null),
+        new Property("Ice\\.BatchAutoFlushDelay", false, null),
         new Property("Ice\\.BatchAutoFlushSize", false, null),
         new Property("Ice\\.ChangeUser", false, null),
         new Property("Ice\\.ClientAccessPolicyProtocol", false, null),
+        new Property("Ice\\.Compression\\.Codec", false, null),
         new Property("Ice\\.Compression\\.Level", false, null),
         new Property("Ice\\.CollectObjects", false, null),
         new Property("Ice\\.Config", false, null),
@@ -156,6 +163,8 @@ public final class PropertyNames
         new Property("Ice\\.ThreadPool\\.Client\\.Serialize", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.ThreadIdleTime", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.ThreadPriority", false, null),
+        new Property("Ice\\.ThreadPool\\.Client\\.Shards", false, null),
+        new Property("Ice\\.ThreadPool\\.Client\\.WorkStealing", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.Size", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.SizeMax", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.SizeWarn", false, null),
@@ -163,7 +172,10 @@ public final class PropertyNames
         new Property("Ice\\.ThreadPool\\.Server\\.Serialize", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.ThreadIdleTime", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.ThreadPriority", false, null),
+        new Property("Ice\\.ThreadPool\\.Server\\.Shards", false, null),
+        new Property("Ice\\.ThreadPool\\.Server\\.WorkStealing", false, null),
         new Property("Ice\\.ThreadPriority", false, null),
+        new Property("Ice\\.TimerThreads", false, null),
         new Property("Ice\\.Trace\\.Admin\\.Properties", false, null),
         new Property("Ice\\.Trace\\.Admin\\.Logger", false, null),
         new Property("Ice\\.Trace\\.Locator", false, null),
@@ -241,7 +253,12 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.Serialize", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.Shards", false, null),
+        new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceDiscovery\\.Multicast\\.MessageSizeMax", false, null),
+        new Property("IceDiscovery\\.Multicast\\.Acceptors", false, null),
+        new Property("IceDiscovery\\.Multicast\\.Compression\\.Codec", false, null),
+        new Property("IceDiscovery\\.Multicast\\.Compression\\.Level", false, null),
         new Property("IceDiscovery\\.Reply\\.ACM\\.Timeout", false, null),
         new Property("IceDiscovery\\.Reply\\.ACM\\.Heartbeat", false, null),
         new Property("IceDiscovery\\.Reply\\.ACM\\.Close", false, null),
@@ -278,7 +295,12 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceDiscovery\\.Reply\\.ThreadPool\\.Shards", false, null),
+        new Property("IceDiscovery\\.Reply\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceDiscovery\\.Reply\\.MessageSizeMax", false, null),
+        new Property("IceDiscovery\\.Reply\\.Acceptors", false, null),
+        new Property("IceDiscovery\\.Reply\\.Compression\\.Codec", false, null),
+        new Property("IceDiscovery\\.Reply\\.Compression\\.Level", false, null),
         new Property("IceDiscovery\\.Locator\\.ACM\\.Timeout", false, null),
         new Property("IceDiscovery\\.Locator\\.ACM\\.Heartbeat", false, null),
         new Property("IceDiscovery\\.Locator\\.ACM\\.Close", false, null),
@@ -315,7 +337,12 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.Serialize", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceDiscovery\\.Locator\\.ThreadPool\\.Shards", false, null),
+        new Property("IceDiscovery\\.Locator\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceDiscovery\\.Locator\\.MessageSizeMax", false, null),
+        new Property("IceDiscovery\\.Locator\\.Acceptors", false, null),
+        new Property("IceDiscovery\\.Locator\\.Compression\\.Codec", false, null),
+        new Property("IceDiscovery\\.Locator\\.Compression\\.Level", false, null),
         new Property("IceDiscovery\\.Lookup", false, null),
         new Property("IceDiscovery\\.Timeout", false, null),
         new Property("IceDiscovery\\.RetryCount", false, null),
@@ -365,7 +392,12 @@ public final class PropertyNames
         new Property("IceGridDiscovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGridDiscovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridDiscovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGridDiscovery\\.Reply\\.ThreadPool\\.Shards", false, null),
+        new Property("IceGridDiscovery\\.Reply\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceGridDiscovery\\.Reply\\.MessageSizeMax", false, null),
+        new Property("IceGridDiscovery\\.Reply\\.Acceptors", false, null),
+        new Property("IceGridDiscovery\\.Reply\\.Compression\\.Codec", false, null),
+        new Property("IceGridDiscovery\\.Reply\\.Compression\\.Level", false, null),
         new Property("IceGridDiscovery\\.Locator\\.ACM\\.Timeout", false, null),
         new Property("IceGridDiscovery\\.Locator\\.ACM\\.Heartbeat", false, null),
         new Property("IceGridDiscovery\\.Locator\\.ACM\\.Close", false, null),
@@ -402,7 +434,12 @@ public final class PropertyNames
         new Property("IceGridDiscovery\\.Locator\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGridDiscovery\\.Locator\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridDiscovery\\.Locator\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGridDiscovery\\.Locator\\.ThreadPool\\.Shards", false, null),
+        new Property("IceGridDiscovery\\.Locator\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceGridDiscovery\\.Locator\\.MessageSizeMax", false, null),
+        new Property("IceGridDiscovery\\.Locator\\.Acceptors", false, null),
+        new Property("IceGridDiscovery\\.Locator\\.Compression\\.Codec", false, null),
+        new Property("IceGridDiscovery\\.Locator\\.Compression\\.Level", false, null),
         new Property("IceGridDiscovery\\.Lookup", false, null),
         new Property("IceGridDiscovery\\.Timeout", false, null),
         new Property("IceGridDiscovery\\.RetryCount", false, null),
@@ -500,7 +537,12 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.Shards", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.MessageSizeMax", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.Acceptors", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.Compression\\.Codec", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.Compression\\.Level", false, null),
         new Property("IceGridAdmin\\.Trace\\.Observers", false, null),
         new Property("IceGridAdmin\\.Trace\\.SaveToRegistry", false, null),
         null
@@ -544,7 +586,12 @@ public final class PropertyNames
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.Shards", false, null),
+        new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceGrid\\.AdminRouter\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.AdminRouter\\.Acceptors", false, null),
+        new Property("IceGrid\\.AdminRouter\\.Compression\\.Codec", false, null),
+        new Property("IceGrid\\.AdminRouter\\.Compression\\.Level", false, null),
         new Property("IceGrid\\.InstanceName", false, null),
         new Property("IceGrid\\.Node\\.ACM\\.Timeout", false, null),
         new Property("IceGrid\\.Node\\.ACM\\.Heartbeat", false, null),
@@ -582,7 +629,12 @@ public final class PropertyNames
         new Property("IceGrid\\.Node\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Node\\.ThreadPool\\.Shards", false, null),
+        new Property("IceGrid\\.Node\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceGrid\\.Node\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Node\\.Acceptors", false, null),
+        new Property("IceGrid\\.Node\\.Compression\\.Codec", false, null),
+        new Property("IceGrid\\.Node\\.Compression\\.Level", false, null),
         new Property("IceGrid\\.Node\\.AllowRunningServersAsRoot", false, null),
         new Property("IceGrid\\.Node\\.AllowEndpointsOverride", false, null),
         new Property("IceGrid\\.Node\\.CollocateRegistry", false, null),
@@ -659,7 +711,12 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.Shards", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Acceptors", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Compression\\.Codec", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.Compression\\.Level", false, null),
         new Property("IceGrid\\.Registry\\.AdminSSLPermissionsVerifier\\.EndpointSelection", false, null),
         new Property("IceGrid\\.Registry\\.AdminSSLPermissionsVerifier\\.ConnectionCached", false, null),
         new Property("IceGrid\\.Registry\\.AdminSSLPermissionsVerifier\\.PreferSecure", false, null),
@@ -706,7 +763,12 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.Shards", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.Acceptors", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.Compression\\.Codec", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.Compression\\.Level", false, null),
         new Property("IceGrid\\.Registry\\.CryptPasswords", false, null),
         new Property("IceGrid\\.Registry\\.DefaultTemplates", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ACM\\.Timeout", false, null),
@@ -745,7 +807,12 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.Shards", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.Acceptors", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.Compression\\.Codec", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.Compression\\.Level", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.Enabled", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.Address", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.Port", false, null),
@@ -787,7 +854,12 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.Shards", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.Acceptors", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.Compression\\.Codec", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.Compression\\.Level", false, null),
         new Property("IceGrid\\.Registry\\.LMDB\\.MapSize", false, null),
         new Property("IceGrid\\.Registry\\.LMDB\\.Path", false, null),
         new Property("IceGrid\\.Registry\\.NodeSessionTimeout", false, null),
@@ -841,7 +913,12 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.Shards", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.Acceptors", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.Compression\\.Codec", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.Compression\\.Level", false, null),
         new Property("IceGrid\\.Registry\\.SessionFilters", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ACM\\.Timeout", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ACM\\.Heartbeat", false, null),
@@ -879,7 +956,12 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.Serialize", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.Shards", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.Acceptors", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.Compression\\.Codec", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.Compression\\.Level", false, null),
         new Property("IceGrid\\.Registry\\.SessionTimeout", false, null),
         new Property("IceGrid\\.Registry\\.SSLPermissionsVerifier\\.EndpointSelection", false, null),
         new Property("IceGrid\\.Registry\\.SSLPermissionsVerifier\\.ConnectionCached", false, null),
@@ -945,7 +1027,12 @@ public final class PropertyNames
         new Property("IcePatch2\\.ThreadPool\\.Serialize", false, null),
         new Property("IcePatch2\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IcePatch2\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("IcePatch2\\.ThreadPool\\.Shards", false, null),
+        new Property("IcePatch2\\.ThreadPool\\.WorkStealing", false, null),
         new Property("IcePatch2\\.MessageSizeMax", false, null),
+        new Property("IcePatch2\\.Acceptors", false, null),
+        new Property("IcePatch2\\.Compression\\.Codec", false, null),
+        new Property("IcePatch2\\.Compression\\.Level", false, null),
         new Property("IcePatch2\\.Directory", false, null),
         new Property("IcePatch2\\.InstanceName", false, null),
         null
@@ -1065,10 +1152,16 @@ public final class PropertyNames
         new Property("Glacier2\\.Client\\.ThreadPool\\.Serialize", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("Glacier2\\.Client\\.ThreadPool\\.Shards", false, null),
+        new Property("Glacier2\\.Client\\.ThreadPool\\.WorkStealing", false, null),
         new Property("Glacier2\\.Client\\.MessageSizeMax", false, null),
+        new Property("Glacier2\\.Client\\.Acceptors", false, null),
+        new Property("Glacier2\\.Client\\.Compression\\.Codec", false, null),
+        new Property("Glacier2\\.Client\\.Compression\\.Level", false, null),
         new Property("Glacier2\\.Client\\.AlwaysBatch", false, null),
         new Property("Glacier2\\.Client\\.Buffered", false, null),
         new Property("Glacier2\\.Client\\.ForwardContext", false, null),
+        new Property("Glacier2\\.Client\\.FlushSize", false, null),
         new Property("Glacier2\\.Client\\.SleepTime", false, null),
         new Property("Glacier2\\.Client\\.Trace\\.Override", false, null),
         new Property("Glacier2\\.Client\\.Trace\\.Reject", false, null),
@@ -1103,6 +1196,7 @@ public final class PropertyNames
         new Property("Glacier2\\.SSLPermissionsVerifier\\.CollocationOptimized", false, null),
         new Property("Glacier2\\.SSLPermissionsVerifier\\.Context\\.[^\\s]+", false, null),
         new Property("Glacier2\\.SSLPermissionsVerifier", false, null),
+        new Property("Glacier2\\.RoutingTable\\.MaxMemory", false, null),
         new Property("Glacier2\\.RoutingTable\\.MaxSize", false, null),
         new Property("Glacier2\\.Server\\.ACM\\.Timeout", false, null),
         new Property("Glacier2\\.Server\\.ACM\\.Heartbeat", false, null),
@@ -1140,10 +1234,16 @@ public final class PropertyNames
         new Property("Glacier2\\.Server\\.ThreadPool\\.Serialize", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
+        new Property("Glacier2\\.Server\\.ThreadPool\\.Shards", false, null),
+        new Property("Glacier2\\.Server\\.ThreadPool\\.WorkStealing", false, null),
         new Property("Glacier2\\.Server\\.MessageSizeMax", false, null),
+        new Property("Glacier2\\.Server\\.Acceptors", false, null),
+        new Property("Glacier2\\.Server\\.Compression\\.Codec", false, null),
+        new Property("Glacier2\\.Server\\.Compression\\.Level", false, null),
         new Property("Glacier2\\.Server\\.AlwaysBatch", false, null),
         new Property("Glacier2\\.Server\\.Buffered", false, null),
         new Property("Glacier2\\.Server\\.ForwardContext", false, null),
+        new Property("Glacier2\\.Server\\.FlushSize", false, null),
         new Property("Glacier2\\.Server\\.SleepTime", false, null),
         new Property("Glacier2\\.Server\\.Trace\\.Override", false, null),
         new Property("Glacier2\\.Server\\.Trace\\.Request", false, null),
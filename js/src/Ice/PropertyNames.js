@@ -67,7 +67,12 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Admin\.ThreadPool\.Serialize/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.ThreadPriority/", false, null),
+    new Property("/^Ice\.Admin\.ThreadPool\.Shards/", false, null),
+    new Property("/^Ice\.Admin\.ThreadPool\.WorkStealing/", false, null),
     new Property("/^Ice\.Admin\.MessageSizeMax/", false, null),
+    new Property("/^Ice\.Admin\.Acceptors/", false, null),
+    new Property("/^Ice\.Admin\.Compression\.Codec/", false, null),
+    new Property("/^Ice\.Admin\.Compression\.Level/", false, null),
     new Property("/^Ice\.Admin\.DelayCreation/", false, null),
     new Property("/^Ice\.Admin\.Enabled/", false, null),
     new Property("/^Ice\.Admin\.Facets/", false, null),
@@ -78,9 +83,11 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Admin\.ServerId/", false, null),
     new Property("/^Ice\.BackgroundLocatorCacheUpdates/", false, null),
     new Property("/^Ice\.BatchAutoFlush/", true, null),
+    new Property("/^Ice\.BatchAutoFlushDelay/", false, null),
     new Property("/^Ice\.BatchAutoFlushSize/", false, null),
     new Property("/^Ice\.ChangeUser/", false, null),
     new Property("/^Ice\.ClientAccessPolicyProtocol/", false, null),
+    new Property("/^Ice\.Compression\.Codec/", false, null),
     new Property("/^Ice\.Compression\.Level/", false, null),
     new Property("/^Ice\.CollectObjects/", false, null),
     new Property("/^Ice\.Config/", false, null),
@@ -157,6 +164,8 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ThreadPool\.Client\.Serialize/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadPriority/", false, null),
+    new Property("/^Ice\.ThreadPool\.Client\.Shards/", false, null),
+    new Property("/^Ice\.ThreadPool\.Client\.WorkStealing/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.Size/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.SizeMax/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.SizeWarn/", false, null),
@@ -164,7 +173,10 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ThreadPool\.Server\.Serialize/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.ThreadPriority/", false, null),
+    new Property("/^Ice\.ThreadPool\.Server\.Shards/", false, null),
+    new Property("/^Ice\.ThreadPool\.Server\.WorkStealing/", false, null),
     new Property("/^Ice\.ThreadPriority/", false, null),
+    new Property("/^Ice\.TimerThreads/", false, null),
     new Property("/^Ice\.Trace\.Admin\.Properties/", false, null),
     new Property("/^Ice\.Trace\.Admin\.Logger/", false, null),
     new Property("/^Ice\.Trace\.Locator/", false, null),
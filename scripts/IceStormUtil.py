@@ -9,7 +9,7 @@
 #
 # **********************************************************************
 
-import os, sys
+import os, sys, signal
 import TestUtil
 
 global testdir
@@ -186,6 +186,12 @@ class Replicated(IceStormUtil):
             self.procs[replica].waitTestSuccess()
             self.procs[replica] = None
 
+    def killReplica(self, replica):
+        if self.procs[replica]:
+            self.procs[replica].kill(signal.SIGKILL if hasattr(signal, "SIGKILL") else signal.SIGTERM)
+            self.procs[replica].wait()
+            self.procs[replica] = None
+
     def reference(self, replica=-1):
         if replica == -1:
             return self.iceStormReference
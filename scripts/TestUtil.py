@@ -7,12 +7,13 @@
 #
 # **********************************************************************
 
-import sys, os, re, getopt, time, string, threading, atexit, platform, traceback, subprocess
+import sys, os, re, getopt, time, string, threading, atexit, platform, traceback, subprocess, shutil
 
 # Global flags and their default values.
 protocol = ""                   # If unset, default to TCP. Valid values are "tcp", "ssl", "ws", "wss" or "bt".
 compress = False                # Set to True to enable bzip2 compression.
 serialize = False               # Set to True to have tests use connection serialization
+shards = False                  # Set to True to have tests use sharded thread pools with work stealing
 host = None                     # Will default to loopback.
 debug = False                   # Set to True to enable test suite debugging.
 mono = False                    # Set to True when not on Windows
@@ -439,6 +440,7 @@ def run(tests, root = False):
           --valgrind           Run the test with valgrind.
           --appverifier        Run the test with appverifier under Windows.
           --serialize          Run with connection serialization.
+          --shards             Run with sharded thread pools and work stealing (C++ only).
           --continue           Keep running when a test fails.
           --ipv6               Use IPv6 addresses.
           --socks              Use SOCKS proxy running on localhost.
@@ -464,7 +466,7 @@ def run(tests, root = False):
     try:
         opts, args = getopt.getopt(sys.argv[1:], "lr:R:",
                                    ["start=", "start-after=", "filter=", "rfilter=", "all", "all-cross", "loop",
-                                    "debug", "protocol=", "compress", "valgrind", "host=", "serialize", "continue",
+                                    "debug", "protocol=", "compress", "valgrind", "host=", "serialize", "shards", "continue",
                                     "ipv6", "no-ipv6", "socks", "ice-home=", "cross=", "client-home=", "x64", "x86",
                                     "script", "env", "arg=", "service-dir=", "appverifier", "compact",
                                     "winrt", "server", "mx", "c++11", "controller=", "configName="])
@@ -544,7 +546,7 @@ def run(tests, root = False):
         elif o == "--x64":
             global x64
             x64 = True
-        if o in ( "--cross", "--protocol", "--host", "--debug", "--compress", "--valgrind", "--serialize", "--ipv6", \
+        if o in ( "--cross", "--protocol", "--host", "--debug", "--compress", "--valgrind", "--serialize", "--shards", "--ipv6", \
                   "--socks", "--ice-home", "--x86", "--x64", "--c++11", "--env", \
                   "--service-dir", "--appverifier", "--compact", "--winrt", \
                   "--server", "--mx", "--client-home", "--controller", "--configName"):
@@ -577,6 +579,10 @@ def run(tests, root = False):
             a = "--ipv6 --protocol=wss --compress --mx --serialize %s" % arg
             expanded.append([ (test, a, config) for test,config in tests if "core" in config])
 
+        if getDefaultMapping() == "cpp":
+            a = "--protocol=tcp --shards %s" % arg
+            expanded.append([ (test, a, config) for test,config in tests if "core" in config])
+
         a = "--protocol=tcp %s" % arg
         expanded.append([ (test, a, config) for test,config in tests if "service" in config])
 
@@ -964,6 +970,7 @@ class DriverConfig:
     protocol = None
     compress = 0
     serialize = 0
+    shards = False
     host = None
     mono = False
     valgrind = False
@@ -984,6 +991,7 @@ class DriverConfig:
         global protocol
         global compress
         global serialize
+        global shards
         global host
         global mono
         global valgrind
@@ -1002,6 +1010,7 @@ class DriverConfig:
         self.protocol = protocol
         self.compress = compress
         self.serialize = serialize
+        self.shards = shards
         self.host = host
         self.mono = mono
         self.valgrind = valgrind
@@ -1079,6 +1088,11 @@ def getCommandLineProperties(exe, config, cfgName):
     if config.serialize:
         components.append("--Ice.ThreadPool.Server.Serialize=1")
 
+    if config.shards and config.lang == "cpp":
+        for pool in ["Client", "Server"]:
+            components.append("--Ice.ThreadPool.%s.Shards=2" % pool)
+            components.append("--Ice.ThreadPool.%s.WorkStealing=1" % pool)
+
     #
     # TODO
     # config.lang == "cpp" required with C++11 mapping, we should be able to ged rid
@@ -1723,7 +1737,10 @@ def cleanDbDir(path):
     #
     ignore = [".gitignore", "DB_CONFIG", "__Freeze"]
     for filename in [ os.path.join(path, f) for f in os.listdir(path) if f not in ignore ]:
-        os.remove(filename)
+        if os.path.isdir(filename):
+            shutil.rmtree(filename)
+        else:
+            os.remove(filename)
 
 def startClient(exe, args = "", config=None, env=None, echo = True, startReader = True, clientConfig = False, iceOptions = None, iceProfile = None):
     if config is None:
@@ -2085,6 +2102,7 @@ def processCmdLine():
           --appverifier        Run the tests with appverifier.
           --host=host          Set --Ice.Default.Host=<host>.
           --serialize          Run with connection serialization.
+          --shards             Run with sharded thread pools and work stealing (C++ only).
           --ipv6               Use IPv6 addresses.
           --socks              Use SOCKS proxy running on localhost.
           --ice-home=<path>    Use the binary distribution from the given path.
@@ -2106,7 +2124,7 @@ def processCmdLine():
 
     try:
         opts, args = getopt.getopt(
-            sys.argv[1:], "", ["debug", "trace=", "protocol=", "compress", "valgrind", "host=", "serialize", "ipv6", \
+            sys.argv[1:], "", ["debug", "trace=", "protocol=", "compress", "valgrind", "host=", "serialize", "shards", "ipv6", \
                                "socks", "ice-home=", "x86", "x64", "cross=", "client-home=", "env", \
                                "service-dir=", "appverifier", "arg=", \
                                "compact", "winrt", "server", "mx", "c++11", "controller=", "configName="])
@@ -2150,6 +2168,9 @@ def processCmdLine():
         elif o == "--serialize":
             global serialize
             serialize = True
+        elif o == "--shards":
+            global shards
+            shards = True
         elif o == "--host":
             global host
             host = a